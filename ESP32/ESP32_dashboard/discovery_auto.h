@@ -0,0 +1,48 @@
+/**
+ * Auto Discovery Policy
+ * Last known server (Preferences), mDNS dan scan subnet lokal di-race
+ * bersamaan (discovery_race.h), yang pertama connect menang
+ * Tanpa hard-coded IP, mendukung pindah-pindah jaringan
+ */
+
+#ifndef DISCOVERY_AUTO_H
+#define DISCOVERY_AUTO_H
+
+#include <Preferences.h>
+#include "policy_discovery.h"
+#include "discovery_race.h"
+
+struct AutoDiscovery {
+    static constexpr const char* kName = "Auto (cache/mDNS/scan race)";
+    static constexpr bool kRaces = true;
+
+    void begin() {
+        preferences.begin("uav-config", false);
+
+        // Load last known configuration
+        String ip = preferences.getString("last_server_ip", "");
+        if (ip.length() > 0) {
+            lastKnown.set(ip.c_str(), preferences.getInt("last_server_port", SERVER_PORT));
+        }
+    }
+
+    bool discover(ServerEndpoint& endpoint) {
+        return race.run(lastKnown, endpoint);
+    }
+
+    void remember(const ServerEndpoint& endpoint) {
+        if (endpoint == lastKnown) return;
+
+        lastKnown = endpoint;
+        preferences.putString("last_server_ip", endpoint.host);
+        preferences.putInt("last_server_port", endpoint.port);
+    }
+
+    DiscoveryRace race;
+
+private:
+    Preferences preferences;
+    ServerEndpoint lastKnown;
+};
+
+#endif // DISCOVERY_AUTO_H
@@ -0,0 +1,340 @@
+/**
+ * Discovery Race (happy-eyeballs)
+ * Semua strategi discovery jalan bersamaan dengan head start bertingkat:
+ *   last known (0ms) -> mDNS (150ms) -> subnet scan (300ms)
+ * Probe = TCP connect non-blocking (lwIP socket), jadi satu strategi yang
+ * lambat tidak lagi menahan strategi lain sampai timeout-nya habis.
+ * Connect pertama yang berhasil menang, sisanya di-cancel (socket ditutup,
+ * query mDNS dihapus). Hasil tiap strategi + pemenang dicatat.
+ */
+
+#ifndef DISCOVERY_RACE_H
+#define DISCOVERY_RACE_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <ESPmDNS.h>
+#include <mdns.h>
+#include <lwip/sockets.h>
+#include "policy_transport.h"
+#include "firmware_config.h"
+
+enum DiscoveryStrategy {
+    STRATEGY_LAST_KNOWN,
+    STRATEGY_MDNS,
+    STRATEGY_SUBNET_SCAN,
+    STRATEGY_COUNT
+};
+
+enum RaceOutcome { RACE_IDLE, RACE_PENDING, RACE_WON, RACE_FAILED, RACE_CANCELLED, RACE_SKIPPED };
+
+static const unsigned long RACE_HEAD_START_MS[STRATEGY_COUNT] = {0, 150, 300};
+static const unsigned long RACE_DEADLINE = 20000;         // Batas total satu race
+static const unsigned long RACE_TICK_MS = 10;             // Jeda antar poll (yield ke WiFi stack)
+static const unsigned long RACE_SCAN_PROBE_TIMEOUT = 400; // Host LAN yang hidup menjawab < 100ms
+static const uint32_t RACE_MDNS_TIMEOUT = 3000;
+static const int RACE_SUBNET_SOCKETS = 6;                 // lwIP default 16 socket, sisakan untuk transport
+
+// ================== TCP PROBE ==================
+enum ProbeState { PROBE_PENDING, PROBE_OPEN, PROBE_FAILED };
+
+class TcpProbe {
+public:
+    bool start(IPAddress ip, uint16_t newPort, unsigned long timeoutMs) {
+        cancel();
+        address = ip;
+        port = newPort;
+        startedAt = millis();
+        timeout = timeoutMs;
+
+        fd = lwip_socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) return false;
+        lwip_fcntl(fd, F_SETFL, lwip_fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+        struct sockaddr_in target = {};
+        target.sin_family = AF_INET;
+        target.sin_port = htons(port);
+        target.sin_addr.s_addr = (uint32_t)address;
+        if (lwip_connect(fd, (struct sockaddr*)&target, sizeof(target)) < 0 && errno != EINPROGRESS) {
+            cancel();
+            return false;
+        }
+        return true;
+    }
+
+    ProbeState poll() {
+        if (fd < 0) return PROBE_FAILED;
+
+        fd_set writable;
+        FD_ZERO(&writable);
+        FD_SET(fd, &writable);
+        struct timeval immediate = {0, 0};
+        if (lwip_select(fd + 1, nullptr, &writable, nullptr, &immediate) > 0) {
+            int error = 0;
+            socklen_t length = sizeof(error);
+            lwip_getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length);
+            cancel();
+            return error == 0 ? PROBE_OPEN : PROBE_FAILED;
+        }
+
+        if (millis() - startedAt >= timeout) {
+            cancel();
+            return PROBE_FAILED;
+        }
+        return PROBE_PENDING;
+    }
+
+    void cancel() {
+        if (fd >= 0) lwip_close(fd);
+        fd = -1;
+    }
+
+    bool active() const { return fd >= 0; }
+
+    IPAddress address;
+    uint16_t port = 0;
+
+private:
+    int fd = -1;
+    unsigned long startedAt = 0;
+    unsigned long timeout = 0;
+};
+
+// ================== RACE COORDINATOR ==================
+struct StrategyResult {
+    RaceOutcome outcome = RACE_IDLE;
+    unsigned long elapsedMs = 0;   // Sejak strategi mulai (bukan sejak race mulai)
+    unsigned long wins = 0;
+};
+
+class DiscoveryRace {
+public:
+    ~DiscoveryRace() { cancelAll(); }
+
+    // Blocking sampai ada pemenang, semua strategi gagal, atau RACE_DEADLINE
+    bool run(const ServerEndpoint& lastKnown, ServerEndpoint& endpoint) {
+        raceStartedAt = millis();
+        races++;
+        winner = -1;
+        for (StrategyResult& result : results) {
+            result.outcome = RACE_IDLE;
+            result.elapsedMs = 0;
+        }
+
+        lastKnownValid = lastKnown.valid() && lastKnownProbe.address.fromString(lastKnown.host);
+        lastKnownPort = lastKnown.port;
+        if (!lastKnownValid) results[STRATEGY_LAST_KNOWN].outcome = RACE_SKIPPED;
+
+        while (winner < 0 && millis() - raceStartedAt < RACE_DEADLINE) {
+            unsigned long elapsed = millis() - raceStartedAt;
+            bool running = false;
+
+            for (int strategy = 0; strategy < STRATEGY_COUNT && winner < 0; strategy++) {
+                StrategyResult& result = results[strategy];
+                if (result.outcome == RACE_IDLE && elapsed >= RACE_HEAD_START_MS[strategy]) {
+                    startedAt[strategy] = millis();
+                    result.outcome = RACE_PENDING;
+                    if (!start(strategy)) finish(strategy, RACE_FAILED);
+                }
+                if (result.outcome == RACE_PENDING) {
+                    step(strategy, endpoint);
+                }
+                if (result.outcome == RACE_IDLE || result.outcome == RACE_PENDING) running = true;
+            }
+
+            if (!running) break;
+            delay(RACE_TICK_MS);
+        }
+
+        // Yang kalah (atau kena deadline) dibatalkan
+        for (int strategy = 0; strategy < STRATEGY_COUNT; strategy++) {
+            StrategyResult& result = results[strategy];
+            if (result.outcome == RACE_PENDING) {
+                finish(strategy, winner >= 0 ? RACE_CANCELLED : RACE_FAILED);
+            } else if (result.outcome == RACE_IDLE) {
+                result.outcome = RACE_CANCELLED;
+            }
+        }
+        cancelAll();
+
+        lastDurationMs = millis() - raceStartedAt;
+        if (winner < 0) return false;
+        results[winner].wins++;
+        return true;
+    }
+
+    static const char* strategyName(int strategy) {
+        static const char* const names[STRATEGY_COUNT] = {"last known", "mDNS", "subnet scan"};
+        return strategy >= 0 && strategy < STRATEGY_COUNT ? names[strategy] : "-";
+    }
+
+    static const char* outcomeName(RaceOutcome outcome) {
+        static const char* const names[] = {"idle", "pending", "won", "failed", "cancelled", "skipped"};
+        return names[outcome];
+    }
+
+    template <typename Log>
+    void report() const {
+        Log::line("🏁 [DISCOVERY] Race #%lu: %s won in %lums", races, strategyName(winner), lastDurationMs);
+        for (int strategy = 0; strategy < STRATEGY_COUNT; strategy++) {
+            const StrategyResult& result = results[strategy];
+            Log::line("    %-12s %-9s %5lums (wins %lu)", strategyName(strategy),
+                      outcomeName(result.outcome), result.elapsedMs, result.wins);
+        }
+    }
+
+    int lastWinner() const { return winner; }
+    unsigned long lastDuration() const { return lastDurationMs; }
+    unsigned long raceCount() const { return races; }
+    const StrategyResult& result(int strategy) const { return results[strategy]; }
+
+private:
+    StrategyResult results[STRATEGY_COUNT];
+    unsigned long startedAt[STRATEGY_COUNT] = {0};
+    unsigned long raceStartedAt = 0;
+    unsigned long lastDurationMs = 0;
+    unsigned long races = 0;
+    int winner = -1;
+
+    TcpProbe lastKnownProbe;
+    bool lastKnownValid = false;
+    int lastKnownPort = 0;
+
+    bool mdnsStarted = false;
+    mdns_search_once_t* mdnsSearch = nullptr;
+    TcpProbe mdnsProbe;
+
+    TcpProbe scanProbes[RACE_SUBNET_SOCKETS];
+    int scanCursor = 0;
+
+    bool start(int strategy) {
+        switch (strategy) {
+            case STRATEGY_LAST_KNOWN:
+                return lastKnownProbe.start(lastKnownProbe.address, lastKnownPort, DISCOVERY_PROBE_TIMEOUT);
+
+            case STRATEGY_MDNS:
+                if (!mdnsStarted) mdnsStarted = MDNS.begin("esp32-uav");
+                if (!mdnsStarted) return false;
+                mdnsSearch = mdns_query_async_new(nullptr, "_uav-dashboard", "_tcp", MDNS_TYPE_PTR,
+                                                  RACE_MDNS_TIMEOUT, 1, nullptr);
+                return mdnsSearch != nullptr;
+
+            case STRATEGY_SUBNET_SCAN:
+                scanCursor = 0;
+                for (TcpProbe& probe : scanProbes) {
+                    if (!startNextScanProbe(probe)) break;
+                }
+                return true;
+        }
+        return false;
+    }
+
+    void step(int strategy, ServerEndpoint& endpoint) {
+        switch (strategy) {
+            case STRATEGY_LAST_KNOWN:
+                settle(strategy, lastKnownProbe, lastKnownProbe.poll(), endpoint);
+                break;
+
+            case STRATEGY_MDNS:
+                if (mdnsSearch) {
+                    pollMdnsQuery(strategy);
+                } else {
+                    settle(strategy, mdnsProbe, mdnsProbe.poll(), endpoint);
+                }
+                break;
+
+            case STRATEGY_SUBNET_SCAN: {
+                bool pending = false;
+                for (TcpProbe& probe : scanProbes) {
+                    if (!probe.active()) continue;
+                    ProbeState state = probe.poll();
+                    if (state == PROBE_OPEN) {
+                        declareWinner(strategy, probe, endpoint);
+                        return;
+                    }
+                    if (state == PROBE_FAILED) startNextScanProbe(probe);
+                    if (probe.active()) pending = true;
+                }
+                if (!pending) finish(strategy, RACE_FAILED);
+                break;
+            }
+        }
+    }
+
+    // Query mDNS selesai -> verifikasi alamatnya dengan TCP connect seperti strategi lain
+    void pollMdnsQuery(int strategy) {
+        mdns_result_t* found = nullptr;
+        uint8_t count = 0;
+        if (!mdns_query_async_get_results(mdnsSearch, 0, &found, &count)) return;
+
+        bool started = false;
+        for (mdns_result_t* entry = found; entry && !started; entry = entry->next) {
+            for (mdns_ip_addr_t* ip = entry->addr; ip && !started; ip = ip->next) {
+                if (ip->addr.type != ESP_IPADDR_TYPE_V4) continue;
+                started = mdnsProbe.start(IPAddress(ip->addr.u_addr.ip4.addr), entry->port, DISCOVERY_PROBE_TIMEOUT);
+            }
+        }
+        if (found) mdns_query_results_free(found);
+        mdns_query_async_delete(mdnsSearch);
+        mdnsSearch = nullptr;
+
+        if (!started) finish(strategy, RACE_FAILED);
+    }
+
+    void settle(int strategy, TcpProbe& probe, ProbeState state, ServerEndpoint& endpoint) {
+        if (state == PROBE_OPEN) {
+            declareWinner(strategy, probe, endpoint);
+        } else if (state == PROBE_FAILED) {
+            finish(strategy, RACE_FAILED);
+        }
+    }
+
+    void finish(int strategy, RaceOutcome outcome) {
+        results[strategy].outcome = outcome;
+        results[strategy].elapsedMs = millis() - startedAt[strategy];
+    }
+
+    void declareWinner(int strategy, const TcpProbe& probe, ServerEndpoint& endpoint) {
+        winner = strategy;
+        finish(strategy, RACE_WON);
+        endpoint.set(probe.address.toString().c_str(), probe.port);
+    }
+
+    // Urutan scan: IP yang umum dulu (router, static), lalu seluruh subnet
+    bool startNextScanProbe(TcpProbe& probe) {
+        static const uint8_t quickScanIPs[] = {1, 100, 101, 102, 150, 200, 254};
+        static const int quickCount = sizeof(quickScanIPs);
+        IPAddress local = WiFi.localIP();
+
+        while (scanCursor < quickCount + 254) {
+            int cursor = scanCursor++;
+            uint8_t last = cursor < quickCount ? quickScanIPs[cursor] : (uint8_t)(cursor - quickCount + 1);
+            if (last == local[3]) continue;
+            if (cursor >= quickCount && isQuickScanIP(last, quickScanIPs, quickCount)) continue;
+
+            if (probe.start(IPAddress(local[0], local[1], local[2], last), SERVER_PORT, RACE_SCAN_PROBE_TIMEOUT)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool isQuickScanIP(uint8_t last, const uint8_t* list, int count) {
+        for (int i = 0; i < count; i++) {
+            if (list[i] == last) return true;
+        }
+        return false;
+    }
+
+    void cancelAll() {
+        lastKnownProbe.cancel();
+        mdnsProbe.cancel();
+        for (TcpProbe& probe : scanProbes) probe.cancel();
+        if (mdnsSearch) {
+            mdns_query_async_delete(mdnsSearch);
+            mdnsSearch = nullptr;
+        }
+    }
+};
+
+#endif // DISCOVERY_RACE_H
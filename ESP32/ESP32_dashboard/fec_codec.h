@@ -0,0 +1,271 @@
+/**
+ * FEC Codec untuk Datagram Telemetry
+ * Reed-Solomon systematic (matriks Cauchy atas GF(256)) per grup k datagram:
+ * k datagram data dikirim apa adanya + r datagram parity; penerima bisa
+ * memulihkan hingga r datagram yang hilang dalam satu grup tanpa retransmisi.
+ * Parity dihitung inkremental saat datagram data dikirim (tidak perlu
+ * menyimpan data). Tanpa dependensi Arduino: decoder dipakai juga oleh
+ * native/fec_link.cpp di ground station.
+ *
+ * Wire format (little endian):
+ *   header[8] : 'F' 'C' type group(u16) index k r
+ *   data      : header | datagram asli (frame MAVLink)
+ *   parity    : header | length[k](u16) | symbol parity (panjang = max length)
+ *   feedback  : header(type=2) | loss_permille(u16) | recovered(u32)
+ *   k di datagram data = rencana grup; grup yang ditutup lebih awal (deadline)
+ *   membawa k final di datagram parity-nya
+ */
+
+#ifndef FEC_CODEC_H
+#define FEC_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define FEC_MAGIC_0 'F'
+#define FEC_MAGIC_1 'C'
+#define FEC_HEADER_LEN 8
+#define FEC_TYPE_DATA 0
+#define FEC_TYPE_PARITY 1
+#define FEC_TYPE_FEEDBACK 2
+#define FEC_MAX_K 16
+#define FEC_MAX_R 4
+#define FEC_FEEDBACK_LEN (FEC_HEADER_LEN + 6)
+
+struct FecHeader {
+    uint8_t type = FEC_TYPE_DATA;
+    uint16_t group = 0;
+    uint8_t index = 0;
+    uint8_t k = 0;
+    uint8_t r = 0;
+};
+
+// ================== GF(256) ==================
+// Polynomial 0x11D, tabel exp/log dibangun compile-time (masuk flash)
+struct GaloisTables {
+    uint8_t exp[512];
+    uint8_t log[256];
+
+    constexpr GaloisTables() : exp(), log() {
+        unsigned value = 1;
+        for (int i = 0; i < 255; i++) {
+            exp[i] = (uint8_t)value;
+            exp[i + 255] = (uint8_t)value;
+            log[value] = (uint8_t)i;
+            value <<= 1;
+            if (value & 0x100) value ^= 0x11D;
+        }
+        exp[510] = exp[0];
+        exp[511] = exp[1];
+    }
+};
+
+inline constexpr GaloisTables gf256{};
+
+inline uint8_t gfMul(uint8_t a, uint8_t b) {
+    return (a == 0 || b == 0) ? 0 : gf256.exp[gf256.log[a] + gf256.log[b]];
+}
+
+inline uint8_t gfInv(uint8_t a) {
+    return gf256.exp[255 - gf256.log[a]];
+}
+
+// Koefisien Cauchy baris parity i, kolom data j: 1 / (x_i + y_j), x_i = 0x80|i, y_j = j
+inline uint8_t fecCoefficient(uint8_t parityRow, uint8_t dataColumn) {
+    return gfInv((uint8_t)((0x80 | parityRow) ^ dataColumn));
+}
+
+// symbol ^= coefficient * data (data lebih pendek dari symbol = di-pad nol)
+inline void gfMulAdd(uint8_t* symbol, const uint8_t* data, size_t length, uint8_t coefficient) {
+    if (coefficient == 0) return;
+    uint8_t logCoefficient = gf256.log[coefficient];
+    for (size_t i = 0; i < length; i++) {
+        if (data[i]) symbol[i] ^= gf256.exp[gf256.log[data[i]] + logCoefficient];
+    }
+}
+
+// ================== REDUNDANCY POLICY ==================
+static const uint16_t FEC_TARGET_GROUP_LOSS = 5;   // Permil grup yang boleh gagal dipulihkan
+
+// Peluang lebih dari `parity` dari n simbol grup hilang (binomial, loss p per datagram)
+inline double fecGroupFailure(double p, uint8_t n, uint8_t parity) {
+    double term = 1;
+    for (uint8_t i = 0; i < n; i++) term *= 1 - p;
+    double within = term;
+    for (uint8_t i = 1; i <= parity && i <= n; i++) {
+        term *= (double)(n - i + 1) / i * p / (1 - p);
+        within += term;
+    }
+    return 1 - within;
+}
+
+// Parity per grup (dipakai firmware dan bench): r terkecil sehingga grup k data + r parity
+// gagal dengan peluang <= FEC_TARGET_GROUP_LOSS pada loss terukur (permil per datagram).
+// Grup k=1 minimal r=1: datagram tunggal tanpa parity sama sekali tidak terlindungi, dan
+// loss dari beberapa datagram per menit terlalu kasar untuk memutuskan r=0
+inline uint8_t fecParityForLoss(uint16_t lossPermille, uint8_t k, uint8_t minimum, uint8_t maximum) {
+    double p = lossPermille < 999 ? lossPermille / 1000.0 : 0.999;
+    uint8_t parity = k == 1 && minimum < 1 ? 1 : minimum;
+    while (parity < maximum && fecGroupFailure(p, k + parity, parity) * 1000 > FEC_TARGET_GROUP_LOSS) parity++;
+    return parity > maximum ? maximum : parity;
+}
+
+// ================== HEADER ==================
+inline void fecWriteHeader(uint8_t* out, const FecHeader& header) {
+    out[0] = FEC_MAGIC_0;
+    out[1] = FEC_MAGIC_1;
+    out[2] = header.type;
+    out[3] = header.group & 0xFF;
+    out[4] = header.group >> 8;
+    out[5] = header.index;
+    out[6] = header.k;
+    out[7] = header.r;
+}
+
+inline bool fecReadHeader(const uint8_t* in, size_t length, FecHeader& header) {
+    if (length < FEC_HEADER_LEN || in[0] != FEC_MAGIC_0 || in[1] != FEC_MAGIC_1) return false;
+    header.type = in[2];
+    header.group = (uint16_t)(in[3] | (in[4] << 8));
+    header.index = in[5];
+    header.k = in[6];
+    header.r = in[7];
+    if (header.type == FEC_TYPE_FEEDBACK) return true;
+    return header.k > 0 && header.k <= FEC_MAX_K && header.r <= FEC_MAX_R && header.index < header.k + header.r;
+}
+
+// ================== ENCODER ==================
+/**
+ * Parity untuk satu grup, diisi saat setiap datagram data lewat.
+ * symbolCapacity = panjang datagram terbesar yang mungkin.
+ */
+template <size_t symbolCapacity>
+class FecGroupEncoder {
+public:
+    void reset(uint8_t newK, uint8_t newR) {
+        k = newK;
+        r = newR;
+        added = 0;
+        symbolLength = 0;
+        memset(parity, 0, sizeof(parity));
+    }
+
+    // Return false jika datagram terlalu besar (dikirim tanpa perlindungan parity)
+    bool add(const uint8_t* data, size_t length) {
+        if (length > symbolCapacity || added >= k) return false;
+        for (uint8_t row = 0; row < r; row++) {
+            gfMulAdd(parity[row], data, length, fecCoefficient(row, added));
+        }
+        lengths[added++] = (uint16_t)length;
+        if (length > symbolLength) symbolLength = length;
+        return true;
+    }
+
+    // Tutup grup sebelum penuh: parity kolom 0..added-1 sudah lengkap, cukup pendekkan k
+    void truncate() { k = added; }
+
+    bool complete() const { return added == k; }
+    uint8_t count() const { return added; }
+
+    // Datagram parity ke-row (header + lengths + symbol); return panjang
+    size_t buildParity(uint8_t row, uint16_t group, uint8_t* out, size_t capacity) const {
+        size_t total = FEC_HEADER_LEN + 2 * k + symbolLength;
+        if (row >= r || total > capacity) return 0;
+
+        FecHeader header;
+        header.type = FEC_TYPE_PARITY;
+        header.group = group;
+        header.index = (uint8_t)(k + row);
+        header.k = k;
+        header.r = r;
+        fecWriteHeader(out, header);
+        for (uint8_t j = 0; j < k; j++) {
+            out[FEC_HEADER_LEN + 2 * j] = lengths[j] & 0xFF;
+            out[FEC_HEADER_LEN + 2 * j + 1] = lengths[j] >> 8;
+        }
+        memcpy(out + FEC_HEADER_LEN + 2 * k, parity[row], symbolLength);
+        return total;
+    }
+
+private:
+    uint8_t parity[FEC_MAX_R][symbolCapacity];
+    uint16_t lengths[FEC_MAX_K];
+    uint8_t k = 0;
+    uint8_t r = 0;
+    uint8_t added = 0;
+    size_t symbolLength = 0;
+};
+
+// ================== DECODER ==================
+/**
+ * Pulihkan data yang hilang dari k symbol yang diterima (data + parity).
+ * symbols[i] menunjuk symbol indeks i (0..k-1 data, k.. parity) atau nullptr.
+ * Symbol data yang diterima harus sudah di-pad nol sampai symbolLength.
+ * Symbol yang dipulihkan ditulis ke recovered[j] untuk setiap j yang hilang.
+ * Return jumlah data yang dipulihkan, -1 jika symbol kurang dari k.
+ */
+inline int fecRecover(uint8_t k, uint8_t r, const uint8_t* const* symbols, size_t symbolLength, uint8_t** recovered) {
+    uint8_t rows[FEC_MAX_K];
+    uint8_t matrix[FEC_MAX_K][FEC_MAX_K];
+    uint8_t inverse[FEC_MAX_K][FEC_MAX_K];
+
+    // Pilih k symbol: semua data yang ada, sisanya dari parity
+    int chosen = 0;
+    int missing = 0;
+    for (uint8_t j = 0; j < k; j++) {
+        if (symbols[j]) rows[chosen++] = j;
+        else missing++;
+    }
+    if (missing == 0) return 0;
+    for (uint8_t i = 0; i < r && chosen < k; i++) {
+        if (symbols[k + i]) rows[chosen++] = (uint8_t)(k + i);
+    }
+    if (chosen < k) return -1;
+
+    for (int row = 0; row < k; row++) {
+        for (int column = 0; column < k; column++) {
+            matrix[row][column] = rows[row] < k ? (rows[row] == column) : fecCoefficient(rows[row] - k, column);
+            inverse[row][column] = row == column;
+        }
+    }
+
+    // Gauss-Jordan atas GF(256); Cauchy menjamin matriks selalu invertible
+    for (int column = 0; column < k; column++) {
+        int pivot = column;
+        while (pivot < k && matrix[pivot][column] == 0) pivot++;
+        if (pivot == k) return -1;
+        if (pivot != column) {
+            for (int c = 0; c < k; c++) {
+                uint8_t swap = matrix[column][c]; matrix[column][c] = matrix[pivot][c]; matrix[pivot][c] = swap;
+                swap = inverse[column][c]; inverse[column][c] = inverse[pivot][c]; inverse[pivot][c] = swap;
+            }
+        }
+        uint8_t scale = gfInv(matrix[column][column]);
+        for (int c = 0; c < k; c++) {
+            matrix[column][c] = gfMul(matrix[column][c], scale);
+            inverse[column][c] = gfMul(inverse[column][c], scale);
+        }
+        for (int row = 0; row < k; row++) {
+            uint8_t factor = matrix[row][column];
+            if (row == column || factor == 0) continue;
+            for (int c = 0; c < k; c++) {
+                matrix[row][c] ^= gfMul(factor, matrix[column][c]);
+                inverse[row][c] ^= gfMul(factor, inverse[column][c]);
+            }
+        }
+    }
+
+    // data_j = sum inverse[j][i] * received_i (hanya baris data yang hilang)
+    int recoveredCount = 0;
+    for (uint8_t j = 0; j < k; j++) {
+        if (symbols[j]) continue;
+        memset(recovered[j], 0, symbolLength);
+        for (int i = 0; i < k; i++) {
+            gfMulAdd(recovered[j], symbols[rows[i]], symbolLength, inverse[j][i]);
+        }
+        recoveredCount++;
+    }
+    return recoveredCount;
+}
+
+#endif // FEC_CODEC_H
@@ -0,0 +1,55 @@
+/**
+ * Firmware Configuration
+ * Semua konstanta jaringan & timing di satu tempat, dipakai oleh semua policy
+ */
+
+#ifndef FIRMWARE_CONFIG_H
+#define FIRMWARE_CONFIG_H
+
+// ================== KONFIGURASI - SESUAI SETUP KOMPUTER KAMU ==================
+struct WiFiNetwork {
+    const char* ssid;
+    const char* password;
+};
+
+// Dicoba berurutan; jaringan pertama yang terlihat saat scan dipakai
+static const WiFiNetwork availableNetworks[] = {
+    {"Redmi13", "12345678"},
+    {"YourHomeWiFi", "password123"},
+    {"YourOfficeWiFi", "office_pass"},
+    // Add more networks as needed
+};
+static const int numNetworks = sizeof(availableNetworks) / sizeof(availableNetworks[0]);
+
+static const char* const SERVER_HOST = "10.94.89.211";   // IP komputer (StaticDiscovery)
+static const int SERVER_PORT = 3000;
+static const int MAVLINK_UDP_PORT = 14550;               // Port standar MAVLink ground station
+static const uint8_t MAVLINK_SYSTEM_ID = 1;
+static const unsigned long SERIAL_TELEMETRY_BAUD = 921600; // USB serial tethered link (profile 4)
+static const int MAVLINK_FEC_PORT = 14551;              // native/fec_link (profile 5)
+static const int FEC_LOCAL_PORT = 14552;                // Feedback loss dari fec_link
+static const uint8_t FEC_GROUP_SIZE = 4;                // k datagram data per grup (maksimum)
+static const unsigned long FEC_GROUP_DEADLINE = 500;     // Grup ditutup (parity dikirim) paling lambat sekian ms
+static const uint8_t FEC_DEFAULT_PARITY = 1;            // r sebelum ada feedback
+static const uint8_t FEC_MIN_PARITY = 0;
+static const uint8_t FEC_MAX_PARITY = 3;
+static const unsigned long FEC_FEEDBACK_TIMEOUT = 10000; // Feedback basi -> kembali ke default
+static const char* const DEVICE_ID = "ESP32_UAV_DASHBOARD";
+static const char* const FIRMWARE_VERSION = "3.0_POLICY";
+
+// MQTT Configuration (HiveMQ free tier)
+static const char* const MQTT_SERVER = "broker.hivemq.com";
+static const int MQTT_PORT = 1883;
+static const char* const MQTT_CLIENT_ID = "ESP32_UAV_Dashboard";
+static const char* const MQTT_TOPIC_TELEMETRY = "uav/dashboard/telemetry";
+static const char* const MQTT_TOPIC_COMMANDS = "uav/dashboard/commands";
+
+// Timing constants
+static const unsigned long DATA_SEND_INTERVAL = 3000;         // Send data every 3 seconds
+static const unsigned long STATUS_PRINT_INTERVAL = 10000;     // Print status every 10 seconds
+static const unsigned long CONNECTION_RETRY_INTERVAL = 15000; // Server (re)connect attempt
+static const unsigned long HTTP_TIMEOUT = 5000;
+static const unsigned long DISCOVERY_PROBE_TIMEOUT = 2000;    // Quick timeout for scanning
+static const unsigned long LOOP_DELAY = 100;
+
+#endif // FIRMWARE_CONFIG_H
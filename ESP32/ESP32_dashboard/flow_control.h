@@ -0,0 +1,100 @@
+/**
+ * Credit-Based Flow Control (device side)
+ * Server mengirim grant {"credit_limit", "credit_bytes", "interval_ms"} lewat
+ * response HTTP atau event Socket.IO flowCredit. Device hanya boleh kirim paket
+ * n selama n < credit_limit; selama belum pernah menerima grant (server lama),
+ * pengiriman tidak dibatasi.
+ */
+
+#ifndef FLOW_CONTROL_H
+#define FLOW_CONTROL_H
+
+#include <Arduino.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Tanpa grant selama ini -> kirim satu frame probe untuk memancing ack baru
+static const unsigned long CREDIT_PROBE_TIMEOUT = 10000;
+
+struct FlowGrant {
+    unsigned long creditLimit = 0;
+    long creditBytes = -1;
+    unsigned long intervalMs = 0;
+};
+
+// Cari `"key":<angka>` di text tanpa parser JSON penuh (tanpa heap)
+inline bool findJsonNumber(const char* text, size_t length, const char* key, long& value) {
+    size_t keyLength = strlen(key);
+    for (size_t i = 0; i + keyLength + 3 <= length; i++) {
+        if (text[i] != '"' || strncmp(text + i + 1, key, keyLength) != 0) continue;
+        size_t pos = i + 1 + keyLength;
+        if (text[pos] != '"' || text[pos + 1] != ':') continue;
+
+        char* end = nullptr;
+        value = strtol(text + pos + 2, &end, 10);
+        return end != text + pos + 2;
+    }
+    return false;
+}
+
+inline bool parseFlowGrant(const char* text, size_t length, FlowGrant& grant) {
+    long value = 0;
+    if (!findJsonNumber(text, length, "credit_limit", value) || value < 0) return false;
+    grant.creditLimit = (unsigned long)value;
+
+    if (findJsonNumber(text, length, "credit_bytes", value)) grant.creditBytes = value;
+    if (findJsonNumber(text, length, "interval_ms", value) && value >= 0) grant.intervalMs = (unsigned long)value;
+    return true;
+}
+
+class CreditWindow {
+public:
+    bool canSend(unsigned long packetNumber, size_t bytes, unsigned long now) {
+        if (!managed) return true;
+        if (packetNumber < creditLimit && (creditBytes < 0 || (long)bytes <= bytesRemaining)) return true;
+
+        // Ack hilang / server restart: satu probe per timeout agar tidak deadlock
+        if (now - lastGrantAt >= CREDIT_PROBE_TIMEOUT) {
+            lastGrantAt = now;
+            probes++;
+            return true;
+        }
+
+        stalls++;
+        return false;
+    }
+
+    void consume(size_t bytes) {
+        if (managed && creditBytes >= 0) bytesRemaining -= (long)bytes;
+    }
+
+    void apply(const FlowGrant& grant, unsigned long now) {
+        managed = true;
+        creditLimit = grant.creditLimit;
+        creditBytes = grant.creditBytes;
+        bytesRemaining = grant.creditBytes;
+        intervalHint = grant.intervalMs;
+        lastGrantAt = now;
+        grants++;
+    }
+
+    bool isManaged() const { return managed; }
+    unsigned long limit() const { return creditLimit; }
+    unsigned long stallCount() const { return stalls; }
+    unsigned long probeCount() const { return probes; }
+    unsigned long grantCount() const { return grants; }
+    unsigned long sendInterval(unsigned long base) const { return intervalHint > base ? intervalHint : base; }
+
+private:
+    bool managed = false;
+    unsigned long creditLimit = 0;
+    long creditBytes = -1;
+    long bytesRemaining = 0;
+    unsigned long intervalHint = 0;
+    unsigned long lastGrantAt = 0;
+    unsigned long stalls = 0;
+    unsigned long probes = 0;
+    unsigned long grants = 0;
+};
+
+#endif // FLOW_CONTROL_H
@@ -0,0 +1,235 @@
+/**
+ * MAVLink v2 Telemetry Encoder
+ * Minimal, dependency-free encoder untuk message standar yang dipakai dashboard
+ * Frame dibangun langsung ke buffer caller (tanpa heap), payload di-truncate
+ * sesuai aturan MAVLink v2 (trailing zero bytes dibuang)
+ */
+
+#ifndef MAVLINK_TELEMETRY_H
+#define MAVLINK_TELEMETRY_H
+
+#include <stdint.h>
+#include <string.h>
+
+// ================== PROTOCOL CONSTANTS ==================
+#define MAVLINK_STX_V2            0xFD
+#define MAVLINK_HEADER_LEN        10
+#define MAVLINK_CHECKSUM_LEN      2
+#define MAVLINK_MAX_PAYLOAD_LEN   255
+#define MAVLINK_MAX_FRAME_LEN     (MAVLINK_HEADER_LEN + MAVLINK_MAX_PAYLOAD_LEN + MAVLINK_CHECKSUM_LEN)
+
+// Message IDs + CRC_EXTRA (dari common.xml)
+#define MAVLINK_MSG_ID_HEARTBEAT            0
+#define MAVLINK_MSG_ID_SYS_STATUS           1
+#define MAVLINK_MSG_ID_GPS_RAW_INT          24
+#define MAVLINK_MSG_ID_SCALED_PRESSURE      29
+#define MAVLINK_MSG_ID_GLOBAL_POSITION_INT  33
+#define MAVLINK_MSG_ID_BATTERY_STATUS       147
+#define MAVLINK_MSG_ID_NAMED_VALUE_FLOAT    251
+#define MAVLINK_MSG_ID_NAMED_VALUE_INT      252
+
+#define MAVLINK_CRC_EXTRA_HEARTBEAT           50
+#define MAVLINK_CRC_EXTRA_SYS_STATUS          124
+#define MAVLINK_CRC_EXTRA_GPS_RAW_INT         24
+#define MAVLINK_CRC_EXTRA_SCALED_PRESSURE     115
+#define MAVLINK_CRC_EXTRA_GLOBAL_POSITION_INT 104
+#define MAVLINK_CRC_EXTRA_BATTERY_STATUS      154
+#define MAVLINK_CRC_EXTRA_NAMED_VALUE_FLOAT   170
+#define MAVLINK_CRC_EXTRA_NAMED_VALUE_INT     44
+
+// Enum values yang dipakai
+#define MAV_TYPE_QUADROTOR                  2
+#define MAV_AUTOPILOT_GENERIC               0
+#define MAV_STATE_ACTIVE                    4
+#define MAV_BATTERY_FUNCTION_ALL            1
+#define MAV_BATTERY_TYPE_LIPO               1
+#define MAV_SYS_STATUS_SENSOR_GPS           0x00000020
+#define MAV_SYS_STATUS_SENSOR_ABSOLUTE_PRESSURE 0x00000008
+#define MAV_SYS_STATUS_SENSOR_BATTERY       0x02000000
+#define GPS_FIX_TYPE_NO_FIX                 1
+#define GPS_FIX_TYPE_3D_FIX                 3
+
+// ================== ENCODER ==================
+class MavlinkEncoder {
+public:
+    MavlinkEncoder(uint8_t systemId = 1, uint8_t componentId = 1)
+        : sysid(systemId), compid(componentId), sequence(0) {}
+
+    // Semua method pack*() menulis satu frame lengkap ke `out` (butuh 12 bytes +
+    // panjang payload penuh message tsb) dan mengembalikan panjang frame.
+
+    size_t packHeartbeat(uint8_t* out) {
+        uint8_t* p = payloadStart(out);
+        put32(p + 0, 0);                       // custom_mode
+        p[4] = MAV_TYPE_QUADROTOR;             // type
+        p[5] = MAV_AUTOPILOT_GENERIC;          // autopilot
+        p[6] = 0;                              // base_mode
+        p[7] = MAV_STATE_ACTIVE;               // system_status
+        p[8] = 3;                              // mavlink_version
+        return finalize(out, MAVLINK_MSG_ID_HEARTBEAT, 9, MAVLINK_CRC_EXTRA_HEARTBEAT);
+    }
+
+    size_t packSysStatus(uint8_t* out, float voltage, float current) {
+        uint8_t* p = payloadStart(out);
+        const uint32_t sensors = MAV_SYS_STATUS_SENSOR_GPS |
+                                 MAV_SYS_STATUS_SENSOR_ABSOLUTE_PRESSURE |
+                                 MAV_SYS_STATUS_SENSOR_BATTERY;
+        memset(p, 0, 31);
+        put32(p + 0, sensors);                 // onboard_control_sensors_present
+        put32(p + 4, sensors);                 // onboard_control_sensors_enabled
+        put32(p + 8, sensors);                 // onboard_control_sensors_health
+        put16(p + 14, toMillivolts(voltage));  // voltage_battery [mV]
+        put16(p + 16, (uint16_t)toCentiamps(current)); // current_battery [cA]
+        p[30] = (uint8_t)(int8_t)-1;           // battery_remaining (unknown)
+        return finalize(out, MAVLINK_MSG_ID_SYS_STATUS, 31, MAVLINK_CRC_EXTRA_SYS_STATUS);
+    }
+
+    size_t packGpsRawInt(uint8_t* out, uint64_t timeUsec, float lat, float lon, float altitude, int satellites) {
+        uint8_t* p = payloadStart(out);
+        put64(p + 0, timeUsec);
+        put32(p + 8, (uint32_t)toDegE7(lat));
+        put32(p + 12, (uint32_t)toDegE7(lon));
+        put32(p + 16, (uint32_t)(int32_t)(altitude * 1000.0f));
+        put16(p + 20, UINT16_MAX);             // eph (unknown)
+        put16(p + 22, UINT16_MAX);             // epv (unknown)
+        put16(p + 24, UINT16_MAX);             // vel (unknown)
+        put16(p + 26, UINT16_MAX);             // cog (unknown)
+        p[28] = satellites >= 4 ? GPS_FIX_TYPE_3D_FIX : GPS_FIX_TYPE_NO_FIX;
+        p[29] = (uint8_t)(satellites < 0 ? 255 : satellites);
+        return finalize(out, MAVLINK_MSG_ID_GPS_RAW_INT, 30, MAVLINK_CRC_EXTRA_GPS_RAW_INT);
+    }
+
+    size_t packScaledPressure(uint8_t* out, uint32_t timeBootMs, float temperature) {
+        uint8_t* p = payloadStart(out);
+        put32(p + 0, timeBootMs);
+        putFloat(p + 4, 0.0f);                 // press_abs (belum ada sensor)
+        putFloat(p + 8, 0.0f);                 // press_diff
+        put16(p + 12, (uint16_t)(int16_t)(temperature * 100.0f)); // [cdegC]
+        return finalize(out, MAVLINK_MSG_ID_SCALED_PRESSURE, 14, MAVLINK_CRC_EXTRA_SCALED_PRESSURE);
+    }
+
+    size_t packGlobalPositionInt(uint8_t* out, uint32_t timeBootMs, float lat, float lon, float altitude) {
+        uint8_t* p = payloadStart(out);
+        int32_t altMm = (int32_t)(altitude * 1000.0f);
+        put32(p + 0, timeBootMs);
+        put32(p + 4, (uint32_t)toDegE7(lat));
+        put32(p + 8, (uint32_t)toDegE7(lon));
+        put32(p + 12, (uint32_t)altMm);        // alt MSL [mm]
+        put32(p + 16, (uint32_t)altMm);        // relative_alt [mm]
+        put16(p + 20, 0);                      // vx
+        put16(p + 22, 0);                      // vy
+        put16(p + 24, 0);                      // vz
+        put16(p + 26, UINT16_MAX);             // hdg (unknown)
+        return finalize(out, MAVLINK_MSG_ID_GLOBAL_POSITION_INT, 28, MAVLINK_CRC_EXTRA_GLOBAL_POSITION_INT);
+    }
+
+    size_t packBatteryStatus(uint8_t* out, float voltage, float current) {
+        uint8_t* p = payloadStart(out);
+        put32(p + 0, (uint32_t)(int32_t)-1);   // current_consumed (unknown)
+        put32(p + 4, (uint32_t)(int32_t)-1);   // energy_consumed (unknown)
+        put16(p + 8, (uint16_t)INT16_MAX);     // temperature (unknown)
+        put16(p + 10, toMillivolts(voltage));  // voltages[0] = total pack
+        for (int i = 1; i < 10; i++) {
+            put16(p + 10 + i * 2, UINT16_MAX); // unused cells
+        }
+        put16(p + 30, (uint16_t)toCentiamps(current));
+        p[32] = 0;                             // id
+        p[33] = MAV_BATTERY_FUNCTION_ALL;
+        p[34] = MAV_BATTERY_TYPE_LIPO;
+        p[35] = (uint8_t)(int8_t)-1;           // battery_remaining (unknown)
+        return finalize(out, MAVLINK_MSG_ID_BATTERY_STATUS, 36, MAVLINK_CRC_EXTRA_BATTERY_STATUS);
+    }
+
+    size_t packNamedValueFloat(uint8_t* out, uint32_t timeBootMs, const char* name, float value) {
+        uint8_t* p = payloadStart(out);
+        put32(p + 0, timeBootMs);
+        putFloat(p + 4, value);
+        putName(p + 8, name);
+        return finalize(out, MAVLINK_MSG_ID_NAMED_VALUE_FLOAT, 18, MAVLINK_CRC_EXTRA_NAMED_VALUE_FLOAT);
+    }
+
+    size_t packNamedValueInt(uint8_t* out, uint32_t timeBootMs, const char* name, int32_t value) {
+        uint8_t* p = payloadStart(out);
+        put32(p + 0, timeBootMs);
+        put32(p + 4, (uint32_t)value);
+        putName(p + 8, name);
+        return finalize(out, MAVLINK_MSG_ID_NAMED_VALUE_INT, 18, MAVLINK_CRC_EXTRA_NAMED_VALUE_INT);
+    }
+
+    // CRC-16/MCRF4XX (X.25) seperti di referensi MAVLink
+    static void crcAccumulate(uint8_t data, uint16_t* crc) {
+        uint8_t tmp = data ^ (uint8_t)(*crc & 0xFF);
+        tmp ^= (tmp << 4);
+        *crc = (*crc >> 8) ^ ((uint16_t)tmp << 8) ^ ((uint16_t)tmp << 3) ^ (tmp >> 4);
+    }
+
+private:
+    uint8_t sysid;
+    uint8_t compid;
+    uint8_t sequence;
+
+    static uint8_t* payloadStart(uint8_t* out) { return out + MAVLINK_HEADER_LEN; }
+
+    size_t finalize(uint8_t* out, uint32_t msgid, uint8_t length, uint8_t crcExtra) {
+        // MAVLink v2 payload truncation: buang trailing zero, sisakan minimal 1 byte
+        uint8_t* payload = payloadStart(out);
+        while (length > 1 && payload[length - 1] == 0) {
+            length--;
+        }
+
+        out[0] = MAVLINK_STX_V2;
+        out[1] = length;
+        out[2] = 0;                            // incompat_flags
+        out[3] = 0;                            // compat_flags
+        out[4] = sequence++;
+        out[5] = sysid;
+        out[6] = compid;
+        out[7] = (uint8_t)(msgid & 0xFF);
+        out[8] = (uint8_t)((msgid >> 8) & 0xFF);
+        out[9] = (uint8_t)((msgid >> 16) & 0xFF);
+
+        uint16_t crc = 0xFFFF;
+        for (size_t i = 1; i < (size_t)MAVLINK_HEADER_LEN + length; i++) {
+            crcAccumulate(out[i], &crc);
+        }
+        crcAccumulate(crcExtra, &crc);
+
+        out[MAVLINK_HEADER_LEN + length] = (uint8_t)(crc & 0xFF);
+        out[MAVLINK_HEADER_LEN + length + 1] = (uint8_t)(crc >> 8);
+        return MAVLINK_HEADER_LEN + length + MAVLINK_CHECKSUM_LEN;
+    }
+
+    static void put16(uint8_t* p, uint16_t v) {
+        p[0] = (uint8_t)v;
+        p[1] = (uint8_t)(v >> 8);
+    }
+
+    static void put32(uint8_t* p, uint32_t v) {
+        p[0] = (uint8_t)v;
+        p[1] = (uint8_t)(v >> 8);
+        p[2] = (uint8_t)(v >> 16);
+        p[3] = (uint8_t)(v >> 24);
+    }
+
+    static void put64(uint8_t* p, uint64_t v) {
+        put32(p, (uint32_t)v);
+        put32(p + 4, (uint32_t)(v >> 32));
+    }
+
+    static void putFloat(uint8_t* p, float v) {
+        uint32_t bits;
+        memcpy(&bits, &v, sizeof(bits));
+        put32(p, bits);
+    }
+
+    static void putName(uint8_t* p, const char* name) {
+        memset(p, 0, 10);
+        strncpy((char*)p, name, 10);
+    }
+
+    static int32_t toDegE7(float deg) { return (int32_t)((double)deg * 1e7); }
+    static uint16_t toMillivolts(float v) { return v <= 0 ? 0 : (uint16_t)(v * 1000.0f + 0.5f); }
+    static int16_t toCentiamps(float a) { return (int16_t)(a * 100.0f + (a >= 0 ? 0.5f : -0.5f)); }
+};
+
+#endif // MAVLINK_TELEMETRY_H
@@ -0,0 +1,198 @@
+/**
+ * Firmware Memory Subsystem
+ * MemoryArena - bump allocator statis, hanya boleh dipakai saat boot (seal() setelah setup)
+ * BlockPool   - blok ukuran tetap untuk buffer paket (TX payload/frame, RX command)
+ * PoolBuffer  - handle move-only; blok kembali ke pool saat handle keluar scope
+ * Setelah boot buffer paket tidak dialokasikan dari heap, pool habis = paket di-drop.
+ * Library (HTTPClient, String, WiFi/lwIP) tetap memakai heap sendiri di luar pool ini.
+ */
+
+#ifndef MEMORY_POOL_H
+#define MEMORY_POOL_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+
+// ================== KONFIGURASI POOL ==================
+static const size_t TX_POOL_BLOCK_SIZE = 512;   // Encoded payload / transport framing
+static const size_t OUTBOX_CAPACITY = 4;        // Paket tertahan selama handover WiFi
+static const size_t TX_POOL_BLOCKS = OUTBOX_CAPACITY + 5; // + payload baru, frame, cadangan
+static const size_t RX_POOL_BLOCK_SIZE = 256;   // Salinan command masuk
+static const size_t RX_POOL_BLOCKS = 4;
+// Arena hanya berisi kedua pool (tidak ada objek lain yang dialokasikan saat boot)
+static const size_t FIRMWARE_ARENA_SIZE =
+    TX_POOL_BLOCK_SIZE * TX_POOL_BLOCKS + RX_POOL_BLOCK_SIZE * RX_POOL_BLOCKS;
+
+// ================== ARENA ==================
+class MemoryArena {
+public:
+    MemoryArena(uint8_t* storage, size_t capacity) : storage(storage), capacity(capacity) {}
+
+    void* allocate(size_t size, size_t align = alignof(max_align_t)) {
+        size_t start = (used + align - 1) & ~(align - 1);
+        if (sealed || start + size > capacity) {
+            rejectedAllocations++;
+            return nullptr;
+        }
+        used = start + size;
+        return storage + start;
+    }
+
+    // Setelah seal() semua allocate() gagal: lifetime arena = lifetime firmware
+    void seal() { sealed = true; }
+
+    size_t bytesUsed() const { return used; }
+    size_t bytesCapacity() const { return capacity; }
+    bool isSealed() const { return sealed; }
+    unsigned long rejected() const { return rejectedAllocations; }
+
+private:
+    uint8_t* storage;
+    size_t capacity;
+    size_t used = 0;
+    bool sealed = false;
+    unsigned long rejectedAllocations = 0;
+};
+
+class BlockPool;
+
+// ================== POOL BUFFER HANDLE ==================
+class PoolBuffer {
+public:
+    PoolBuffer() = default;
+    PoolBuffer(BlockPool* pool, uint8_t* block) : pool(pool), block(block) {}
+    PoolBuffer(const PoolBuffer&) = delete;
+    PoolBuffer& operator=(const PoolBuffer&) = delete;
+
+    PoolBuffer(PoolBuffer&& other) noexcept { swap(other); }
+    PoolBuffer& operator=(PoolBuffer&& other) noexcept {
+        if (this != &other) {
+            reset();
+            swap(other);
+        }
+        return *this;
+    }
+
+    ~PoolBuffer() { reset(); }
+
+    explicit operator bool() const { return block != nullptr; }
+    uint8_t* data() const { return block; }
+    size_t capacity() const;
+    size_t length = 0;
+
+    inline void reset();
+
+private:
+    BlockPool* pool = nullptr;
+    uint8_t* block = nullptr;
+
+    void swap(PoolBuffer& other) {
+        std::swap(pool, other.pool);
+        std::swap(block, other.block);
+        std::swap(length, other.length);
+    }
+};
+
+// ================== BLOCK POOL ==================
+class BlockPool {
+public:
+    BlockPool(const char* name) : name(name) {}
+
+    // Ambil storage dari arena (sekali, saat boot) dan bangun free list
+    bool begin(MemoryArena& arena, size_t newBlockSize, size_t newBlockCount) {
+        blockSize = (newBlockSize + 3) & ~(size_t)3;
+        storage = (uint8_t*)arena.allocate(blockSize * newBlockCount, 4);
+        if (!storage) return false;
+
+        blockCount = newBlockCount;
+        freeHead = nullptr;
+        for (size_t i = blockCount; i > 0; i--) {
+            uint8_t* block = storage + (i - 1) * blockSize;
+            *reinterpret_cast<uint8_t**>(block) = freeHead;
+            freeHead = block;
+        }
+        return true;
+    }
+
+    // Pool habis -> PoolBuffer kosong; caller wajib degrade (drop/skip), bukan malloc
+    PoolBuffer acquire() {
+        if (!freeHead) {
+            exhaustedCount++;
+            return PoolBuffer();
+        }
+
+        uint8_t* block = freeHead;
+        freeHead = *reinterpret_cast<uint8_t**>(block);
+        inUse++;
+        if (inUse > highWater) highWater = inUse;
+        return PoolBuffer(this, block);
+    }
+
+    void release(uint8_t* block) {
+        *reinterpret_cast<uint8_t**>(block) = freeHead;
+        freeHead = block;
+        inUse--;
+    }
+
+    const char* poolName() const { return name; }
+    size_t size() const { return blockSize; }
+    size_t blocks() const { return blockCount; }
+    size_t blocksInUse() const { return inUse; }
+    size_t highWaterMark() const { return highWater; }
+    unsigned long exhausted() const { return exhaustedCount; }
+
+private:
+    const char* name;
+    uint8_t* storage = nullptr;
+    uint8_t* freeHead = nullptr;
+    size_t blockSize = 0;
+    size_t blockCount = 0;
+    size_t inUse = 0;
+    size_t highWater = 0;
+    unsigned long exhaustedCount = 0;
+};
+
+inline size_t PoolBuffer::capacity() const { return pool ? pool->size() : 0; }
+
+inline void PoolBuffer::reset() {
+    if (pool && block) pool->release(block);
+    pool = nullptr;
+    block = nullptr;
+    length = 0;
+}
+
+// ================== FIRMWARE MEMORY ==================
+struct FirmwareMemory {
+    MemoryArena arena;
+    BlockPool txPool{"TX"};
+    BlockPool rxPool{"RX"};
+    uint32_t heapAfterBoot = 0;
+
+    FirmwareMemory() : arena(arenaStorage(), FIRMWARE_ARENA_SIZE) {}
+
+    bool begin() {
+        return txPool.begin(arena, TX_POOL_BLOCK_SIZE, TX_POOL_BLOCKS) &&
+               rxPool.begin(arena, RX_POOL_BLOCK_SIZE, RX_POOL_BLOCKS);
+    }
+
+    // Dipanggil di akhir setup(): heap baseline dicatat untuk deteksi pertumbuhan
+    void seal() {
+        arena.seal();
+        heapAfterBoot = ESP.getFreeHeap();
+    }
+
+private:
+    static uint8_t* arenaStorage() {
+        alignas(8) static uint8_t storage[FIRMWARE_ARENA_SIZE];
+        return storage;
+    }
+};
+
+inline FirmwareMemory& firmwareMemory() {
+    static FirmwareMemory memory;
+    return memory;
+}
+
+#endif // MEMORY_POOL_H
@@ -0,0 +1,28 @@
+/**
+ * Discovery Policies
+ * Mengisi ServerEndpoint untuk transport yang kNeedsServer
+ * StaticDiscovery langsung memakai SERVER_HOST; AutoDiscovery ada di discovery_auto.h
+ * Trait kRaces: discovery punya member `race` (DiscoveryRace) untuk laporan status
+ */
+
+#ifndef POLICY_DISCOVERY_H
+#define POLICY_DISCOVERY_H
+
+#include "policy_transport.h"
+#include "firmware_config.h"
+
+struct StaticDiscovery {
+    static constexpr const char* kName = "Static";
+    static constexpr bool kRaces = false;
+
+    void begin() {}
+
+    bool discover(ServerEndpoint& endpoint) {
+        endpoint.set(SERVER_HOST, SERVER_PORT);
+        return true;
+    }
+
+    void remember(const ServerEndpoint&) {}
+};
+
+#endif // POLICY_DISCOVERY_H
@@ -0,0 +1,70 @@
+/**
+ * Encoding Policies
+ * Mengubah SensorData + TelemetryMeta menjadi payload siap kirim
+ * JsonEncoding  -> object JSON (text), skema sama dengan dashboard
+ * MavlinkEncoding -> rangkaian frame MAVLink v2 (binary)
+ */
+
+#ifndef POLICY_ENCODING_H
+#define POLICY_ENCODING_H
+
+#include <Arduino.h>
+#include <stdio.h>
+#include "sensor_data.h"
+#include "mavlink_telemetry.h"
+#include "firmware_config.h"
+
+struct JsonEncoding {
+    static constexpr const char* kName = "JSON";
+    static constexpr bool kBinary = false;
+    static constexpr size_t kMaxPayload = 384;
+
+    // Format compact tanpa String concatenation; return 0 jika tidak muat
+    size_t encode(const SensorData& sensors, const TelemetryMeta& meta, uint8_t* out, size_t capacity) {
+        int written = snprintf((char*)out, capacity,
+            "{\"battery_voltage\":%.2f,\"battery_current\":%.2f,\"battery_power\":%.2f,"
+            "\"temperature\":%.1f,\"humidity\":%.1f,"
+            "\"gps_latitude\":%.6f,\"gps_longitude\":%.6f,\"altitude\":%.1f,"
+            "\"signal_strength\":%d,\"satellites\":%d,"
+            "\"timestamp\":%lu,\"packet_number\":%lu,\"credit_stalls\":%lu,"
+            "\"device_id\":\"%s\",\"connection_type\":\"%s\"}",
+            sensors.batteryVoltage, sensors.batteryCurrent, sensors.batteryPower,
+            sensors.temperature, sensors.humidity,
+            sensors.gpsLatitude, sensors.gpsLongitude, sensors.altitude,
+            sensors.signalStrength, sensors.satellites,
+            meta.timestamp, meta.packetNumber, meta.creditStalls,
+            meta.deviceId, meta.connectionType);
+
+        if (written < 0 || (size_t)written >= capacity) return 0;
+        return (size_t)written;
+    }
+};
+
+struct MavlinkEncoding {
+    static constexpr const char* kName = "MAVLink v2";
+    static constexpr bool kBinary = true;
+    // 8 frame dengan payload penuh (sebelum truncation)
+    static constexpr size_t kMaxPayload =
+        8 * (MAVLINK_HEADER_LEN + MAVLINK_CHECKSUM_LEN) + (9 + 31 + 36 + 28 + 30 + 14 + 18 + 18);
+
+    MavlinkEncoder mavlink{MAVLINK_SYSTEM_ID, 1};
+
+    // Satu siklus = 8 frame (<= 280 bytes)
+    size_t encode(const SensorData& sensors, const TelemetryMeta& meta, uint8_t* out, size_t capacity) {
+        if (capacity < kMaxPayload) return 0;
+
+        uint32_t now = (uint32_t)meta.timestamp;
+        size_t length = 0;
+        length += mavlink.packHeartbeat(out + length);
+        length += mavlink.packSysStatus(out + length, sensors.batteryVoltage, sensors.batteryCurrent);
+        length += mavlink.packBatteryStatus(out + length, sensors.batteryVoltage, sensors.batteryCurrent);
+        length += mavlink.packGlobalPositionInt(out + length, now, sensors.gpsLatitude, sensors.gpsLongitude, sensors.altitude);
+        length += mavlink.packGpsRawInt(out + length, (uint64_t)micros(), sensors.gpsLatitude, sensors.gpsLongitude, sensors.altitude, sensors.satellites);
+        length += mavlink.packScaledPressure(out + length, now, sensors.temperature);
+        length += mavlink.packNamedValueFloat(out + length, now, "humidity", sensors.humidity);
+        length += mavlink.packNamedValueInt(out + length, now, "rssi", sensors.signalStrength);
+        return length;
+    }
+};
+
+#endif // POLICY_ENCODING_H
@@ -0,0 +1,36 @@
+/**
+ * Logging Policies
+ * SerialLog mencetak ke Serial; NullLog membuat semua log (dan string-nya)
+ * hilang saat compile lewat `if constexpr (Log::enabled)` di TelemetryNode
+ */
+
+#ifndef POLICY_LOGGING_H
+#define POLICY_LOGGING_H
+
+#include <Arduino.h>
+
+struct SerialLog {
+    static constexpr bool enabled = true;
+
+    static void begin(unsigned long baud) {
+        Serial.begin(baud);
+        delay(1000);
+    }
+
+    template <typename... Args>
+    static void line(const char* fmt, Args... args) {
+        Serial.printf(fmt, args...);
+        Serial.println();
+    }
+};
+
+struct NullLog {
+    static constexpr bool enabled = false;
+
+    static void begin(unsigned long) {}
+
+    template <typename... Args>
+    static void line(const char*, Args...) {}
+};
+
+#endif // POLICY_LOGGING_H
@@ -0,0 +1,89 @@
+/**
+ * Transport Policies
+ * Setiap transport punya interface yang sama (begin/connected/loop/send) plus
+ * trait compile-time yang dibaca TelemetryNode lewat `if constexpr`:
+ *   kNeedsServer   - butuh endpoint hasil discovery
+ *   kNeedsWiFi     - butuh link WiFi (false: tethered, mis. USB serial)
+ *   kAcceptsBinary - boleh dikirimi payload binary (MAVLink)
+ *   kHasEventLoop  - perlu loop() tiap iterasi
+ * Implementasi ada di transport_*.h agar profile hanya meng-include
+ * library yang benar-benar dipakai
+ */
+
+#ifndef POLICY_TRANSPORT_H
+#define POLICY_TRANSPORT_H
+
+#include <Arduino.h>
+#include <string.h>
+
+struct ServerEndpoint {
+    char host[40] = "";
+    int port = 0;
+
+    bool valid() const { return host[0] != '\0' && port > 0; }
+
+    void set(const char* newHost, int newPort) {
+        strncpy(host, newHost, sizeof(host) - 1);
+        host[sizeof(host) - 1] = '\0';
+        port = newPort;
+    }
+
+    bool operator==(const ServerEndpoint& other) const {
+        return port == other.port && strcmp(host, other.host) == 0;
+    }
+};
+
+// Dipanggil transport saat menerima command dari server/dashboard
+typedef void (*CommandHandler)(void* context, const char* message, size_t length);
+
+// Dipanggil transport saat menerima ack berisi grant flow control (text JSON)
+typedef void (*GrantHandler)(void* context, const char* message, size_t length);
+
+// ================== FALLBACK COMBINATOR ==================
+// Kirim lewat Primary selama terhubung, selain itu lewat Secondary
+template <typename Primary, typename Secondary>
+struct FallbackTransport {
+    static constexpr const char* kName = Primary::kName;
+    static constexpr bool kNeedsServer = Primary::kNeedsServer || Secondary::kNeedsServer;
+    static constexpr bool kNeedsWiFi = Primary::kNeedsWiFi || Secondary::kNeedsWiFi;
+    static constexpr bool kAcceptsBinary = Primary::kAcceptsBinary && Secondary::kAcceptsBinary;
+    static constexpr bool kHasEventLoop = Primary::kHasEventLoop || Secondary::kHasEventLoop;
+
+    bool begin(const ServerEndpoint& endpoint) {
+        bool primaryUp = primary.begin(endpoint);
+        bool secondaryUp = secondary.begin(endpoint);
+        return primaryUp || secondaryUp;
+    }
+
+    bool connected() { return primary.connected() || secondary.connected(); }
+
+    void loop() {
+        if constexpr (Primary::kHasEventLoop) primary.loop();
+        if constexpr (Secondary::kHasEventLoop) secondary.loop();
+    }
+
+    const char* activeName() {
+        return primary.connected() ? primary.activeName() : secondary.activeName();
+    }
+
+    void setCommandHandler(CommandHandler handler, void* context) {
+        primary.setCommandHandler(handler, context);
+        secondary.setCommandHandler(handler, context);
+    }
+
+    void setGrantHandler(GrantHandler handler, void* context) {
+        primary.setGrantHandler(handler, context);
+        secondary.setGrantHandler(handler, context);
+    }
+
+    bool send(const uint8_t* payload, size_t length) {
+        if (primary.connected() && primary.send(payload, length)) return true;
+        return secondary.connected() && secondary.send(payload, length);
+    }
+
+private:
+    Primary primary;
+    Secondary secondary;
+};
+
+#endif // POLICY_TRANSPORT_H
@@ -0,0 +1,56 @@
+/**
+ * Sensor Data
+ * Struktur data sensor + pembacaan (simulasi) yang dipakai semua konfigurasi firmware
+ */
+
+#ifndef SENSOR_DATA_H
+#define SENSOR_DATA_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+struct SensorData {
+    float batteryVoltage = 12.5;
+    float batteryCurrent = 2.3;
+    float batteryPower = 0.0;
+    float temperature = 25.8;
+    float humidity = 65.0;
+    float gpsLatitude = -5.397;
+    float gpsLongitude = 105.266;
+    float altitude = 150.0;
+    int signalStrength = 0;
+    int satellites = 8;
+};
+
+// Metadata per paket yang ikut di-encode bersama SensorData
+struct TelemetryMeta {
+    unsigned long timestamp;
+    unsigned long packetNumber;
+    const char* deviceId;
+    const char* connectionType;
+    unsigned long creditStalls;
+};
+
+inline void initializeSensors() {
+    // Initialize real sensors here (INA219, BME280, GPS, etc.)
+    // For now, using simulated data
+    delay(500); // Simulate sensor initialization time
+}
+
+inline void readSensors(SensorData& sensors) {
+    // Simulate sensor readings - GANTI DENGAN SENSOR ASLI
+    sensors.batteryVoltage = 12.0 + (random(0, 200) / 100.0);  // 12.0-14.0V
+    sensors.batteryCurrent = 1.0 + (random(0, 300) / 100.0);   // 1.0-4.0A
+    sensors.batteryPower = sensors.batteryVoltage * sensors.batteryCurrent;
+    sensors.temperature = 20.0 + (random(0, 1500) / 100.0);    // 20-35°C
+    sensors.humidity = 40.0 + (random(0, 4000) / 100.0);       // 40-80%
+    sensors.altitude = 150.0 + (random(-20, 20));              // 130-170m
+
+    // Small GPS movement simulation
+    sensors.gpsLatitude += (random(-5, 5) / 100000.0);
+    sensors.gpsLongitude += (random(-5, 5) / 100000.0);
+
+    sensors.signalStrength = WiFi.RSSI();
+}
+
+#endif // SENSOR_DATA_H
@@ -0,0 +1,142 @@
+/**
+ * Serial Framing (COBS + CRC-32)
+ * Format frame di kabel USB serial:
+ *   COBS( header[10] | payload | crc32[4] ) 0x00
+ * Header (little endian): version(1) flags(1) sequence(4) sent_us(4)
+ * CRC-32 (IEEE 802.3) dihitung atas header + payload.
+ * 0x00 hanya muncul sebagai delimiter, jadi receiver selalu bisa resync
+ * setelah byte hilang/rusak. Tanpa dependensi Arduino: header ini juga
+ * dipakai bridge native di native/serial_bridge.cpp.
+ */
+
+#ifndef SERIAL_FRAMING_H
+#define SERIAL_FRAMING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SERIAL_FRAME_VERSION 1
+#define SERIAL_FRAME_HEADER_LEN 10
+#define SERIAL_FRAME_CRC_LEN 4
+#define SERIAL_FRAME_DELIMITER 0x00
+
+// Ukuran buffer COBS untuk n byte data (+1 per 254 byte, +1 delimiter)
+#define SERIAL_COBS_MAX_LEN(n) ((n) + (n) / 254 + 2)
+
+struct SerialFrameHeader {
+    uint8_t version = SERIAL_FRAME_VERSION;
+    uint8_t flags = 0;
+    uint32_t sequence = 0;
+    uint32_t sentMicros = 0;
+};
+
+// ================== CRC-32 ==================
+// Tabel nibble (16 entri): kecil di flash, cukup cepat untuk frame < 512 byte
+inline uint32_t serialCrc32(const uint8_t* data, size_t length, uint32_t crc = 0) {
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc = table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+        crc = table[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+    }
+    return ~crc;
+}
+
+inline void serialPutU32(uint8_t* out, uint32_t value) {
+    out[0] = value & 0xFF;
+    out[1] = (value >> 8) & 0xFF;
+    out[2] = (value >> 16) & 0xFF;
+    out[3] = (value >> 24) & 0xFF;
+}
+
+inline uint32_t serialGetU32(const uint8_t* in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+// ================== COBS ==================
+// Encode + tulis delimiter; return panjang total atau 0 jika tidak muat
+inline size_t cobsEncode(const uint8_t* in, size_t length, uint8_t* out, size_t capacity) {
+    if (capacity < SERIAL_COBS_MAX_LEN(length)) return 0;
+
+    size_t codeIndex = 0;
+    size_t written = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < length; i++) {
+        if (in[i] != 0) {
+            out[written++] = in[i];
+            code++;
+        }
+        if (in[i] == 0 || code == 0xFF) {
+            out[codeIndex] = code;
+            codeIndex = written++;
+            code = 1;
+        }
+    }
+    out[codeIndex] = code;
+    out[written++] = SERIAL_FRAME_DELIMITER;
+    return written;
+}
+
+// Decode satu frame tanpa delimiter; return panjang atau 0 jika COBS rusak
+inline size_t cobsDecode(const uint8_t* in, size_t length, uint8_t* out, size_t capacity) {
+    size_t read = 0;
+    size_t written = 0;
+    while (read < length) {
+        uint8_t code = in[read++];
+        if (code == 0 || read + code - 1 > length) return 0;
+        for (uint8_t i = 1; i < code; i++) {
+            if (written >= capacity) return 0;
+            out[written++] = in[read++];
+        }
+        if (code != 0xFF && read < length) {
+            if (written >= capacity) return 0;
+            out[written++] = 0;
+        }
+    }
+    return written;
+}
+
+// ================== FRAME ==================
+/**
+ * Susun header + payload + CRC di `scratch`, lalu COBS ke `out`.
+ * Return panjang bytes siap tulis ke serial, 0 jika buffer kurang.
+ */
+inline size_t serialFrameEncode(const SerialFrameHeader& header, const uint8_t* payload, size_t length,
+                                uint8_t* scratch, size_t scratchCapacity, uint8_t* out, size_t capacity) {
+    size_t rawLength = SERIAL_FRAME_HEADER_LEN + length + SERIAL_FRAME_CRC_LEN;
+    if (scratchCapacity < rawLength) return 0;
+
+    scratch[0] = header.version;
+    scratch[1] = header.flags;
+    serialPutU32(scratch + 2, header.sequence);
+    serialPutU32(scratch + 6, header.sentMicros);
+    for (size_t i = 0; i < length; i++) scratch[SERIAL_FRAME_HEADER_LEN + i] = payload[i];
+    serialPutU32(scratch + SERIAL_FRAME_HEADER_LEN + length, serialCrc32(scratch, SERIAL_FRAME_HEADER_LEN + length));
+
+    return cobsEncode(scratch, rawLength, out, capacity);
+}
+
+enum SerialFrameStatus { SERIAL_FRAME_OK, SERIAL_FRAME_COBS_ERROR, SERIAL_FRAME_CRC_ERROR, SERIAL_FRAME_TOO_SHORT };
+
+/**
+ * Validasi frame yang sudah di-COBS-decode (tanpa delimiter).
+ * Payload = raw + SERIAL_FRAME_HEADER_LEN, panjang ditulis ke payloadLength.
+ */
+inline SerialFrameStatus serialFrameParse(const uint8_t* raw, size_t length, SerialFrameHeader& header, size_t& payloadLength) {
+    if (length < SERIAL_FRAME_HEADER_LEN + SERIAL_FRAME_CRC_LEN) return SERIAL_FRAME_TOO_SHORT;
+
+    size_t covered = length - SERIAL_FRAME_CRC_LEN;
+    if (serialCrc32(raw, covered) != serialGetU32(raw + covered)) return SERIAL_FRAME_CRC_ERROR;
+
+    header.version = raw[0];
+    header.flags = raw[1];
+    header.sequence = serialGetU32(raw + 2);
+    header.sentMicros = serialGetU32(raw + 6);
+    payloadLength = covered - SERIAL_FRAME_HEADER_LEN;
+    return SERIAL_FRAME_OK;
+}
+
+#endif // SERIAL_FRAMING_H
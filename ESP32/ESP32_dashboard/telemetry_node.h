@@ -0,0 +1,509 @@
+/**
+ * Telemetry Node - Firmware Core
+ * Satu core untuk semua varian firmware, disusun dari policy compile-time:
+ *   Transport  - HttpTransport / SocketIoTransport / MqttTransport / UdpTransport / SerialTransport /
+ *                FallbackTransport<A, B>
+ *   Discovery  - StaticDiscovery / AutoDiscovery
+ *   Encoding   - JsonEncoding / MavlinkEncoding
+ *   Log        - SerialLog / NullLog
+ * Fitur yang tidak dipakai profile tidak ikut ter-compile (tanpa branching runtime)
+ */
+
+#ifndef TELEMETRY_NODE_H
+#define TELEMETRY_NODE_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include "firmware_config.h"
+#include "memory_pool.h"
+#include "flow_control.h"
+#include "wifi_roaming.h"
+#include "sensor_data.h"
+#include "policy_logging.h"
+#include "policy_encoding.h"
+#include "policy_transport.h"
+#include "policy_discovery.h"
+
+template <typename Transport, typename Discovery, typename Encoding, typename Log>
+class TelemetryNode {
+    static_assert(!Encoding::kBinary || Transport::kAcceptsBinary,
+                  "Encoding menghasilkan payload binary tapi transport hanya menerima text");
+    static_assert(Encoding::kMaxPayload <= TX_POOL_BLOCK_SIZE,
+                  "Payload encoding lebih besar dari blok TX pool");
+
+public:
+    void begin() {
+        Log::begin(115200);
+        printWelcomeBanner();
+
+        if (!memory.begin()) {
+            log("❌ [MEMORY] Arena too small for packet pools");
+            status.lastError = "Memory pool init failed";
+        }
+
+        log("🔍 [SENSORS] Initializing...");
+        initializeSensors();
+        status.sensorsReady = true;
+
+        if constexpr (Transport::kNeedsServer) {
+            discovery.begin();
+        }
+        transport.setCommandHandler(&TelemetryNode::onCommand, this);
+        transport.setGrantHandler(&TelemetryNode::onGrant, this);
+
+        if constexpr (Transport::kNeedsWiFi) {
+            WiFi.mode(WIFI_STA);
+            connectToAvailableNetwork();
+        } else {
+            connectToServer();
+        }
+
+        // Mulai dari sini buffer paket/command hanya dari pool (library masih boleh pakai heap)
+        memory.seal();
+        log("🧠 [MEMORY] Arena sealed: %u/%u bytes, free heap %u bytes",
+            (unsigned)memory.arena.bytesUsed(), (unsigned)memory.arena.bytesCapacity(), (unsigned)memory.heapAfterBoot);
+
+        log("✅ SYSTEM READY FOR DASHBOARD CONNECTION!");
+    }
+
+    void loop() {
+        // 1. Maintain WiFi connection (roaming berjalan di background)
+        bool linkUp = maintainLink();
+        if (!linkUp && !roamer.inHandover()) {
+            delay(2000);
+            return;
+        }
+
+        // 2. Maintain server connection
+        if (linkUp) {
+            if (!transport.connected() && millis() - status.lastConnectionAttempt >= CONNECTION_RETRY_INTERVAL) {
+                connectToServer();
+            }
+
+            if constexpr (Transport::kHasEventLoop) {
+                transport.loop();
+            }
+            processPendingCommands();
+            flushOutbox();
+        }
+
+        // 3. Send telemetry data (masuk outbox selama handover)
+        // Server overload bisa memperlambat device lewat hint interval_ms
+        if (millis() - status.lastDataSent >= credits.sendInterval(DATA_SEND_INTERVAL)) {
+            outboxStalled = false;
+            sendTelemetry();
+            status.lastDataSent = millis();
+        }
+
+        // 4. Print status summary
+        if constexpr (Log::enabled) {
+            if (millis() - status.lastStatusPrint >= STATUS_PRINT_INTERVAL) {
+                printSystemStatus();
+                status.lastStatusPrint = millis();
+            }
+        }
+
+        delay(LOOP_DELAY);
+    }
+
+private:
+    // Host microbenchmark (ESP32/host/bench_main.cpp) memanggil routine per-paket langsung
+    friend struct TelemetryNodeBench;
+
+    struct NodeStatus {
+        bool wifiConnected = false;
+        bool sensorsReady = false;
+        unsigned long lastDataSent = 0;
+        unsigned long lastStatusPrint = 0;
+        unsigned long lastConnectionAttempt = 0;
+        unsigned long totalDataPackets = 0;
+        unsigned long nextSequence = 0;
+        unsigned long queuedDataPackets = 0;
+        unsigned long failedDataPackets = 0;
+        unsigned long droppedDataPackets = 0;
+        unsigned long droppedCommands = 0;
+        int connectionAttempts = 0;
+        const char* lastError = "";
+    };
+
+    Transport transport;
+    Discovery discovery;
+    Encoding encoding;
+    SensorData sensors;
+    NodeStatus status;
+    ServerEndpoint endpoint;
+    FirmwareMemory& memory = firmwareMemory();
+    CreditWindow credits;
+    WifiRoamer roamer;
+
+    // Paket yang sudah di-encode tapi belum terkirim (handover / transport turun)
+    struct OutboxEntry {
+        PoolBuffer payload;
+        unsigned long sequence = 0;
+    };
+    OutboxEntry outbox[OUTBOX_CAPACITY];
+    size_t outboxHead = 0;
+    size_t outboxCount = 0;
+    // Kredit habis untuk head outbox: tunggu grant baru atau slot kirim berikutnya
+    bool outboxStalled = false;
+
+    // Command masuk disalin ke RX pool di callback, dieksekusi di loop()
+    PoolBuffer pendingCommands[RX_POOL_BLOCKS];
+    size_t pendingHead = 0;
+    size_t pendingCount = 0;
+
+    template <typename... Args>
+    static void log(const char* fmt, Args... args) {
+        if constexpr (Log::enabled) {
+            Log::line(fmt, args...);
+        }
+    }
+
+    // ================== WIFI MANAGEMENT ==================
+    // Transport tethered (USB serial) tidak butuh WiFi sama sekali
+    bool maintainLink() {
+        if constexpr (Transport::kNeedsWiFi) {
+            return maintainWiFiConnection();
+        } else {
+            return true;
+        }
+    }
+
+    bool linkReady() const {
+        if constexpr (Transport::kNeedsWiFi) {
+            return status.wifiConnected;
+        } else {
+            return true;
+        }
+    }
+
+    bool maintainWiFiConnection() {
+        unsigned long now = millis();
+
+        if (WiFi.status() == WL_CONNECTED) {
+            if (!status.wifiConnected || roamer.inHandover()) {
+                bool roamed = roamer.inHandover();
+                status.wifiConnected = true;
+                roamer.onLinkUp(now);
+                if (roamed) {
+                    log("📶 [ROAM] Handover to %s done in %lums (%d dBm)", roamer.targetSsid(), roamer.lastGap(), (int)WiFi.RSSI());
+                } else {
+                    log("✅ [WIFI] Connected to: %s (IP %s, %d dBm)",
+                        WiFi.SSID().c_str(), WiFi.localIP().toString().c_str(), (int)WiFi.RSSI());
+                }
+                connectToServer();
+                return true;
+            }
+
+            int linkRssi = WiFi.RSSI();
+            if (roamer.poll(now)) {
+                status.wifiConnected = false;
+                log("📶 [ROAM] Link %d dBm, pre-emptive handover to %s", linkRssi, roamer.targetSsid());
+                return false;
+            }
+            return true;
+        }
+
+        // Handover berjalan: tunggu tanpa blocking, telemetry tetap di-queue
+        if (roamer.inHandover()) {
+            if (!roamer.handoverTimedOut(now)) return false;
+            log("❌ [ROAM] Handover to %s timed out", roamer.targetSsid());
+        }
+
+        if (status.wifiConnected) {
+            log("❌ [WIFI] Connection lost!");
+            status.wifiConnected = false;
+            status.lastError = "WiFi disconnected";
+
+            // Kandidat hasil scan background masih segar: reconnect tanpa scan blocking
+            if (roamer.recover(now)) {
+                log("📶 [ROAM] Reconnecting to %s", roamer.targetSsid());
+                return false;
+            }
+        }
+
+        connectToAvailableNetwork();
+        return status.wifiConnected;
+    }
+
+    void connectToAvailableNetwork() {
+        log("🔍 [WIFI] Scanning for available networks...");
+
+        int networkCount = WiFi.scanNetworks();
+        if (networkCount <= 0) {
+            log("❌ [WIFI] No networks found");
+            status.lastError = "No WiFi networks found";
+            return;
+        }
+        roamer.absorbScanResults(networkCount, millis());
+
+        // Try to connect to known networks
+        for (int i = 0; i < numNetworks; i++) {
+            for (int j = 0; j < networkCount; j++) {
+                if (WiFi.SSID(j) != availableNetworks[i].ssid) continue;
+
+                log("🔗 [WIFI] Attempting: %s", availableNetworks[i].ssid);
+                WiFi.begin(availableNetworks[i].ssid, availableNetworks[i].password);
+
+                int attempts = 0;
+                while (WiFi.status() != WL_CONNECTED && attempts < 20) {
+                    delay(500);
+                    attempts++;
+                }
+
+                if (WiFi.status() == WL_CONNECTED) {
+                    status.wifiConnected = true;
+                    status.lastError = "";
+                    roamer.onLinkUp(millis());
+                    log("✅ [WIFI] Connected to %s (IP %s)", availableNetworks[i].ssid, WiFi.localIP().toString().c_str());
+                    connectToServer();
+                    return;
+                }
+
+                log("❌ [WIFI] %s failed", availableNetworks[i].ssid);
+                WiFi.disconnect();
+            }
+        }
+
+        log("❌ [WIFI] No known networks available");
+        status.lastError = "No known WiFi networks available";
+    }
+
+    // ================== SERVER CONNECTION ==================
+    void connectToServer() {
+        status.lastConnectionAttempt = millis();
+        status.connectionAttempts++;
+
+        if constexpr (Transport::kNeedsServer) {
+            if (!discovery.discover(endpoint)) {
+                log("❌ [DISCOVERY] No server found (%s)", Discovery::kName);
+                status.lastError = "Server discovery failed";
+            }
+            if constexpr (Discovery::kRaces && Log::enabled) {
+                discovery.race.template report<Log>();
+            }
+        }
+
+        if (transport.begin(endpoint)) {
+            log("✅ [CONNECTION] %s ready", transport.activeName());
+            status.lastError = "";
+            if constexpr (Transport::kNeedsServer) {
+                discovery.remember(endpoint);
+            }
+        } else {
+            log("🔗 [CONNECTION] %s pending...", Transport::kName);
+        }
+    }
+
+    // ================== DATA TRANSMISSION ==================
+    void sendTelemetry() {
+        if (!status.sensorsReady) return;
+
+        readSensors(sensors);
+
+        // Lifetime payload = sampai terkirim (langsung atau dari outbox)
+        PoolBuffer payload = memory.txPool.acquire();
+        if (!payload && outboxCount > 0) {
+            dropOldestQueued();
+            payload = memory.txPool.acquire();
+        }
+        if (!payload) {
+            status.droppedDataPackets++;
+            status.lastError = "TX pool exhausted";
+            log("⚠️ [MEMORY] TX pool exhausted, packet dropped");
+            return;
+        }
+
+        TelemetryMeta meta = {millis(), status.nextSequence, DEVICE_ID, transport.activeName(), credits.stallCount()};
+        payload.length = encoding.encode(sensors, meta, payload.data(), payload.capacity());
+        if (payload.length == 0) {
+            log("❌ [DATA] Payload does not fit %u bytes", (unsigned)payload.capacity());
+            status.lastError = "Payload encoding overflow";
+            return;
+        }
+
+        // Link belum siap atau antrean belum habis: jaga urutan, masuk outbox
+        if (!linkReady() || !transport.connected() || outboxCount > 0) {
+            status.nextSequence++;
+            enqueue(std::move(payload), meta.packetNumber);
+            return;
+        }
+
+        // Kredit habis: sampel ini dilewati (sequence tidak dipakai),
+        // sampel berikutnya selalu lebih baru
+        if (!credits.canSend(meta.packetNumber, payload.length, millis())) {
+            log("⏸️ [FLOW] Credit stall (packet %lu >= limit %lu)", meta.packetNumber, credits.limit());
+            return;
+        }
+
+        status.nextSequence++;
+        if (!transmit(payload, meta.packetNumber)) {
+            status.failedDataPackets++;
+            status.lastError = "Telemetry send failed";
+            enqueue(std::move(payload), meta.packetNumber);
+            return;
+        }
+
+        log("    🔋 Battery: %.1fV, %.1fA, %.1fW", sensors.batteryVoltage, sensors.batteryCurrent, sensors.batteryPower);
+    }
+
+    bool transmit(const PoolBuffer& payload, unsigned long sequence) {
+        if (!transport.connected() || !transport.send(payload.data(), payload.length)) return false;
+
+        credits.consume(payload.length);
+        status.totalDataPackets++;
+        log("📊 [%s] Telemetry sent (%u bytes, Packet #%lu)", transport.activeName(), (unsigned)payload.length, sequence);
+        return true;
+    }
+
+    // ================== OUTBOX ==================
+    void enqueue(PoolBuffer&& payload, unsigned long sequence) {
+        if (outboxCount == OUTBOX_CAPACITY) dropOldestQueued();
+
+        OutboxEntry& entry = outbox[(outboxHead + outboxCount) % OUTBOX_CAPACITY];
+        entry.payload = std::move(payload);
+        entry.sequence = sequence;
+        outboxCount++;
+        status.queuedDataPackets++;
+    }
+
+    void dropOldestQueued() {
+        outbox[outboxHead].payload.reset();
+        outboxHead = (outboxHead + 1) % OUTBOX_CAPACITY;
+        outboxCount--;
+        status.droppedDataPackets++;
+    }
+
+    // Kredit dicek sekali per slot kirim, bukan tiap iterasi loop(): stall counter
+    // tetap per paket dan probe tidak terpakai oleh retry yang sama berulang-ulang
+    void flushOutbox() {
+        if (outboxStalled) return;
+        while (outboxCount > 0 && transport.connected()) {
+            OutboxEntry& entry = outbox[outboxHead];
+            if (!credits.canSend(entry.sequence, entry.payload.length, millis())) {
+                outboxStalled = true;
+                return;
+            }
+            if (!transmit(entry.payload, entry.sequence)) return;
+
+            entry.payload.reset();
+            outboxHead = (outboxHead + 1) % OUTBOX_CAPACITY;
+            outboxCount--;
+        }
+    }
+
+    static void onGrant(void* context, const char* message, size_t length) {
+        TelemetryNode* self = static_cast<TelemetryNode*>(context);
+        FlowGrant grant;
+        if (parseFlowGrant(message, length, grant)) {
+            self->credits.apply(grant, millis());
+            self->outboxStalled = false;
+        }
+    }
+
+    static void onCommand(void* context, const char* message, size_t length) {
+        static_cast<TelemetryNode*>(context)->queueCommand(message, length);
+    }
+
+    void queueCommand(const char* message, size_t length) {
+        PoolBuffer buffer = pendingCount < RX_POOL_BLOCKS ? memory.rxPool.acquire() : PoolBuffer();
+        if (!buffer || length >= buffer.capacity()) {
+            // Degrade: command di-drop, sistem tetap jalan
+            status.droppedCommands++;
+            log("⚠️ [MEMORY] Command dropped (%u bytes, RX pool %u/%u)",
+                (unsigned)length, (unsigned)memory.rxPool.blocksInUse(), (unsigned)memory.rxPool.blocks());
+            return;
+        }
+
+        memcpy(buffer.data(), message, length);
+        buffer.data()[length] = '\0';
+        buffer.length = length;
+        pendingCommands[(pendingHead + pendingCount) % RX_POOL_BLOCKS] = std::move(buffer);
+        pendingCount++;
+    }
+
+    void processPendingCommands() {
+        while (pendingCount > 0) {
+            PoolBuffer command = std::move(pendingCommands[pendingHead]);
+            pendingHead = (pendingHead + 1) % RX_POOL_BLOCKS;
+            pendingCount--;
+            executeRelayCommand((const char*)command.data(), command.length);
+        }
+    }
+
+    void executeRelayCommand(const char* message, size_t length) {
+        log("🔌 [RELAY] Command received: %.*s", (int)length, message);
+
+        // Add actual relay control code here
+        // Example: digitalWrite(RELAY_PIN, HIGH/LOW);
+    }
+
+    // ================== STATUS ==================
+    void printWelcomeBanner() {
+        log("");
+        log("🚀========================================🚀");
+        log("       ESP32 UAV TELEMETRY SYSTEM");
+        log("🚀========================================🚀");
+        log("   Transport: %s", Transport::kName);
+        log("   Discovery: %s", Transport::kNeedsServer ? Discovery::kName : "-");
+        log("   Encoding: %s", Encoding::kName);
+        log("");
+    }
+
+    void printPoolStatus(const BlockPool& pool) {
+        log("    %s pool: %u/%u x %uB in use (high-water %u, exhausted %lu)",
+            pool.poolName(), (unsigned)pool.blocksInUse(), (unsigned)pool.blocks(), (unsigned)pool.size(),
+            (unsigned)pool.highWaterMark(), pool.exhausted());
+    }
+
+    void printMemoryStatus() {
+        uint32_t freeHeap = ESP.getFreeHeap();
+        log("🧠 Memory: arena %u/%u bytes%s, heap %u bytes (boot %u, min %u)",
+            (unsigned)memory.arena.bytesUsed(), (unsigned)memory.arena.bytesCapacity(),
+            memory.arena.isSealed() ? " sealed" : "",
+            (unsigned)freeHeap, (unsigned)memory.heapAfterBoot, (unsigned)ESP.getMinFreeHeap());
+        printPoolStatus(memory.txPool);
+        printPoolStatus(memory.rxPool);
+        if (status.droppedCommands > 0) {
+            log("    ⚠️ Commands dropped: %lu", status.droppedCommands);
+        }
+    }
+
+    void printSystemStatus() {
+        log("");
+        log("📊 ============ SYSTEM STATUS ============");
+        log("⏰ Uptime: %lu seconds", millis() / 1000);
+        if constexpr (Transport::kNeedsWiFi) {
+            log("📶 WiFi: %s", status.wifiConnected ? "✅ CONNECTED" : "❌ DISCONNECTED");
+            if (status.wifiConnected) {
+                log("    📍 IP: %s", WiFi.localIP().toString().c_str());
+                log("    📡 Signal: %d dBm", (int)WiFi.RSSI());
+            }
+        }
+        if constexpr (Transport::kNeedsServer) {
+            log("🌐 Server: %s:%d", endpoint.valid() ? endpoint.host : "-", endpoint.port);
+        }
+        log("🔗 Transport: %s (%s)", transport.activeName(), transport.connected() ? "✅ CONNECTED" : "❌ DISCONNECTED");
+        log("📦 Data packets sent: %lu (failed %lu, queued %lu, dropped %lu, outbox %u)",
+            status.totalDataPackets, status.failedDataPackets, status.queuedDataPackets,
+            status.droppedDataPackets, (unsigned)outboxCount);
+        if constexpr (Transport::kNeedsWiFi) {
+            log("📶 Roaming: %lu scans, %lu handovers (%lu failed), gap last %lums / avg %lums / max %lums",
+                roamer.scanCount(), roamer.handoverCount(), roamer.failedHandoverCount(),
+                roamer.lastGap(), roamer.averageGap(), roamer.maxGap());
+        }
+        printMemoryStatus();
+        if (credits.isManaged()) {
+            log("⚖️ Flow: limit %lu, grants %lu, stalls %lu, probes %lu, interval %lums",
+                credits.limit(), credits.grantCount(), credits.stallCount(), credits.probeCount(),
+                credits.sendInterval(DATA_SEND_INTERVAL));
+        }
+        log("🔄 Connection attempts: %d", status.connectionAttempts);
+        if (status.lastError[0] != '\0') {
+            log("⚠️ Last error: %s", status.lastError);
+        }
+        log("==========================================");
+    }
+};
+
+#endif // TELEMETRY_NODE_H
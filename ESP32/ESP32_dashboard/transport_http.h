@@ -0,0 +1,96 @@
+/**
+ * HTTP Transport Policy
+ * POST /api/telemetry per paket, probe GET / saat begin()
+ */
+
+#ifndef TRANSPORT_HTTP_H
+#define TRANSPORT_HTTP_H
+
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include <stdio.h>
+#include "policy_transport.h"
+#include "memory_pool.h"
+#include "firmware_config.h"
+
+// ================== HTTP ==================
+struct HttpTransport {
+    static constexpr const char* kName = "HTTP";
+    static constexpr bool kNeedsServer = true;
+    static constexpr bool kNeedsWiFi = true;
+    static constexpr bool kAcceptsBinary = false;
+    static constexpr bool kHasEventLoop = false;
+
+    bool begin(const ServerEndpoint& endpoint) {
+        if (!endpoint.valid()) return false;
+
+        char probeUrl[64];
+        snprintf(probeUrl, sizeof(probeUrl), "http://%s:%d/", endpoint.host, endpoint.port);
+        snprintf(url, sizeof(url), "http://%s:%d/api/telemetry", endpoint.host, endpoint.port);
+
+        http.end();
+        http.begin(wifiClient, probeUrl);
+        http.setTimeout(HTTP_TIMEOUT);
+        ready = http.GET() > 0;
+        http.end();
+
+        // URL & header di-parse sekali di sini; setiap POST memakai ulang
+        // koneksi keep-alive tanpa alokasi String baru per paket
+        if (ready) {
+            http.setReuse(true);
+            http.begin(wifiClient, url);
+            http.addHeader("Content-Type", "application/json");
+            http.addHeader("User-Agent", "ESP32-UAV-Dashboard/3.0");
+            http.setTimeout(HTTP_TIMEOUT);
+        }
+        return ready;
+    }
+
+    bool connected() const { return ready; }
+    void loop() {}
+    const char* activeName() const { return kName; }
+    void setCommandHandler(CommandHandler, void*) {}
+
+    void setGrantHandler(GrantHandler handler, void* context) {
+        grantHandler = handler;
+        grantContext = context;
+    }
+
+    bool send(const uint8_t* payload, size_t length) {
+        if (!ready) return false;
+
+        int httpCode = http.POST((uint8_t*)payload, length);
+
+        // Connection error -> tutup, minta TelemetryNode untuk discovery ulang
+        if (httpCode <= 0) {
+            http.end();
+            ready = false;
+        }
+        if (httpCode == 200 && grantHandler) {
+            readGrant();
+        }
+        return httpCode == 200;
+    }
+
+private:
+    // Response body (berisi grant) dibaca ke blok RX pool, bukan String
+    void readGrant() {
+        PoolBuffer body = firmwareMemory().rxPool.acquire();
+        int size = http.getSize();
+        if (!body || size <= 0) return;
+
+        size_t wanted = (size_t)size < body.capacity() - 1 ? (size_t)size : body.capacity() - 1;
+        size_t length = http.getStreamPtr()->readBytes((char*)body.data(), wanted);
+        body.data()[length] = '\0';
+        grantHandler(grantContext, (const char*)body.data(), length);
+    }
+
+    HTTPClient http;
+    WiFiClient wifiClient;
+    char url[64] = "";
+    bool ready = false;
+    GrantHandler grantHandler = nullptr;
+    void* grantContext = nullptr;
+};
+
+#endif // TRANSPORT_HTTP_H
@@ -0,0 +1,65 @@
+/**
+ * MQTT Transport Policy
+ * Publish telemetry ke cloud broker, command dari topic commands
+ */
+
+#ifndef TRANSPORT_MQTT_H
+#define TRANSPORT_MQTT_H
+
+#include <WiFi.h>
+#include <PubSubClient.h>
+#include "policy_transport.h"
+#include "firmware_config.h"
+
+static const uint16_t MQTT_BUFFER_SIZE = 512;
+
+// ================== MQTT (CLOUD) ==================
+struct MqttTransport {
+    static constexpr const char* kName = "MQTT";
+    static constexpr bool kNeedsServer = false;
+    static constexpr bool kNeedsWiFi = true;
+    static constexpr bool kAcceptsBinary = true;
+    static constexpr bool kHasEventLoop = true;
+
+    bool begin(const ServerEndpoint&) {
+        if (mqttClient.connected()) return true;
+
+        mqttClient.setServer(MQTT_SERVER, MQTT_PORT);
+        // Default 256 bytes terlalu kecil untuk payload JSON. Buffer dialokasikan
+        // sekali di sini (PubSubClient hanya realloc jika ukuran berubah)
+        mqttClient.setBufferSize(MQTT_BUFFER_SIZE);
+        mqttClient.setCallback([this](char*, uint8_t* payload, unsigned int length) {
+            if (commandHandler) commandHandler(commandContext, (const char*)payload, length);
+        });
+
+        if (!mqttClient.connect(MQTT_CLIENT_ID)) return false;
+
+        // Subscribe to command topic
+        mqttClient.subscribe(MQTT_TOPIC_COMMANDS);
+        return true;
+    }
+
+    // Broker publik tidak mengirim ack: MQTT tidak ikut flow control
+    void setGrantHandler(GrantHandler, void*) {}
+
+    bool connected() { return mqttClient.connected(); }
+    void loop() { mqttClient.loop(); }
+    const char* activeName() const { return kName; }
+
+    void setCommandHandler(CommandHandler handler, void* context) {
+        commandHandler = handler;
+        commandContext = context;
+    }
+
+    bool send(const uint8_t* payload, size_t length) {
+        return mqttClient.publish(MQTT_TOPIC_TELEMETRY, payload, length);
+    }
+
+private:
+    WiFiClient wifiClient;
+    PubSubClient mqttClient{wifiClient};
+    CommandHandler commandHandler = nullptr;
+    void* commandContext = nullptr;
+};
+
+#endif // TRANSPORT_MQTT_H
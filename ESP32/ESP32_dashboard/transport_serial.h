@@ -0,0 +1,64 @@
+/**
+ * USB Serial Transport Policy
+ * Link tethered untuk bench/test tanpa WiFi: setiap payload dibungkus
+ * frame COBS + CRC-32 (serial_framing.h) dan ditulis ke port USB serial.
+ * Di sisi PC, native/serial_bridge men-deframe dan meneruskan ke server.js.
+ * Port serial dipakai penuh untuk data, jadi profile ini selalu NullLog.
+ */
+
+#ifndef TRANSPORT_SERIAL_H
+#define TRANSPORT_SERIAL_H
+
+#include <Arduino.h>
+#include "policy_transport.h"
+#include "memory_pool.h"
+#include "serial_framing.h"
+#include "firmware_config.h"
+
+// ================== USB SERIAL ==================
+struct SerialTransport {
+    static constexpr const char* kName = "USB Serial";
+    static constexpr bool kNeedsServer = false;
+    static constexpr bool kNeedsWiFi = false;
+    static constexpr bool kAcceptsBinary = true;
+    static constexpr bool kHasEventLoop = false;
+
+    bool begin(const ServerEndpoint&) {
+        if (!started) {
+            Serial.begin(SERIAL_TELEMETRY_BAUD);
+            started = true;
+        }
+        return true;
+    }
+
+    bool connected() const { return started; }
+    void loop() {}
+    const char* activeName() const { return kName; }
+    void setCommandHandler(CommandHandler, void*) {}
+    void setGrantHandler(GrantHandler, void*) {}
+
+    // Dua blok TX: susunan mentah (header+payload+CRC) dan hasil COBS
+    bool send(const uint8_t* payload, size_t length) {
+        PoolBuffer raw = firmwareMemory().txPool.acquire();
+        PoolBuffer frame = firmwareMemory().txPool.acquire();
+        if (!raw || !frame) return false;
+
+        SerialFrameHeader header;
+        header.sequence = sequence;
+        header.sentMicros = (uint32_t)micros();
+        frame.length = serialFrameEncode(header, payload, length, raw.data(), raw.capacity(),
+                                         frame.data(), frame.capacity());
+        if (frame.length == 0) return false;
+
+        // Serial.write blocking sampai masuk TX FIFO; partial write = frame rusak, receiver resync di 0x00
+        if (Serial.write(frame.data(), frame.length) != frame.length) return false;
+        sequence++;
+        return true;
+    }
+
+private:
+    bool started = false;
+    uint32_t sequence = 0;
+};
+
+#endif // TRANSPORT_SERIAL_H
@@ -0,0 +1,131 @@
+/**
+ * Socket.IO Transport Policy
+ * Event telemetryData/esp32Connect lewat WebSocket mentah (EIO=4)
+ */
+
+#ifndef TRANSPORT_SOCKETIO_H
+#define TRANSPORT_SOCKETIO_H
+
+#include <WiFi.h>
+#include <WebSocketsClient.h>
+#include <stdio.h>
+#include <string.h>
+#include "policy_transport.h"
+#include "memory_pool.h"
+#include "firmware_config.h"
+
+// ================== SOCKET.IO (WEBSOCKET) ==================
+struct SocketIoTransport {
+    static constexpr const char* kName = "WebSocket";
+    static constexpr bool kNeedsServer = true;
+    static constexpr bool kNeedsWiFi = true;
+    static constexpr bool kAcceptsBinary = false;
+    static constexpr bool kHasEventLoop = true;
+
+    bool begin(const ServerEndpoint& newEndpoint) {
+        if (!newEndpoint.valid()) return false;
+        if (started && newEndpoint == endpoint) return isConnected;
+
+        if (started) webSocket.disconnect();
+        endpoint = newEndpoint;
+
+        // Socket.IO connection string format
+        webSocket.begin(endpoint.host, endpoint.port, "/socket.io/?EIO=4&transport=websocket");
+        webSocket.onEvent([this](WStype_t type, uint8_t* payload, size_t length) {
+            handleEvent(type, payload, length);
+        });
+        webSocket.setReconnectInterval(5000);
+        webSocket.enableHeartbeat(15000, 3000, 2);
+        started = true;
+
+        // Handshake selesai secara async di loop()
+        return false;
+    }
+
+    bool connected() const { return isConnected; }
+    void loop() { webSocket.loop(); }
+    const char* activeName() const { return kName; }
+
+    void setCommandHandler(CommandHandler handler, void* context) {
+        commandHandler = handler;
+        commandContext = context;
+    }
+
+    void setGrantHandler(GrantHandler handler, void* context) {
+        grantHandler = handler;
+        grantContext = context;
+    }
+
+    bool send(const uint8_t* payload, size_t length) {
+        if (!isConnected) return false;
+        return sendEvent("telemetryData", (const char*)payload, length);
+    }
+
+private:
+    WebSocketsClient webSocket;
+    ServerEndpoint endpoint;
+    bool started = false;
+    bool isConnected = false;
+    CommandHandler commandHandler = nullptr;
+    void* commandContext = nullptr;
+    GrantHandler grantHandler = nullptr;
+    void* grantContext = nullptr;
+
+    // Socket.IO event format: 42["event_name", data]
+    // Frame hanya hidup selama sendTXT(), blok TX langsung kembali ke pool
+    bool sendEvent(const char* event, const char* data, size_t length) {
+        PoolBuffer frame = firmwareMemory().txPool.acquire();
+        if (!frame) return false;
+
+        char* text = (char*)frame.data();
+        int header = snprintf(text, frame.capacity(), "42[\"%s\",", event);
+        if (header < 0 || header + length + 2 > frame.capacity()) return false;
+
+        memcpy(text + header, data, length);
+        text[header + length] = ']';
+        text[header + length + 1] = '\0';
+        return webSocket.sendTXT(frame.data(), header + length + 1);
+    }
+
+    void sendConnectionInfo() {
+        char info[160];
+        int length = snprintf(info, sizeof(info),
+            "{\"deviceId\":\"%s\",\"ip\":\"%s\",\"signalStrength\":%d,\"timestamp\":%lu,\"version\":\"%s\"}",
+            DEVICE_ID, WiFi.localIP().toString().c_str(), (int)WiFi.RSSI(), millis(), FIRMWARE_VERSION);
+        if (length > 0 && (size_t)length < sizeof(info)) {
+            sendEvent("esp32Connect", info, length);
+        }
+    }
+
+    void handleEvent(WStype_t type, uint8_t* payload, size_t length) {
+        switch (type) {
+            case WStype_DISCONNECTED:
+                isConnected = false;
+                break;
+
+            case WStype_CONNECTED:
+                isConnected = true;
+                sendConnectionInfo();
+                break;
+
+            case WStype_TEXT:
+                // Ack flow control: 42["flowCredit",{...}]
+                if (grantHandler && strstr((const char*)payload, "flowCredit") != nullptr) {
+                    grantHandler(grantContext, (const char*)payload, length);
+                    break;
+                }
+
+                // Handle Socket.IO relay commands
+                if (commandHandler && strstr((const char*)payload, "relayCommand") != nullptr) {
+                    commandHandler(commandContext, (const char*)payload, length);
+                    webSocket.sendTXT("{\"type\":\"relayStatus\",\"status\":\"executed\"}");
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+};
+
+#endif // TRANSPORT_SOCKETIO_H
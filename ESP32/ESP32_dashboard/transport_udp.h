@@ -0,0 +1,177 @@
+/**
+ * UDP Transport Policy
+ * UdpTransport    - datagram ke port MAVLink ground station, cocok untuk MavlinkEncoding
+ * FecUdpTransport - sama, plus parity Reed-Solomon per grup (fec_codec.h) ke
+ *                   native/fec_link yang memulihkan datagram hilang lalu
+ *                   meneruskan MAVLink asli ke server.js. Grup berisi datagram
+ *                   sebanyak yang muat dalam FEC_GROUP_DEADLINE pada laju kirim
+ *                   saat ini, jadi pemulihan tidak menunggu siklus berikutnya
+ */
+
+#ifndef TRANSPORT_UDP_H
+#define TRANSPORT_UDP_H
+
+#include <WiFiUdp.h>
+#include <stdio.h>
+#include "policy_transport.h"
+#include "memory_pool.h"
+#include "fec_codec.h"
+#include "firmware_config.h"
+
+static const size_t FEC_SYMBOL_CAPACITY = 320;   // >= satu siklus MAVLink (MavlinkEncoding::kMaxPayload)
+
+// ================== UDP (MAVLINK) ==================
+struct UdpTransport {
+    static constexpr const char* kName = "UDP";
+    static constexpr bool kNeedsServer = true;
+    static constexpr bool kNeedsWiFi = true;
+    static constexpr bool kAcceptsBinary = true;
+    static constexpr bool kHasEventLoop = false;
+
+    // Connectionless: cukup simpan host tujuan, port MAVLink standar
+    bool begin(const ServerEndpoint& endpoint) {
+        if (!endpoint.valid()) return false;
+        target.set(endpoint.host, MAVLINK_UDP_PORT);
+        return true;
+    }
+
+    bool connected() const { return target.valid(); }
+    void loop() {}
+    const char* activeName() const { return kName; }
+    void setCommandHandler(CommandHandler, void*) {}
+    void setGrantHandler(GrantHandler, void*) {}
+
+    bool send(const uint8_t* payload, size_t length) {
+        if (!udp.beginPacket(target.host, target.port)) return false;
+        udp.write(payload, length);
+        return udp.endPacket() == 1;
+    }
+
+private:
+    WiFiUDP udp;
+    ServerEndpoint target;
+};
+
+// ================== UDP + FEC ==================
+struct FecUdpTransport {
+    static constexpr const char* kName = "UDP+FEC";
+    static constexpr bool kNeedsServer = true;
+    static constexpr bool kNeedsWiFi = true;
+    static constexpr bool kAcceptsBinary = true;
+    static constexpr bool kHasEventLoop = true;    // Baca feedback loss dari fec_link
+
+    bool begin(const ServerEndpoint& endpoint) {
+        if (!endpoint.valid()) return false;
+        target.set(endpoint.host, MAVLINK_FEC_PORT);
+        if (!listening) listening = udp.begin(FEC_LOCAL_PORT) == 1;
+        return true;
+    }
+
+    bool connected() const { return target.valid(); }
+    const char* activeName() const { return label; }
+    void setCommandHandler(CommandHandler, void*) {}
+    void setGrantHandler(GrantHandler, void*) {}
+
+    // Feedback: loss terukur di ground station -> jumlah parity grup berikutnya.
+    // Laju kirim melambat di tengah grup: tutup grup parsial saat deadline lewat
+    void loop() {
+        if (groupOpen && millis() - groupStartedAt >= FEC_GROUP_DEADLINE) closeGroup();
+
+        if (listening && udp.parsePacket() > 0) {
+            uint8_t packet[FEC_FEEDBACK_LEN];
+            FecHeader header;
+            int length = udp.read(packet, sizeof(packet));
+            if (length == FEC_FEEDBACK_LEN && fecReadHeader(packet, length, header) && header.type == FEC_TYPE_FEEDBACK) {
+                lossPermille = (uint16_t)(packet[FEC_HEADER_LEN] | (packet[FEC_HEADER_LEN + 1] << 8));
+                lastFeedbackAt = millis();
+                feedbackCount++;
+            }
+        }
+    }
+
+    bool send(const uint8_t* payload, size_t length) {
+        unsigned long now = millis();
+        if (sentBefore) sendInterval = now - lastSendAt;
+        lastSendAt = now;
+        sentBefore = true;
+        if (!groupOpen) startGroup(now);
+
+        FecHeader header;
+        header.type = FEC_TYPE_DATA;
+        header.group = group;
+        header.index = encoder.count();
+        header.k = groupSize;
+        header.r = parity;
+        uint8_t prefix[FEC_HEADER_LEN];
+        fecWriteHeader(prefix, header);
+
+        // Header + datagram asli dalam satu packet, tanpa salinan
+        if (!encoder.add(payload, length)) return false;
+        bool sent = udp.beginPacket(target.host, target.port) &&
+                    udp.write(prefix, FEC_HEADER_LEN) == FEC_HEADER_LEN &&
+                    udp.write(payload, length) == length &&
+                    udp.endPacket() == 1;
+
+        if (encoder.complete()) closeGroup();
+        return sent;
+    }
+
+    uint8_t parityPerGroup() const { return parity; }
+    uint16_t reportedLoss() const { return lossPermille; }
+    unsigned long feedbackReceived() const { return feedbackCount; }
+    unsigned long parityBytesSent() const { return parityBytes; }
+
+private:
+    WiFiUDP udp;
+    ServerEndpoint target;
+    FecGroupEncoder<FEC_SYMBOL_CAPACITY> encoder;
+    bool listening = false;
+    bool groupOpen = false;
+    uint16_t group = 0;
+    uint8_t groupSize = FEC_GROUP_SIZE;
+    uint8_t parity = FEC_DEFAULT_PARITY;
+    unsigned long groupStartedAt = 0;
+    unsigned long lastSendAt = 0;
+    unsigned long sendInterval = 0;      // 0 = belum diketahui
+    bool sentBefore = false;
+    uint16_t lossPermille = 0;
+    unsigned long lastFeedbackAt = 0;
+    unsigned long feedbackCount = 0;
+    unsigned long parityBytes = 0;
+    char label[24] = "UDP+FEC";
+
+    // Redundansi dan ukuran grup hanya berubah di batas grup. k = datagram yang terkirim
+    // dalam FEC_GROUP_DEADLINE pada interval terakhir (3000 ms -> k=1, 50 ms -> FEC_GROUP_SIZE),
+    // parity dipilih untuk k tersebut
+    void startGroup(unsigned long now) {
+        unsigned long fit = sendInterval ? 1 + FEC_GROUP_DEADLINE / sendInterval : FEC_GROUP_SIZE;
+        groupSize = (uint8_t)(fit < FEC_GROUP_SIZE ? fit : FEC_GROUP_SIZE);
+        bool fresh = feedbackCount > 0 && now - lastFeedbackAt < FEC_FEEDBACK_TIMEOUT;
+        parity = fresh ? fecParityForLoss(lossPermille, groupSize, FEC_MIN_PARITY, FEC_MAX_PARITY) : FEC_DEFAULT_PARITY;
+        group++;
+        encoder.reset(groupSize, parity);
+        groupOpen = true;
+        groupStartedAt = now;
+        snprintf(label, sizeof(label), "UDP+FEC %u+%u", (unsigned)groupSize, (unsigned)parity);
+    }
+
+    void closeGroup() {
+        encoder.truncate();
+        sendParity();
+        groupOpen = false;
+    }
+
+    void sendParity() {
+        PoolBuffer buffer = firmwareMemory().txPool.acquire();
+        if (!buffer) return;
+
+        for (uint8_t row = 0; row < parity; row++) {
+            size_t length = encoder.buildParity(row, group, buffer.data(), buffer.capacity());
+            if (length == 0 || !udp.beginPacket(target.host, target.port)) continue;
+            udp.write(buffer.data(), length);
+            if (udp.endPacket() == 1) parityBytes += length;
+        }
+    }
+};
+
+#endif // TRANSPORT_UDP_H
@@ -0,0 +1,197 @@
+/**
+ * Background WiFi Roaming
+ * Selama terhubung, scan async per-channel (bukan scan penuh yang blocking)
+ * untuk memantau RSSI jaringan di availableNetworks[]. Jika link sekarang
+ * melemah melewati ROAM_RSSI_THRESHOLD dan ada AP lain yang jelas lebih kuat,
+ * pindah lebih dulu (WiFi.begin dengan channel + BSSID, tanpa scan ulang).
+ * Celah handover (link turun -> link naik) diukur.
+ */
+
+#ifndef WIFI_ROAMING_H
+#define WIFI_ROAMING_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <string.h>
+#include "firmware_config.h"
+
+static const int ROAM_RSSI_THRESHOLD = -72;           // Mulai pindah di bawah ini (dBm)
+static const int ROAM_RSSI_HYSTERESIS = 8;            // Kandidat harus lebih kuat sekian dB
+static const unsigned long ROAM_SCAN_INTERVAL_WEAK = 5000;    // Link mendekati threshold
+static const unsigned long ROAM_SCAN_INTERVAL_STRONG = 30000; // Link bagus
+static const int ROAM_SCAN_WEAK_MARGIN = 8;           // "Mendekati" = threshold + margin
+static const uint32_t ROAM_SCAN_MS_PER_CHANNEL = 120; // Off-channel singkat per scan
+static const unsigned long ROAM_CANDIDATE_MAX_AGE = 20000;
+static const unsigned long ROAM_HANDOVER_TIMEOUT = 8000;
+static const int ROAM_MAX_CHANNEL = 13;
+
+struct RoamCandidate {
+    int32_t rssi = -127;
+    int32_t channel = 0;
+    uint8_t bssid[6] = {0};
+    unsigned long seenAt = 0;
+};
+
+class WifiRoamer {
+public:
+    /**
+     * Dipanggil tiap loop selama link naik. Menjalankan scan satu channel
+     * secara async; return true jika handover baru saja dimulai.
+     */
+    bool poll(unsigned long now) {
+        if (state == ROAM_SCANNING) {
+            collectScanResults(now);
+            return false;
+        }
+
+        int32_t rssi = WiFi.RSSI();
+        bool weak = rssi < ROAM_RSSI_THRESHOLD + ROAM_SCAN_WEAK_MARGIN;
+        unsigned long interval = weak ? ROAM_SCAN_INTERVAL_WEAK : ROAM_SCAN_INTERVAL_STRONG;
+
+        if (rssi < ROAM_RSSI_THRESHOLD) {
+            int best = bestCandidate(now, rssi + ROAM_RSSI_HYSTERESIS);
+            if (best >= 0) {
+                startHandover(best, now);
+                return true;
+            }
+        }
+
+        if (now - lastScanAt >= interval) {
+            startChannelScan(now);
+        }
+        return false;
+    }
+
+    // Link putus tanpa direncanakan: langsung ke kandidat terbaik yang masih segar
+    bool recover(unsigned long now) {
+        int best = bestCandidate(now, -127);
+        if (best < 0) return false;
+        startHandover(best, now);
+        return true;
+    }
+
+    void onLinkUp(unsigned long now) {
+        if (state == ROAM_HANDOVER) {
+            unsigned long gap = now - handoverStartedAt;
+            lastGapMs = gap;
+            if (gap > maxGapMs) maxGapMs = gap;
+            totalGapMs += gap;
+            handovers++;
+        }
+        state = ROAM_IDLE;
+        lastScanAt = now;
+    }
+
+    // Hasil scan apa pun (termasuk scan penuh saat boot) memperbarui tabel kandidat
+    void absorbScanResults(int count, unsigned long now) {
+        for (int j = 0; j < count; j++) {
+            for (int i = 0; i < numNetworks; i++) {
+                if (WiFi.SSID(j) != availableNetworks[i].ssid) continue;
+
+                RoamCandidate& candidate = known[i];
+                bool stale = now - candidate.seenAt > ROAM_CANDIDATE_MAX_AGE;
+                if (stale || WiFi.RSSI(j) >= candidate.rssi || memcmp(candidate.bssid, WiFi.BSSID(j), 6) == 0) {
+                    candidate.rssi = WiFi.RSSI(j);
+                    candidate.channel = WiFi.channel(j);
+                    memcpy(candidate.bssid, WiFi.BSSID(j), 6);
+                    candidate.seenAt = now;
+                }
+            }
+        }
+    }
+
+    bool inHandover() const { return state == ROAM_HANDOVER; }
+
+    bool handoverTimedOut(unsigned long now) {
+        if (state != ROAM_HANDOVER || now - handoverStartedAt < ROAM_HANDOVER_TIMEOUT) return false;
+        state = ROAM_IDLE;
+        failedHandovers++;
+        return true;
+    }
+
+    const char* targetSsid() const { return targetNetwork >= 0 ? availableNetworks[targetNetwork].ssid : "-"; }
+    int32_t candidateRssi(int network) const { return known[network].rssi; }
+    unsigned long handoverCount() const { return handovers; }
+    unsigned long failedHandoverCount() const { return failedHandovers; }
+    unsigned long scanCount() const { return scans; }
+    unsigned long lastGap() const { return lastGapMs; }
+    unsigned long maxGap() const { return maxGapMs; }
+    unsigned long averageGap() const { return handovers ? totalGapMs / handovers : 0; }
+
+private:
+    enum RoamState { ROAM_IDLE, ROAM_SCANNING, ROAM_HANDOVER };
+
+    RoamState state = ROAM_IDLE;
+    RoamCandidate known[numNetworks];
+    int sweepChannel = 1;
+    int knownCursor = 0;
+    int targetNetwork = -1;
+    unsigned long lastScanAt = 0;
+    unsigned long handoverStartedAt = 0;
+    unsigned long scans = 0;
+    unsigned long handovers = 0;
+    unsigned long failedHandovers = 0;
+    unsigned long lastGapMs = 0;
+    unsigned long maxGapMs = 0;
+    unsigned long totalGapMs = 0;
+
+    // 3 dari 4 scan: channel tempat AP yang dikenal terakhir terlihat;
+    // sisanya menyapu channel 1..13 bergiliran untuk menemukan AP baru
+    int pickChannel() {
+        if (scans % 4 != 0) {
+            for (int i = 0; i < numNetworks; i++) {
+                int index = (knownCursor + i) % numNetworks;
+                if (known[index].channel > 0) {
+                    knownCursor = index + 1;
+                    return known[index].channel;
+                }
+            }
+        }
+
+        int channel = sweepChannel;
+        sweepChannel = sweepChannel % ROAM_MAX_CHANNEL + 1;
+        return channel;
+    }
+
+    void startChannelScan(unsigned long now) {
+        lastScanAt = now;
+        WiFi.scanDelete();
+        if (WiFi.scanNetworks(true, false, false, ROAM_SCAN_MS_PER_CHANNEL, pickChannel()) == WIFI_SCAN_FAILED) {
+            return;
+        }
+        state = ROAM_SCANNING;
+    }
+
+    void collectScanResults(unsigned long now) {
+        int16_t count = WiFi.scanComplete();
+        if (count == WIFI_SCAN_RUNNING) return;
+
+        state = ROAM_IDLE;
+        scans++;
+        absorbScanResults(count, now);
+        WiFi.scanDelete();
+    }
+
+    int bestCandidate(unsigned long now, int32_t minimumRssi) const {
+        const uint8_t* currentBssid = WiFi.BSSID();
+        int best = -1;
+        for (int i = 0; i < numNetworks; i++) {
+            const RoamCandidate& candidate = known[i];
+            if (candidate.seenAt == 0 || now - candidate.seenAt > ROAM_CANDIDATE_MAX_AGE) continue;
+            if (candidate.rssi <= minimumRssi) continue;
+            if (currentBssid && memcmp(candidate.bssid, currentBssid, 6) == 0) continue;
+            if (best < 0 || candidate.rssi > known[best].rssi) best = i;
+        }
+        return best;
+    }
+
+    void startHandover(int network, unsigned long now) {
+        state = ROAM_HANDOVER;
+        targetNetwork = network;
+        handoverStartedAt = now;
+        WiFi.begin(availableNetworks[network].ssid, availableNetworks[network].password,
+                   known[network].channel, known[network].bssid);
+    }
+};
+
+#endif // WIFI_ROAMING_H
@@ -0,0 +1,118 @@
+/**
+ * Host Arduino Shim
+ * Pengganti minimal Arduino core untuk compile & menjalankan firmware core di Linux
+ * Waktu virtual: delay() memajukan millis() tanpa benar-benar tidur
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <string>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+typedef uint8_t byte;
+
+namespace host {
+inline uint64_t& clockUs() {
+    static uint64_t now = 0;
+    return now;
+}
+inline bool& quiet() {
+    static bool value = false;
+    return value;
+}
+}
+
+inline unsigned long millis() { return (unsigned long)(host::clockUs() / 1000); }
+inline unsigned long micros() { return (unsigned long)host::clockUs(); }
+inline void delay(unsigned long ms) { host::clockUs() += (uint64_t)ms * 1000; }
+inline void yield() {}
+inline long random(long low, long high) { return high > low ? low + rand() % (high - low) : low; }
+
+class String {
+public:
+    String(const char* value = "") : data(value ? value : "") {}
+    String(const std::string& value) : data(value) {}
+    String(int value) : data(std::to_string(value)) {}
+    String(unsigned long value) : data(std::to_string(value)) {}
+    String(float value, int decimals = 2) {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+        data = buffer;
+    }
+
+    const char* c_str() const { return data.c_str(); }
+    unsigned int length() const { return (unsigned int)data.size(); }
+    bool operator==(const char* other) const { return data == other; }
+    bool operator!=(const char* other) const { return data != other; }
+    bool operator==(const String& other) const { return data == other.data; }
+    String operator+(const String& other) const { return String(data + other.data); }
+    String& operator+=(const String& other) { data += other.data; return *this; }
+    int indexOf(const char* needle) const {
+        size_t pos = data.find(needle);
+        return pos == std::string::npos ? -1 : (int)pos;
+    }
+
+private:
+    std::string data;
+};
+
+// Byte binary dari Serial.write(): ke tty HOST_SERIAL_DEVICE (mis. slave PTY
+// dari native/serial_bridge --pty) atau hanya dihitung
+class HardwareSerial {
+public:
+    void begin(unsigned long) {
+        const char* device = getenv("HOST_SERIAL_DEVICE");
+        if (!device || fd >= 0) return;
+        fd = open(device, O_WRONLY | O_NOCTTY);
+        termios tty;
+        if (fd >= 0 && tcgetattr(fd, &tty) == 0) {
+            cfmakeraw(&tty);
+            tcsetattr(fd, TCSANOW, &tty);
+        }
+    }
+    size_t write(const uint8_t* data, size_t length) {
+        bytesWritten += length;
+        if (fd < 0) return length;
+        ssize_t written = ::write(fd, data, length);
+        return written < 0 ? 0 : (size_t)written;
+    }
+    void print(const char* text) { if (!host::quiet()) fputs(text, stdout); }
+    void print(const String& text) { print(text.c_str()); }
+    void println(const char* text = "") { if (!host::quiet()) printf("%s\n", text); }
+    void println(const String& text) { println(text.c_str()); }
+    int printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        if (host::quiet()) return 0;
+        va_list args;
+        va_start(args, fmt);
+        int written = vprintf(fmt, args);
+        va_end(args);
+        return written;
+    }
+
+    unsigned long bytesWritten = 0;
+
+private:
+    int fd = -1;
+};
+
+inline HardwareSerial Serial;
+
+// Heap host tidak relevan; angka tetap agar output status stabil
+class EspClass {
+public:
+    uint32_t getFreeHeap() { return 200000; }
+    uint32_t getMinFreeHeap() { return 200000; }
+};
+
+inline EspClass ESP;
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,21 @@
+/**
+ * Host ESPmDNS Shim
+ * Selalu menemukan satu service uav-dashboard
+ */
+
+#ifndef HOST_ESPMDNS_H
+#define HOST_ESPMDNS_H
+
+#include "WiFi.h"
+
+class MDNSResponder {
+public:
+    bool begin(const char*) { return true; }
+    int queryService(const char*, const char*) { return 1; }
+    IPAddress IP(int) { return IPAddress(192, 168, 1, 10); }
+    uint16_t port(int) { return 3000; }
+};
+
+inline MDNSResponder MDNS;
+
+#endif // HOST_ESPMDNS_H
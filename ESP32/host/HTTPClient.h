@@ -0,0 +1,56 @@
+/**
+ * Host HTTPClient Shim
+ * GET/POST selalu sukses (HTTP 200) kecuali hostFail() diset
+ */
+
+#ifndef HOST_HTTPCLIENT_H
+#define HOST_HTTPCLIENT_H
+
+#include "WiFi.h"
+
+namespace host {
+inline bool& httpFail() {
+    static bool value = false;
+    return value;
+}
+inline unsigned long& httpRequests() {
+    static unsigned long value = 0;
+    return value;
+}
+// Grant flow control seperti server.js: credit_limit = POST ke-n + window
+inline long& httpCreditWindow() {
+    static long value = 8;
+    return value;
+}
+}
+
+class HTTPClient {
+public:
+    bool begin(WiFiClient& client, const String&) { stream = &client; return true; }
+    void addHeader(const char*, const char*) {}
+    void setTimeout(unsigned long) {}
+    void setReuse(bool) {}
+    int GET() { host::httpRequests()++; return host::httpFail() ? -1 : 200; }
+    int POST(uint8_t*, size_t) {
+        if (host::httpFail()) return -1;
+        char body[128];
+        snprintf(body, sizeof(body), "{\"success\":true,\"flow\":{\"credit_limit\":%lu,\"credit_bytes\":8192,\"interval_ms\":0}}",
+                 posts + host::httpCreditWindow());
+        posts++;
+        host::httpRequests()++;
+        if (stream) stream->pending = body;
+        return 200;
+    }
+    int getSize() { return stream ? (int)stream->pending.size() : -1; }
+    WiFiClient* getStreamPtr() { return stream; }
+    int POST(const String&) { host::httpRequests()++; return host::httpFail() ? -1 : 200; }
+    String getString() { return String("{\"success\":true}"); }
+    void end() {}
+    static String errorToString(int) { return String("connection refused"); }
+
+private:
+    WiFiClient* stream = nullptr;
+    unsigned long posts = 0;
+};
+
+#endif // HOST_HTTPCLIENT_H
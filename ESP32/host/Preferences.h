@@ -0,0 +1,30 @@
+/**
+ * Host Preferences Shim (in-memory)
+ */
+
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include "Arduino.h"
+#include <map>
+
+class Preferences {
+public:
+    bool begin(const char*, bool) { return true; }
+    String getString(const char* key, const String& fallback) {
+        auto it = strings.find(key);
+        return it == strings.end() ? fallback : String(it->second);
+    }
+    size_t putString(const char* key, const char* value) { strings[key] = value; return strlen(value); }
+    int getInt(const char* key, int fallback) {
+        auto it = ints.find(key);
+        return it == ints.end() ? fallback : it->second;
+    }
+    size_t putInt(const char* key, int value) { ints[key] = value; return sizeof(value); }
+
+private:
+    std::map<std::string, std::string> strings;
+    std::map<std::string, int> ints;
+};
+
+#endif // HOST_PREFERENCES_H
@@ -0,0 +1,30 @@
+/**
+ * Host PubSubClient Shim
+ */
+
+#ifndef HOST_PUBSUBCLIENT_H
+#define HOST_PUBSUBCLIENT_H
+
+#include "WiFi.h"
+#include <functional>
+
+class PubSubClient {
+public:
+    typedef std::function<void(char*, uint8_t*, unsigned int)> Callback;
+
+    explicit PubSubClient(WiFiClient&) {}
+    PubSubClient& setServer(const char*, uint16_t) { return *this; }
+    PubSubClient& setCallback(Callback value) { callback = value; return *this; }
+    bool setBufferSize(uint16_t) { return true; }
+    bool connect(const char*) { isConnected = true; return true; }
+    bool connected() { return isConnected; }
+    bool subscribe(const char*) { return true; }
+    bool publish(const char*, const uint8_t*, unsigned int) { return isConnected; }
+    bool loop() { return isConnected; }
+
+private:
+    Callback callback;
+    bool isConnected = false;
+};
+
+#endif // HOST_PUBSUBCLIENT_H
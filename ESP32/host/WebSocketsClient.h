@@ -0,0 +1,50 @@
+/**
+ * Host WebSocketsClient Shim
+ * Handshake "selesai" pada loop() pertama setelah begin()
+ */
+
+#ifndef HOST_WEBSOCKETSCLIENT_H
+#define HOST_WEBSOCKETSCLIENT_H
+
+#include "Arduino.h"
+#include <functional>
+
+typedef enum {
+    WStype_ERROR,
+    WStype_DISCONNECTED,
+    WStype_CONNECTED,
+    WStype_TEXT,
+    WStype_BIN,
+    WStype_PING,
+    WStype_PONG
+} WStype_t;
+
+class WebSocketsClient {
+public:
+    typedef std::function<void(WStype_t type, uint8_t* payload, size_t length)> WebSocketClientEvent;
+
+    void begin(const char*, uint16_t, const char*) { pendingConnect = true; }
+    void onEvent(WebSocketClientEvent callback) { handler = callback; }
+    void setReconnectInterval(unsigned long) {}
+    void enableHeartbeat(uint32_t, uint32_t, uint8_t) {}
+    void disconnect() {}
+
+    void loop() {
+        if (pendingConnect && handler) {
+            pendingConnect = false;
+            uint8_t url[] = "/socket.io/";
+            handler(WStype_CONNECTED, url, sizeof(url) - 1);
+        }
+    }
+
+    bool sendTXT(uint8_t*, size_t) { framesSent++; return true; }
+    bool sendTXT(const char*) { framesSent++; return true; }
+
+    unsigned long framesSent = 0;
+
+private:
+    WebSocketClientEvent handler;
+    bool pendingConnect = false;
+};
+
+#endif // HOST_WEBSOCKETSCLIENT_H
@@ -0,0 +1,166 @@
+/**
+ * Host WiFi Shim
+ * Dua AP simulasi: "Redmi13" melemah 1 dB/detik (virtual), "YourHomeWiFi" stabil,
+ * supaya roaming background + handover ikut teruji di host
+ */
+
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include "Arduino.h"
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+#define WIFI_STA 1
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED (-2)
+
+class IPAddress {
+public:
+    IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : octets{a, b, c, d} {}
+    // Network byte order seperti ESP32 (octet pertama di byte terendah)
+    explicit IPAddress(uint32_t address) { memcpy(octets, &address, 4); }
+    uint8_t operator[](int index) const { return octets[index]; }
+    operator uint32_t() const {
+        uint32_t address;
+        memcpy(&address, octets, 4);
+        return address;
+    }
+    bool fromString(const char* text) {
+        unsigned a, b, c, d;
+        char extra;
+        if (sscanf(text, "%u.%u.%u.%u%c", &a, &b, &c, &d, &extra) != 4 || a > 255 || b > 255 || c > 255 || d > 255) {
+            return false;
+        }
+        octets[0] = a; octets[1] = b; octets[2] = c; octets[3] = d;
+        return true;
+    }
+    String toString() const {
+        char buffer[16];
+        snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", octets[0], octets[1], octets[2], octets[3]);
+        return String(buffer);
+    }
+
+private:
+    uint8_t octets[4];
+};
+
+namespace host {
+struct AccessPoint {
+    const char* ssid;
+    int32_t channel;
+    uint8_t bssid[6];
+    int32_t rssiAtBoot;
+    int32_t fadePerSecond;
+};
+
+inline const AccessPoint accessPoints[] = {
+    {"Redmi13", 6, {0x02, 0, 0, 0, 0, 0x01}, -58, 1},
+    {"YourHomeWiFi", 11, {0x02, 0, 0, 0, 0, 0x02}, -60, 0},
+};
+inline const int accessPointCount = sizeof(accessPoints) / sizeof(accessPoints[0]);
+inline const unsigned long associationMs = 300;
+
+inline int32_t accessPointRssi(int index) {
+    const AccessPoint& ap = accessPoints[index];
+    int32_t rssi = ap.rssiAtBoot - (int32_t)(millis() / 1000) * ap.fadePerSecond;
+    return rssi < -95 ? -95 : rssi;
+}
+} // namespace host
+
+class WiFiClass {
+public:
+    void mode(int) {}
+
+    wl_status_t status() const {
+        if (associating >= 0 && millis() >= associatedAt) {
+            current = associating;
+            associating = -1;
+            linkStatus = WL_CONNECTED;
+        }
+        return linkStatus;
+    }
+
+    // Channel/BSSID opsional seperti API ESP32; tanpa BSSID -> AP pertama dengan SSID tsb
+    void begin(const char* ssid, const char*, int32_t = 0, const uint8_t* bssid = nullptr) {
+        linkStatus = WL_DISCONNECTED;
+        current = -1;
+        for (int i = 0; i < host::accessPointCount; i++) {
+            const host::AccessPoint& ap = host::accessPoints[i];
+            if (strcmp(ap.ssid, ssid) != 0) continue;
+            if (bssid && memcmp(ap.bssid, bssid, 6) != 0) continue;
+            associating = i;
+            associatedAt = millis() + host::associationMs;
+            return;
+        }
+    }
+
+    void disconnect() { linkStatus = WL_DISCONNECTED; current = -1; associating = -1; }
+
+    // Scan blocking: semua AP
+    int16_t scanNetworks() {
+        resultCount = 0;
+        for (int i = 0; i < host::accessPointCount; i++) results[resultCount++] = i;
+        scanReadyAt = millis();
+        return resultCount;
+    }
+
+    // Scan async satu channel, selesai setelah maxMsPerChannel (virtual)
+    int16_t scanNetworks(bool async, bool, bool, uint32_t maxMsPerChannel, uint8_t channel) {
+        resultCount = 0;
+        for (int i = 0; i < host::accessPointCount; i++) {
+            if (channel == 0 || host::accessPoints[i].channel == channel) results[resultCount++] = i;
+        }
+        scanReadyAt = millis() + maxMsPerChannel;
+        return async ? WIFI_SCAN_RUNNING : resultCount;
+    }
+
+    int16_t scanComplete() const { return millis() < scanReadyAt ? WIFI_SCAN_RUNNING : resultCount; }
+    void scanDelete() { resultCount = 0; }
+
+    String SSID(int index) const { return String(host::accessPoints[results[index]].ssid); }
+    int32_t RSSI(int index) const { return host::accessPointRssi(results[index]); }
+    int32_t channel(int index) const { return host::accessPoints[results[index]].channel; }
+    const uint8_t* BSSID(int index) const { return host::accessPoints[results[index]].bssid; }
+
+    String SSID() const { return String(current >= 0 ? host::accessPoints[current].ssid : ""); }
+    int32_t RSSI() const { return current >= 0 ? host::accessPointRssi(current) : 0; }
+    const uint8_t* BSSID() const { return current >= 0 ? host::accessPoints[current].bssid : nullptr; }
+    IPAddress localIP() const { return IPAddress(192, 168, 1, 50); }
+    IPAddress gatewayIP() const { return IPAddress(192, 168, 1, 1); }
+
+    // Dipakai host build untuk simulasi link putus
+    mutable wl_status_t linkStatus = WL_DISCONNECTED;
+
+private:
+    mutable int current = -1;
+    mutable int associating = -1;
+    unsigned long associatedAt = 0;
+    int results[4] = {0};
+    int16_t resultCount = 0;
+    unsigned long scanReadyAt = 0;
+};
+
+inline WiFiClass WiFi;
+
+// Stream response HTTP di-inject oleh HTTPClient shim
+class WiFiClient {
+public:
+    size_t readBytes(char* buffer, size_t length) {
+        size_t count = length < pending.size() ? length : pending.size();
+        memcpy(buffer, pending.data(), count);
+        pending.erase(0, count);
+        return count;
+    }
+
+    std::string pending;
+};
+
+#endif // HOST_WIFI_H
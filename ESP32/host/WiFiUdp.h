@@ -0,0 +1,23 @@
+/**
+ * Host WiFiUDP Shim
+ */
+
+#ifndef HOST_WIFIUDP_H
+#define HOST_WIFIUDP_H
+
+#include "Arduino.h"
+
+// Tidak ada datagram masuk di host build (feedback FEC tidak disimulasikan)
+class WiFiUDP {
+public:
+    uint8_t begin(uint16_t) { return 1; }
+    int parsePacket() { return 0; }
+    int read(uint8_t*, size_t) { return 0; }
+    int beginPacket(const char*, uint16_t) { return 1; }
+    size_t write(const uint8_t*, size_t length) { bytesSent += length; return length; }
+    int endPacket() { return 1; }
+
+    unsigned long bytesSent = 0;
+};
+
+#endif // HOST_WIFIUDP_H
@@ -0,0 +1,13 @@
+#!/bin/sh
+# Compile & jalankan microbenchmark firmware di Linux; argumen diteruskan ke binary.
+# Usage: ESP32/host/bench.sh [--json out.json] [--baseline base.json] [--threshold 0.15] [--filter text]
+set -e
+
+HOST_DIR="$(cd "$(dirname "$0")" && pwd)"
+OUT_DIR="${BENCH_BUILD_DIR:-${TMPDIR:-/tmp}/esp32-host-build}"
+CXX="${CXX:-g++}"
+mkdir -p "$OUT_DIR"
+
+"$CXX" -std=c++17 -O2 -Wall -Wextra -Werror -I"$HOST_DIR" \
+    -o "$OUT_DIR/firmware_bench" "$HOST_DIR/bench_main.cpp"
+"$OUT_DIR/firmware_bench" "$@"
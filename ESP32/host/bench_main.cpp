@@ -0,0 +1,368 @@
+/**
+ * Host Microbenchmark Driver
+ * Mengukur routine per-paket firmware (sensor, encoding, format angka, parsing
+ * command, antrean, framing transport) lewat host shim: ns/op, alokasi heap/op
+ * dan bytes/op (operator new global dihitung).
+ * Hasil JSON satu baris per benchmark, bisa dibandingkan dengan baseline:
+ *   firmware_bench [--json out.json] [--baseline base.json] [--threshold 0.15]
+ *                  [--filter teks] [--min-ms 200]
+ * Exit code 1 jika ada regresi terhadap baseline.
+ */
+
+#include "Arduino.h"
+#include "../ESP32_dashboard/telemetry_node.h"
+#include "../ESP32_dashboard/serial_framing.h"
+#include "../ESP32_dashboard/fec_codec.h"
+
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <sys/stat.h>
+#include <time.h>
+#include <vector>
+
+// ================== ALLOCATION COUNTER ==================
+namespace bench {
+unsigned long allocations = 0;
+unsigned long allocatedBytes = 0;
+}
+
+void* operator new(size_t size) {
+    bench::allocations++;
+    bench::allocatedBytes += size;
+    if (void* memory = malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { free(memory); }
+void operator delete(void* memory, size_t) noexcept { free(memory); }
+
+// Cegah compiler membuang hasil routine yang diukur
+template <typename T>
+inline void keep(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// ================== BENCH NODE ==================
+// Transport tanpa I/O: biaya yang terukur hanya milik firmware
+struct BenchTransport {
+    static constexpr const char* kName = "Bench";
+    static constexpr bool kNeedsServer = false;
+    static constexpr bool kNeedsWiFi = false;
+    static constexpr bool kAcceptsBinary = true;
+    static constexpr bool kHasEventLoop = false;
+
+    bool begin(const ServerEndpoint&) { return true; }
+    bool connected() const { return up; }
+    void loop() {}
+    const char* activeName() const { return kName; }
+    void setCommandHandler(CommandHandler, void*) {}
+    void setGrantHandler(GrantHandler, void*) {}
+
+    bool send(const uint8_t* payload, size_t length) {
+        bytesSent += length;
+        keep(payload[length - 1]);
+        return true;
+    }
+
+    bool up = true;
+    unsigned long bytesSent = 0;
+};
+
+using BenchNode = TelemetryNode<BenchTransport, StaticDiscovery, JsonEncoding, NullLog>;
+
+// Akses ke routine private TelemetryNode (friend), tanpa mengubah perilakunya
+struct TelemetryNodeBench {
+    template <typename Node>
+    static void sendTelemetry(Node& node) { node.sendTelemetry(); }
+
+    template <typename Node>
+    static void queueCommand(Node& node, const char* message, size_t length) {
+        node.queueCommand(message, length);
+        node.processPendingCommands();
+    }
+
+    // Satu paket lewat outbox: enqueue lalu flush (jalur saat handover/transport turun)
+    template <typename Node>
+    static void outboxRoundTrip(Node& node) {
+        PoolBuffer payload = node.memory.txPool.acquire();
+        payload.length = 200;
+        node.enqueue(std::move(payload), node.status.nextSequence++);
+        node.flushOutbox();
+    }
+};
+
+// ================== HARNESS ==================
+struct BenchResult {
+    std::string name;
+    double nsPerOp = 0;
+    double nsMedian = 0;
+    double allocsPerOp = 0;
+    double bytesPerOp = 0;
+    unsigned long iterations = 0;
+};
+
+static const int BENCH_SAMPLES = 7;
+
+struct BenchOptions {
+    const char* jsonPath = nullptr;
+    const char* baselinePath = nullptr;
+    const char* filter = nullptr;
+    double threshold = 0.15;
+    double minMs = 200;
+};
+
+static double elapsedNs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Kalibrasi jumlah iterasi sampai satu sampel >= minMs/BENCH_SAMPLES.
+// ns/op = sampel tercepat (paling tahan noise scheduler untuk deteksi regresi), median ikut dicatat
+template <typename Routine>
+static BenchResult measure(const char* name, const BenchOptions& options, Routine routine) {
+    unsigned long iterations = 1;
+    double sampleNs = options.minMs * 1e6 / BENCH_SAMPLES;
+    for (;;) {
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned long i = 0; i < iterations; i++) routine();
+        double elapsed = elapsedNs(start);
+        if (elapsed >= sampleNs / 4) {
+            iterations = std::max(1UL, (unsigned long)(iterations * sampleNs / elapsed));
+            break;
+        }
+        iterations *= 2;
+    }
+
+    std::vector<double> samples;
+    unsigned long allocations = bench::allocations;
+    unsigned long bytes = bench::allocatedBytes;
+    for (int sample = 0; sample < BENCH_SAMPLES; sample++) {
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned long i = 0; i < iterations; i++) routine();
+        samples.push_back(elapsedNs(start) / iterations);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    BenchResult result;
+    result.name = name;
+    result.nsPerOp = samples.front();
+    result.nsMedian = samples[samples.size() / 2];
+    result.allocsPerOp = (double)(bench::allocations - allocations) / ((double)BENCH_SAMPLES * iterations);
+    result.bytesPerOp = (double)(bench::allocatedBytes - bytes) / ((double)BENCH_SAMPLES * iterations);
+    result.iterations = iterations * BENCH_SAMPLES;
+    return result;
+}
+
+// ================== BASELINE ==================
+static std::vector<BenchResult> loadResults(const char* path) {
+    std::vector<BenchResult> results;
+    FILE* file = fopen(path, "r");
+    if (!file) return results;
+
+    char line[512];
+    char name[128];
+    while (fgets(line, sizeof(line), file)) {
+        BenchResult result;
+        const char* entry = strstr(line, "{\"name\":\"");
+        if (entry && sscanf(entry, "{\"name\":\"%127[^\"]\",\"ns_per_op\":%lf,\"allocs_per_op\":%lf,\"bytes_per_op\":%lf",
+                            name, &result.nsPerOp, &result.allocsPerOp, &result.bytesPerOp) == 4) {
+            result.name = name;
+            results.push_back(result);
+        }
+    }
+    fclose(file);
+    return results;
+}
+
+static bool writeResults(const char* path, const std::vector<BenchResult>& results, const BenchOptions& options) {
+    // Buat direktori induk (mis. benchmarks/results/)
+    std::string directory(path);
+    for (size_t slash = directory.find('/', 1); slash != std::string::npos; slash = directory.find('/', slash + 1)) {
+        mkdir(directory.substr(0, slash).c_str(), 0755);
+    }
+
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+    fprintf(file, "{\"suite\":\"firmware-host\",\"compiler\":\"%s\",\"timestamp\":%ld,\"min_ms\":%.0f,\"results\":[\n",
+            __VERSION__, (long)time(nullptr), options.minMs);
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& result = results[i];
+        fprintf(file, "  {\"name\":\"%s\",\"ns_per_op\":%.2f,\"allocs_per_op\":%.3f,\"bytes_per_op\":%.1f,\"ns_median\":%.2f,\"iterations\":%lu}%s\n",
+                result.name.c_str(), result.nsPerOp, result.allocsPerOp, result.bytesPerOp, result.nsMedian, result.iterations,
+                i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "]}\n");
+    fclose(file);
+    return true;
+}
+
+// ================== BENCHMARKS ==================
+static const char kFlowCreditEvent[] =
+    "42[\"flowCredit\",{\"device_id\":\"ESP32_UAV_001\",\"credit_limit\":1842,\"credit_bytes\":65536,\"interval_ms\":1000}]";
+static const char kRelayCommandEvent[] =
+    "42[\"relayCommand\",{\"relay\":1,\"state\":\"on\",\"source\":\"dashboard\"}]";
+
+static std::vector<BenchResult> runAll(const BenchOptions& options) {
+    std::vector<BenchResult> results;
+    auto run = [&](const char* name, auto routine) {
+        if (options.filter && !strstr(name, options.filter)) return;
+        results.push_back(measure(name, options, routine));
+        const BenchResult& result = results.back();
+        fprintf(stderr, "  %-24s %10.1f ns/op %8.2f allocs/op %8.1f B/op\n",
+                name, result.nsPerOp, result.allocsPerOp, result.bytesPerOp);
+    };
+
+    host::quiet() = true;
+    static BenchNode node;
+    node.begin();
+
+    SensorData sensors;
+    readSensors(sensors);
+    TelemetryMeta meta = {123456, 42, DEVICE_ID, "WebSocket", 0};
+    uint8_t buffer[TX_POOL_BLOCK_SIZE];
+    uint8_t scratch[TX_POOL_BLOCK_SIZE];
+    uint8_t frame[TX_POOL_BLOCK_SIZE];
+    char text[32];
+
+    // Varian optimasi ditambahkan sebagai entry baru di samping versi aslinya
+    // (mis. "encode.json/fast"), supaya keduanya selalu terukur bersama
+    run("sensors.read", [&] {
+        readSensors(sensors);
+        keep(sensors);
+    });
+
+    JsonEncoding json;
+    run("encode.json", [&] {
+        meta.packetNumber++;
+        keep(json.encode(sensors, meta, buffer, sizeof(buffer)));
+    });
+
+    MavlinkEncoding mavlink;
+    run("encode.mavlink", [&] {
+        meta.timestamp++;
+        keep(mavlink.encode(sensors, meta, buffer, sizeof(buffer)));
+    });
+
+    run("format.float2", [&] {
+        keep(snprintf(text, sizeof(text), "%.2f", sensors.batteryVoltage));
+    });
+
+    run("format.float6", [&] {
+        keep(snprintf(text, sizeof(text), "%.6f", sensors.gpsLatitude));
+    });
+
+    run("format.ulong", [&] {
+        keep(snprintf(text, sizeof(text), "%lu", meta.packetNumber++));
+    });
+
+    run("command.flow_grant", [&] {
+        FlowGrant grant;
+        keep(parseFlowGrant(kFlowCreditEvent, sizeof(kFlowCreditEvent) - 1, grant));
+        keep(grant);
+    });
+
+    run("command.relay_queue", [&] {
+        TelemetryNodeBench::queueCommand(node, kRelayCommandEvent, sizeof(kRelayCommandEvent) - 1);
+    });
+
+    run("queue.pool_acquire", [&] {
+        PoolBuffer block = firmwareMemory().txPool.acquire();
+        keep(block.data());
+    });
+
+    run("queue.outbox_roundtrip", [&] {
+        TelemetryNodeBench::outboxRoundTrip(node);
+    });
+
+    size_t payloadLength = json.encode(sensors, meta, buffer, sizeof(buffer));
+    run("frame.serial_cobs_crc", [&] {
+        SerialFrameHeader header;
+        header.sequence = (uint32_t)meta.packetNumber++;
+        keep(serialFrameEncode(header, buffer, payloadLength, scratch, sizeof(scratch), frame, sizeof(frame)));
+    });
+
+    FecGroupEncoder<TX_POOL_BLOCK_SIZE> fec;
+    fec.reset(FEC_GROUP_SIZE, 2);
+    run("frame.fec_parity2", [&] {
+        if (fec.complete()) fec.reset(FEC_GROUP_SIZE, 2);
+        keep(fec.add(buffer, payloadLength));
+    });
+
+    run("node.send_telemetry", [&] {
+        TelemetryNodeBench::sendTelemetry(node);
+    });
+
+    return results;
+}
+
+// ================== MAIN ==================
+static void usage() {
+    fprintf(stderr, "Usage: firmware_bench [--json out.json] [--baseline base.json] [--threshold 0.15] [--filter text] [--min-ms 200]\n");
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    for (int i = 1; i < argc; i++) {
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            usage();
+            return 2;
+        }
+        if (strcmp(argv[i], "--json") == 0) options.jsonPath = value;
+        else if (strcmp(argv[i], "--baseline") == 0) options.baselinePath = value;
+        else if (strcmp(argv[i], "--threshold") == 0) options.threshold = atof(value);
+        else if (strcmp(argv[i], "--filter") == 0) options.filter = value;
+        else if (strcmp(argv[i], "--min-ms") == 0) options.minMs = std::max(10.0, atof(value));
+        else {
+            usage();
+            return 2;
+        }
+        i++;
+    }
+
+    fprintf(stderr, "⏱️ Firmware host microbenchmarks (%s)\n", __VERSION__);
+    std::vector<BenchResult> results = runAll(options);
+
+    if (options.jsonPath) {
+        if (!writeResults(options.jsonPath, results, options)) {
+            fprintf(stderr, "❌ Cannot write %s\n", options.jsonPath);
+            return 2;
+        }
+        fprintf(stderr, "💾 Results written to %s\n", options.jsonPath);
+    }
+
+    if (!options.baselinePath) return 0;
+    std::vector<BenchResult> baseline = loadResults(options.baselinePath);
+    if (baseline.empty()) {
+        fprintf(stderr, "ℹ️ No baseline at %s, skipping comparison\n", options.baselinePath);
+        return 0;
+    }
+
+    // Regresi: ns/op naik melebihi threshold (dan > 5ns, noise routine kecil),
+    // atau alokasi/op bertambah (deterministik)
+    int regressions = 0;
+    fprintf(stderr, "📊 Baseline comparison (%s, threshold %.0f%%)\n", options.baselinePath, options.threshold * 100);
+    for (const BenchResult& result : results) {
+        auto base = std::find_if(baseline.begin(), baseline.end(),
+                                 [&](const BenchResult& entry) { return entry.name == result.name; });
+        if (base == baseline.end()) {
+            fprintf(stderr, "  %-24s %10.1f ns/op (new)\n", result.name.c_str(), result.nsPerOp);
+            continue;
+        }
+        double change = base->nsPerOp > 0 ? result.nsPerOp / base->nsPerOp - 1 : 0;
+        bool slower = change > options.threshold && result.nsPerOp - base->nsPerOp > 5;
+        bool moreAllocations = result.allocsPerOp > base->allocsPerOp + 0.001;
+        if (slower || moreAllocations) regressions++;
+        fprintf(stderr, "  %-24s %10.1f -> %10.1f ns/op (%+6.1f%%)  allocs %.2f -> %.2f%s\n",
+                result.name.c_str(), base->nsPerOp, result.nsPerOp, change * 100,
+                base->allocsPerOp, result.allocsPerOp,
+                slower || moreAllocations ? "  ❌ REGRESSION" : "");
+    }
+
+    if (regressions > 0) {
+        fprintf(stderr, "❌ %d regression(s) against baseline\n", regressions);
+        return 1;
+    }
+    fprintf(stderr, "✅ No regressions against baseline\n");
+    return 0;
+}
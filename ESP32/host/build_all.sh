@@ -0,0 +1,21 @@
+#!/bin/sh
+# Compile & jalankan semua kombinasi profile x logging di Linux.
+# Usage: ESP32/host/build_all.sh [output_dir]
+set -e
+
+HOST_DIR="$(cd "$(dirname "$0")" && pwd)"
+OUT_DIR="${1:-${TMPDIR:-/tmp}/esp32-host-build}"
+CXX="${CXX:-g++}"
+mkdir -p "$OUT_DIR"
+
+for profile in 1 2 3 4 5; do
+    for log in 1 0; do
+        binary="$OUT_DIR/firmware_p${profile}_log${log}"
+        "$CXX" -std=c++17 -O2 -Wall -Wextra -Werror -I"$HOST_DIR" \
+            -DFIRMWARE_PROFILE=$profile -DENABLE_SERIAL_LOG=$log \
+            -o "$binary" "$HOST_DIR/host_main.cpp"
+        "$binary" 60 --quiet
+    done
+done
+
+echo "✅ All firmware configurations built and ran on host"
@@ -0,0 +1,24 @@
+/**
+ * Host Build Driver
+ * Compile ESP32_dashboard.ino apa adanya (profile via -DFIRMWARE_PROFILE=N)
+ * lalu jalankan setup() + loop() selama 60 detik waktu virtual
+ */
+
+#include "Arduino.h"
+#include "../ESP32_dashboard/ESP32_dashboard.ino"
+
+int main(int argc, char** argv) {
+    unsigned long seconds = argc > 1 ? strtoul(argv[1], nullptr, 10) : 60;
+    host::quiet() = argc > 2 && strcmp(argv[2], "--quiet") == 0;
+
+    setup();
+    unsigned long iterations = 0;
+    while (millis() < seconds * 1000UL) {
+        loop();
+        iterations++;
+    }
+
+    fprintf(stderr, "host run: profile=%d log=%d iterations=%lu virtual_ms=%lu serial_bytes=%lu\n",
+            FIRMWARE_PROFILE, ENABLE_SERIAL_LOG, iterations, millis(), Serial.bytesWritten);
+    return 0;
+}
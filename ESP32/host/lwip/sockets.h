@@ -0,0 +1,104 @@
+/**
+ * Host lwIP Socket Shim
+ * Jaringan virtual untuk probe TCP non-blocking:
+ *   192.168.1.10:3000 -> server (connect sukses setelah 40ms)
+ *   192.168.1.1       -> router (connection refused setelah 5ms)
+ *   IP lain           -> tidak pernah menjawab (probe kena timeout)
+ */
+
+#ifndef HOST_LWIP_SOCKETS_H
+#define HOST_LWIP_SOCKETS_H
+
+#include "../WiFi.h"
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <vector>
+
+namespace host {
+struct VirtualSocket {
+    bool open = false;
+    unsigned long readyAt = 0;
+    int error = 0;
+};
+
+inline std::vector<VirtualSocket>& virtualSockets() {
+    static std::vector<VirtualSocket> sockets;
+    return sockets;
+}
+
+inline const int virtualSocketBase = 3;
+inline const unsigned long neverMs = (unsigned long)-1;
+
+inline VirtualSocket* virtualSocket(int fd) {
+    size_t index = (size_t)(fd - virtualSocketBase);
+    return fd >= virtualSocketBase && index < virtualSockets().size() && virtualSockets()[index].open
+        ? &virtualSockets()[index] : nullptr;
+}
+} // namespace host
+
+inline int lwip_socket(int, int, int) {
+    auto& sockets = host::virtualSockets();
+    for (size_t i = 0; i < sockets.size(); i++) {
+        if (!sockets[i].open) {
+            sockets[i] = host::VirtualSocket{true, 0, 0};
+            return (int)i + host::virtualSocketBase;
+        }
+    }
+    sockets.push_back(host::VirtualSocket{true, 0, 0});
+    return (int)sockets.size() - 1 + host::virtualSocketBase;
+}
+
+inline int lwip_fcntl(int, int, int) { return 0; }
+
+inline int lwip_connect(int fd, const struct sockaddr* address, socklen_t) {
+    host::VirtualSocket* socket = host::virtualSocket(fd);
+    if (!socket) {
+        errno = EBADF;
+        return -1;
+    }
+
+    const sockaddr_in* target = (const sockaddr_in*)address;
+    uint32_t ip = target->sin_addr.s_addr;
+    if (ip == (uint32_t)IPAddress(192, 168, 1, 10) && ntohs(target->sin_port) == 3000) {
+        socket->readyAt = millis() + 40;
+    } else if (ip == (uint32_t)IPAddress(192, 168, 1, 1)) {
+        socket->readyAt = millis() + 5;
+        socket->error = ECONNREFUSED;
+    } else {
+        socket->readyAt = host::neverMs;
+    }
+    errno = EINPROGRESS;
+    return -1;
+}
+
+inline int lwip_select(int maxFd, fd_set*, fd_set* writable, fd_set*, struct timeval*) {
+    int ready = 0;
+    for (int fd = 0; writable && fd < maxFd; fd++) {
+        if (!FD_ISSET(fd, writable)) continue;
+        host::VirtualSocket* socket = host::virtualSocket(fd);
+        if (socket && millis() >= socket->readyAt) {
+            ready++;
+        } else {
+            FD_CLR(fd, writable);
+        }
+    }
+    return ready;
+}
+
+inline int lwip_getsockopt(int fd, int, int, void* value, socklen_t*) {
+    host::VirtualSocket* socket = host::virtualSocket(fd);
+    *(int*)value = socket ? socket->error : EBADF;
+    return 0;
+}
+
+inline int lwip_close(int fd) {
+    host::VirtualSocket* socket = host::virtualSocket(fd);
+    if (socket) socket->open = false;
+    return 0;
+}
+
+#endif // HOST_LWIP_SOCKETS_H
@@ -0,0 +1,61 @@
+/**
+ * Host ESP-IDF mDNS Shim
+ * Query async selalu selesai setelah 150ms (virtual) dengan satu service
+ * uav-dashboard di 192.168.1.10:3000
+ */
+
+#ifndef HOST_MDNS_H
+#define HOST_MDNS_H
+
+#include "WiFi.h"
+
+#define MDNS_TYPE_PTR 0x000C
+#define ESP_IPADDR_TYPE_V4 0
+
+struct esp_ip4_addr_t { uint32_t addr; };
+struct esp_ip_addr_t {
+    union { esp_ip4_addr_t ip4; } u_addr;
+    uint8_t type;
+};
+struct mdns_ip_addr_t {
+    esp_ip_addr_t addr;
+    mdns_ip_addr_t* next;
+};
+struct mdns_result_t {
+    mdns_result_t* next;
+    mdns_ip_addr_t* addr;
+    uint16_t port;
+};
+struct mdns_search_once_t {
+    unsigned long readyAt;
+};
+typedef void (*mdns_query_notify_t)(mdns_search_once_t*);
+
+inline mdns_search_once_t* mdns_query_async_new(const char*, const char*, const char*, uint16_t,
+                                                uint32_t, size_t, mdns_query_notify_t) {
+    return new mdns_search_once_t{millis() + 150};
+}
+
+inline bool mdns_query_async_get_results(mdns_search_once_t* search, uint32_t, mdns_result_t** results, uint8_t* count) {
+    if (millis() < search->readyAt) return false;
+
+    mdns_ip_addr_t* ip = new mdns_ip_addr_t{};
+    ip->addr.u_addr.ip4.addr = (uint32_t)IPAddress(192, 168, 1, 10);
+    ip->addr.type = ESP_IPADDR_TYPE_V4;
+    *results = new mdns_result_t{nullptr, ip, 3000};
+    if (count) *count = 1;
+    return true;
+}
+
+inline void mdns_query_results_free(mdns_result_t* results) {
+    while (results) {
+        mdns_result_t* next = results->next;
+        delete results->addr;
+        delete results;
+        results = next;
+    }
+}
+
+inline void mdns_query_async_delete(mdns_search_once_t* search) { delete search; }
+
+#endif // HOST_MDNS_H
@@ -0,0 +1,135 @@
+/**
+ * Analytics Benchmark
+ * Membandingkan kernel /api/analytics (native AVX2 / SSE2 / scalar) dengan loop
+ * JS naif di data yang sama: satu hari telemetry sintetis 10 Hz (864k baris)
+ * di HistoryStore, window 1 menit. Hasil tiap kernel juga dicek identik.
+ *
+ * Usage: node benchmarks/analytics-bench.js [--json out.json] [--baseline base.json]
+ *        [--threshold 0.15] [--rows 864000] [--window-ms 60000]
+ * Exit code 1 jika ada regresi terhadap baseline.
+ */
+
+const { performance } = require('perf_hooks');
+const { HistoryStore } = require('../lib/history-store');
+const { computeAnalytics, native } = require('../lib/analytics');
+const { writeResults, loadResults, compareResults } = require('./lib/results');
+
+function parseArgs(argv) {
+    const options = { json: null, baseline: null, threshold: 0.15, rows: 864000, windowMs: 60000 };
+    for (let i = 2; i < argv.length; i++) {
+        const arg = argv[i];
+        const value = argv[++i];
+        if (value === undefined) throw new Error(`Missing value for ${arg}`);
+        if (arg === '--json') options.json = value;
+        else if (arg === '--baseline') options.baseline = value;
+        else if (arg === '--threshold') options.threshold = parseFloat(value);
+        else if (arg === '--rows') options.rows = parseInt(value, 10);
+        else if (arg === '--window-ms') options.windowMs = parseInt(value, 10);
+        else throw new Error(`Unknown option ${arg}`);
+    }
+    return options;
+}
+
+// Profil terbang berulang: climb berarus tinggi, cruise, descent; ada sampel kosong dan link putus
+function syntheticFlight(rows) {
+    const store = new HistoryStore({ maxRows: rows + 1 });
+    let time = Date.UTC(2025, 7, 1, 6);
+    for (let i = 0; i < rows; i++) {
+        time += i % 50000 === 0 ? 20000 : 100;
+        const phase = i % 6000;
+        const load = phase < 600 ? 25 : phase < 5000 ? 9 : 6;
+        const current = load + (i % 13) * 0.1;
+        const voltage = 12.6 - (i / rows) * 1.5 - current * 0.03 + (i % 7) * 0.01;
+        store.append('BENCH', {
+            battery_voltage: i % 997 === 0 ? undefined : voltage,
+            battery_current: current,
+            battery_power: i % 1009 === 0 ? undefined : voltage * current,
+            altitude: phase < 600 ? phase / 6 : phase < 5000 ? 100 + (i % 50) / 10 : (6000 - phase),
+            gps_latitude: -5.397,
+            gps_longitude: 105.266
+        }, time);
+    }
+    return store;
+}
+
+function measure(slices, options) {
+    computeAnalytics(slices, options);
+    let best = Infinity;
+    let result = null;
+    for (let sample = 0; sample < 7; sample++) {
+        const start = performance.now();
+        result = computeAnalytics(slices, options);
+        best = Math.min(best, performance.now() - start);
+    }
+    return { best, result };
+}
+
+// Energi boleh beda di digit terakhir (urutan penjumlahan SIMD), sisanya harus identik
+function sameResult(a, b) {
+    const strip = (result) => JSON.stringify(result.windows.map(({ energy_wh, avg_power_w, ...rest }) => rest));
+    const energyClose = a.windows.every((window, i) => Math.abs(window.energy_wh - b.windows[i].energy_wh) <= 1e-3);
+    return strip(a) === strip(b) && energyClose;
+}
+
+function main() {
+    const options = parseArgs(process.argv);
+    console.log(`⏱️ Analytics benchmark (${process.version}, ${options.rows} rows, window ${options.windowMs}ms)`);
+
+    const store = syntheticFlight(options.rows);
+    const slices = store.slices('BENCH');
+    const results = [];
+    const record = (name, metrics) => {
+        results.push({ name, metrics });
+        console.log(`  ${name.padEnd(28)} ${Object.entries(metrics).map(([key, value]) => `${key}=${value}`).join(' ')}`);
+    };
+
+    const js = measure(slices, { kernel: 'js', windowMs: options.windowMs });
+    record('analytics.js_naive', { ms: Math.round(js.best * 100) / 100, rows_per_s: Math.round(options.rows / js.best * 1000) });
+
+    if (!native) {
+        console.log('ℹ️ native/build/analytics.node not built (npm run native:build), JS only');
+    } else {
+        const initial = native.kernel();
+        for (const kernel of ['scalar', 'sse2', 'avx2']) {
+            if (!native.setKernel(kernel)) {
+                console.log(`  ${`analytics.native_${kernel}`.padEnd(28)} not supported on this CPU`);
+                continue;
+            }
+            const run = measure(slices, { kernel: 'native', windowMs: options.windowMs });
+            if (!sameResult(js.result, run.result)) throw new Error(`native ${kernel} result differs from JS`);
+            record(`analytics.native_${kernel}`, {
+                ms: Math.round(run.best * 100) / 100,
+                rows_per_s: Math.round(options.rows / run.best * 1000),
+                speedup_ratio: Math.round(js.best / run.best * 100) / 100
+            });
+        }
+        native.setKernel(initial);
+    }
+
+    if (options.json) {
+        writeResults(options.json, 'analytics', results, { rows: options.rows, window_ms: options.windowMs });
+        console.log(`💾 Results written to ${options.json}`);
+    }
+    if (!options.baseline) return 0;
+    const baseline = loadResults(options.baseline);
+    if (!baseline) {
+        console.log(`ℹ️ No baseline at ${options.baseline}, skipping comparison`);
+        return 0;
+    }
+
+    const rows = compareResults(results, baseline, options.threshold);
+    for (const row of rows) {
+        const change = `${row.change >= 0 ? '+' : ''}${(row.change * 100).toFixed(1)}%`;
+        console.log(`  ${row.name.padEnd(28)} ${row.metric.padEnd(14)} ${row.previous} -> ${row.value} (${change})${row.regression ? '  ❌ REGRESSION' : ''}`);
+    }
+    const regressions = rows.filter((row) => row.regression).length;
+    console.log(regressions ? `❌ ${regressions} regression(s) against baseline` : '✅ No regressions against baseline');
+    return regressions ? 1 : 0;
+}
+
+try {
+    process.exit(main());
+} catch (error) {
+    console.error('❌ Benchmark failed:', error.message);
+    process.exit(2);
+}
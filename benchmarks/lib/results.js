@@ -0,0 +1,73 @@
+/**
+ * Benchmark Results
+ * Simpan hasil sebagai JSON dan bandingkan dengan baseline yang direkam.
+ * Arah metrik dari nama: *_per_s / *_ratio = makin besar makin baik,
+ * *_ms / *_bytes / errors = makin kecil makin baik.
+ */
+
+const fs = require('fs');
+const path = require('path');
+
+function metricDirection(name) {
+    if (name.endsWith('_per_s') || name.endsWith('_ratio')) return 1;
+    if (name.endsWith('_ms') || name.endsWith('_bytes') || name === 'errors') return -1;
+    return 0;
+}
+
+// Perubahan kecil absolut (noise timer/scheduler) tidak dihitung regresi
+const ABSOLUTE_TOLERANCE = { _ms: 1, errors: 0, _bytes: 64 };
+
+function toleranceFor(name) {
+    for (const [suffix, tolerance] of Object.entries(ABSOLUTE_TOLERANCE)) {
+        if (name.endsWith(suffix)) return tolerance;
+    }
+    return 0;
+}
+
+function writeResults(file, suite, results, extra = {}) {
+    fs.mkdirSync(path.dirname(file), { recursive: true });
+    const document = {
+        suite,
+        node: process.version,
+        timestamp: new Date().toISOString(),
+        ...extra,
+        results
+    };
+    fs.writeFileSync(file, JSON.stringify(document, null, 2) + '\n');
+}
+
+function loadResults(file) {
+    try {
+        return JSON.parse(fs.readFileSync(file, 'utf8'));
+    } catch (error) {
+        return null;
+    }
+}
+
+/**
+ * Bandingkan results ({ name, metrics }) dengan baseline.
+ * Return daftar baris perbandingan; row.regression = true jika memburuk > threshold.
+ */
+function compareResults(results, baseline, threshold) {
+    const baseByName = new Map((baseline.results || []).map((entry) => [entry.name, entry]));
+    const rows = [];
+
+    for (const result of results) {
+        const base = baseByName.get(result.name);
+        for (const [metric, value] of Object.entries(result.metrics)) {
+            const direction = metricDirection(metric);
+            const previous = base ? base.metrics[metric] : undefined;
+            if (direction === 0 || typeof previous !== 'number' || typeof value !== 'number') continue;
+
+            const change = previous !== 0 ? value / previous - 1 : (value === 0 ? 0 : Infinity);
+            const worse = direction > 0 ? value < previous : value > previous;
+            const regression = worse &&
+                Math.abs(change) > threshold &&
+                Math.abs(value - previous) > toleranceFor(metric);
+            rows.push({ name: result.name, metric, previous, value, change, regression });
+        }
+    }
+    return rows;
+}
+
+module.exports = { writeResults, loadResults, compareResults, metricDirection };
@@ -0,0 +1,173 @@
+/**
+ * Minimal Socket.IO Client (benchmark)
+ * Engine.IO v4 + Socket.IO v5 di atas WebSocket mentah (tanpa dependency),
+ * cukup untuk meniru ESP32 (telemetryData) dan dashboard (telemetryUpdate)
+ * dalam jumlah banyak dari satu proses load generator.
+ */
+
+const http = require('http');
+const crypto = require('crypto');
+const { EventEmitter } = require('events');
+
+const OPCODE_CONTINUATION = 0x0;
+const OPCODE_TEXT = 0x1;
+const OPCODE_CLOSE = 0x8;
+const OPCODE_PING = 0x9;
+const OPCODE_PONG = 0xA;
+
+class SocketIoClient extends EventEmitter {
+    constructor(port, host = '127.0.0.1') {
+        super();
+        this.port = port;
+        this.host = host;
+        this.socket = null;
+        this.buffer = Buffer.alloc(0);
+        this.fragments = [];
+        this.connected = false;
+    }
+
+    // Resolve setelah Socket.IO CONNECT ("40") di-ack server
+    connect(timeoutMs = 10000) {
+        return new Promise((resolve, reject) => {
+            const timer = setTimeout(() => {
+                this.close();
+                reject(new Error('Socket.IO connect timeout'));
+            }, timeoutMs);
+
+            const request = http.request({
+                host: this.host,
+                port: this.port,
+                path: '/socket.io/?EIO=4&transport=websocket',
+                headers: {
+                    Connection: 'Upgrade',
+                    Upgrade: 'websocket',
+                    'Sec-WebSocket-Version': '13',
+                    'Sec-WebSocket-Key': crypto.randomBytes(16).toString('base64')
+                }
+            });
+
+            request.on('upgrade', (response, socket, head) => {
+                this.socket = socket;
+                socket.setNoDelay(true);
+                socket.on('data', (chunk) => this.onData(chunk));
+                socket.on('close', () => {
+                    this.connected = false;
+                    this.emit('disconnect');
+                });
+                socket.on('error', () => {});
+                this.once('connect', () => {
+                    clearTimeout(timer);
+                    resolve(this);
+                });
+                if (head && head.length) this.onData(head);
+            });
+            request.on('response', (response) => {
+                clearTimeout(timer);
+                reject(new Error(`WebSocket upgrade rejected (${response.statusCode})`));
+            });
+            request.on('error', (error) => {
+                clearTimeout(timer);
+                reject(error);
+            });
+            request.end();
+        });
+    }
+
+    // Event Socket.IO: 42["event",data]
+    send(event, data) {
+        this.writeFrame(OPCODE_TEXT, Buffer.from('42' + JSON.stringify([event, data])));
+    }
+
+    close() {
+        if (this.socket) this.socket.destroy();
+        this.socket = null;
+        this.connected = false;
+    }
+
+    writeFrame(opcode, payload) {
+        if (!this.socket || this.socket.destroyed) return;
+
+        // Frame dari client wajib di-mask (RFC 6455)
+        const mask = crypto.randomBytes(4);
+        const length = payload.length;
+        const headerLength = length < 126 ? 2 : length < 65536 ? 4 : 10;
+        const frame = Buffer.allocUnsafe(headerLength + 4 + length);
+        frame[0] = 0x80 | opcode;
+        if (length < 126) {
+            frame[1] = 0x80 | length;
+        } else if (length < 65536) {
+            frame[1] = 0x80 | 126;
+            frame.writeUInt16BE(length, 2);
+        } else {
+            frame[1] = 0x80 | 127;
+            frame.writeBigUInt64BE(BigInt(length), 2);
+        }
+        mask.copy(frame, headerLength);
+        for (let i = 0; i < length; i++) {
+            frame[headerLength + 4 + i] = payload[i] ^ mask[i & 3];
+        }
+        this.socket.write(frame);
+    }
+
+    onData(chunk) {
+        this.buffer = this.buffer.length ? Buffer.concat([this.buffer, chunk]) : chunk;
+
+        while (this.buffer.length >= 2) {
+            const fin = (this.buffer[0] & 0x80) !== 0;
+            const opcode = this.buffer[0] & 0x0F;
+            let length = this.buffer[1] & 0x7F;
+            let offset = 2;
+            if (length === 126) {
+                if (this.buffer.length < 4) return;
+                length = this.buffer.readUInt16BE(2);
+                offset = 4;
+            } else if (length === 127) {
+                if (this.buffer.length < 10) return;
+                length = Number(this.buffer.readBigUInt64BE(2));
+                offset = 10;
+            }
+            if (this.buffer.length < offset + length) return;
+
+            const payload = this.buffer.subarray(offset, offset + length);
+            this.buffer = this.buffer.subarray(offset + length);
+
+            if (opcode === OPCODE_PING) {
+                this.writeFrame(OPCODE_PONG, payload);
+            } else if (opcode === OPCODE_CLOSE) {
+                this.close();
+                return;
+            } else if (opcode === OPCODE_TEXT || opcode === OPCODE_CONTINUATION) {
+                this.fragments.push(payload);
+                if (fin) {
+                    const text = Buffer.concat(this.fragments).toString('utf8');
+                    this.fragments = [];
+                    this.onPacket(text);
+                }
+            }
+        }
+    }
+
+    onPacket(text) {
+        switch (text[0]) {
+            case '0': // Engine.IO OPEN -> Socket.IO CONNECT namespace "/"
+                this.writeFrame(OPCODE_TEXT, Buffer.from('40'));
+                break;
+            case '2': // Engine.IO PING -> PONG
+                this.writeFrame(OPCODE_TEXT, Buffer.from('3'));
+                break;
+            case '4':
+                if (text[1] === '0') {
+                    this.connected = true;
+                    this.emit('connect');
+                } else if (text[1] === '2') {
+                    const [event, data] = JSON.parse(text.slice(2));
+                    this.emit('event', event, data);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+module.exports = { SocketIoClient };
@@ -0,0 +1,685 @@
+/**
+ * Server Benchmark & Load-Regression Suite
+ * Menjalankan server.js asli sebagai child process (port acak) lalu membebani
+ * dengan client in-process: HTTP ingest berbagai ukuran body (port utama dan
+ * listener fast-path INGEST_PORT, termasuk pipelining), WebSocket
+ * telemetryData ingest, validasi, rule engine alert, geofence, deteksi anomali, kompresi stream
+ * dashboard, broadcast fan-out ke 1-1000 dashboard (Socket.IO dan SSE), dan event loop lag
+ * server (dari /api/stats) selama beban.
+ *
+ * Usage: node benchmarks/server-bench.js [--json out.json] [--baseline base.json]
+ *        [--threshold 0.15] [--duration 3000] [--fanout 1,10,100,1000] [--filter teks] [--quick]
+ * Exit code 1 jika ada regresi terhadap baseline.
+ */
+
+const http = require('http');
+const net = require('net');
+const path = require('path');
+const zlib = require('zlib');
+const { spawn } = require('child_process');
+const { performance, monitorEventLoopDelay } = require('perf_hooks');
+const { SocketIoClient } = require('./lib/socketio-client');
+const { writeResults, loadResults, compareResults } = require('./lib/results');
+const { validateTelemetry } = require('../lib/telemetry-validation');
+const { AlertEngine, compileRules } = require('../lib/alert-engine');
+const { GeofenceEngine, normalizeZones } = require('../lib/geofence');
+const { AnomalyDetector } = require('../lib/anomaly-detector');
+const { StreamCompressor } = require('../lib/stream-compression');
+
+const ROOT = path.join(__dirname, '..');
+
+// ================== OPTIONS ==================
+function parseArgs(argv) {
+    const options = {
+        json: null,
+        baseline: null,
+        threshold: 0.15,
+        durationMs: 3000,
+        fanout: [1, 10, 100, 1000],
+        bodySizes: [400, 4096, 65536, 524288],
+        filter: null
+    };
+
+    for (let i = 2; i < argv.length; i++) {
+        const arg = argv[i];
+        const value = argv[i + 1];
+        if (arg === '--quick') {
+            options.durationMs = 1500;
+            options.fanout = [1, 10, 100];
+            options.bodySizes = [400, 4096, 65536];
+            continue;
+        }
+        if (value === undefined) throw new Error(`Missing value for ${arg}`);
+        i++;
+        if (arg === '--json') options.json = value;
+        else if (arg === '--baseline') options.baseline = value;
+        else if (arg === '--threshold') options.threshold = parseFloat(value);
+        else if (arg === '--duration') options.durationMs = Math.max(1000, parseInt(value, 10));
+        else if (arg === '--fanout') options.fanout = value.split(',').map((n) => parseInt(n, 10)).filter((n) => n > 0);
+        else if (arg === '--filter') options.filter = value;
+        else throw new Error(`Unknown option ${arg}`);
+    }
+    return options;
+}
+
+// ================== HELPERS ==================
+const sleep = (ms) => new Promise((resolve) => setTimeout(resolve, ms));
+
+function percentile(values, q) {
+    if (values.length === 0) return 0;
+    const sorted = Float64Array.from(values).sort();
+    return sorted[Math.min(sorted.length - 1, Math.floor(q * (sorted.length - 1)))];
+}
+
+const round = (value, digits = 2) => Math.round(value * 10 ** digits) / 10 ** digits;
+
+function formatSize(bytes) {
+    return bytes >= 1024 ? `${Math.round(bytes / 1024)}KB` : `${bytes}B`;
+}
+
+function freePort() {
+    return new Promise((resolve, reject) => {
+        const probe = net.createServer();
+        probe.once('error', reject);
+        probe.listen(0, '127.0.0.1', () => {
+            const { port } = probe.address();
+            probe.close(() => resolve(port));
+        });
+    });
+}
+
+// Payload dengan skema firmware (JsonEncoding), di-pad sampai ukuran target
+function telemetryBody(targetBytes, deviceId, extra = {}) {
+    const data = {
+        battery_voltage: 12.61, battery_current: 2.34, battery_power: 29.51,
+        temperature: 27.4, humidity: 61.2,
+        gps_latitude: -5.397012, gps_longitude: 105.266031, altitude: 152.3,
+        signal_strength: -61, satellites: 9,
+        timestamp: 123456, packet_number: 1, credit_stalls: 0,
+        device_id: deviceId, connection_type: 'HTTP',
+        ...extra
+    };
+    const base = JSON.stringify(data).length;
+    if (targetBytes > base + 10) data.pad = 'x'.repeat(targetBytes - base - 10);
+    return data;
+}
+
+function request(port, method, urlPath, body, agent) {
+    return new Promise((resolve, reject) => {
+        const req = http.request({
+            host: '127.0.0.1', port, method, path: urlPath, agent,
+            headers: body ? { 'Content-Type': 'application/json', 'Content-Length': body.length } : {}
+        }, (res) => {
+            const chunks = [];
+            res.on('data', (chunk) => chunks.push(chunk));
+            res.on('end', () => resolve({ status: res.statusCode, body: Buffer.concat(chunks) }));
+        });
+        req.on('error', reject);
+        req.end(body);
+    });
+}
+
+// ================== SERVER UNDER TEST ==================
+async function startServer() {
+    for (const dependency of ['express', 'socket.io', 'cors']) {
+        try {
+            require.resolve(dependency, { paths: [ROOT] });
+        } catch (error) {
+            throw new Error(`Dependency '${dependency}' not installed, run npm install first`);
+        }
+    }
+
+    const port = await freePort();
+    const ingestPort = await freePort();
+    const child = spawn(process.execPath, [path.join(ROOT, 'server.js')], {
+        cwd: ROOT,
+        env: { ...process.env, PORT: String(port), INGEST_PORT: String(ingestPort), MAVLINK_PORT: '0', SERIAL_BRIDGE_PORT: '0' },
+        stdio: ['ignore', 'ignore', 'pipe']
+    });
+    let stderr = '';
+    child.stderr.on('data', (chunk) => { stderr += chunk; });
+
+    const deadline = Date.now() + 15000;
+    while (Date.now() < deadline) {
+        if (child.exitCode !== null) throw new Error(`server.js exited (${child.exitCode}): ${stderr.trim()}`);
+        try {
+            const response = await request(port, 'GET', '/api/stats');
+            if (response.status === 200) return { port, ingestPort, child };
+        } catch (error) {
+            // Belum listen
+        }
+        await sleep(100);
+    }
+    child.kill('SIGKILL');
+    throw new Error('server.js did not become ready within 15s');
+}
+
+// Lag event loop server: FlowController me-refresh /api/stats tiap detik
+function sampleServerLag(port) {
+    const samples = { mean: [], p99: [] };
+    const agent = new http.Agent({ keepAlive: true, maxSockets: 1 });
+    let running = true;
+
+    const loop = (async () => {
+        while (running) {
+            await sleep(1000);
+            if (!running) break;
+            try {
+                const response = await request(port, 'GET', '/api/stats', null, agent);
+                const { load } = JSON.parse(response.body).stats.flowControl;
+                samples.mean.push(load.eventLoopLagMs || 0);
+                samples.p99.push(load.eventLoopLagP99Ms || 0);
+            } catch (error) {
+                // Sampel hilang saat server sangat sibuk
+            }
+        }
+    })();
+
+    return async () => {
+        running = false;
+        await loop;
+        agent.destroy();
+        return {
+            server_lag_mean_ms: round(samples.mean.length ? Math.max(...samples.mean) : 0),
+            server_lag_p99_ms: round(samples.p99.length ? Math.max(...samples.p99) : 0)
+        };
+    };
+}
+
+async function connectClients(port, count, batch = 50) {
+    const clients = [];
+    for (let i = 0; i < count; i += batch) {
+        const group = [];
+        for (let j = i; j < Math.min(count, i + batch); j++) {
+            group.push(new SocketIoClient(port).connect());
+        }
+        clients.push(...await Promise.all(group));
+    }
+    return clients;
+}
+
+async function closeClients(clients) {
+    clients.forEach((client) => client.close());
+    await sleep(300);
+}
+
+// Penonton GET /stream lewat net.Socket mentah; onEvent(data) per event SSE yang lengkap
+async function connectSseViewers(port, count, onEvent, batch = 50) {
+    const viewers = [];
+    const open = () => new Promise((resolve, reject) => {
+        const socket = net.connect(port, '127.0.0.1', () => {
+            socket.write('GET /stream HTTP/1.1\r\nHost: localhost\r\nAccept: text/event-stream\r\n\r\n');
+            resolve(socket);
+        });
+        let tail = '';
+        socket.setEncoding('utf8');
+        socket.on('data', (text) => {
+            // Framing chunked ikut terbaca di antara event, cukup ambil baris data:
+            const events = (tail + text).split('\n\n');
+            tail = events.pop();
+            for (const event of events) {
+                const at = event.indexOf('data: ');
+                if (at >= 0) onEvent(JSON.parse(event.slice(at + 6)));
+            }
+        });
+        socket.on('error', reject);
+    });
+    for (let i = 0; i < count; i += batch) {
+        viewers.push(...await Promise.all(Array.from({ length: Math.min(batch, count - i) }, open)));
+    }
+    return viewers;
+}
+
+// ================== SCENARIOS ==================
+function microBench(routine, minMs = 300) {
+    let iterations = 1000;
+    for (;;) {
+        const start = performance.now();
+        for (let i = 0; i < iterations; i++) routine(i);
+        const elapsed = performance.now() - start;
+        if (elapsed >= minMs / 10) {
+            iterations = Math.max(1, Math.round(iterations * (minMs / 5) / elapsed));
+            break;
+        }
+        iterations *= 4;
+    }
+
+    let best = Infinity;
+    for (let sample = 0; sample < 5; sample++) {
+        const start = performance.now();
+        for (let i = 0; i < iterations; i++) routine(i);
+        best = Math.min(best, (performance.now() - start) / iterations);
+    }
+    return { ops_per_s: Math.round(1000 / best), ns_per_op: round(best * 1e6, 1) };
+}
+
+function validationScenarios(options) {
+    const scenarios = [];
+    const valid = telemetryBody(400, 'BENCH_VALIDATE');
+    const invalid = { ...valid, altitude: 'NaN-ish' };
+    let sink = 0;
+
+    scenarios.push(['validate.telemetry', () => microBench(() => { sink += validateTelemetry(valid) ? 1 : 0; })]);
+    scenarios.push(['validate.telemetry_invalid', () => microBench(() => { sink += validateTelemetry(invalid) ? 1 : 0; })]);
+    for (const size of options.bodySizes) {
+        const text = JSON.stringify(telemetryBody(size, 'BENCH_VALIDATE'));
+        scenarios.push([`validate.parse_and_check.${formatSize(size)}`, () => microBench(() => {
+            sink += validateTelemetry(JSON.parse(text)) ? 1 : 0;
+        })]);
+    }
+    return scenarios;
+}
+
+// Rule engine: N rule sintetis tersebar di field telemetry, sampel bergilir antar device
+function alertScenarios() {
+    const fields = ['battery_voltage', 'battery_current', 'battery_power', 'temperature', 'humidity',
+        'gps_latitude', 'gps_longitude', 'altitude', 'signal_strength', 'satellites'];
+    const types = ['threshold', 'rate', 'duration'];
+    const scenarios = [];
+
+    for (const [ruleCount, deviceCount] of [[10, 1], [300, 1], [300, 100]]) {
+        const rules = compileRules(Array.from({ length: ruleCount }, (_, i) => ({
+            id: `bench_${i}`,
+            field: fields[i % fields.length],
+            type: types[i % types.length],
+            op: i % 2 ? '>' : '<',
+            value: i % 2 ? 1000 : -1000,
+            forMs: types[i % types.length] === 'duration' ? 1000 : 0
+        })));
+        const engine = new AlertEngine(rules);
+        const sample = telemetryBody(400, 'BENCH_ALERT');
+        let now = Date.now();
+
+        scenarios.push([`alerts.evaluate.${ruleCount}rules_${deviceCount}devices`, () => microBench((i) => {
+            sample.altitude = 150 + (i & 15);
+            engine.evaluate(`BENCH_ALERT_${i % deviceCount}`, sample, now += 50);
+        })]);
+    }
+    return scenarios;
+}
+
+// Geofence: N zona poligon 12 titik tersebar di area ~5 km, titik GPS bergerak di area yang sama
+function geofenceScenarios() {
+    const scenarios = [];
+    for (const zoneCount of [10, 1000]) {
+        const zones = Array.from({ length: zoneCount }, (_, z) => {
+            const lat = -5.42 + ((z * 7919) % 1000) / 1000 * 0.045;
+            const lon = 105.24 + ((z * 104729) % 1000) / 1000 * 0.045;
+            const radius = 0.0005 + (z % 7) * 0.0003;
+            const polygon = Array.from({ length: 12 }, (__, i) => {
+                const angle = i / 12 * 2 * Math.PI;
+                const scale = i % 2 ? 0.6 : 1;
+                return [lat + radius * scale * Math.sin(angle), lon + radius * scale * Math.cos(angle)];
+            });
+            return { id: `zone_${z}`, kind: z % 3 ? 'allowed' : 'no_fly', polygon };
+        });
+        const engine = new GeofenceEngine(normalizeZones(zones));
+
+        scenarios.push([`geofence.evaluate.${zoneCount}zones`, () => microBench((i) => {
+            engine.evaluate('BENCH_GEOFENCE', -5.42 + (i % 4999) * 0.00001, 105.24 + (i % 4987) * 0.00001);
+        })]);
+    }
+    return scenarios;
+}
+
+// Anomali: semua field default per sampel, 1 dan 100 device bergantian
+function anomalyScenarios() {
+    return [1, 100].map((deviceCount) => {
+        const detector = new AnomalyDetector();
+        const sample = telemetryBody(400, 'BENCH_ANOMALY');
+        let now = Date.now();
+        return [`anomaly.evaluate.${deviceCount}devices`, () => microBench((i) => {
+            sample.battery_current = 8 + (i % 13) * 0.1;
+            sample.altitude = 150 + (i & 15) * 0.1;
+            sample.gps_latitude = -5.397 + (i % 1000) * 1e-6;
+            detector.evaluate(`BENCH_ANOMALY_${i % deviceCount}`, sample, now += 10);
+        })];
+    });
+}
+
+// Kompresi frame telemetryUpdate: wire_bytes per frame dan CPU server. dictionary dikompresi
+// sekali untuk semua dashboard; context takeover (WS_DEFLATE) dihitung per client.
+function compressionScenarios() {
+    const frame = (i) => ({
+        ...telemetryBody(0, 'ESP32_UAV_001', { connection_type: 'WebSocket' }),
+        battery_current: round(2.34 + Math.sin(i / 3) * 0.4),
+        altitude: round(152.3 + Math.sin(i / 20) * 10, 1),
+        gps_latitude: round(-5.397012 + i * 1e-6, 6),
+        signal_strength: -61 - (i % 7),
+        timestamp: 1760000000000 + i * 50,
+        connection_status: 'connected',
+        packet_number: i,
+        seq: i + 1
+    });
+    const frames = Array.from({ length: 1024 }, (_, i) => frame(i));
+    const texts = frames.map((data) => Buffer.from(JSON.stringify(data)));
+    const compressor = new StreamCompressor();
+    let bytes = 0;
+    const average = () => {
+        const value = Math.round(bytes / texts.length);
+        bytes = 0;
+        return value;
+    };
+
+    // Context takeover: satu stream deflate per client, flush per frame (trailer 4 byte dibuang seperti ws)
+    const contextTakeover = async (windowBits, memLevel) => {
+        const deflate = zlib.createDeflateRaw({ windowBits, memLevel, level: 6 });
+        deflate.on('data', (chunk) => { bytes += chunk.length; });
+        const started = process.cpuUsage();
+        for (const text of texts) {
+            deflate.write(text);
+            await new Promise((resolve) => deflate.flush(zlib.constants.Z_SYNC_FLUSH, resolve));
+            bytes -= 4;
+        }
+        const cpu = process.cpuUsage(started);
+        deflate.close();
+        return { wire_bytes: average(), ns_per_op: round((cpu.user + cpu.system) * 1000 / texts.length, 1) };
+    };
+
+    return [
+        ['compression.none', () => {
+            const metrics = microBench((i) => { bytes += JSON.stringify(frames[i & 1023]).length; });
+            bytes = 0;
+            return { wire_bytes: texts[0].length, ...metrics };
+        }],
+        ['compression.deflate_per_frame', () => {
+            texts.forEach((text) => { bytes += zlib.deflateRawSync(text).length; });
+            return { wire_bytes: average(), ...microBench((i) => zlib.deflateRawSync(texts[i & 1023])) };
+        }],
+        ['compression.dictionary_shared', () => {
+            frames.forEach((data) => { bytes += compressor.pack(data).length; });
+            return { wire_bytes: average(), ...microBench((i) => compressor.pack(frames[i & 1023])) };
+        }],
+        ['compression.context_takeover_per_client', () => contextTakeover(10, 4)],
+        ['compression.context_takeover_default_per_client', () => contextTakeover(15, 8)]
+    ];
+}
+
+// targetPort: port utama (default) atau listener fast-path; lag tetap dibaca dari port utama
+async function httpIngest(port, size, options, concurrency = 16, targetPort = port) {
+    const body = Buffer.from(JSON.stringify(telemetryBody(size, 'BENCH_HTTP')));
+    const agent = new http.Agent({ keepAlive: true, maxSockets: concurrency });
+    const latencies = [];
+    let errors = 0;
+    const stopLag = sampleServerLag(port);
+    const start = performance.now();
+    const deadline = start + options.durationMs;
+
+    const worker = async () => {
+        while (performance.now() < deadline) {
+            const sentAt = performance.now();
+            try {
+                const response = await request(targetPort, 'POST', '/api/telemetry', body, agent);
+                if (response.status !== 200) errors++;
+            } catch (error) {
+                errors++;
+            }
+            latencies.push(performance.now() - sentAt);
+        }
+    };
+    await Promise.all(Array.from({ length: concurrency }, worker));
+    const elapsed = performance.now() - start;
+    agent.destroy();
+
+    return {
+        req_per_s: Math.round(latencies.length / (elapsed / 1000)),
+        p50_ms: round(percentile(latencies, 0.5)),
+        p99_ms: round(percentile(latencies, 0.99)),
+        errors,
+        ...await stopLag()
+    };
+}
+
+// Satu koneksi raw, depth request ditulis sekaligus (pipelining) lalu tunggu semua response
+async function httpPipeline(port, ingestPort, options, depth = 16) {
+    const body = JSON.stringify(telemetryBody(400, 'BENCH_PIPELINE'));
+    const batch = `POST /api/telemetry HTTP/1.1\r\nHost: bench\r\nContent-Type: application/json\r\nContent-Length: ${Buffer.byteLength(body)}\r\n\r\n${body}`.repeat(depth);
+    const socket = net.connect(ingestPort, '127.0.0.1');
+    await new Promise((resolve, reject) => socket.once('connect', resolve).once('error', reject));
+    socket.setNoDelay(true);
+
+    const latencies = [];
+    let pending = 0;
+    let tail = '';
+    let onBatch = null;
+    socket.on('data', (chunk) => {
+        const text = tail + chunk.toString('latin1');
+        pending -= text.split('HTTP/1.1 ').length - 1;
+        tail = text.slice(-8);
+        if (pending <= 0 && onBatch) onBatch();
+    });
+
+    const stopLag = sampleServerLag(port);
+    const start = performance.now();
+    let requests = 0;
+    while (performance.now() - start < options.durationMs) {
+        const sentAt = performance.now();
+        pending = depth;
+        await new Promise((resolve) => {
+            onBatch = resolve;
+            socket.write(batch);
+        });
+        latencies.push(performance.now() - sentAt);
+        requests += depth;
+    }
+    const elapsed = performance.now() - start;
+    socket.destroy();
+    return {
+        req_per_s: Math.round(requests / (elapsed / 1000)),
+        batch_p50_ms: round(percentile(latencies, 0.5)),
+        batch_p99_ms: round(percentile(latencies, 0.99)),
+        ...await stopLag()
+    };
+}
+
+// Tiap device menjaga 8 frame in-flight (= jendela kredit default) dan menunggu flowCredit
+async function websocketIngest(port, deviceCount, options, window = 8) {
+    const devices = await connectClients(port, deviceCount);
+    const latencies = [];
+    const stopLag = sampleServerLag(port);
+    const start = performance.now();
+    const deadline = start + options.durationMs;
+
+    await Promise.all(devices.map((device, index) => new Promise((resolve) => {
+        const deviceId = `BENCH_WS_${index}`;
+        const inFlight = [];
+        let packetNumber = 0;
+
+        const sendOne = () => {
+            inFlight.push(performance.now());
+            device.send('telemetryData', telemetryBody(400, deviceId, { packet_number: packetNumber++, connection_type: 'WebSocket' }));
+        };
+
+        device.on('event', (event) => {
+            if (event !== 'flowCredit' || inFlight.length === 0) return;
+            latencies.push(performance.now() - inFlight.shift());
+            if (performance.now() < deadline) sendOne();
+            else if (inFlight.length === 0) resolve();
+        });
+        device.on('disconnect', resolve);
+        for (let i = 0; i < window; i++) sendOne();
+        setTimeout(resolve, options.durationMs + 5000);
+    })));
+
+    const elapsed = performance.now() - start;
+    await closeClients(devices);
+    return {
+        acks_per_s: Math.round(latencies.length / (elapsed / 1000)),
+        ack_p50_ms: round(percentile(latencies, 0.5)),
+        ack_p99_ms: round(percentile(latencies, 0.99)),
+        ...await stopLag()
+    };
+}
+
+// Satu device kirim 20 Hz, N dashboard menerima telemetryUpdate (broadcast server)
+async function broadcastFanout(port, dashboardCount, options, rateHz = 20) {
+    const dashboards = await connectClients(port, dashboardCount);
+    const [device] = await connectClients(port, 1);
+    const runId = `${Date.now()}_${dashboardCount}`;
+    const latencies = [];
+
+    for (const dashboard of dashboards) {
+        dashboard.on('event', (event, data) => {
+            if (event === 'telemetryUpdate' && data && data.bench_run === runId) {
+                latencies.push(performance.now() - data.bench_sent_at);
+            }
+        });
+    }
+
+    const stopLag = sampleServerLag(port);
+    let sent = 0;
+    const interval = 1000 / rateHz;
+    const start = performance.now();
+    while (performance.now() - start < options.durationMs) {
+        device.send('telemetryData', telemetryBody(400, 'BENCH_FANOUT', {
+            packet_number: sent++,
+            connection_type: 'WebSocket',
+            bench_run: runId,
+            bench_sent_at: performance.now()
+        }));
+        await sleep(Math.max(0, start + sent * interval - performance.now()));
+    }
+    await sleep(1000); // Drain broadcast yang masih antre
+
+    const lag = await stopLag();
+    await closeClients([device, ...dashboards]);
+    return {
+        delivered_ratio: round(latencies.length / (sent * dashboardCount), 4),
+        deliveries_per_s: Math.round(latencies.length / (options.durationMs / 1000)),
+        latency_p50_ms: round(percentile(latencies, 0.5)),
+        latency_p99_ms: round(percentile(latencies, 0.99)),
+        ...lag
+    };
+}
+
+// Sama dengan broadcastFanout, tapi penonton lewat SSE /stream (serialisasi sekali per frame)
+async function sseFanout(port, viewerCount, options, rateHz = 20) {
+    const runId = `${Date.now()}_sse_${viewerCount}`;
+    const latencies = [];
+    const viewers = await connectSseViewers(port, viewerCount, (data) => {
+        if (data.bench_run === runId) latencies.push(performance.now() - data.bench_sent_at);
+    });
+    const [device] = await connectClients(port, 1);
+
+    const stopLag = sampleServerLag(port);
+    let sent = 0;
+    const interval = 1000 / rateHz;
+    const start = performance.now();
+    while (performance.now() - start < options.durationMs) {
+        device.send('telemetryData', telemetryBody(400, 'BENCH_SSE', {
+            packet_number: sent++,
+            connection_type: 'WebSocket',
+            bench_run: runId,
+            bench_sent_at: performance.now()
+        }));
+        await sleep(Math.max(0, start + sent * interval - performance.now()));
+    }
+    await sleep(1000);
+
+    const lag = await stopLag();
+    viewers.forEach((viewer) => viewer.destroy());
+    await closeClients([device]);
+    return {
+        delivered_ratio: round(latencies.length / (sent * viewerCount), 4),
+        deliveries_per_s: Math.round(latencies.length / (options.durationMs / 1000)),
+        latency_p50_ms: round(percentile(latencies, 0.5)),
+        latency_p99_ms: round(percentile(latencies, 0.99)),
+        ...lag
+    };
+}
+
+async function idleLag(port, options) {
+    const stopLag = sampleServerLag(port);
+    await sleep(Math.max(2200, options.durationMs));
+    return stopLag();
+}
+
+// ================== MAIN ==================
+async function main() {
+    const options = parseArgs(process.argv);
+    const results = [];
+    const clientLag = monitorEventLoopDelay({ resolution: 10 });
+    const selected = (name) => !options.filter || name.includes(options.filter);
+
+    const record = (name, metrics, notes) => {
+        results.push(notes ? { name, metrics, notes } : { name, metrics });
+        const summary = Object.entries(metrics).map(([key, value]) => `${key}=${value}`).join(' ');
+        console.log(`  ${name.padEnd(32)} ${summary}`);
+    };
+
+    console.log(`⏱️ Server benchmark (${process.version}, ${options.durationMs}ms per scenario)`);
+    const microScenarios = [...validationScenarios(options), ...alertScenarios(), ...geofenceScenarios(), ...anomalyScenarios(), ...compressionScenarios()];
+    for (const [name, run] of microScenarios) {
+        if (selected(name)) record(name, await run());
+    }
+
+    const { port, ingestPort, child } = await startServer();
+    console.log(`🚀 server.js under test on port ${port} (pid ${child.pid})`);
+
+    const scenarios = [['eventloop.idle', () => idleLag(port, options)]];
+    for (const size of options.bodySizes) {
+        scenarios.push([`http.ingest.${formatSize(size)}`, () => httpIngest(port, size, options)]);
+    }
+    for (const size of options.bodySizes.filter((bytes) => bytes <= 4096)) {
+        scenarios.push([`http.fastpath.${formatSize(size)}`, () => httpIngest(port, size, options, 16, ingestPort)]);
+    }
+    scenarios.push(['http.fastpath.pipeline16', () => httpPipeline(port, ingestPort, options)]);
+    for (const devices of [1, 10]) {
+        scenarios.push([`ws.ingest.devices${devices}`, () => websocketIngest(port, devices, options)]);
+    }
+    for (const dashboards of options.fanout) {
+        scenarios.push([`broadcast.fanout${dashboards}`, () => broadcastFanout(port, dashboards, options)]);
+    }
+    for (const viewers of options.fanout) {
+        scenarios.push([`sse.fanout${viewers}`, () => sseFanout(port, viewers, options)]);
+    }
+
+    try {
+        for (const [name, run] of scenarios) {
+            if (!selected(name)) continue;
+            // Lag di proses load generator: jika tinggi, client yang jadi bottleneck
+            clientLag.reset();
+            clientLag.enable();
+            const metrics = await run();
+            clientLag.disable();
+            record(name, metrics, { client_lag_p99_ms: round(clientLag.percentile(99) / 1e6) });
+            await sleep(500);
+        }
+    } finally {
+        child.kill('SIGTERM');
+    }
+
+    if (options.json) {
+        writeResults(options.json, 'server', results, { duration_ms: options.durationMs });
+        console.log(`💾 Results written to ${options.json}`);
+    }
+
+    if (!options.baseline) return 0;
+    const baseline = loadResults(options.baseline);
+    if (!baseline) {
+        console.log(`ℹ️ No baseline at ${options.baseline}, skipping comparison`);
+        return 0;
+    }
+
+    const rows = compareResults(results, baseline, options.threshold);
+    console.log(`📊 Baseline comparison (${options.baseline}, threshold ${Math.round(options.threshold * 100)}%)`);
+    for (const row of rows) {
+        const change = Number.isFinite(row.change) ? `${row.change >= 0 ? '+' : ''}${(row.change * 100).toFixed(1)}%` : 'new';
+        console.log(`  ${row.name.padEnd(32)} ${row.metric.padEnd(20)} ${String(row.previous).padStart(10)} -> ${String(row.value).padStart(10)} (${change})${row.regression ? '  ❌ REGRESSION' : ''}`);
+    }
+
+    const regressions = rows.filter((row) => row.regression).length;
+    if (regressions > 0) {
+        console.log(`❌ ${regressions} regression(s) against baseline`);
+        return 1;
+    }
+    console.log('✅ No regressions against baseline');
+    return 0;
+}
+
+main()
+    .then((code) => process.exit(code))
+    .catch((error) => {
+        console.error('❌ Benchmark failed:', error.message);
+        process.exit(2);
+    });
@@ -0,0 +1,265 @@
+/**
+ * Alert Rule Engine
+ * Rule threshold / rate-of-change / duration / hysteresis dikompilasi sekali
+ * menjadi evaluator, lalu dijalankan inkremental per sampel yang di-ingest:
+ * setiap rule O(1) per sampel (state per device, tanpa histori).
+ *
+ * Definisi rule (JSON):
+ *   { id, field, type: 'threshold' | 'rate' | 'duration', op: '>' | '>=' | '<' | '<=',
+ *     value, clear?, forMs?, clearForMs?, severity?, message?, devices?, absolute?, smoothing? }
+ *   clear      - level hysteresis: alert aktif sampai nilai melewati balik level ini
+ *                (op '>'/'>=' -> clear <= value, op '<'/'<=' -> clear >= value)
+ *   forMs      - kondisi harus bertahan selama ini sebelum alert naik (type 'duration')
+ *   type rate  - value dalam satuan/detik, dihitung dari sampel sebelumnya (EWMA `smoothing`)
+ *   devices    - daftar device_id, boleh diakhiri '*' sebagai prefix; default semua device
+ */
+
+const fs = require('fs');
+
+const OPERATORS = {
+    '>': (a, b) => a > b,
+    '>=': (a, b) => a >= b,
+    '<': (a, b) => a < b,
+    '<=': (a, b) => a <= b
+};
+
+const SEVERITIES = ['info', 'warning', 'critical'];
+// device_id datang dari klien: state per device dibatasi jumlahnya dan dibuang saat idle
+const DEFAULT_MAX_DEVICES = 256;
+const DEFAULT_IDLE_MS = 10 * 60 * 1000;
+
+const DEFAULT_RULES = [
+    { id: 'battery_low', field: 'battery_voltage', type: 'duration', op: '<', value: 11.1, clear: 11.4, forMs: 3000, severity: 'critical', message: 'Battery voltage low' },
+    { id: 'battery_overcurrent', field: 'battery_current', op: '>', value: 20, clear: 18, severity: 'critical', message: 'Battery current too high' },
+    { id: 'temperature_high', field: 'temperature', op: '>', value: 60, clear: 55, severity: 'warning', message: 'Temperature high' },
+    { id: 'signal_weak', field: 'signal_strength', type: 'duration', op: '<', value: -85, clear: -80, forMs: 5000, severity: 'warning', message: 'WiFi signal weak' },
+    { id: 'altitude_rate', field: 'altitude', type: 'rate', op: '>', value: 15, clear: 10, severity: 'warning', message: 'Altitude changing fast (m/s)' },
+    { id: 'gps_lost', field: 'satellites', type: 'duration', op: '<', value: 4, clear: 5, forMs: 5000, severity: 'warning', message: 'GPS fix lost' }
+];
+
+function compileDeviceFilter(devices) {
+    if (!devices || devices === '*' || (Array.isArray(devices) && devices.length === 0)) return null;
+    const list = Array.isArray(devices) ? devices : [devices];
+    const exact = new Set(list.filter((pattern) => !pattern.endsWith('*')));
+    const prefixes = list.filter((pattern) => pattern.endsWith('*')).map((pattern) => pattern.slice(0, -1));
+    return (deviceId) => exact.has(deviceId) || prefixes.some((prefix) => deviceId.startsWith(prefix));
+}
+
+/**
+ * Validasi + kompilasi satu definisi rule. Throw Error jika definisi tidak valid.
+ */
+function compileRule(definition, index) {
+    const { id, field, type = 'threshold', op = '>', value, clear, severity = 'warning' } = definition || {};
+    if (typeof id !== 'string' || !id) throw new Error(`Rule #${index}: missing id`);
+    if (typeof field !== 'string' || !field) throw new Error(`Rule ${id}: missing field`);
+    if (!['threshold', 'rate', 'duration'].includes(type)) throw new Error(`Rule ${id}: unknown type '${type}'`);
+    if (!OPERATORS[op]) throw new Error(`Rule ${id}: unknown operator '${op}'`);
+    if (!Number.isFinite(value)) throw new Error(`Rule ${id}: value must be a number`);
+    if (clear !== undefined && !Number.isFinite(clear)) throw new Error(`Rule ${id}: clear must be a number`);
+    if (!SEVERITIES.includes(severity)) throw new Error(`Rule ${id}: unknown severity '${severity}'`);
+
+    const forMs = Math.max(0, definition.forMs || 0);
+    if (type === 'duration' && forMs === 0) throw new Error(`Rule ${id}: duration rule needs forMs`);
+
+    const compare = OPERATORS[op];
+    const rising = op[0] === '>';
+    // clear di sisi yang salah: alert langsung turun saat naik, atau tidak pernah turun
+    if (clear !== undefined && (rising ? clear > value : clear < value)) {
+        throw new Error(`Rule ${id}: clear ${clear} must be ${rising ? '<=' : '>='} value ${value} for '${op}'`);
+    }
+    // Tanpa level clear: alert turun begitu kondisi tidak terpenuhi lagi
+    const cleared = clear === undefined
+        ? (input) => !compare(input, value)
+        : rising ? (input) => input < clear : (input) => input > clear;
+
+    return {
+        index,
+        id,
+        field,
+        type,
+        op,
+        value,
+        clear,
+        severity,
+        message: definition.message || `${field} ${op} ${value}`,
+        forMs,
+        clearForMs: Math.max(0, definition.clearForMs || 0),
+        rate: type === 'rate',
+        absolute: definition.absolute !== false,
+        smoothing: Math.min(1, Math.max(0.01, definition.smoothing || 0.5)),
+        matchesDevice: compileDeviceFilter(definition.devices),
+        triggered: (input) => compare(input, value),
+        cleared
+    };
+}
+
+function compileRules(definitions) {
+    if (!Array.isArray(definitions)) throw new Error('Alert rules must be an array');
+    const rules = definitions.map(compileRule);
+    const seen = new Set();
+    for (const rule of rules) {
+        if (seen.has(rule.id)) throw new Error(`Duplicate rule id '${rule.id}'`);
+        seen.add(rule.id);
+    }
+    return rules;
+}
+
+function loadRuleFile(file) {
+    return compileRules(JSON.parse(fs.readFileSync(file, 'utf8')));
+}
+
+class AlertEngine {
+    constructor(rules = compileRules(DEFAULT_RULES), options = {}) {
+        this.rules = rules;
+        this.maxDevices = options.maxDevices || DEFAULT_MAX_DEVICES;
+        this.idleMs = options.idleMs || DEFAULT_IDLE_MS;
+        this.devices = new Map();
+        this.active = new Map();
+        this.stats = { samples: 0, evaluations: 0, raised: 0, cleared: 0, evictedDevices: 0 };
+    }
+
+    // Evaluator per device: hanya rule yang berlaku, dikelompokkan per field
+    deviceFor(deviceId, now) {
+        let device = this.devices.get(deviceId);
+        if (device) return device;
+        if (this.devices.size >= this.maxDevices) this.evictIdle(now, true);
+
+        const byField = new Map();
+        for (const rule of this.rules) {
+            if (rule.matchesDevice && !rule.matchesDevice(deviceId)) continue;
+            if (!byField.has(rule.field)) byField.set(rule.field, []);
+            byField.get(rule.field).push({
+                rule,
+                active: false,
+                since: null,     // Awal kondisi (raise atau clear) bertahan
+                previous: NaN,   // Untuk rate-of-change
+                previousAt: 0,
+                rate: NaN,
+                input: NaN
+            });
+        }
+        device = { id: deviceId, fields: [...byField.entries()], lastSeen: now };
+        this.devices.set(deviceId, device);
+        return device;
+    }
+
+    /**
+     * Buang device yang tidak mengirim selama idleMs beserta alert aktifnya;
+     * force = map penuh, buang juga device yang paling lama tidak terlihat.
+     */
+    evictIdle(now = Date.now(), force = false) {
+        let oldest = null;
+        for (const device of this.devices.values()) {
+            if (now - device.lastSeen > this.idleMs) this.dropDevice(device);
+            else if (!oldest || device.lastSeen < oldest.lastSeen) oldest = device;
+        }
+        if (force && this.devices.size >= this.maxDevices && oldest) this.dropDevice(oldest);
+    }
+
+    dropDevice(device) {
+        this.devices.delete(device.id);
+        this.stats.evictedDevices++;
+        for (const [, states] of device.fields) {
+            for (const state of states) {
+                if (state.active) this.active.delete(`${device.id}|${state.rule.id}`);
+            }
+        }
+    }
+
+    /**
+     * Evaluasi satu sampel; return array event transisi (raised / cleared).
+     */
+    evaluate(deviceId, sample, now = Date.now()) {
+        const device = this.deviceFor(deviceId, now);
+        const events = [];
+        device.lastSeen = now;
+        this.stats.samples++;
+
+        for (const [field, states] of device.fields) {
+            const raw = sample[field];
+            if (raw === undefined || raw === null) continue;
+            const value = typeof raw === 'number' ? raw : Number(raw);
+            if (!Number.isFinite(value)) continue;
+
+            for (const state of states) {
+                this.step(device, state, value, now, events);
+            }
+        }
+        return events;
+    }
+
+    step(device, state, value, now, events) {
+        const { rule } = state;
+        this.stats.evaluations++;
+        let input = value;
+
+        if (rule.rate) {
+            if (state.previousAt > 0 && now > state.previousAt) {
+                const rate = (value - state.previous) / ((now - state.previousAt) / 1000);
+                state.rate = Number.isNaN(state.rate) ? rate : state.rate + rule.smoothing * (rate - state.rate);
+            }
+            state.previous = value;
+            state.previousAt = now;
+            if (Number.isNaN(state.rate)) return;
+            input = rule.absolute ? Math.abs(state.rate) : state.rate;
+        }
+        state.input = input;
+
+        const condition = state.active ? rule.cleared(input) : rule.triggered(input);
+        if (!condition) {
+            state.since = null;
+            return;
+        }
+        if (state.since === null) state.since = now;
+        if (now - state.since < (state.active ? rule.clearForMs : rule.forMs)) return;
+
+        state.active = !state.active;
+        state.since = null;
+        const event = this.buildEvent(device.id, state, now);
+        const key = `${device.id}|${rule.id}`;
+        if (state.active) {
+            this.active.set(key, event);
+            this.stats.raised++;
+        } else {
+            this.active.delete(key);
+            this.stats.cleared++;
+        }
+        events.push(event);
+    }
+
+    buildEvent(deviceId, state, now) {
+        const { rule } = state;
+        return {
+            rule: rule.id,
+            device_id: deviceId,
+            state: state.active ? 'raised' : 'cleared',
+            severity: rule.severity,
+            field: rule.field,
+            type: rule.type,
+            value: Math.round(state.input * 1000) / 1000,
+            threshold: state.active || rule.clear === undefined ? rule.value : rule.clear,
+            message: rule.message,
+            timestamp: new Date(now).toISOString()
+        };
+    }
+
+    getActiveAlerts() {
+        return [...this.active.values()];
+    }
+
+    getRules() {
+        return this.rules.map(({ id, field, type, op, value, clear, forMs, severity, message }) =>
+            ({ id, field, type, op, value, clear, forMs, severity, message }));
+    }
+
+    getStats() {
+        return {
+            ...this.stats,
+            rules: this.rules.length,
+            devices: this.devices.size,
+            active: this.active.size
+        };
+    }
+}
+
+module.exports = { AlertEngine, compileRule, compileRules, loadRuleFile, DEFAULT_RULES };
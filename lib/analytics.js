@@ -0,0 +1,329 @@
+/**
+ * Flight Analytics
+ * Statistik per window waktu dari HistoryStore untuk laporan pasca-terbang:
+ * energi terpakai (integral battery_power), arus puncak, persentil tegangan +
+ * voltage sag, dan histogram ketinggian.
+ *
+ * Kernel akumulasi dari native/build/analytics.node (SSE2/AVX2, lihat
+ * native/analytics.cpp) jika sudah di-build, fallback ke loop JS dengan hasil
+ * yang sama. ANALYTICS_NATIVE=0 memaksa JS.
+ */
+
+const path = require('path');
+const { COLUMNS } = require('./history-store');
+
+// Layout state window (harus sama dengan enum StateIndex di native/analytics.cpp)
+const STATE = {
+    SAMPLES: 0,
+    ENERGY_J: 1,
+    ENERGY_MS: 2,
+    PREV_T: 3,
+    PREV_P: 4,
+    PEAK_CURRENT: 5,
+    VOLT_MIN: 6,
+    VOLT_MAX: 7,
+    ALT_MIN: 8,
+    ALT_MAX: 9,
+    MAX_GAP_MS: 10,
+    ALT_ORIGIN_M: 11,
+    ALT_BIN_M: 12,
+    VOLT_BIN_V: 13,
+    SIZE: 14
+};
+
+const DEFAULTS = {
+    windowMs: 60000,
+    maxGapMs: 5000,
+    altitudeOriginM: -50,
+    altitudeBinM: 10,
+    altitudeBins: 256,
+    voltageBinV: 0.01,
+    voltageBins: 6000,
+    maxWindows: 10000
+};
+
+const column = (name) => COLUMNS.findIndex((entry) => entry.name === name);
+const COLUMN_INDEX = {
+    timestamp: 0,
+    power: column('battery_power'),
+    current: column('battery_current'),
+    voltage: column('battery_voltage'),
+    altitude: column('altitude')
+};
+
+function loadNative() {
+    if (process.env.ANALYTICS_NATIVE === '0') return null;
+    try {
+        return require(path.join(__dirname, '..', 'native', 'build', 'analytics.node'));
+    } catch (error) {
+        return null;
+    }
+}
+
+const native = loadNative();
+
+// ====== JS KERNEL ======
+
+const fround = Math.fround;
+
+function histogramIndex(value, origin, inverse, last) {
+    let index = Math.floor(fround(fround(value - origin) * inverse));
+    if (index < 0) index = 0;
+    if (index > last) index = last;
+    return index;
+}
+
+// Loop naif satu sampel per iterasi; semantik identik dengan kernel native
+function accumulateJs(t, power, current, voltage, altitude, begin, end, state, voltageHist, altitudeHist) {
+    if (end <= begin) return;
+    const maxGap = state[STATE.MAX_GAP_MS];
+    const voltInverse = fround(1 / state[STATE.VOLT_BIN_V]);
+    const altOrigin = fround(state[STATE.ALT_ORIGIN_M]);
+    const altInverse = fround(1 / state[STATE.ALT_BIN_M]);
+    const voltLast = voltageHist.length - 1;
+    const altLast = altitudeHist.length - 1;
+
+    let prevT = state[STATE.PREV_T];
+    let prevP = state[STATE.PREV_P];
+    let joules = 0;
+    let ms = 0;
+    for (let i = begin; i < end; i++) {
+        const dt = t[i] - prevT;
+        const p = power[i];
+        if (dt > 0 && dt <= maxGap && p === p && prevP === prevP) {
+            joules += (prevP + p) * 0.5 * dt;
+            ms += dt;
+        }
+        prevT = t[i];
+        prevP = p;
+
+        const c = current[i];
+        if (c > state[STATE.PEAK_CURRENT]) state[STATE.PEAK_CURRENT] = c;
+        const v = voltage[i];
+        if (v === v) {
+            if (v < state[STATE.VOLT_MIN]) state[STATE.VOLT_MIN] = v;
+            if (v > state[STATE.VOLT_MAX]) state[STATE.VOLT_MAX] = v;
+            voltageHist[histogramIndex(v, 0, voltInverse, voltLast)]++;
+        }
+        const a = altitude[i];
+        if (a === a) {
+            if (a < state[STATE.ALT_MIN]) state[STATE.ALT_MIN] = a;
+            if (a > state[STATE.ALT_MAX]) state[STATE.ALT_MAX] = a;
+            altitudeHist[histogramIndex(a, altOrigin, altInverse, altLast)]++;
+        }
+    }
+    state[STATE.ENERGY_J] += joules / 1000;
+    state[STATE.ENERGY_MS] += ms;
+    state[STATE.SAMPLES] += end - begin;
+    state[STATE.PREV_T] = prevT;
+    state[STATE.PREV_P] = prevP;
+}
+
+// ====== WINDOWS ======
+
+function resetState(state, options) {
+    state.fill(0);
+    state[STATE.PREV_T] = NaN;
+    state[STATE.PREV_P] = NaN;
+    state[STATE.PEAK_CURRENT] = -Infinity;
+    state[STATE.VOLT_MIN] = state[STATE.ALT_MIN] = Infinity;
+    state[STATE.VOLT_MAX] = state[STATE.ALT_MAX] = -Infinity;
+    state[STATE.MAX_GAP_MS] = options.maxGapMs;
+    state[STATE.ALT_ORIGIN_M] = options.altitudeOriginM;
+    state[STATE.ALT_BIN_M] = options.altitudeBinM;
+    state[STATE.VOLT_BIN_V] = options.voltageBinV;
+}
+
+function createWindow(start, options) {
+    const state = new Float64Array(STATE.SIZE);
+    resetState(state, options);
+    return {
+        start,
+        state,
+        voltageHist: new Uint32Array(options.voltageBins),
+        altitudeHist: new Uint32Array(options.altitudeBins),
+        voltageBinV: options.voltageBinV,
+        altitudeOriginM: options.altitudeOriginM,
+        altitudeBinM: options.altitudeBinM
+    };
+}
+
+// Pakai ulang histogram window yang sudah diringkas: cukup nolkan rentang bin yang terisi
+function reuseWindow(window, start, options) {
+    const s = window.state;
+    const [voltFrom, voltTo] = binRange(s[STATE.VOLT_MIN], s[STATE.VOLT_MAX], 0, window.voltageBinV, window.voltageHist.length);
+    if (voltFrom <= voltTo) window.voltageHist.fill(0, voltFrom, voltTo + 1);
+    const [altFrom, altTo] = binRange(s[STATE.ALT_MIN], s[STATE.ALT_MAX], window.altitudeOriginM, window.altitudeBinM, window.altitudeHist.length);
+    if (altFrom <= altTo) window.altitudeHist.fill(0, altFrom, altTo + 1);
+    resetState(s, options);
+    window.start = start;
+    return window;
+}
+
+// Rentang bin terisi dari min/max window; walk & merge histogram cukup di rentang ini
+function binRange(min, max, origin, binWidth, bins) {
+    if (!(min <= max)) return [0, -1];
+    const index = (value) => Math.min(bins - 1, Math.max(0, Math.floor((value - origin) / binWidth)));
+    return [Math.max(0, index(min) - 1), Math.min(bins - 1, index(max) + 1)];
+}
+
+// Persentil dari histogram (nilai tengah bin), q terurut naik
+function histogramPercentiles(counts, [from, to], binWidth, origin, quantiles) {
+    let total = 0;
+    for (let i = from; i <= to; i++) total += counts[i];
+    if (total === 0) return quantiles.map(() => null);
+
+    const result = [];
+    let cumulative = 0;
+    let q = 0;
+    for (let i = from; i <= to && q < quantiles.length; i++) {
+        cumulative += counts[i];
+        while (q < quantiles.length && cumulative >= Math.max(1, Math.ceil(quantiles[q] * total))) {
+            result.push(origin + (i + 0.5) * binWidth);
+            q++;
+        }
+    }
+    return result;
+}
+
+const round = (value, digits = 3) => (Number.isFinite(value) ? Math.round(value * 10 ** digits) / 10 ** digits : null);
+
+function summarize(window, end, options) {
+    const s = window.state;
+    const voltageBins = binRange(s[STATE.VOLT_MIN], s[STATE.VOLT_MAX], 0, options.voltageBinV, options.voltageBins);
+    const [p5, p50, p95, p99] = histogramPercentiles(window.voltageHist, voltageBins, options.voltageBinV, 0, [0.05, 0.5, 0.95, 0.99]);
+    // Sag = turun dari tegangan "istirahat" (p99 window) saat beban
+    const sagP95 = p99 !== null ? p99 - p5 : null;
+
+    let [first, last] = binRange(s[STATE.ALT_MIN], s[STATE.ALT_MAX], options.altitudeOriginM, options.altitudeBinM, options.altitudeBins);
+    while (first <= last && window.altitudeHist[first] === 0) first++;
+    while (last >= first && window.altitudeHist[last] === 0) last--;
+
+    return {
+        start: new Date(window.start).toISOString(),
+        end: new Date(end).toISOString(),
+        samples: s[STATE.SAMPLES],
+        energy_wh: round(s[STATE.ENERGY_J] / 3600, 4),
+        avg_power_w: s[STATE.ENERGY_MS] > 0 ? round(s[STATE.ENERGY_J] / (s[STATE.ENERGY_MS] / 1000), 2) : null,
+        integrated_s: round(s[STATE.ENERGY_MS] / 1000, 1),
+        peak_current_a: round(s[STATE.PEAK_CURRENT], 2),
+        voltage: {
+            min: round(s[STATE.VOLT_MIN], 2),
+            p5: round(p5, 2),
+            p50: round(p50, 2),
+            p95: round(p95, 2),
+            max: round(s[STATE.VOLT_MAX], 2)
+        },
+        sag: {
+            p50_v: p99 !== null ? round(p99 - p50, 2) : null,
+            p95_v: round(sagP95, 2),
+            p95_pct: p99 ? round(sagP95 / p99 * 100, 1) : null
+        },
+        altitude: {
+            min: round(s[STATE.ALT_MIN], 1),
+            max: round(s[STATE.ALT_MAX], 1),
+            bin_m: options.altitudeBinM,
+            origin_m: options.altitudeOriginM + first * options.altitudeBinM,
+            counts: Array.from(window.altitudeHist.subarray(first, last + 1))
+        }
+    };
+}
+
+// Gabung window untuk total seluruh rentang (histogram dijumlah, extrema digabung)
+function mergeInto(total, window) {
+    const t = total.state;
+    const s = window.state;
+    t[STATE.SAMPLES] += s[STATE.SAMPLES];
+    t[STATE.ENERGY_J] += s[STATE.ENERGY_J];
+    t[STATE.ENERGY_MS] += s[STATE.ENERGY_MS];
+    t[STATE.PEAK_CURRENT] = Math.max(t[STATE.PEAK_CURRENT], s[STATE.PEAK_CURRENT]);
+    t[STATE.VOLT_MIN] = Math.min(t[STATE.VOLT_MIN], s[STATE.VOLT_MIN]);
+    t[STATE.VOLT_MAX] = Math.max(t[STATE.VOLT_MAX], s[STATE.VOLT_MAX]);
+    t[STATE.ALT_MIN] = Math.min(t[STATE.ALT_MIN], s[STATE.ALT_MIN]);
+    t[STATE.ALT_MAX] = Math.max(t[STATE.ALT_MAX], s[STATE.ALT_MAX]);
+    const [voltFrom, voltTo] = binRange(s[STATE.VOLT_MIN], s[STATE.VOLT_MAX], 0, window.voltageBinV, window.voltageHist.length);
+    for (let i = voltFrom; i <= voltTo; i++) total.voltageHist[i] += window.voltageHist[i];
+    const [altFrom, altTo] = binRange(s[STATE.ALT_MIN], s[STATE.ALT_MAX], window.altitudeOriginM, window.altitudeBinM, window.altitudeHist.length);
+    for (let i = altFrom; i <= altTo; i++) total.altitudeHist[i] += window.altitudeHist[i];
+}
+
+function lowerBound(values, begin, end, target) {
+    while (begin < end) {
+        const mid = (begin + end) >>> 1;
+        if (values[mid] < target) begin = mid + 1; else end = mid;
+    }
+    return begin;
+}
+
+/**
+ * Statistik per window untuk slice HistoryStore (store.slices(device, from, to)).
+ * kernel: 'native' | 'js' | undefined (native jika tersedia).
+ */
+function computeAnalytics(slices, options = {}) {
+    const config = { ...DEFAULTS, ...options };
+    const accumulate = config.kernel === 'js' || !native ? accumulateJs : native.accumulate;
+    const kernel = accumulate === accumulateJs ? 'js' : `native-${native.kernel()}`;
+    if (!(config.windowMs > 0)) throw new Error('window must be positive');
+    if (slices.length === 0) return { kernel, window_ms: config.windowMs, windows: [], total: null };
+
+    const first = slices[0].chunk.columns[0][slices[0].begin];
+    const lastSlice = slices[slices.length - 1];
+    const lastTime = lastSlice.chunk.columns[0][lastSlice.end - 1];
+    const origin = config.from !== undefined && Number.isFinite(config.from) ? config.from : first;
+    if ((lastTime - origin) / config.windowMs > config.maxWindows) {
+        throw new Error(`Too many windows (max ${config.maxWindows}), use a larger window`);
+    }
+
+    // Window ditutup berurutan: diringkas, digabung ke total, lalu histogramnya dipakai
+    // window berikutnya. Memori tetap dua pasang histogram berapa pun jumlah window
+    const windows = [];
+    let total = null;
+    let current = null;
+    let carry = [NaN, NaN];
+    const close = () => {
+        if (!total) total = createWindow(current.start, config);
+        mergeInto(total, current);
+        windows.push(summarize(current, Math.min(current.start + config.windowMs, lastTime), config));
+    };
+
+    for (const { chunk, begin, end } of slices) {
+        const t = chunk.columns[COLUMN_INDEX.timestamp];
+        const columns = [t, chunk.columns[COLUMN_INDEX.power], chunk.columns[COLUMN_INDEX.current],
+            chunk.columns[COLUMN_INDEX.voltage], chunk.columns[COLUMN_INDEX.altitude]];
+
+        let row = begin;
+        while (row < end) {
+            const index = Math.floor((t[row] - origin) / config.windowMs);
+            const windowStart = origin + index * config.windowMs;
+            if (!current || current.start !== windowStart) {
+                if (current) {
+                    close();
+                    reuseWindow(current, windowStart, config);
+                } else {
+                    current = createWindow(windowStart, config);
+                }
+                // Interval yang melewati batas window dihitung ke window berikutnya
+                current.state[STATE.PREV_T] = carry[0];
+                current.state[STATE.PREV_P] = carry[1];
+            }
+            const stop = lowerBound(t, row, end, windowStart + config.windowMs);
+            accumulate(...columns, row, stop, current.state, current.voltageHist, current.altitudeHist);
+            carry = [current.state[STATE.PREV_T], current.state[STATE.PREV_P]];
+            row = stop;
+        }
+    }
+    if (current) close();
+
+    return {
+        kernel,
+        window_ms: config.windowMs,
+        windows,
+        total: summarize(total, lastTime, config)
+    };
+}
+
+function nativeKernel() {
+    return native ? native.kernel() : null;
+}
+
+module.exports = { computeAnalytics, accumulateJs, nativeKernel, native, STATE, DEFAULTS };
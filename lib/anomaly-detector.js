@@ -0,0 +1,272 @@
+/**
+ * Anomaly Detector
+ * Deteksi glitch sensor / perilaku abnormal secara streaming per device per field,
+ * O(1) memori dan waktu per sampel:
+ *   - robust z-score: median (stochastic approximation) + MAD (EWMA deviasi absolut)
+ *     -> 'spike' saat |z| > threshold dan sampel berikutnya kembali normal
+ *     (baru diketahui satu sampel kemudian, jadi flag-nya dikembalikan lewat
+ *     `previous` untuk baris spike itu sendiri); outlier yang bertahan = perubahan
+ *     level (step), baseline di-reset dan hanya dilaporkan jika reportSteps
+ *     (perubahan throttle bukan anomali);
+ *     GPS: kecepatan implisit outlier langsung 'jump'
+ *   - EWMA mean/variance + CUSUM dua sisi pada residual terstandar
+ *     -> 'shift_up' / 'shift_down' untuk perubahan level bertahap (mis. temperature runaway)
+ * Outlier tidak ikut meng-update statistik agar spike tidak menggeser baseline.
+ *
+ * mode 'level' memakai nilai field, 'rate' turunan per detik (altitude),
+ * 'gps' kecepatan implisit antar fix (lompatan posisi).
+ */
+
+const DEFAULT_FIELDS = {
+    battery_current: { mode: 'level', minScale: 0.3 },
+    battery_voltage: { mode: 'level', minScale: 0.05 },
+    // Baseline lambat supaya kenaikan bertahap (runaway) terlihat oleh CUSUM
+    temperature: { mode: 'level', minScale: 0.3, alpha: 0.005, cusumK: 0.25, cusumH: 10, reportSteps: true },
+    // Perubahan laju climb/descent normal; hanya glitch (spike) yang dicari
+    altitude: { mode: 'rate', minScale: 1, cusumH: Infinity },
+    signal_strength: { mode: 'level', minScale: 2 },
+    gps: { mode: 'gps', minScale: 1, maxValue: 80 }
+};
+
+const DEFAULTS = {
+    alpha: 0.05,        // EWMA mean/variance
+    medianStep: 0.1,    // Langkah median dalam satuan skala
+    z: 6,               // Threshold robust z
+    cusumK: 0.5,        // Slack CUSUM (sigma)
+    cusumH: 8,          // Threshold CUSUM (sigma)
+    warmup: 20,         // Sampel sebelum boleh flag
+    cooldownMs: 5000,   // Anomali jenis sama per field tidak diulang dalam jeda ini
+    reportSteps: false,
+    recentLimit: 500,
+    // device_id datang dari klien: state dibatasi jumlahnya dan dibuang saat idle
+    maxDevices: 256,
+    idleMs: 10 * 60 * 1000
+};
+
+const METERS_PER_DEGREE = 111320;
+
+function createState() {
+    return {
+        n: 0,
+        mean: 0,
+        variance: 0,
+        median: 0,
+        mad: 0,
+        cusumUp: 0,
+        cusumDown: 0,
+        previous: NaN,      // Nilai/posisi sebelumnya untuk mode rate/gps
+        previousLon: NaN,
+        previousAt: 0,
+        pending: null,      // Outlier yang menunggu konfirmasi spike vs step
+        lastEvent: {}
+    };
+}
+
+class AnomalyDetector {
+    constructor(fields = DEFAULT_FIELDS, options = {}) {
+        this.options = { ...DEFAULTS, ...options };
+        this.fields = Object.entries(fields).map(([name, config], bit) => ({
+            name,
+            bit,
+            ...this.options,
+            ...config
+        }));
+        this.devices = new Map();
+        this.recent = [];
+        this.stats = { samples: 0, anomalies: 0, byKind: {}, evictedDevices: 0 };
+    }
+
+    deviceFor(deviceId, now) {
+        let device = this.devices.get(deviceId);
+        if (!device) {
+            if (this.devices.size >= this.options.maxDevices) this.evictIdle(now, true);
+            device = { samples: 0, fields: this.fields.map(createState), lastSeen: now };
+            this.devices.set(deviceId, device);
+        }
+        return device;
+    }
+
+    // Buang baseline device yang diam > idleMs; force = map penuh, buang juga yang paling lama diam
+    evictIdle(now = Date.now(), force = false) {
+        let oldestId = null;
+        let oldestSeen = Infinity;
+        for (const [deviceId, device] of this.devices) {
+            if (now - device.lastSeen > this.options.idleMs) {
+                this.devices.delete(deviceId);
+                this.stats.evictedDevices++;
+            } else if (device.lastSeen < oldestSeen) {
+                oldestId = deviceId;
+                oldestSeen = device.lastSeen;
+            }
+        }
+        if (force && this.devices.size >= this.options.maxDevices && oldestId !== null) {
+            this.devices.delete(oldestId);
+            this.stats.evictedDevices++;
+        }
+    }
+
+    // Nilai yang dianalisis untuk field (level, rate, atau kecepatan GPS); NaN = lewati
+    input(field, state, data, now) {
+        if (field.mode === 'gps') {
+            const lat = Number(data.gps_latitude);
+            const lon = Number(data.gps_longitude);
+            if (!Number.isFinite(lat) || !Number.isFinite(lon) || (lat === 0 && lon === 0)) return NaN;
+            const previousLat = state.previous;
+            const previousLon = state.previousLon;
+            const dt = (now - state.previousAt) / 1000;
+            state.previous = lat;
+            state.previousLon = lon;
+            state.previousAt = now;
+            if (!Number.isFinite(previousLat) || dt <= 0) return NaN;
+            const dx = (lon - previousLon) * METERS_PER_DEGREE * Math.cos(lat * Math.PI / 180);
+            const dy = (lat - previousLat) * METERS_PER_DEGREE;
+            return Math.sqrt(dx * dx + dy * dy) / dt;
+        }
+
+        const raw = data[field.name];
+        if (raw === undefined || raw === null) return NaN;
+        const value = Number(raw);
+        if (!Number.isFinite(value)) return NaN;
+        if (field.mode === 'level') return value;
+
+        const previous = state.previous;
+        const dt = (now - state.previousAt) / 1000;
+        state.previous = value;
+        state.previousAt = now;
+        return Number.isFinite(previous) && dt > 0 ? (value - previous) / dt : NaN;
+    }
+
+    step(field, state, x, now, sample, frame) {
+        state.n++;
+        if (state.n === 1) {
+            state.mean = state.median = x;
+            state.variance = field.minScale * field.minScale;
+            state.mad = field.minScale;
+            return null;
+        }
+
+        const scale = Math.max(1.4826 * state.mad, field.minScale);
+        const robustZ = (x - state.median) / scale;
+        const outlier = state.n > field.warmup &&
+            (Math.abs(robustZ) > field.z || (field.maxValue !== undefined && x > field.maxValue));
+        let anomaly = null;
+
+        if (state.pending) {
+            const pending = state.pending;
+            state.pending = null;
+            if (outlier && Math.sign(robustZ) === Math.sign(pending.score)) {
+                // Dua outlier searah = level baru, bukan glitch
+                state.mean = state.median = x;
+                state.cusumUp = state.cusumDown = 0;
+                if (!field.reportSteps) return null;
+                return { kind: robustZ > 0 ? 'step_up' : 'step_down', value: x, expected: pending.expected, score: robustZ, at: now, sample, frame };
+            }
+            anomaly = { kind: 'spike', ...pending };   // at/sample/frame = sampel spike, bukan sampel ini
+        }
+
+        if (outlier && field.mode === 'gps') {
+            // Kecepatan implisit selalu positif (lompat pergi lalu kembali = dua outlier searah),
+            // dan teleport bukan level baru -> langsung dilaporkan
+            return anomaly || { kind: 'jump', value: x, expected: state.median, score: robustZ, at: now, sample, frame };
+        }
+        if (outlier) {
+            // Statistik tidak di-update dengan outlier; keputusan di sampel berikutnya
+            state.pending = { value: x, expected: state.median, score: robustZ, at: now, sample, frame };
+            return anomaly;
+        }
+
+        if (state.n > field.warmup) {
+            const sd = Math.max(Math.sqrt(state.variance), field.minScale);
+            const residual = Math.max(-field.z, Math.min(field.z, (x - state.mean) / sd));
+            state.cusumUp = Math.max(0, state.cusumUp + residual - field.cusumK);
+            state.cusumDown = Math.max(0, state.cusumDown - residual - field.cusumK);
+            if (!anomaly && (state.cusumUp > field.cusumH || state.cusumDown > field.cusumH)) {
+                const up = state.cusumUp > field.cusumH;
+                anomaly = { kind: up ? 'shift_up' : 'shift_down', value: x, expected: state.mean, score: up ? state.cusumUp : -state.cusumDown, at: now, sample, frame };
+                state.cusumUp = 0;
+                state.cusumDown = 0;
+            }
+        }
+
+        const delta = x - state.mean;
+        state.mean += field.alpha * delta;
+        state.variance = (1 - field.alpha) * (state.variance + field.alpha * delta * delta);
+        state.median += field.medianStep * scale * Math.sign(x - state.median);
+        state.mad += field.alpha * (Math.abs(x - state.median) - state.mad);
+        return anomaly;
+    }
+
+    /**
+     * Evaluasi satu sampel; frame = id frame broadcast (seq) untuk anotasi.
+     * Return { flags (bit per field untuk sampel ini), previous, events }; previous =
+     * [{ rowsBack, flags }] untuk spike yang baru terkonfirmasi, rowsBack 1 = sampel
+     * sebelumnya dari device ini. Event membawa seq frame tempat anomali terjadi.
+     */
+    evaluate(deviceId, data, now = Date.now(), frame = undefined) {
+        const device = this.deviceFor(deviceId, now);
+        const sample = ++device.samples;
+        device.lastSeen = now;
+        this.stats.samples++;
+        let flags = 0;
+        let previous = null;
+        let events = null;
+
+        for (let i = 0; i < this.fields.length; i++) {
+            const field = this.fields[i];
+            const state = device.fields[i];
+            const x = this.input(field, state, data, now);
+            if (x !== x) continue;
+
+            const anomaly = this.step(field, state, x, now, sample, frame);
+            if (!anomaly) continue;
+            if (anomaly.sample === sample) {
+                flags |= 1 << field.bit;
+            } else {
+                const rowsBack = sample - anomaly.sample;
+                const entry = (previous || (previous = [])).find((candidate) => candidate.rowsBack === rowsBack);
+                if (entry) entry.flags |= 1 << field.bit; else previous.push({ rowsBack, flags: 1 << field.bit });
+            }
+
+            const last = state.lastEvent[anomaly.kind] || 0;
+            if (now - last < field.cooldownMs) continue;
+            state.lastEvent[anomaly.kind] = now;
+
+            const event = {
+                device_id: deviceId,
+                field: field.mode === 'gps' ? 'gps_speed' : field.mode === 'rate' ? `${field.name}_rate` : field.name,
+                kind: anomaly.kind,
+                value: Math.round(anomaly.value * 1000) / 1000,
+                expected: Math.round(anomaly.expected * 1000) / 1000,
+                score: Math.round(anomaly.score * 100) / 100,
+                timestamp: new Date(anomaly.at).toISOString(),
+                seq: anomaly.frame
+            };
+            (events || (events = [])).push(event);
+            this.record(event);
+        }
+        return { flags, previous: previous || [], events: events || [] };
+    }
+
+    record(event) {
+        this.stats.anomalies++;
+        this.stats.byKind[event.kind] = (this.stats.byKind[event.kind] || 0) + 1;
+        this.recent.push(event);
+        if (this.recent.length > this.options.recentLimit) this.recent.shift();
+    }
+
+    getRecent(deviceId = null, limit = 100) {
+        const events = deviceId ? this.recent.filter((event) => event.device_id === deviceId) : this.recent;
+        return events.slice(-limit);
+    }
+
+    // Arti bit kolom anomaly_flags di history/export
+    getFlagBits() {
+        return Object.fromEntries(this.fields.map((field) => [field.name, 1 << field.bit]));
+    }
+
+    getStats() {
+        return { ...this.stats, devices: this.devices.size, fields: this.fields.length };
+    }
+}
+
+module.exports = { AnomalyDetector, DEFAULT_FIELDS };
@@ -0,0 +1,75 @@
+/**
+ * Export Worker
+ * Format batch baris telemetry ke CSV. Dipakai langsung (export kecil) atau
+ * lewat worker_threads untuk flight besar, supaya format angka (bagian termahal
+ * export) berjalan paralel dan tidak menahan event loop ingest telemetry.
+ */
+
+const { isMainThread, parentPort } = require('worker_threads');
+
+const MILLIS = Array.from({ length: 1000 }, (_, ms) => String(ms).padStart(3, '0'));
+const FORMAT_CACHE_LIMIT = 4096;
+
+// Float32 disimpan dari nilai desimal pendek; 7 digit signifikan mengembalikan nilai aslinya.
+// Nilai telemetry banyak berulang (tegangan, suhu, satelit), jadi hasil format di-cache per kolom.
+function formatSingle(value, cache) {
+    let text = cache.get(value);
+    if (text === undefined) {
+        if (cache.size >= FORMAT_CACHE_LIMIT) cache.clear();
+        text = String(+value.toPrecision(7));
+        cache.set(value, text);
+    }
+    return text;
+}
+
+/**
+ * columns: typed array per kolom (kolom 0 = timestamp ms), single[i] = kolom Float32.
+ * Ditulis langsung ke Buffer (bukan string per baris) supaya GC tidak mendominasi,
+ * dan hasilnya bisa di-transfer dari worker tanpa copy.
+ */
+function formatCsvRows(columns, single, rows) {
+    const count = columns.length;
+    const caches = columns.map(() => new Map());
+    const timestamps = columns[0];
+    let buffer = Buffer.allocUnsafeSlow(Math.max(rows, 1) * 96);
+    let length = 0;
+    // toISOString mahal; prefix 'YYYY-MM-DDTHH:MM:SS.' dipakai ulang dalam detik yang sama
+    let second = NaN;
+    let prefix = '';
+
+    for (let row = 0; row < rows; row++) {
+        if (length + 512 > buffer.length) {
+            const grown = Buffer.allocUnsafeSlow(buffer.length * 2);
+            buffer.copy(grown, 0, 0, length);
+            buffer = grown;
+        }
+
+        const ms = Math.round(timestamps[row]);
+        const rowSecond = Math.floor(ms / 1000);
+        if (rowSecond !== second) {
+            second = rowSecond;
+            prefix = new Date(rowSecond * 1000).toISOString().slice(0, 20);
+        }
+        length += buffer.latin1Write(prefix, length);
+        length += buffer.latin1Write(MILLIS[ms - rowSecond * 1000], length);
+        buffer[length++] = 0x5A; // 'Z'
+
+        for (let i = 1; i < count; i++) {
+            buffer[length++] = 0x2C; // ','
+            const value = columns[i][row];
+            if (value !== value) continue;
+            length += buffer.latin1Write(single[i] ? formatSingle(value, caches[i]) : String(value), length);
+        }
+        buffer[length++] = 0x0A;
+    }
+    return buffer.subarray(0, length);
+}
+
+if (!isMainThread) {
+    parentPort.on('message', ({ id, columns, single, rows }) => {
+        const bytes = formatCsvRows(columns, single, rows);
+        parentPort.postMessage({ id, buffer: bytes.buffer, length: bytes.length }, [bytes.buffer]);
+    });
+}
+
+module.exports = { formatCsvRows };
@@ -0,0 +1,340 @@
+/**
+ * Ground-Station Federation Relay
+ * Satu server.js (pit laptop yang menerima dari UAV) meneruskan stream per device ke
+ * station lain (layar display) lewat satu koneksi TCP per peer:
+ *   - multiplexed: semua device dalam satu koneksi, record { d: device, q: seq, ... }
+ *   - compressed: newline-JSON di dalam satu stream deflate-raw per koneksi, flush per
+ *     batch (setImmediate) -> konteks kompresi terbawa antar frame, latensi tambahan ~ms
+ *   - sequenced: seq per device dari origin; receiver membuang seq <= terakhir
+ *   - backfill: origin menyimpan ring record terakhir per device; setelah reconnect
+ *     receiver mengirim { type: 'resume', lastSeq } dan origin mengirim ulang yang hilang
+ *   - backpressure: ring juga antrean kirim. Per peer hanya disimpan seq terakhir yang
+ *     sudah ditulis per device; record dikirim dari ring dalam batch terbatas dan berhenti
+ *     saat deflate.write() penuh sampai 'drain'. Peer yang tertinggal lebih dari ring
+ *     kehilangan record tertua (stats.dropped), memori origin tidak ikut tumbuh
+ * Arah sebaliknya (receiver -> origin) hanya JSON baris pendek tanpa kompresi.
+ * Waktu terima asli (a) ikut dikirim; receiver mengoreksi beda jam antar laptop.
+ */
+
+const net = require('net');
+const os = require('os');
+const zlib = require('zlib');
+
+const DEFAULT_REPLAY_FRAMES = 12000;  // ~20 menit pada 10 Hz per device
+const ACK_INTERVAL_MS = 5000;
+const IDLE_TIMEOUT_MS = 15000;
+const RECONNECT_MIN_MS = 1000;
+const RECONNECT_MAX_MS = 10000;
+const MAX_CONTROL_LINE = 64 * 1024;
+const SEND_BATCH_FRAMES = 256;        // Record per write ke deflate
+
+// Split newline-JSON; sisa baris yang belum lengkap disimpan untuk chunk berikutnya
+function lineReader(onMessage, onError) {
+    let tail = '';
+    return (chunk) => {
+        const lines = (tail + chunk).split('\n');
+        tail = lines.pop();
+        if (tail.length > MAX_CONTROL_LINE && onError) return onError(new Error('Line too long'));
+        for (const line of lines) {
+            if (!line) continue;
+            let message;
+            try {
+                message = JSON.parse(line);
+            } catch (error) {
+                if (onError) onError(error);
+                return;
+            }
+            onMessage(message);
+        }
+    };
+}
+
+function parsePeers(value) {
+    return String(value || '').split(',').map((entry) => entry.trim()).filter(Boolean).map((entry) => {
+        const at = entry.lastIndexOf(':');
+        return { host: at > 0 ? entry.slice(0, at) : entry, port: parseInt(at > 0 ? entry.slice(at + 1) : '', 10) };
+    }).filter((peer) => peer.port > 0);
+}
+
+/**
+ * Sisi origin: forward() dipanggil untuk setiap frame lokal; record diserialisasi sekali
+ * lalu dipakai untuk ring replay dan semua peer.
+ */
+class FederationUplink {
+    constructor(peers, options = {}) {
+        this.station = options.station || os.hostname();
+        this.epoch = `${Date.now().toString(36)}${Math.random().toString(36).slice(2, 8)}`;
+        this.replayFrames = options.replayFrames || DEFAULT_REPLAY_FRAMES;
+        this.devices = new Map();
+        this.peers = peers.map((peer) => this.createPeer(peer));
+        this.closed = false;
+        this.peers.forEach((peer) => this.connect(peer));
+        // Ping supaya receiver tidak menganggap koneksi mati saat device diam
+        this.pingTimer = setInterval(() => this.ping(), ACK_INTERVAL_MS);
+        this.pingTimer.unref();
+    }
+
+    ping() {
+        const line = `${JSON.stringify({ type: 'ping', now: Date.now() })}\n`;
+        for (const peer of this.peers) {
+            if (peer.ready && !peer.blocked && !peer.flushScheduled) {
+                peer.deflate.write(line);
+                peer.deflate.flush(zlib.constants.Z_SYNC_FLUSH);
+            }
+        }
+    }
+
+    createPeer({ host, port }) {
+        return {
+            name: `${host}:${port}`,
+            host,
+            port,
+            socket: null,
+            deflate: null,
+            ready: false,
+            blocked: false,         // Menunggu 'drain' dari deflate
+            sentSeq: new Map(),     // device -> seq terakhir yang sudah ditulis ke peer
+            flushScheduled: false,
+            retryMs: RECONNECT_MIN_MS,
+            retryTimer: null,
+            stats: { connects: 0, sent: 0, replayed: 0, dropped: 0, drains: 0, rawBytes: 0, wireBytes: 0, ackedSeq: {} }
+        };
+    }
+
+    deviceFor(deviceId) {
+        let device = this.devices.get(deviceId);
+        if (!device) {
+            device = { seq: 0, ring: new Array(this.replayFrames), count: 0 };
+            this.devices.set(deviceId, device);
+        }
+        return device;
+    }
+
+    forward(deviceId, connectionType, data, receivedAt = Date.now()) {
+        const device = this.deviceFor(deviceId);
+        const seq = ++device.seq;
+        const line = `${JSON.stringify({ d: deviceId, q: seq, a: receivedAt, c: connectionType, p: data })}\n`;
+        device.ring[(seq - 1) % this.replayFrames] = line;
+        device.count = Math.min(device.count + 1, this.replayFrames);
+
+        for (const peer of this.peers) {
+            if (peer.ready) this.schedule(peer);
+        }
+    }
+
+    // Semua record dalam satu tick digabung jadi satu write + satu flush deflate
+    schedule(peer) {
+        if (peer.flushScheduled || peer.blocked) return;
+        peer.flushScheduled = true;
+        setImmediate(() => {
+            peer.flushScheduled = false;
+            this.pump(peer);
+        });
+    }
+
+    // Tulis record dari ring yang belum dikirim ke peer, batch demi batch sampai habis
+    // atau deflate menolak (write() false); lanjut lagi setelah 'drain'
+    pump(peer) {
+        const deflate = peer.deflate;
+        if (!deflate || !peer.ready || peer.blocked) return;
+
+        for (;;) {
+            const lines = [];
+            for (const [deviceId, device] of this.devices) {
+                const sent = peer.sentSeq.get(deviceId) || 0;
+                if (sent >= device.seq) continue;
+                const oldest = device.seq - device.count;
+                if (sent < oldest) peer.stats.dropped += oldest - sent;
+                let seq = Math.max(sent, oldest);
+                while (seq < device.seq && lines.length < SEND_BATCH_FRAMES) {
+                    lines.push(device.ring[seq % this.replayFrames]);
+                    seq++;
+                }
+                peer.sentSeq.set(deviceId, seq);
+                if (lines.length === SEND_BATCH_FRAMES) break;
+            }
+            if (lines.length === 0) return;
+
+            const chunk = lines.join('');
+            peer.stats.sent += lines.length;
+            peer.stats.rawBytes += chunk.length;
+            const accepted = deflate.write(chunk);
+            deflate.flush(zlib.constants.Z_SYNC_FLUSH);
+            if (!accepted) {
+                peer.blocked = true;
+                deflate.once('drain', () => {
+                    if (peer.deflate !== deflate) return;
+                    peer.blocked = false;
+                    peer.stats.drains++;
+                    this.schedule(peer);
+                });
+                return;
+            }
+        }
+    }
+
+    connect(peer) {
+        if (this.closed) return;
+        const socket = net.connect(peer.port, peer.host);
+        const deflate = zlib.createDeflateRaw({ level: 6 });
+        peer.socket = socket;
+        peer.deflate = deflate;
+        peer.ready = false;
+        peer.blocked = false;
+
+        socket.setNoDelay(true);
+        socket.setKeepAlive(true, 5000);
+        socket.setEncoding('utf8');
+        socket.setTimeout(IDLE_TIMEOUT_MS, () => socket.destroy(new Error('Peer idle timeout')));
+        deflate.on('data', (chunk) => { peer.stats.wireBytes += chunk.length; });
+        deflate.pipe(socket);
+
+        socket.on('connect', () => {
+            peer.stats.connects++;
+            peer.retryMs = RECONNECT_MIN_MS;
+            console.log(`🛰️ [FEDERATION] Connected to peer ${peer.name}`);
+            deflate.write(`${JSON.stringify({ type: 'hello', station: this.station, epoch: this.epoch, now: Date.now() })}\n`);
+            deflate.flush(zlib.constants.Z_SYNC_FLUSH);
+        });
+        socket.on('data', lineReader((message) => {
+            if (message.type === 'resume') this.resume(peer, message);
+            else if (message.type === 'ack') peer.stats.ackedSeq = message.lastSeq || {};
+        }, () => socket.destroy()));
+        socket.on('error', () => {});
+        socket.on('close', () => {
+            deflate.unpipe(socket);
+            deflate.destroy();
+            if (peer.ready) console.log(`🔄 [FEDERATION] Peer ${peer.name} disconnected, retrying`);
+            peer.ready = false;
+            peer.socket = null;
+            peer.deflate = null;
+            if (this.closed) return;
+            peer.retryTimer = setTimeout(() => this.connect(peer), peer.retryMs);
+            peer.retryMs = Math.min(peer.retryMs * 2, RECONNECT_MAX_MS);
+        });
+    }
+
+    // Kirim ulang record yang belum dimiliki peer (epoch beda = peer belum pernah lihat origin ini);
+    // cukup set posisi per device, pump() yang mengirim dari ring secara bertahap
+    resume(peer, message) {
+        const known = message.epoch === this.epoch ? message.lastSeq || {} : {};
+        peer.sentSeq = new Map();
+        for (const [deviceId, device] of this.devices) {
+            const from = Math.min(Math.max(Number(known[deviceId]) || 0, device.seq - device.count), device.seq);
+            peer.sentSeq.set(deviceId, from);
+            peer.stats.replayed += device.seq - from;
+        }
+        peer.ready = true;
+        this.schedule(peer);
+    }
+
+    close() {
+        this.closed = true;
+        clearInterval(this.pingTimer);
+        for (const peer of this.peers) {
+            clearTimeout(peer.retryTimer);
+            if (peer.socket) peer.socket.destroy();
+        }
+    }
+
+    getStats() {
+        return {
+            station: this.station,
+            devices: Object.fromEntries([...this.devices].map(([deviceId, device]) => [deviceId, device.seq])),
+            peers: this.peers.map((peer) => ({
+                peer: peer.name,
+                connected: peer.ready,
+                ...peer.stats,
+                ratio: peer.stats.rawBytes ? Math.round(peer.stats.wireBytes / peer.stats.rawBytes * 1000) / 1000 : null
+            }))
+        };
+    }
+}
+
+/**
+ * Sisi receiver: listener FEDERATION_PORT. onTelemetry({ station, deviceId, seq,
+ * connectionType, receivedAt, data }) dipanggil sekali per record baru, urut per device.
+ */
+function createFederationServer({ port, host = '0.0.0.0', onTelemetry }) {
+    const origins = new Map(); // station -> { epoch, lastSeq: Map(device -> seq) }
+    const stats = { connections: 0, activeConnections: 0, received: 0, duplicates: 0, errors: 0 };
+
+    const server = net.createServer((socket) => {
+        const inflate = zlib.createInflateRaw();
+        let origin = null;
+        let clockOffset = Infinity;
+        let ackTimer = null;
+        stats.connections++;
+        stats.activeConnections++;
+
+        const sendAck = () => {
+            if (origin) socket.write(`${JSON.stringify({ type: 'ack', lastSeq: Object.fromEntries(origin.lastSeq) })}\n`);
+        };
+
+        socket.setNoDelay(true);
+        socket.setKeepAlive(true, 5000);
+        socket.setTimeout(IDLE_TIMEOUT_MS, () => socket.destroy());
+        socket.pipe(inflate);
+        inflate.setEncoding('utf8');
+
+        inflate.on('data', lineReader((message) => {
+            if (message.type === 'hello') {
+                const station = String(message.station);
+                let state = origins.get(station);
+                if (!state || state.epoch !== message.epoch) {
+                    // Origin baru atau restart (seq mulai dari 1 lagi)
+                    state = { epoch: message.epoch, lastSeq: new Map() };
+                    origins.set(station, state);
+                }
+                origin = { station, lastSeq: state.lastSeq };
+                clockOffset = Date.now() - message.now;
+                console.log(`🛰️ [FEDERATION] Station ${station} connected from ${socket.remoteAddress}`);
+                socket.write(`${JSON.stringify({ type: 'resume', epoch: state.epoch, lastSeq: Object.fromEntries(state.lastSeq) })}\n`);
+                ackTimer = setInterval(sendAck, ACK_INTERVAL_MS);
+                return;
+            }
+            if (!origin || message.type === 'ping') return;
+
+            const last = origin.lastSeq.get(message.d) || 0;
+            if (message.q <= last) {
+                stats.duplicates++;
+                return;
+            }
+            origin.lastSeq.set(message.d, message.q);
+            // Batas atas latensi jaringan + beda jam; minimum = estimasi beda jam terbaik
+            clockOffset = Math.min(clockOffset, Date.now() - message.a);
+            stats.received++;
+            onTelemetry({
+                station: origin.station,
+                deviceId: message.d,
+                seq: message.q,
+                connectionType: message.c,
+                receivedAt: Math.min(message.a + clockOffset, Date.now()),
+                data: message.p
+            });
+        }, () => {
+            stats.errors++;
+            socket.destroy();
+        }));
+
+        inflate.on('error', () => {
+            stats.errors++;
+            socket.destroy();
+        });
+        socket.on('error', () => socket.destroy());
+        socket.on('close', () => {
+            clearInterval(ackTimer);
+            stats.activeConnections--;
+            if (origin) console.log(`🔄 [FEDERATION] Station ${origin.station} disconnected`);
+        });
+    });
+
+    server.federationStats = () => ({
+        ...stats,
+        stations: Object.fromEntries([...origins].map(([station, state]) => [station, Object.fromEntries(state.lastSeq)]))
+    });
+    server.listen(port, host);
+    return server;
+}
+
+module.exports = { FederationUplink, createFederationServer, parsePeers };
@@ -0,0 +1,152 @@
+/**
+ * Credit-Based Flow Control
+ * Server memberi setiap device jendela kredit (frame + bytes). Kredit bersifat
+ * kumulatif terhadap packet_number device: device boleh kirim paket n selama
+ * n < credit_limit, sehingga ack yang hilang tidak pernah mengunci device.
+ * Besar jendela mengecil saat server overload (event loop lag / Socket.IO buffer).
+ */
+
+const { monitorEventLoopDelay } = require('perf_hooks');
+
+const LOAD_LEVELS = ['normal', 'elevated', 'overloaded'];
+
+const DEFAULT_OPTIONS = {
+    windowFrames: 8,            // Frame in-flight saat normal
+    windowBytes: 8192,          // Bytes per grant saat normal
+    baseIntervalMs: 0,          // 0 = device pakai interval sendiri
+    elevatedIntervalMs: 5000,   // Hint interval kirim saat elevated
+    overloadedIntervalMs: 10000,
+    lagElevatedMs: 50,
+    lagOverloadedMs: 200,
+    bufferElevated: 100,        // Paket antre di semua socket dashboard
+    bufferOverloaded: 1000
+};
+
+class FlowController {
+    constructor(options = {}) {
+        this.options = { ...DEFAULT_OPTIONS, ...options };
+        this.devices = new Map();
+        this.load = { level: 0, eventLoopLagMs: 0, eventLoopLagP99Ms: 0, bufferedPackets: 0, updatedAt: Date.now() };
+
+        this.lagMonitor = monitorEventLoopDelay({ resolution: 20 });
+        this.lagMonitor.enable();
+    }
+
+    getDevice(deviceId) {
+        let device = this.devices.get(deviceId);
+        if (!device) {
+            device = {
+                framesReceived: 0,
+                bytesReceived: 0,
+                creditLimit: 0,
+                lastPacketNumber: -1,
+                creditStalls: 0,        // Dilaporkan device (punya data, kredit habis)
+                overruns: 0,            // Frame datang melebihi credit_limit
+                grantsSent: 0,
+                lastGrantAt: null
+            };
+            this.devices.set(deviceId, device);
+        }
+        return device;
+    }
+
+    /**
+     * Catat satu frame dari device dan kembalikan grant terbaru untuk di-ack.
+     */
+    onFrame(deviceId, packetNumber, bytes, reportedStalls) {
+        const device = this.getDevice(deviceId);
+        const sequence = Number.isInteger(packetNumber) ? packetNumber : device.lastPacketNumber + 1;
+
+        // Device reboot / reconnect: sequence mulai dari awal lagi
+        if (sequence < device.lastPacketNumber) {
+            device.creditLimit = 0;
+        }
+
+        if (device.creditLimit > 0 && sequence >= device.creditLimit) {
+            device.overruns++;
+        }
+
+        device.framesReceived++;
+        device.bytesReceived += bytes;
+        device.lastPacketNumber = sequence;
+        if (Number.isFinite(reportedStalls) && reportedStalls >= device.creditStalls) {
+            device.creditStalls = reportedStalls;
+        }
+
+        return this.grant(deviceId);
+    }
+
+    grant(deviceId) {
+        const device = this.getDevice(deviceId);
+        const { level } = this.load;
+        const o = this.options;
+
+        // Overload: jendela menyusut ke 1 frame + hint interval lebih lambat
+        const frames = level === 2 ? 1 : level === 1 ? Math.max(1, o.windowFrames >> 2) : o.windowFrames;
+        const bytes = level === 2 ? o.windowBytes >> 3 : level === 1 ? o.windowBytes >> 1 : o.windowBytes;
+        const interval = level === 2 ? o.overloadedIntervalMs : level === 1 ? o.elevatedIntervalMs : o.baseIntervalMs;
+
+        device.creditLimit = device.lastPacketNumber + 1 + frames;
+        device.grantsSent++;
+        device.lastGrantAt = Date.now();
+
+        return {
+            credit_limit: device.creditLimit,
+            credit_bytes: bytes,
+            interval_ms: interval,
+            load: LOAD_LEVELS[level]
+        };
+    }
+
+    /**
+     * Dipanggil periodik dengan jumlah paket yang antre di socket dashboard.
+     * Mengembalikan true jika level load berubah.
+     */
+    updateLoad(bufferedPackets) {
+        const o = this.options;
+        const lagMs = this.lagMonitor.mean / 1e6;
+        const lagP99Ms = this.lagMonitor.percentile(99) / 1e6;
+        this.lagMonitor.reset();
+
+        let level = 0;
+        if (lagMs > o.lagOverloadedMs || bufferedPackets > o.bufferOverloaded) {
+            level = 2;
+        } else if (lagMs > o.lagElevatedMs || bufferedPackets > o.bufferElevated) {
+            level = 1;
+        }
+
+        const changed = level !== this.load.level;
+        this.load = {
+            level,
+            eventLoopLagMs: Number.isFinite(lagMs) ? Math.round(lagMs * 100) / 100 : 0,
+            eventLoopLagP99Ms: Number.isFinite(lagP99Ms) ? Math.round(lagP99Ms * 100) / 100 : 0,
+            bufferedPackets,
+            updatedAt: Date.now()
+        };
+        return changed;
+    }
+
+    // Hanya level 'overloaded'; saat 'elevated' cukup jendela kredit yang mengecil,
+    // broadcast ke dashboard tetap reliable
+    isOverloaded() {
+        return this.load.level === 2;
+    }
+
+    getStats() {
+        const devices = {};
+        for (const [deviceId, device] of this.devices) {
+            devices[deviceId] = { ...device };
+        }
+        return {
+            load: { ...this.load, level: LOAD_LEVELS[this.load.level] },
+            window: { frames: this.options.windowFrames, bytes: this.options.windowBytes },
+            devices
+        };
+    }
+
+    stop() {
+        this.lagMonitor.disable();
+    }
+}
+
+module.exports = { FlowController };
@@ -0,0 +1,442 @@
+/**
+ * Geofence Engine
+ * Zona poligon (area terbang 'allowed' dan 'no_fly') diproyeksikan ke bidang lokal
+ * (meter) lalu dimasukkan ke grid uniform. Tiap cell menyimpan, per zona yang
+ * menyentuhnya, status inside di titik referensi cell + edge yang memotong cell.
+ * Cek satu titik GPS = lookup cell + uji silang segmen (ref -> titik) dengan edge
+ * di cell itu saja, jadi biayanya tidak tumbuh dengan jumlah zona.
+ *
+ * Kernel uji paritas yang sama tersedia native (native/geofence.cpp, hasil identik) dan
+ * dipakai dengan GEOFENCE_NATIVE=1 jika geofence.node sudah di-build. Default tetap JS:
+ * satu titik per panggilan, dan overhead panggilan Node-API lebih besar dari kerja per cell
+ * (benchmarks/server-bench.js: JS ~160 vs native ~270 ns/titik dengan 10 zona).
+ *
+ * Definisi zona (JSON array) atau GeoJSON FeatureCollection (Polygon / MultiPolygon):
+ *   { id, name?, kind: 'allowed' | 'no_fly', polygon: [[lat, lon], ...] | [ring, ...] }
+ *   ring pertama = batas luar, ring berikutnya = lubang (aturan even-odd)
+ */
+
+const fs = require('fs');
+const path = require('path');
+
+const METERS_PER_DEGREE = 111320;
+const KINDS = ['allowed', 'no_fly'];
+const MAX_CELLS = 1 << 18;
+const CELLS_PER_EDGE = 4;
+// Titik referensi di dalam cell sengaja tidak di tengah/sudut agar tidak segaris vertex "bulat"
+const REF_FRACTION_X = 0.4137;
+const REF_FRACTION_Y = 0.5821;
+
+function loadNative() {
+    if (process.env.GEOFENCE_NATIVE !== '1') return null;
+    try {
+        return require(path.join(__dirname, '..', 'native', 'build', 'geofence.node'));
+    } catch (error) {
+        return null;
+    }
+}
+
+const native = loadNative();
+
+function toRings(polygon, id) {
+    if (!Array.isArray(polygon) || polygon.length === 0) throw new Error(`Zone ${id}: missing polygon`);
+    const rings = typeof polygon[0][0] === 'number' ? [polygon] : polygon;
+    for (const ring of rings) {
+        if (!Array.isArray(ring) || ring.length < 3) throw new Error(`Zone ${id}: ring needs at least 3 points`);
+        for (const point of ring) {
+            if (!Array.isArray(point) || !Number.isFinite(point[0]) || !Number.isFinite(point[1]) ||
+                Math.abs(point[0]) > 90 || Math.abs(point[1]) > 180) {
+                throw new Error(`Zone ${id}: invalid point ${JSON.stringify(point)}`);
+            }
+        }
+    }
+    return rings;
+}
+
+// GeoJSON memakai urutan [lon, lat]; definisi internal [lat, lon]
+function fromGeoJson(collection) {
+    return (collection.features || []).map((feature, index) => {
+        const properties = feature.properties || {};
+        const geometry = feature.geometry || {};
+        const swap = (ring) => ring.map(([lon, lat]) => [lat, lon]);
+        let rings;
+        if (geometry.type === 'Polygon') rings = geometry.coordinates.map(swap);
+        else if (geometry.type === 'MultiPolygon') rings = geometry.coordinates.flat().map(swap);
+        else throw new Error(`Feature #${index}: unsupported geometry '${geometry.type}'`);
+        return {
+            id: String(properties.id ?? feature.id ?? `zone_${index}`),
+            name: properties.name,
+            kind: properties.kind || properties.type,
+            polygon: rings
+        };
+    });
+}
+
+function normalizeZones(definitions) {
+    if (definitions && definitions.type === 'FeatureCollection') definitions = fromGeoJson(definitions);
+    if (!Array.isArray(definitions)) throw new Error('Geofence zones must be an array or a GeoJSON FeatureCollection');
+
+    const seen = new Set();
+    return definitions.map((definition, index) => {
+        const { id, name, kind = 'allowed', polygon } = definition || {};
+        if (typeof id !== 'string' || !id) throw new Error(`Zone #${index}: missing id`);
+        if (seen.has(id)) throw new Error(`Duplicate zone id '${id}'`);
+        if (!KINDS.includes(kind)) throw new Error(`Zone ${id}: unknown kind '${kind}'`);
+        seen.add(id);
+        return { id, name: name || id, kind, rings: toRings(polygon, id) };
+    });
+}
+
+function loadZoneFile(file) {
+    return normalizeZones(JSON.parse(fs.readFileSync(file, 'utf8')));
+}
+
+function orient(ax, ay, bx, by, px, py) {
+    return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+}
+
+function pointSegmentDistance(px, py, ax, ay, bx, by) {
+    const dx = bx - ax;
+    const dy = by - ay;
+    const lengthSq = dx * dx + dy * dy;
+    let t = lengthSq > 0 ? ((px - ax) * dx + (py - ay) * dy) / lengthSq : 0;
+    t = t < 0 ? 0 : t > 1 ? 1 : t;
+    const ex = ax + t * dx - px;
+    const ey = ay + t * dy - py;
+    return Math.sqrt(ex * ex + ey * ey);
+}
+
+// Liang-Barsky: apakah segmen menyentuh persegi (tertutup, diperlebar epsilon)
+function segmentTouchesRect(ax, ay, bx, by, minX, minY, maxX, maxY) {
+    const epsilon = 1e-6;
+    minX -= epsilon; minY -= epsilon; maxX += epsilon; maxY += epsilon;
+    const dx = bx - ax;
+    const dy = by - ay;
+    let t0 = 0;
+    let t1 = 1;
+    const clip = (p, q) => {
+        if (p === 0) return q >= 0;
+        const r = q / p;
+        if (p < 0) { if (r > t1) return false; if (r > t0) t0 = r; }
+        else { if (r < t0) return false; if (r < t1) t1 = r; }
+        return true;
+    };
+    return clip(-dx, ax - minX) && clip(dx, maxX - ax) && clip(-dy, ay - minY) && clip(dy, maxY - ay);
+}
+
+class GeofenceEngine {
+    constructor(zones = []) {
+        this.zones = zones.map((zone, index) => ({ ...zone, index }));
+        // State awal device: dianggap di dalam semua area terbang, jadi fix pertama
+        // di luar area langsung menghasilkan exit (violation), bukan diam saja
+        this.allowedZones = this.zones.filter((zone) => zone.kind === 'allowed').map((zone) => zone.index);
+        this.devices = new Map();
+        this.stats = { points: 0, entries: 0, exits: 0, violations: 0 };
+        this.build();
+    }
+
+    build() {
+        const zones = this.zones;
+        let minLat = Infinity, maxLat = -Infinity, minLon = Infinity, maxLon = -Infinity;
+        let edgeCount = 0;
+        for (const zone of zones) {
+            for (const ring of zone.rings) {
+                edgeCount += ring.length;
+                for (const [lat, lon] of ring) {
+                    if (lat < minLat) minLat = lat;
+                    if (lat > maxLat) maxLat = lat;
+                    if (lon < minLon) minLon = lon;
+                    if (lon > maxLon) maxLon = lon;
+                }
+            }
+        }
+
+        this.edgeCount = edgeCount;
+        if (zones.length === 0) {
+            this.cols = this.rows = 0;
+            return;
+        }
+
+        // Proyeksi equirectangular di sekitar pusat semua zona (cukup akurat untuk area beberapa km)
+        this.originLat = (minLat + maxLat) / 2;
+        this.originLon = (minLon + maxLon) / 2;
+        this.metersPerLat = METERS_PER_DEGREE;
+        this.metersPerLon = METERS_PER_DEGREE * Math.cos(this.originLat * Math.PI / 180);
+
+        // Edge disimpan flat: [ax, ay, bx, by] per edge
+        const edges = new Float64Array(edgeCount * 4);
+        let edge = 0;
+        for (const zone of zones) {
+            zone.edgeStart = edge;
+            zone.minX = zone.minY = Infinity;
+            zone.maxX = zone.maxY = -Infinity;
+            for (const ring of zone.rings) {
+                for (let i = 0; i < ring.length; i++) {
+                    const [ax, ay] = this.project(ring[i][0], ring[i][1]);
+                    const [bx, by] = this.project(ring[(i + 1) % ring.length][0], ring[(i + 1) % ring.length][1]);
+                    edges.set([ax, ay, bx, by], edge * 4);
+                    edge++;
+                    zone.minX = Math.min(zone.minX, ax);
+                    zone.maxX = Math.max(zone.maxX, ax);
+                    zone.minY = Math.min(zone.minY, ay);
+                    zone.maxY = Math.max(zone.maxY, ay);
+                }
+            }
+            zone.edgeEnd = edge;
+        }
+        this.edges = edges;
+
+        const [minX, minY] = this.project(minLat, minLon);
+        const [maxX, maxY] = this.project(maxLat, maxLon);
+        const width = Math.max(maxX - minX, 1);
+        const height = Math.max(maxY - minY, 1);
+        const targetCells = Math.min(MAX_CELLS, Math.max(64, edgeCount * CELLS_PER_EDGE));
+        let cellSize = Math.sqrt(width * height / targetCells);
+        cellSize = Math.max(cellSize, width / 4096, height / 4096, 0.5);
+
+        this.cellSize = cellSize;
+        this.minX = minX;
+        this.minY = minY;
+        this.cols = Math.floor(width / cellSize) + 1;
+        this.rows = Math.floor(height / cellSize) + 1;
+        this.buildCells();
+    }
+
+    buildCells() {
+        const { cols, rows, cellSize, minX, minY, edges } = this;
+        const cellEntries = new Array(cols * rows);
+
+        for (const zone of this.zones) {
+            const col0 = Math.max(0, Math.floor((zone.minX - minX) / cellSize));
+            const col1 = Math.min(cols - 1, Math.floor((zone.maxX - minX) / cellSize));
+            const row0 = Math.max(0, Math.floor((zone.minY - minY) / cellSize));
+            const row1 = Math.min(rows - 1, Math.floor((zone.maxY - minY) / cellSize));
+
+            // Edge zona per cell (hanya cell yang benar-benar dipotong edge)
+            const cellEdges = new Map();
+            for (let e = zone.edgeStart; e < zone.edgeEnd; e++) {
+                const ax = edges[e * 4], ay = edges[e * 4 + 1], bx = edges[e * 4 + 2], by = edges[e * 4 + 3];
+                const c0 = Math.max(col0, Math.floor((Math.min(ax, bx) - minX) / cellSize));
+                const c1 = Math.min(col1, Math.floor((Math.max(ax, bx) - minX) / cellSize));
+                const r0 = Math.max(row0, Math.floor((Math.min(ay, by) - minY) / cellSize));
+                const r1 = Math.min(row1, Math.floor((Math.max(ay, by) - minY) / cellSize));
+                for (let row = r0; row <= r1; row++) {
+                    for (let col = c0; col <= c1; col++) {
+                        const x = minX + col * cellSize;
+                        const y = minY + row * cellSize;
+                        if (!segmentTouchesRect(ax, ay, bx, by, x, y, x + cellSize, y + cellSize)) continue;
+                        const cell = row * cols + col;
+                        if (!cellEdges.has(cell)) cellEdges.set(cell, []);
+                        cellEdges.get(cell).push(e);
+                    }
+                }
+            }
+
+            // Status inside titik referensi: scanline per baris (semua ref di satu baris punya y sama)
+            for (let row = row0; row <= row1; row++) {
+                const refY = minY + (row + REF_FRACTION_Y) * cellSize;
+                const crossings = [];
+                for (let e = zone.edgeStart; e < zone.edgeEnd; e++) {
+                    const ax = edges[e * 4], ay = edges[e * 4 + 1], bx = edges[e * 4 + 2], by = edges[e * 4 + 3];
+                    if ((ay > refY) !== (by > refY)) crossings.push(ax + (refY - ay) * (bx - ax) / (by - ay));
+                }
+                crossings.sort((a, b) => a - b);
+
+                let crossed = 0;
+                for (let col = col0; col <= col1; col++) {
+                    const refX = minX + (col + REF_FRACTION_X) * cellSize;
+                    while (crossed < crossings.length && crossings[crossed] < refX) crossed++;
+                    const cell = row * cols + col;
+                    const inside = (crossed & 1) === 1;
+                    const zoneEdges = cellEdges.get(cell);
+                    if (!inside && !zoneEdges) continue;
+                    if (!cellEntries[cell]) cellEntries[cell] = [];
+                    cellEntries[cell].push({ zone: zone.index, inside, edges: zoneEdges || [] });
+                }
+            }
+        }
+
+        // Flatten ke typed array (CSR): cell -> entry -> edge
+        let entryCount = 0;
+        let edgeRefCount = 0;
+        for (const entries of cellEntries) {
+            if (!entries) continue;
+            entryCount += entries.length;
+            for (const entry of entries) edgeRefCount += entry.edges.length;
+        }
+        this.cellStart = new Int32Array(cols * rows + 1);
+        this.entryZone = new Int32Array(entryCount);
+        this.entryInside = new Uint8Array(entryCount);
+        this.entryEdgeStart = new Int32Array(entryCount + 1);
+        this.entryEdges = new Int32Array(edgeRefCount);
+
+        let entry = 0;
+        let edgeRef = 0;
+        for (let cell = 0; cell < cols * rows; cell++) {
+            this.cellStart[cell] = entry;
+            for (const item of cellEntries[cell] || []) {
+                this.entryZone[entry] = item.zone;
+                this.entryInside[entry] = item.inside ? 1 : 0;
+                this.entryEdgeStart[entry] = edgeRef;
+                for (const e of item.edges) this.entryEdges[edgeRef++] = e;
+                entry++;
+            }
+        }
+        this.cellStart[cols * rows] = entry;
+        this.entryEdgeStart[entry] = edgeRef;
+
+        if (native) {
+            // lat/lon masuk dan index zona keluar lewat buffer tetap (lihat native/geofence.cpp)
+            this.nativeIo = new Float64Array(2);
+            this.nativeZones = new Int32Array(this.zones.length);
+            this.nativeIndex = native.attach(this.cellStart, this.entryZone, this.entryInside, this.entryEdgeStart,
+                this.entryEdges, this.edges, Float64Array.of(this.originLat, this.originLon, this.metersPerLat,
+                    this.metersPerLon, minX, minY, cellSize, cols, rows), this.nativeIo, this.nativeZones);
+        }
+    }
+
+    project(lat, lon) {
+        return [(lon - this.originLon) * this.metersPerLon, (lat - this.originLat) * this.metersPerLat];
+    }
+
+    /**
+     * Index zona yang memuat titik (lat, lon).
+     */
+    locate(lat, lon, out = []) {
+        out.length = 0;
+        if (this.cols === 0) return out;
+        if (this.nativeIndex) {
+            this.nativeIo[0] = lat;
+            this.nativeIo[1] = lon;
+            const count = native.locate(this.nativeIndex);
+            for (let i = 0; i < count; i++) out.push(this.nativeZones[i]);
+            return out;
+        }
+        return this.locateJs(lat, lon, out);
+    }
+
+    // Jalur JS tanpa addon; semantik sama dengan locatePoint di native/geofence.cpp
+    locateJs(lat, lon, out) {
+
+        const x = (lon - this.originLon) * this.metersPerLon;
+        const y = (lat - this.originLat) * this.metersPerLat;
+        const col = Math.floor((x - this.minX) / this.cellSize);
+        const row = Math.floor((y - this.minY) / this.cellSize);
+        if (col < 0 || row < 0 || col >= this.cols || row >= this.rows) return out;
+
+        const cell = row * this.cols + col;
+        const refX = this.minX + (col + REF_FRACTION_X) * this.cellSize;
+        const refY = this.minY + (row + REF_FRACTION_Y) * this.cellSize;
+        const edges = this.edges;
+
+        for (let entry = this.cellStart[cell]; entry < this.cellStart[cell + 1]; entry++) {
+            let inside = this.entryInside[entry];
+            // Paritas perpotongan segmen ref -> titik dengan edge zona di cell ini.
+            // Vertex tepat di garis dihitung sebagai sisi negatif (perturbasi simbolik) agar konsisten.
+            for (let k = this.entryEdgeStart[entry]; k < this.entryEdgeStart[entry + 1]; k++) {
+                const e = this.entryEdges[k] * 4;
+                const ax = edges[e], ay = edges[e + 1], bx = edges[e + 2], by = edges[e + 3];
+                if ((orient(refX, refY, x, y, ax, ay) > 0) !== (orient(refX, refY, x, y, bx, by) > 0) &&
+                    (orient(ax, ay, bx, by, refX, refY) > 0) !== (orient(ax, ay, bx, by, x, y) > 0)) {
+                    inside ^= 1;
+                }
+            }
+            if (inside) out.push(this.entryZone[entry]);
+        }
+        return out;
+    }
+
+    // Jarak (meter) ke batas zona; hanya dihitung saat transisi, O(edge zona)
+    distanceToBoundary(zoneIndex, lat, lon) {
+        const zone = this.zones[zoneIndex];
+        const [x, y] = this.project(lat, lon);
+        const edges = this.edges;
+        let best = Infinity;
+        for (let e = zone.edgeStart; e < zone.edgeEnd; e++) {
+            const distance = pointSegmentDistance(x, y, edges[e * 4], edges[e * 4 + 1], edges[e * 4 + 2], edges[e * 4 + 3]);
+            if (distance < best) best = distance;
+        }
+        return best;
+    }
+
+    /**
+     * Evaluasi satu posisi GPS; return event transisi (enter / exit) per zona.
+     */
+    evaluate(deviceId, lat, lon, now = Date.now()) {
+        const events = [];
+        if (this.zones.length === 0) return events;
+        // Tanpa fix GPS firmware mengirim 0,0
+        if (!Number.isFinite(lat) || !Number.isFinite(lon) || (lat === 0 && lon === 0)) return events;
+
+        let device = this.devices.get(deviceId);
+        if (!device) {
+            device = { inside: this.allowedZones.slice(), scratch: [], latitude: lat, longitude: lon };
+            this.devices.set(deviceId, device);
+        }
+        this.stats.points++;
+
+        const current = this.locate(lat, lon, device.scratch);
+        const previous = device.inside;
+        device.latitude = lat;
+        device.longitude = lon;
+
+        // Jumlah zona yang memuat satu titik kecil, diff linear cukup
+        if (current.length === previous.length && current.every((zone, i) => zone === previous[i])) return events;
+        for (const zone of previous) {
+            if (!current.includes(zone)) events.push(this.buildEvent(deviceId, zone, 'exit', lat, lon, now));
+        }
+        for (const zone of current) {
+            if (!previous.includes(zone)) events.push(this.buildEvent(deviceId, zone, 'enter', lat, lon, now));
+        }
+        device.inside = current.slice();
+        return events;
+    }
+
+    buildEvent(deviceId, zoneIndex, transition, lat, lon, now) {
+        const zone = this.zones[zoneIndex];
+        const violation = (zone.kind === 'no_fly') === (transition === 'enter');
+        if (transition === 'enter') this.stats.entries++;
+        else this.stats.exits++;
+        if (violation) this.stats.violations++;
+
+        return {
+            zone: zone.id,
+            name: zone.name,
+            kind: zone.kind,
+            device_id: deviceId,
+            event: transition,
+            violation,
+            distance_m: Math.round(this.distanceToBoundary(zoneIndex, lat, lon) * 10) / 10,
+            latitude: lat,
+            longitude: lon,
+            timestamp: new Date(now).toISOString()
+        };
+    }
+
+    getZones() {
+        return this.zones.map(({ id, name, kind, rings }) => ({ id, name, kind, polygon: rings }));
+    }
+
+    getDevices() {
+        return [...this.devices.entries()].map(([deviceId, device]) => ({
+            device_id: deviceId,
+            zones: device.inside.map((zone) => this.zones[zone].id),
+            latitude: device.latitude,
+            longitude: device.longitude
+        }));
+    }
+
+    getStats() {
+        return {
+            ...this.stats,
+            zones: this.zones.length,
+            edges: this.edgeCount,
+            cells: this.cols * this.rows,
+            cell_size_m: this.cellSize ? Math.round(this.cellSize * 10) / 10 : 0,
+            kernel: this.nativeIndex ? 'native' : 'js',
+            devices: this.devices.size
+        };
+    }
+}
+
+module.exports = { GeofenceEngine, normalizeZones, loadZoneFile };
@@ -0,0 +1,357 @@
+/**
+ * Telemetry History Store
+ * Histori telemetry per device disimpan kolumnar dalam chunk berisi CHUNK_ROWS
+ * baris (satu typed array per kolom), sehingga export CSV/Parquet bisa membaca
+ * langsung per kolom tanpa menyalin. Chunk terbuka mulai kecil (INITIAL_CHUNK_ROWS)
+ * dan tumbuh 2x sampai CHUNK_ROWS. Retention dibatasi per device (maxRows), total
+ * (maxTotalRows, chunk tertua dibuang dulu) dan jumlah device (maxDevices, device
+ * yang paling lama tidak mengirim dibuang) karena device_id datang dari klien.
+ *
+ * Persistensi opsional (dir): chunk yang penuh ditulis sebagai file biner
+ *   <dir>/<device>/<timestamp awal>.bin  = 'UAVH' | versi u8 | kolom u8 | rows u32 LE | data kolom
+ * dan dimuat ulang saat server start. Kolom baru hanya ditambah di akhir; file lama
+ * dengan kolom lebih sedikit diisi nilai missing kolom tersebut.
+ */
+
+const fs = require('fs');
+const path = require('path');
+const os = require('os');
+
+// Urutan kolom = urutan di file chunk dan export; GPS + timestamp butuh presisi double
+const COLUMNS = [
+    { name: 'timestamp', array: Float64Array },
+    { name: 'battery_voltage', array: Float32Array },
+    { name: 'battery_current', array: Float32Array },
+    { name: 'battery_power', array: Float32Array },
+    { name: 'temperature', array: Float32Array },
+    { name: 'humidity', array: Float32Array },
+    { name: 'gps_latitude', array: Float64Array },
+    { name: 'gps_longitude', array: Float64Array },
+    { name: 'altitude', array: Float32Array },
+    { name: 'signal_strength', array: Float32Array },
+    { name: 'satellites', array: Float32Array },
+    { name: 'packet_number', array: Float64Array },
+    // Bit per field dari AnomalyDetector (0 = normal); ditambahkan belakangan, jadi file lama tanpa kolom ini
+    { name: 'anomaly_flags', array: Float32Array, missing: 0 }
+];
+
+const CHUNK_ROWS = 4096;
+const FLAGS_COLUMN = COLUMNS.findIndex((column) => column.name === 'anomaly_flags');
+const INITIAL_CHUNK_ROWS = 64;
+const DEFAULT_MAX_DEVICES = 64;
+const FILE_MAGIC = 'UAVH';
+const FILE_VERSION = 1;
+const FILE_HEADER_BYTES = 10;
+const LITTLE_ENDIAN = os.endianness() === 'LE';
+
+function createChunk(start, capacity = INITIAL_CHUNK_ROWS) {
+    return {
+        start,
+        end: start,
+        rows: 0,
+        capacity,
+        sealed: false,
+        file: null,
+        columns: COLUMNS.map((column) => new column.array(capacity))
+    };
+}
+
+// Kolom diganti array baru; slice yang sudah diambil tetap valid karena baris lama ikut disalin
+function growChunk(chunk) {
+    chunk.capacity = Math.min(chunk.capacity * 2, CHUNK_ROWS);
+    chunk.columns = chunk.columns.map((array) => {
+        const grown = new array.constructor(chunk.capacity);
+        grown.set(array.subarray(0, chunk.rows));
+        return grown;
+    });
+}
+
+// Byte mentah kolom (little-endian) untuk file chunk dan Parquet PLAIN encoding
+function columnBytes(array, from, to) {
+    const view = Buffer.from(array.buffer, array.byteOffset + from * array.BYTES_PER_ELEMENT,
+        (to - from) * array.BYTES_PER_ELEMENT);
+    if (LITTLE_ENDIAN) return view;
+    const copy = Buffer.from(view);
+    if (array.BYTES_PER_ELEMENT === 8) copy.swap64(); else copy.swap32();
+    return copy;
+}
+
+function encodeChunk(chunk) {
+    const header = Buffer.alloc(FILE_HEADER_BYTES);
+    header.write(FILE_MAGIC, 0, 'ascii');
+    header.writeUInt8(FILE_VERSION, 4);
+    header.writeUInt8(COLUMNS.length, 5);
+    header.writeUInt32LE(chunk.rows, 6);
+    return Buffer.concat([header, ...chunk.columns.map((array) => columnBytes(array, 0, chunk.rows))]);
+}
+
+function decodeChunk(buffer) {
+    if (buffer.length < FILE_HEADER_BYTES || buffer.toString('ascii', 0, 4) !== FILE_MAGIC) throw new Error('bad magic');
+    const count = buffer.readUInt8(5);
+    if (buffer.readUInt8(4) !== FILE_VERSION || count > COLUMNS.length) throw new Error('unsupported version');
+    const rows = buffer.readUInt32LE(6);
+    if (rows === 0 || rows > CHUNK_ROWS) throw new Error(`bad row count ${rows}`);
+
+    const chunk = createChunk(0, rows);
+    let offset = FILE_HEADER_BYTES;
+    COLUMNS.forEach((column, index) => {
+        if (index >= count) {
+            chunk.columns[index].fill(column.missing ?? NaN, 0, rows);
+            return;
+        }
+        const bytes = rows * column.array.BYTES_PER_ELEMENT;
+        if (offset + bytes > buffer.length) throw new Error('truncated');
+        const source = Buffer.from(buffer.subarray(offset, offset + bytes));
+        if (!LITTLE_ENDIAN) {
+            if (column.array.BYTES_PER_ELEMENT === 8) source.swap64(); else source.swap32();
+        }
+        chunk.columns[index].set(new column.array(source.buffer, source.byteOffset, rows));
+        offset += bytes;
+    });
+    chunk.rows = rows;
+    chunk.start = chunk.columns[0][0];
+    chunk.end = chunk.columns[0][rows - 1];
+    chunk.sealed = true;
+    return chunk;
+}
+
+// Index baris pertama dengan timestamp >= t (timestamp server monoton naik)
+function lowerBound(timestamps, rows, t) {
+    let low = 0;
+    let high = rows;
+    while (low < high) {
+        const mid = (low + high) >>> 1;
+        if (timestamps[mid] < t) low = mid + 1; else high = mid;
+    }
+    return low;
+}
+
+class HistoryStore {
+    constructor(options = {}) {
+        this.maxRows = options.maxRows || 1 << 20;
+        this.maxTotalRows = options.maxTotalRows || this.maxRows * 4;
+        this.maxDevices = options.maxDevices || DEFAULT_MAX_DEVICES;
+        this.dir = options.dir || null;
+        this.devices = new Map();
+        this.totalRows = 0;
+        this.stats = { rows: 0, chunksWritten: 0, writeErrors: 0, evictedChunks: 0, evictedDevices: 0 };
+        if (this.dir) this.load();
+    }
+
+    deviceFor(deviceId, now = Date.now()) {
+        let device = this.devices.get(deviceId);
+        if (!device) {
+            if (this.devices.size >= this.maxDevices) this.evictDevice(deviceId);
+            device = { chunks: [], rows: 0, lastSeen: now };
+            this.devices.set(deviceId, device);
+        }
+        return device;
+    }
+
+    // Device yang paling lama tidak append dibuang seluruhnya (termasuk file chunk-nya)
+    evictDevice(exceptId) {
+        let oldestId = null;
+        let oldestSeen = Infinity;
+        for (const [deviceId, device] of this.devices) {
+            if (deviceId !== exceptId && device.lastSeen < oldestSeen) {
+                oldestId = deviceId;
+                oldestSeen = device.lastSeen;
+            }
+        }
+        if (oldestId === null) return;
+        const device = this.devices.get(oldestId);
+        this.devices.delete(oldestId);
+        this.totalRows -= device.rows;
+        this.stats.evictedDevices++;
+        this.stats.evictedChunks += device.chunks.length;
+        for (const chunk of device.chunks) {
+            if (chunk.file) fs.promises.unlink(chunk.file).catch(() => {});
+        }
+    }
+
+    append(deviceId, data, now = Date.now()) {
+        const device = this.deviceFor(deviceId, now);
+        device.lastSeen = now;
+        let chunk = device.chunks[device.chunks.length - 1];
+        if (chunk && !chunk.sealed && chunk.rows === CHUNK_ROWS) {
+            // Chunk penuh baru di-seal saat baris berikutnya datang, supaya markFlags
+            // masih bisa menandai baris terakhirnya sebelum ditulis ke file
+            this.seal(deviceId, chunk);
+        }
+        if (!chunk || chunk.sealed) {
+            chunk = createChunk(now);
+            device.chunks.push(chunk);
+        } else if (chunk.rows === chunk.capacity) {
+            growChunk(chunk);
+        }
+
+        const row = chunk.rows;
+        chunk.columns[0][row] = now;
+        for (let i = 1; i < COLUMNS.length; i++) {
+            const value = data[COLUMNS[i].name];
+            chunk.columns[i][row] = value === undefined || value === null ? COLUMNS[i].missing ?? NaN : Number(value);
+        }
+        chunk.rows++;
+        chunk.end = now;
+        device.rows++;
+        this.totalRows++;
+        this.stats.rows++;
+
+        this.evict(deviceId, device);
+        if (this.totalRows > this.maxTotalRows) this.evictOldest(chunk);
+    }
+
+    /**
+     * OR-kan bit anomaly_flags ke baris rowsBack dari akhir (1 = baris terakhir device),
+     * untuk anomali yang baru terkonfirmasi setelah barisnya disimpan (spike).
+     * Baris yang sudah dibuang atau ada di chunk yang sudah ditulis dilewati.
+     */
+    markFlags(deviceId, rowsBack, flags) {
+        const device = this.devices.get(deviceId);
+        if (!device || !(rowsBack >= 1)) return false;
+        for (let c = device.chunks.length - 1; c >= 0; c--) {
+            const chunk = device.chunks[c];
+            if (rowsBack <= chunk.rows) {
+                if (chunk.sealed) return false;
+                chunk.columns[FLAGS_COLUMN][chunk.rows - rowsBack] |= flags;
+                return true;
+            }
+            rowsBack -= chunk.rows;
+        }
+        return false;
+    }
+
+    seal(deviceId, chunk) {
+        chunk.sealed = true;
+        if (!this.dir) return;
+
+        const directory = path.join(this.dir, encodeURIComponent(deviceId));
+        chunk.file = path.join(directory, `${chunk.start}.bin`);
+        fs.promises.mkdir(directory, { recursive: true })
+            .then(() => fs.promises.writeFile(chunk.file, encodeChunk(chunk)))
+            .then(() => { this.stats.chunksWritten++; })
+            .catch((error) => {
+                this.stats.writeErrors++;
+                console.error(`❌ [HISTORY] Failed to write ${chunk.file}: ${error.message}`);
+            });
+    }
+
+    evict(deviceId, device) {
+        while (device.rows - device.chunks[0].rows >= this.maxRows) this.dropChunk(device);
+    }
+
+    dropChunk(device) {
+        const chunk = device.chunks.shift();
+        device.rows -= chunk.rows;
+        this.totalRows -= chunk.rows;
+        this.stats.evictedChunks++;
+        if (chunk.file) fs.promises.unlink(chunk.file).catch(() => {});
+    }
+
+    // Batas total: chunk tertua dari semua device dibuang, kecuali chunk yang sedang diisi
+    evictOldest(current) {
+        while (this.totalRows > this.maxTotalRows) {
+            let oldestId = null;
+            let oldest = null;
+            for (const [deviceId, device] of this.devices) {
+                const chunk = device.chunks[0];
+                if (chunk && chunk !== current && (!oldest || chunk.start < oldest.chunks[0].start)) {
+                    oldestId = deviceId;
+                    oldest = device;
+                }
+            }
+            if (!oldest) return;
+            this.dropChunk(oldest);
+            if (oldest.chunks.length === 0) this.devices.delete(oldestId);
+        }
+    }
+
+    // Chunk yang belum penuh ikut ditulis saat shutdown (sinkron)
+    flush() {
+        if (!this.dir) return;
+        for (const [deviceId, device] of this.devices) {
+            const chunk = device.chunks[device.chunks.length - 1];
+            if (!chunk || chunk.sealed || chunk.rows === 0) continue;
+            chunk.sealed = true;
+            try {
+                const directory = path.join(this.dir, encodeURIComponent(deviceId));
+                fs.mkdirSync(directory, { recursive: true });
+                chunk.file = path.join(directory, `${chunk.start}.bin`);
+                fs.writeFileSync(chunk.file, encodeChunk(chunk));
+                this.stats.chunksWritten++;
+            } catch (error) {
+                this.stats.writeErrors++;
+                console.error(`❌ [HISTORY] Failed to flush ${deviceId}: ${error.message}`);
+            }
+        }
+    }
+
+    load() {
+        if (!fs.existsSync(this.dir)) return;
+        for (const entry of fs.readdirSync(this.dir, { withFileTypes: true })) {
+            if (!entry.isDirectory()) continue;
+            const deviceId = decodeURIComponent(entry.name);
+            const directory = path.join(this.dir, entry.name);
+            const files = fs.readdirSync(directory).filter((file) => file.endsWith('.bin'))
+                .sort((a, b) => parseFloat(a) - parseFloat(b));
+            const device = this.deviceFor(deviceId, 0);
+
+            for (const file of files) {
+                try {
+                    const chunk = decodeChunk(fs.readFileSync(path.join(directory, file)));
+                    chunk.file = path.join(directory, file);
+                    device.chunks.push(chunk);
+                    device.rows += chunk.rows;
+                    device.lastSeen = chunk.end;
+                    this.totalRows += chunk.rows;
+                    this.evict(deviceId, device);
+                } catch (error) {
+                    console.error(`❌ [HISTORY] Skipping ${path.join(directory, file)}: ${error.message}`);
+                }
+            }
+            if (device.chunks.length === 0) this.devices.delete(deviceId);
+        }
+        this.evictOldest(null);
+    }
+
+    /**
+     * Potongan chunk dalam rentang waktu [from, to]: [{ chunk, begin, end }].
+     * Jumlah baris di-snapshot sekarang, jadi append berikutnya tidak ikut ter-export.
+     */
+    slices(deviceId, from = -Infinity, to = Infinity) {
+        const device = this.devices.get(deviceId);
+        if (!device) return [];
+        const result = [];
+        for (const chunk of device.chunks) {
+            if (chunk.rows === 0 || chunk.end < from || chunk.start > to) continue;
+            const timestamps = chunk.columns[0];
+            const begin = chunk.start >= from ? 0 : lowerBound(timestamps, chunk.rows, from);
+            const end = chunk.end <= to ? chunk.rows : lowerBound(timestamps, chunk.rows, to + 1);
+            if (end > begin) result.push({ chunk, begin, end });
+        }
+        return result;
+    }
+
+    getDevices() {
+        return [...this.devices.entries()].map(([deviceId, device]) => ({
+            device_id: deviceId,
+            rows: device.rows,
+            from: device.chunks.length ? new Date(device.chunks[0].start).toISOString() : null,
+            to: device.chunks.length ? new Date(device.chunks[device.chunks.length - 1].end).toISOString() : null
+        }));
+    }
+
+    getStats() {
+        let chunks = 0;
+        let bytes = 0;
+        for (const device of this.devices.values()) {
+            chunks += device.chunks.length;
+            for (const chunk of device.chunks) {
+                for (const array of chunk.columns) bytes += array.byteLength;
+            }
+        }
+        return { ...this.stats, devices: this.devices.size, totalRows: this.totalRows, chunks, memoryBytes: bytes, persistent: !!this.dir };
+    }
+}
+
+module.exports = { HistoryStore, COLUMNS, CHUNK_ROWS, columnBytes };
@@ -0,0 +1,293 @@
+/**
+ * Fast-path HTTP Ingest
+ * POST /api/telemetry tanpa Express (cors, body-parser, static, logging middleware):
+ *   - createIngestServer: listener sendiri (INGEST_PORT) di atas net.Socket dengan
+ *     parser HTTP/1.1 minimal dan buffer per koneksi yang dipakai ulang. Keep-alive
+ *     default, pipelining: semua request lengkap dalam satu segmen TCP diproses
+ *     berurutan dan response-nya digabung jadi satu write.
+ *   - handleHttpIngest: jalur yang sama untuk port utama (http.Server), dipasang
+ *     sebelum Express supaya firmware lama langsung ikut cepat.
+ * onTelemetry(body, remoteAddress) -> { status, body } dipanggil sinkron; body
+ * hanya valid selama panggilan itu (buffer koneksi dipakai ulang).
+ */
+
+const net = require('net');
+
+const INGEST_PATH = '/api/telemetry';
+const DEFAULT_MAX_BODY = 1024 * 1024; // Sama dengan limit express.json sebelumnya
+const MAX_HEADER_BYTES = 8 * 1024;
+const INITIAL_BUFFER = 4096;
+const IDLE_TIMEOUT_MS = 65000;
+
+const CRLFCRLF = Buffer.from('\r\n\r\n');
+const CONTINUE = 'HTTP/1.1 100 Continue\r\n\r\n';
+const REASONS = {
+    200: 'OK', 400: 'Bad Request', 404: 'Not Found', 411: 'Length Required', 413: 'Payload Too Large',
+    431: 'Request Header Fields Too Large', 500: 'Internal Server Error', 501: 'Not Implemented', 503: 'Service Unavailable'
+};
+const JSON_HEADERS = { 'Content-Type': 'application/json', 'Access-Control-Allow-Origin': '*' };
+
+// Status line + header statis per status; hanya Content-Length dan body yang berubah
+const RESPONSE_PREFIX = Object.fromEntries(Object.entries(REASONS).map(([status, reason]) => [status,
+    `HTTP/1.1 ${status} ${reason}\r\nContent-Type: application/json\r\nAccess-Control-Allow-Origin: *\r\nContent-Length: `]));
+
+const errorBody = (message) => JSON.stringify({ success: false, error: message });
+
+// Nama header (byte, case-insensitive) dibandingkan tanpa membuat string
+function headerNameIs(buffer, start, end, name) {
+    if (end - start !== name.length) return false;
+    for (let i = 0; i < name.length; i++) {
+        if ((buffer[start + i] | 0x20) !== name.charCodeAt(i)) return false;
+    }
+    return true;
+}
+
+function containsToken(buffer, start, end, token) {
+    return buffer.latin1Slice(start, end).toLowerCase().includes(token);
+}
+
+/**
+ * Parser request per koneksi. push(chunk) mengumpulkan data di buffer yang sama
+ * (tumbuh hanya jika request lebih besar), lalu next() mengembalikan request
+ * lengkap berikutnya atau null jika butuh data lagi.
+ */
+class IngestRequestParser {
+    constructor(maxBodyBytes = DEFAULT_MAX_BODY) {
+        this.maxBodyBytes = maxBodyBytes;
+        this.buffer = Buffer.allocUnsafe(INITIAL_BUFFER);
+        this.length = 0;
+        this.offset = 0;
+        this.continueSent = false;
+        // Objek hasil dipakai ulang per request
+        this.request = { ok: true, status: 0, keepAlive: true, needsContinue: false, body: null };
+    }
+
+    push(chunk) {
+        // Request yang sudah diproses dibuang dulu supaya buffer tidak tumbuh karena pipelining
+        if (this.offset > 0) {
+            this.buffer.copy(this.buffer, 0, this.offset, this.length);
+            this.length -= this.offset;
+            this.offset = 0;
+        }
+        const needed = this.length + chunk.length;
+        if (needed > this.buffer.length) {
+            const grown = Buffer.allocUnsafe(Math.min(Math.max(needed, this.buffer.length * 2), this.maxBodyBytes + MAX_HEADER_BYTES));
+            this.buffer.copy(grown, 0, 0, this.length);
+            this.buffer = grown;
+        }
+        chunk.copy(this.buffer, this.length);
+        this.length += chunk.length;
+    }
+
+    fits(chunk) {
+        return this.length - this.offset + chunk.length <= this.maxBodyBytes + MAX_HEADER_BYTES;
+    }
+
+    // Error yang membuat stream tidak bisa disinkronkan lagi: response lalu tutup koneksi
+    fail(status, message) {
+        const request = this.request;
+        request.ok = false;
+        request.status = status;
+        request.keepAlive = false;
+        request.body = errorBody(message);
+        this.offset = this.length;
+        return request;
+    }
+
+    next() {
+        const buffer = this.buffer;
+        const start = this.offset;
+        const available = this.length - start;
+        if (available === 0) return null;
+
+        const headerEnd = buffer.subarray(start, this.length).indexOf(CRLFCRLF);
+        if (headerEnd < 0) {
+            return available > MAX_HEADER_BYTES ? this.fail(431, 'Request headers too large') : null;
+        }
+
+        // Request line: METHOD SP PATH SP HTTP/1.x
+        const lineEnd = buffer.indexOf(0x0D, start);
+        const methodEnd = buffer.indexOf(0x20, start);
+        const pathEnd = methodEnd < 0 ? -1 : buffer.indexOf(0x20, methodEnd + 1);
+        if (methodEnd < 0 || pathEnd < 0 || pathEnd > lineEnd) return this.fail(400, 'Malformed request line');
+        const http10 = buffer[lineEnd - 1] === 0x30;
+
+        let contentLength = -1;
+        let keepAlive = !http10;
+        let expectContinue = false;
+        let chunked = false;
+        let line = lineEnd + 2;
+        const headersEnd = start + headerEnd;
+        while (line < headersEnd) {
+            let eol = buffer.indexOf(0x0D, line);
+            if (eol < 0 || eol > headersEnd) eol = headersEnd;
+            const colon = buffer.indexOf(0x3A, line);
+            if (colon > line && colon < eol) {
+                let valueStart = colon + 1;
+                while (buffer[valueStart] === 0x20 || buffer[valueStart] === 0x09) valueStart++;
+                if (headerNameIs(buffer, line, colon, 'content-length')) {
+                    contentLength = 0;
+                    for (let i = valueStart; i < eol && buffer[i] !== 0x20; i++) {
+                        const digit = buffer[i] - 0x30;
+                        if (digit < 0 || digit > 9) return this.fail(400, 'Invalid Content-Length');
+                        contentLength = contentLength * 10 + digit;
+                    }
+                } else if (headerNameIs(buffer, line, colon, 'connection')) {
+                    if (containsToken(buffer, valueStart, eol, 'close')) keepAlive = false;
+                    else if (containsToken(buffer, valueStart, eol, 'keep-alive')) keepAlive = true;
+                } else if (headerNameIs(buffer, line, colon, 'transfer-encoding')) {
+                    chunked = true;
+                } else if (headerNameIs(buffer, line, colon, 'expect')) {
+                    expectContinue = containsToken(buffer, valueStart, eol, '100-continue');
+                }
+            }
+            line = eol + 2;
+        }
+
+        if (chunked) return this.fail(501, 'Chunked transfer encoding not supported, send Content-Length');
+
+        const request = this.request;
+        const isPost = methodEnd - start === 4 && buffer.latin1Slice(start, methodEnd) === 'POST';
+        const pathLength = pathEnd - methodEnd - 1;
+        const queryAt = buffer.indexOf(0x3F, methodEnd + 1);
+        const routeLength = queryAt > methodEnd && queryAt < pathEnd ? queryAt - methodEnd - 1 : pathLength;
+        const isIngest = routeLength === INGEST_PATH.length && buffer.latin1Slice(methodEnd + 1, methodEnd + 1 + routeLength) === INGEST_PATH;
+        const bodyStart = headersEnd + 4;
+
+        if (contentLength < 0) {
+            if (isPost) return this.fail(411, 'Content-Length required');
+            contentLength = 0;
+        }
+        if (contentLength > this.maxBodyBytes) return this.fail(413, `Body larger than ${this.maxBodyBytes} bytes`);
+
+        if (this.length - bodyStart < contentLength) {
+            // Body belum lengkap; klien dengan Expect menunggu 100 Continue dulu
+            request.needsContinue = expectContinue && !this.continueSent;
+            this.continueSent = this.continueSent || request.needsContinue;
+            return request.needsContinue ? request : null;
+        }
+
+        this.offset = bodyStart + contentLength;
+        this.continueSent = false;
+        request.needsContinue = false;
+        request.keepAlive = keepAlive;
+        if (!isPost || !isIngest) {
+            request.ok = false;
+            request.status = 404;
+            request.body = errorBody(`Only POST ${INGEST_PATH} is served on this port`);
+            return request;
+        }
+        request.ok = true;
+        request.status = 0;
+        request.body = buffer.subarray(bodyStart, bodyStart + contentLength);
+        return request;
+    }
+}
+
+function formatResponse(status, body, keepAlive) {
+    return `${RESPONSE_PREFIX[status] || RESPONSE_PREFIX[500]}${Buffer.byteLength(body)}\r\nConnection: ${keepAlive ? 'keep-alive' : 'close'}\r\n\r\n${body}`;
+}
+
+function runHandler(onTelemetry, body, remoteAddress) {
+    try {
+        return onTelemetry(body, remoteAddress);
+    } catch (error) {
+        return { status: 500, body: errorBody('Internal server error') };
+    }
+}
+
+/**
+ * Listener ingest di port sendiri; stats bisa dibaca lewat server.ingestStats.
+ */
+function createIngestServer({ port, host = '0.0.0.0', onTelemetry, maxBodyBytes = DEFAULT_MAX_BODY }) {
+    const stats = { connections: 0, activeConnections: 0, requests: 0, pipelinedBatches: 0, errors: 0, bytes: 0 };
+
+    const server = net.createServer((socket) => {
+        const parser = new IngestRequestParser(maxBodyBytes);
+        stats.connections++;
+        stats.activeConnections++;
+        socket.setNoDelay(true);
+        socket.setTimeout(IDLE_TIMEOUT_MS, () => socket.destroy());
+
+        socket.on('data', (chunk) => {
+            stats.bytes += chunk.length;
+            let output = '';
+            let handled = 0;
+            let close = false;
+
+            if (parser.fits(chunk)) parser.push(chunk);
+            else {
+                output = formatResponse(413, errorBody(`Body larger than ${maxBodyBytes} bytes`), false);
+                close = true;
+            }
+
+            for (let request = close ? null : parser.next(); request; request = close ? null : parser.next()) {
+                if (request.needsContinue) {
+                    output += CONTINUE;
+                    break;
+                }
+                handled++;
+                if (request.ok) {
+                    const result = runHandler(onTelemetry, request.body, socket.remoteAddress);
+                    output += formatResponse(result.status, result.body, request.keepAlive);
+                } else {
+                    stats.errors++;
+                    output += formatResponse(request.status, request.body, request.keepAlive);
+                }
+                if (!request.keepAlive) close = true;
+            }
+
+            stats.requests += handled;
+            if (handled > 1) stats.pipelinedBatches++;
+            if (!output) return;
+            if (close) {
+                socket.end(output);
+            } else if (!socket.write(output)) {
+                // Klien tidak membaca response: berhenti membaca request sampai drain
+                socket.pause();
+                socket.once('drain', () => socket.resume());
+            }
+        });
+        socket.on('close', () => { stats.activeConnections--; });
+        socket.on('error', () => socket.destroy());
+    });
+
+    server.ingestStats = stats;
+    server.listen(port, host);
+    return server;
+}
+
+/**
+ * POST /api/telemetry di http.Server utama, sebelum Express. Body dialokasikan
+ * sekali sesuai Content-Length; response memakai header statis yang sama.
+ */
+function handleHttpIngest(req, res, onTelemetry, maxBodyBytes = DEFAULT_MAX_BODY) {
+    const declared = parseInt(req.headers['content-length'], 10);
+    const reply = (status, body) => {
+        res.writeHead(status, JSON_HEADERS);
+        res.end(body);
+    };
+    if (!(declared >= 0)) {
+        req.resume();
+        return reply(411, errorBody('Content-Length required'));
+    }
+    if (declared > maxBodyBytes) {
+        req.resume();
+        return reply(413, errorBody(`Body larger than ${maxBodyBytes} bytes`));
+    }
+
+    const body = Buffer.allocUnsafe(declared);
+    let length = 0;
+    req.on('data', (chunk) => {
+        const room = Math.min(chunk.length, declared - length);
+        chunk.copy(body, length, 0, room);
+        length += room;
+    });
+    req.on('end', () => {
+        if (length !== declared) return reply(400, errorBody('Incomplete body'));
+        const result = runHandler(onTelemetry, body, req.socket.remoteAddress);
+        reply(result.status, result.body);
+    });
+}
+
+module.exports = { createIngestServer, handleHttpIngest, IngestRequestParser, INGEST_PATH };
@@ -0,0 +1,181 @@
+/**
+ * Ingest Ring Consumer
+ * Sisi Node dari native/ingest_sidecar: sidecar menerima UDP/TCP (epoll + recvmmsg,
+ * SO_REUSEPORT per core), memvalidasi dan memberi nomor urut, lalu menaruh frame di ring
+ * shared memory. Di sini ring dibaca langsung dari mapping (native/build/ingest_ring.node):
+ * payload diberikan ke onRecord sebagai Buffer view di atas slot, tanpa copy. View hanya
+ * valid selama callback; setelah batch selesai readIndex dilepas dan slot bisa ditimpa.
+ *
+ * Polling: setImmediate selama ada data (batch dibatasi agar event loop tetap responsif),
+ * timer POLL_IDLE_MS saat kosong. Sidecar restart = file baru (inode berubah) -> buka ulang.
+ */
+
+const fs = require('fs');
+const path = require('path');
+
+// Layout (harus sama dengan native/ingest_ring.h)
+const HEADER_BYTES = 4096;
+const CONTROL_BYTES = 256;
+const SLOT_HEADER = 32;
+const HEADER = { RING_COUNT: 8, SLOT_COUNT: 12, SLOT_BYTES: 16, PID: 20, STARTED_AT_MS: 24, SEQUENCE: 32 };
+const CONTROL = { WRITE_INDEX: 0, READ_INDEX: 64, RECEIVED: 128, INVALID: 136, DROPPED: 144, BATCHES: 152 };
+const SLOT = { LENGTH: 0, FLAGS: 4, SEQUENCE: 8, RECEIVED_AT_US: 16, SOURCE_ADDRESS: 24, SOURCE_PORT: 28 };
+const INGEST_KIND = { MAVLINK: 1, JSON: 2, MASK: 0xff };
+const FLAG_TCP = 0x100;
+const FLAG_SKIP = 0x200;
+
+const POLL_IDLE_MS = 2;
+const MAX_BATCH = 1024;          // Slot per giliran event loop
+const REOPEN_CHECK_MS = 1000;
+
+function loadNative() {
+    try {
+        return require(path.join(__dirname, '..', 'native', 'build', 'ingest_ring.node'));
+    } catch (error) {
+        return null;
+    }
+}
+
+const native = loadNative();
+
+const u64 = (view, offset) => view.getUint32(offset, true) + view.getUint32(offset + 4, true) * 0x100000000;
+
+class IngestRingConsumer {
+    /**
+     * onRecord({ kind, tcp, payload, sequence, receivedAtUs, sourceAddress, sourcePort })
+     * sourceAddress = IPv4 sebagai uint32 (string hanya dibuat jika perlu, lihat formatSource)
+     */
+    constructor({ file, onRecord }) {
+        this.file = file;
+        this.onRecord = onRecord;
+        this.mapping = null;
+        this.inode = null;
+        this.rings = [];
+        this.pollTimer = null;
+        this.checkTimer = null;
+        this.closed = false;
+        this.stats = { opens: 0, consumed: 0, skipped: 0, lagUsTotal: 0, lastSequence: 0 };
+    }
+
+    start() {
+        if (!native) {
+            console.warn('⚠️ [SIDECAR] native/build/ingest_ring.node not found, run native/build.sh');
+            return false;
+        }
+        this.reopen();
+        this.checkTimer = setInterval(() => this.reopen(), REOPEN_CHECK_MS);
+        this.checkTimer.unref();
+        this.schedule(false);
+        return true;
+    }
+
+    // Buka (ulang) jika file baru muncul; mapping lama dilepas GC setelah view terakhir hilang
+    reopen() {
+        let inode;
+        try {
+            inode = fs.statSync(this.file).ino;
+        } catch (error) {
+            return;
+        }
+        if (inode === this.inode) return;
+        try {
+            this.mapping = native.open(this.file);
+        } catch (error) {
+            return;  // Sidecar belum selesai inisialisasi, coba lagi detik berikutnya
+        }
+        this.inode = inode;
+        this.view = new DataView(this.mapping);
+        const ringCount = this.view.getUint32(HEADER.RING_COUNT, true);
+        this.slotCount = this.view.getUint32(HEADER.SLOT_COUNT, true);
+        this.slotBytes = this.view.getUint32(HEADER.SLOT_BYTES, true);
+        this.rings = [];
+        for (let ring = 0; ring < ringCount; ring++) {
+            const control = HEADER_BYTES + ring * (CONTROL_BYTES + this.slotCount * this.slotBytes);
+            // Lanjut dari readIndex tersimpan: frame selama server.js restart tidak hilang
+            this.rings.push({ control, slots: control + CONTROL_BYTES, read: native.loadAcquire(this.mapping, control + CONTROL.READ_INDEX) });
+        }
+        this.stats.opens++;
+        this.stats.lastSequence = 0;
+        console.log(`🛰️ [SIDECAR] Attached to ${this.file} (pid ${this.view.getUint32(HEADER.PID, true)}, ${ringCount} rings x ${this.slotCount} slots)`);
+    }
+
+    schedule(busy) {
+        if (this.closed) return;
+        if (busy) setImmediate(() => this.poll());
+        else this.pollTimer = setTimeout(() => this.poll(), POLL_IDLE_MS);
+    }
+
+    poll() {
+        let busy = false;
+        for (const ring of this.rings) {
+            const write = native.loadAcquire(this.mapping, ring.control + CONTROL.WRITE_INDEX);
+            if (write === ring.read) continue;
+            const end = Math.min(write, ring.read + MAX_BATCH);
+            this.consume(ring, end);
+            native.storeRelease(this.mapping, ring.control + CONTROL.READ_INDEX, end);
+            if (end < write) busy = true;
+        }
+        this.schedule(busy);
+    }
+
+    consume(ring, end) {
+        const { view, mapping, stats } = this;
+        const mask = this.slotCount - 1;
+        const nowUs = Date.now() * 1000;
+        for (; ring.read < end; ring.read++) {
+            const slot = ring.slots + (ring.read & mask) * this.slotBytes;
+            const flags = view.getUint32(slot + SLOT.FLAGS, true);
+            const sequence = u64(view, slot + SLOT.SEQUENCE);
+            if (sequence > stats.lastSequence) stats.lastSequence = sequence;
+            if (flags & FLAG_SKIP) {
+                stats.skipped++;
+                continue;
+            }
+            const receivedAtUs = u64(view, slot + SLOT.RECEIVED_AT_US);
+            stats.consumed++;
+            stats.lagUsTotal += Math.max(0, nowUs - receivedAtUs);
+            this.onRecord({
+                kind: flags & INGEST_KIND.MASK,
+                tcp: (flags & FLAG_TCP) !== 0,
+                payload: Buffer.from(mapping, slot + SLOT_HEADER, view.getUint32(slot + SLOT.LENGTH, true)),
+                sequence,
+                receivedAtUs,
+                sourceAddress: view.getUint32(slot + SLOT.SOURCE_ADDRESS, false),
+                sourcePort: view.getUint16(slot + SLOT.SOURCE_PORT, true)
+            });
+        }
+    }
+
+    close() {
+        this.closed = true;
+        clearTimeout(this.pollTimer);
+        clearInterval(this.checkTimer);
+    }
+
+    getStats() {
+        const rings = this.rings.map((ring) => ({
+            received: u64(this.view, ring.control + CONTROL.RECEIVED),
+            invalid: u64(this.view, ring.control + CONTROL.INVALID),
+            dropped: u64(this.view, ring.control + CONTROL.DROPPED),
+            backlog: native.loadAcquire(this.mapping, ring.control + CONTROL.WRITE_INDEX) - ring.read
+        }));
+        const { opens, consumed, skipped, lagUsTotal, lastSequence } = this.stats;
+        return {
+            file: this.file,
+            attached: this.rings.length > 0,
+            opens,
+            consumed,
+            skipped,
+            lastSequence,
+            avgLagMs: consumed ? Math.round(lagUsTotal / consumed / 10) / 100 : null,
+            rings
+        };
+    }
+}
+
+// sourceAddress dari slot (uint32 big endian) -> 'a.b.c.d:port'
+function formatSource(address, port) {
+    return `${address >>> 24}.${(address >>> 16) & 0xff}.${(address >>> 8) & 0xff}.${address & 0xff}:${port}`;
+}
+
+module.exports = { IngestRingConsumer, INGEST_KIND, formatSource, nativeAvailable: () => native !== null };
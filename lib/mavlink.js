@@ -0,0 +1,195 @@
+/**
+ * MAVLink v2 Decoder
+ * Stream parser untuk frame MAVLink v2 dari ESP32 (atau GCS/autopilot lain)
+ * dan pemetaan message standar ke field telemetry dashboard
+ */
+
+const MAVLINK_STX_V2 = 0xFD;
+const HEADER_LEN = 10;
+const CHECKSUM_LEN = 2;
+const SIGNATURE_LEN = 13;
+const INCOMPAT_FLAG_SIGNED = 0x01;
+
+// msgid -> { name, length (payload penuh), crcExtra }
+const MESSAGES = {
+    0: { name: 'HEARTBEAT', length: 9, crcExtra: 50 },
+    1: { name: 'SYS_STATUS', length: 31, crcExtra: 124 },
+    24: { name: 'GPS_RAW_INT', length: 30, crcExtra: 24 },
+    29: { name: 'SCALED_PRESSURE', length: 14, crcExtra: 115 },
+    33: { name: 'GLOBAL_POSITION_INT', length: 28, crcExtra: 104 },
+    147: { name: 'BATTERY_STATUS', length: 36, crcExtra: 154 },
+    251: { name: 'NAMED_VALUE_FLOAT', length: 18, crcExtra: 170 },
+    252: { name: 'NAMED_VALUE_INT', length: 18, crcExtra: 44 }
+};
+
+// CRC-16/MCRF4XX (X.25) sesuai referensi MAVLink
+function crcAccumulate(byte, crc) {
+    let tmp = (byte ^ (crc & 0xFF)) & 0xFF;
+    tmp = (tmp ^ (tmp << 4)) & 0xFF;
+    return ((crc >> 8) ^ (tmp << 8) ^ (tmp << 3) ^ (tmp >> 4)) & 0xFFFF;
+}
+
+function crcCalculate(buffer, start, end, crcExtra) {
+    let crc = 0xFFFF;
+    for (let i = start; i < end; i++) {
+        crc = crcAccumulate(buffer[i], crc);
+    }
+    return crcAccumulate(crcExtra, crc);
+}
+
+class MavlinkParser {
+    constructor() {
+        this.buffer = Buffer.alloc(0);
+        this.stats = {
+            framesDecoded: 0,
+            crcErrors: 0,
+            unknownMessages: 0,
+            bytesDropped: 0
+        };
+    }
+
+    /**
+     * Tambahkan bytes baru dan kembalikan semua message yang lengkap.
+     * Message yang tidak dikenal tetap dilewati agar stream tidak tersendat.
+     */
+    push(chunk) {
+        this.buffer = this.buffer.length ? Buffer.concat([this.buffer, chunk]) : chunk;
+        const messages = [];
+        let offset = 0;
+
+        while (offset < this.buffer.length) {
+            if (this.buffer[offset] !== MAVLINK_STX_V2) {
+                offset++;
+                this.stats.bytesDropped++;
+                continue;
+            }
+
+            if (this.buffer.length - offset < HEADER_LEN) break;
+
+            const payloadLength = this.buffer[offset + 1];
+            const incompatFlags = this.buffer[offset + 2];
+            const signatureLength = (incompatFlags & INCOMPAT_FLAG_SIGNED) ? SIGNATURE_LEN : 0;
+            const frameLength = HEADER_LEN + payloadLength + CHECKSUM_LEN + signatureLength;
+
+            if (this.buffer.length - offset < frameLength) break;
+
+            const msgid = this.buffer[offset + 7] |
+                (this.buffer[offset + 8] << 8) |
+                (this.buffer[offset + 9] << 16);
+            const definition = MESSAGES[msgid];
+
+            if (!definition) {
+                this.stats.unknownMessages++;
+                offset += frameLength;
+                continue;
+            }
+
+            const crcOffset = offset + HEADER_LEN + payloadLength;
+            const expected = this.buffer.readUInt16LE(crcOffset);
+            const actual = crcCalculate(this.buffer, offset + 1, crcOffset, definition.crcExtra);
+
+            if (expected !== actual) {
+                // Resync: mulai cari STX dari byte berikutnya
+                this.stats.crcErrors++;
+                offset++;
+                continue;
+            }
+
+            // Payload yang di-truncate di-zero-extend ke panjang penuh
+            const payload = Buffer.alloc(Math.max(definition.length, payloadLength));
+            this.buffer.copy(payload, 0, offset + HEADER_LEN, crcOffset);
+
+            messages.push({
+                msgid,
+                name: definition.name,
+                sequence: this.buffer[offset + 4],
+                sysid: this.buffer[offset + 5],
+                compid: this.buffer[offset + 6],
+                payload
+            });
+
+            this.stats.framesDecoded++;
+            offset += frameLength;
+        }
+
+        this.buffer = offset >= this.buffer.length ? Buffer.alloc(0) : this.buffer.subarray(offset);
+        return messages;
+    }
+}
+
+function readName(payload, offset) {
+    const raw = payload.subarray(offset, offset + 10);
+    const end = raw.indexOf(0);
+    return raw.subarray(0, end === -1 ? raw.length : end).toString('ascii');
+}
+
+/**
+ * Petakan satu message MAVLink ke field telemetry dashboard.
+ * Mengembalikan object parsial (bisa kosong) untuk di-merge ke latestTelemetry.
+ */
+function toTelemetry(message) {
+    const p = message.payload;
+    const data = {};
+
+    switch (message.name) {
+        case 'SYS_STATUS': {
+            const voltage = p.readUInt16LE(14);
+            const current = p.readInt16LE(16);
+            if (voltage !== 0xFFFF) data.battery_voltage = voltage / 1000;
+            if (current !== -1) data.battery_current = current / 100;
+            break;
+        }
+
+        case 'BATTERY_STATUS': {
+            let millivolts = 0;
+            for (let i = 0; i < 10; i++) {
+                const cell = p.readUInt16LE(10 + i * 2);
+                if (cell !== 0xFFFF) millivolts += cell;
+            }
+            const current = p.readInt16LE(30);
+            if (millivolts > 0) data.battery_voltage = millivolts / 1000;
+            if (current !== -1) data.battery_current = current / 100;
+            break;
+        }
+
+        case 'GLOBAL_POSITION_INT':
+            data.gps_latitude = p.readInt32LE(4) / 1e7;
+            data.gps_longitude = p.readInt32LE(8) / 1e7;
+            data.altitude = p.readInt32LE(16) / 1000;
+            break;
+
+        case 'GPS_RAW_INT': {
+            const satellites = p[29];
+            if (satellites !== 255) data.satellites = satellites;
+            break;
+        }
+
+        case 'SCALED_PRESSURE':
+            data.temperature = p.readInt16LE(12) / 100;
+            break;
+
+        case 'NAMED_VALUE_FLOAT':
+            if (readName(p, 8) === 'humidity') data.humidity = p.readFloatLE(4);
+            break;
+
+        case 'NAMED_VALUE_INT':
+            if (readName(p, 8) === 'rssi') data.signal_strength = p.readInt32LE(4);
+            break;
+
+        default:
+            break;
+    }
+
+    if (data.battery_voltage !== undefined && data.battery_current !== undefined) {
+        data.battery_power = data.battery_voltage * data.battery_current;
+    }
+
+    return data;
+}
+
+module.exports = {
+    MavlinkParser,
+    toTelemetry,
+    crcCalculate,
+    MESSAGES
+};
@@ -0,0 +1,93 @@
+/**
+ * Rate Meter
+ * Laju bergerak 1/5/15 menit (seperti load average Unix) untuk packets, bytes, errors,
+ * dan commands, global dan per device. Counter eksponensial di-decay secara lazy:
+ * mark() O(1) tanpa timer, nilai = Σ n·e^(-(t - tᵢ)/τ) dan laju = nilai/τ per detik.
+ * Selama umur meter < τ laju dikoreksi dengan (1 - e^(-umur/τ)) supaya menit-menit
+ * pertama tidak terbaca terlalu rendah.
+ */
+
+const WINDOWS = [['m1', 60], ['m5', 300], ['m15', 900]];
+const METRICS = ['packets', 'bytes', 'errors', 'commands'];
+const MIN_AGE_S = 5;  // Di bawah ini koreksi bias terlalu berisik
+const DEFAULT_MAX_DEVICES = 256;
+
+class DecayingRate {
+    constructor(now) {
+        this.values = new Float64Array(WINDOWS.length);
+        this.createdAt = now;
+        this.at = now;
+        this.total = 0;
+    }
+
+    decay(now) {
+        const dt = (now - this.at) / 1000;
+        if (dt <= 0) return;
+        for (let i = 0; i < WINDOWS.length; i++) this.values[i] *= Math.exp(-dt / WINDOWS[i][1]);
+        this.at = now;
+    }
+
+    mark(n, now) {
+        this.decay(now);
+        for (let i = 0; i < WINDOWS.length; i++) this.values[i] += n;
+        this.total += n;
+    }
+
+    rates(now) {
+        this.decay(now);
+        const age = Math.max((now - this.createdAt) / 1000, MIN_AGE_S);
+        const result = { total: this.total, age_s: Math.round((now - this.createdAt) / 1000) };
+        for (let i = 0; i < WINDOWS.length; i++) {
+            const [name, tau] = WINDOWS[i];
+            const rate = this.values[i] / (tau * (1 - Math.exp(-age / tau)));
+            result[name] = Math.round(rate * 100) / 100;
+        }
+        return result;
+    }
+}
+
+function createMeters(now) {
+    return Object.fromEntries(METRICS.map((metric) => [metric, new DecayingRate(now)]));
+}
+
+function snapshotMeters(meters, now) {
+    return Object.fromEntries(METRICS.map((metric) => [metric, meters[metric].rates(now)]));
+}
+
+class RateTracker {
+    constructor(options = {}) {
+        this.maxDevices = options.maxDevices || DEFAULT_MAX_DEVICES;
+        this.global = createMeters(Date.now());
+        this.devices = new Map();
+    }
+
+    /**
+     * Catat n kejadian metric; deviceId null = hanya global (mis. error sebelum device dikenali).
+     */
+    mark(metric, deviceId, n = 1, now = Date.now()) {
+        this.global[metric].mark(n, now);
+        if (deviceId === null || deviceId === undefined) return;
+
+        let meters = this.devices.get(deviceId);
+        if (meters) {
+            // Pindah ke akhir Map: urutan insertion = urutan pemakaian terakhir (LRU)
+            this.devices.delete(deviceId);
+        } else {
+            // Device yang paling lama tidak aktif dibuang agar id acak (socket.id/IP) tidak menumpuk
+            if (this.devices.size >= this.maxDevices) this.devices.delete(this.devices.keys().next().value);
+            meters = createMeters(now);
+        }
+        this.devices.set(deviceId, meters);
+        meters[metric].mark(n, now);
+    }
+
+    getStats(now = Date.now()) {
+        return {
+            windows: WINDOWS.map(([name]) => name),
+            global: snapshotMeters(this.global, now),
+            devices: Object.fromEntries([...this.devices].map(([deviceId, meters]) => [deviceId, snapshotMeters(meters, now)]))
+        };
+    }
+}
+
+module.exports = { RateTracker, DecayingRate, METRICS };
@@ -0,0 +1,75 @@
+/**
+ * USB Serial Bridge Ingest
+ * Menerima frame dari native/serial_bridge lewat TCP lokal:
+ *   [u16 big endian length][header 10 bytes][payload]
+ * Header: version(1) flags(1) sequence(u32 LE) sent_us(u32 LE)
+ * CRC sudah diverifikasi bridge, di sini hanya pemisahan frame + header.
+ * Payload diawali '{' = JSON, 0xFD = MAVLink v2 (sama seperti firmware).
+ */
+
+const net = require('net');
+
+const FRAME_HEADER_LEN = 10;
+const MAX_FRAME_LEN = 2048;
+
+class BridgeFrameReader {
+    constructor() {
+        this.buffer = Buffer.alloc(0);
+        this.stats = { framesDecoded: 0, invalidFrames: 0 };
+    }
+
+    // Return array { sequence, sentMicros, flags, payload }
+    push(chunk) {
+        this.buffer = this.buffer.length ? Buffer.concat([this.buffer, chunk]) : chunk;
+        const frames = [];
+
+        while (this.buffer.length >= 2) {
+            const length = this.buffer.readUInt16BE(0);
+            if (length < FRAME_HEADER_LEN || length > MAX_FRAME_LEN) {
+                // Stream tidak bisa di-resync tanpa delimiter: buang semua
+                this.stats.invalidFrames++;
+                this.buffer = Buffer.alloc(0);
+                break;
+            }
+            if (this.buffer.length < 2 + length) break;
+
+            const frame = this.buffer.subarray(2, 2 + length);
+            frames.push({
+                version: frame[0],
+                flags: frame[1],
+                sequence: frame.readUInt32LE(2),
+                sentMicros: frame.readUInt32LE(6),
+                payload: frame.subarray(FRAME_HEADER_LEN)
+            });
+            this.stats.framesDecoded++;
+            this.buffer = this.buffer.subarray(2 + length);
+        }
+        return frames;
+    }
+}
+
+/**
+ * TCP server untuk satu atau lebih bridge; onFrame(frame, connectionKey) per frame.
+ * Hanya bind ke loopback secara default: bridge jalan di mesin yang sama.
+ */
+function createSerialBridgeServer({ port, host = '127.0.0.1', onFrame, onConnect, onDisconnect }) {
+    const server = net.createServer((socket) => {
+        const key = `${socket.remoteAddress}:${socket.remotePort}`;
+        const reader = new BridgeFrameReader();
+        socket.setNoDelay(true);
+        if (onConnect) onConnect(key);
+
+        socket.on('data', (chunk) => {
+            for (const frame of reader.push(chunk)) {
+                onFrame(frame, key);
+            }
+        });
+        socket.on('close', () => onDisconnect && onDisconnect(key, reader.stats));
+        socket.on('error', () => socket.destroy());
+    });
+
+    server.listen(port, host);
+    return server;
+}
+
+module.exports = { BridgeFrameReader, createSerialBridgeServer, FRAME_HEADER_LEN };
@@ -0,0 +1,125 @@
+/**
+ * SSE Spectator Stream
+ * GET /stream (text/event-stream) untuk layar penonton/juri yang hanya membaca
+ * telemetry, tanpa sesi Socket.IO (heartbeat, upgrade, ack).
+ *
+ * Setiap update diserialisasi sekali menjadi satu Buffer yang sudah berisi framing
+ * chunked transfer-encoding, lalu Buffer yang sama ditulis langsung ke socket semua
+ * subscriber. Subscriber lambat (antrean socket > maxBufferedBytes) dilewati; saat
+ * socket drain hanya frame terbaru yang dikirim, bukan semua yang tertinggal.
+ */
+
+const CRLF = Buffer.from('\r\n');
+const DEFAULT_MAX_BUFFERED = 64 * 1024;
+const DEFAULT_HEARTBEAT_MS = 15000;
+const DEFAULT_STALL_TIMEOUT_MS = 60000;
+
+const HEADERS = {
+    'Content-Type': 'text/event-stream; charset=utf-8',
+    'Cache-Control': 'no-cache, no-transform',
+    'Access-Control-Allow-Origin': '*',
+    'X-Accel-Buffering': 'no'
+};
+
+// Satu event SSE -> { chunked: dengan framing HTTP/1.1 chunked, raw: tanpa (klien HTTP/1.0) }
+function encodeFrame(text) {
+    const raw = Buffer.from(text);
+    const chunked = Buffer.concat([Buffer.from(`${raw.length.toString(16)}\r\n`), raw, CRLF]);
+    return { raw, chunked };
+}
+
+class SseBroadcaster {
+    constructor(options = {}) {
+        this.maxBufferedBytes = options.maxBufferedBytes || DEFAULT_MAX_BUFFERED;
+        this.stallTimeoutMs = options.stallTimeoutMs || DEFAULT_STALL_TIMEOUT_MS;
+        this.subscribers = new Set();
+        this.latest = null;
+        this.latestSeq = 0;
+        this.heartbeat = encodeFrame(': ping\n\n');
+        this.stats = { subscribed: 0, framesPublished: 0, framesWritten: 0, framesSkipped: 0, bytesWritten: 0, stalledDropped: 0 };
+        this.heartbeatTimer = setInterval(() => this.writeAll(this.heartbeat, 0), options.heartbeatMs || DEFAULT_HEARTBEAT_MS);
+        this.heartbeatTimer.unref();
+    }
+
+    subscribe(req, res) {
+        res.writeHead(200, HEADERS);
+        res.flushHeaders();
+        const socket = res.socket;
+        socket.setNoDelay(true);
+        socket.setTimeout(0);
+
+        const subscriber = {
+            res,
+            socket,
+            // Node memakai chunked untuk HTTP/1.1; klien HTTP/1.0 menerima body mentah
+            chunked: res.chunkedEncoding !== false && req.httpVersion !== '1.0',
+            sentSeq: 0,
+            stalledSince: 0
+        };
+        this.subscribers.add(subscriber);
+        this.stats.subscribed++;
+
+        // Retry hint + frame terbaru supaya layar langsung terisi
+        this.write(subscriber, encodeFrame('retry: 2000\n\n'));
+        if (this.latest) this.send(subscriber, this.latest, this.latestSeq);
+
+        socket.on('drain', () => {
+            subscriber.stalledSince = 0;
+            if (this.latest && subscriber.sentSeq < this.latestSeq) this.send(subscriber, this.latest, this.latestSeq);
+        });
+        res.on('close', () => this.subscribers.delete(subscriber));
+        return subscriber;
+    }
+
+    publish(data, seq) {
+        this.latest = encodeFrame(`id: ${seq}\nevent: telemetry\ndata: ${JSON.stringify(data)}\n\n`);
+        this.latestSeq = seq;
+        this.stats.framesPublished++;
+        this.writeAll(this.latest, seq);
+    }
+
+    writeAll(frame, seq) {
+        const now = Date.now();
+        for (const subscriber of this.subscribers) {
+            if (subscriber.socket.writableLength > this.maxBufferedBytes) {
+                // Lambat: frame ini dilewati, drain nanti mengirim yang terbaru
+                if (!subscriber.stalledSince) subscriber.stalledSince = now;
+                else if (now - subscriber.stalledSince > this.stallTimeoutMs) this.drop(subscriber);
+                if (seq) this.stats.framesSkipped++;
+                continue;
+            }
+            if (seq) this.send(subscriber, frame, seq);
+            else this.write(subscriber, frame);
+        }
+    }
+
+    send(subscriber, frame, seq) {
+        subscriber.sentSeq = seq;
+        this.stats.framesWritten++;
+        this.write(subscriber, frame);
+    }
+
+    write(subscriber, frame) {
+        const bytes = subscriber.chunked ? frame.chunked : frame.raw;
+        this.stats.bytesWritten += bytes.length;
+        subscriber.socket.write(bytes);
+    }
+
+    drop(subscriber) {
+        this.stats.stalledDropped++;
+        this.subscribers.delete(subscriber);
+        subscriber.socket.destroy();
+    }
+
+    close() {
+        clearInterval(this.heartbeatTimer);
+        for (const subscriber of this.subscribers) subscriber.socket.destroy();
+        this.subscribers.clear();
+    }
+
+    getStats() {
+        return { ...this.stats, subscribers: this.subscribers.size };
+    }
+}
+
+module.exports = { SseBroadcaster };
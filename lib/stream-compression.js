@@ -0,0 +1,89 @@
+/**
+ * Stream Compression (preset dictionary)
+ * Frame telemetryUpdate hanya ~350 byte JSON; deflate per frame tanpa konteks cuma
+ * menghemat ~30% karena nama field belum pernah "terlihat". Mode 'dictionary' memakai
+ * deflate-raw dengan preset dictionary berisi nama field dan nilai tipikal, sehingga
+ * sebagian besar frame menjadi back-reference (~350 -> ~70 byte).
+ *   - Kompresi sekali per frame, hasil yang sama dikirim ke semua dashboard mode ini:
+ *     tanpa state zlib per client (beda dengan permessage-deflate context takeover).
+ *   - Browser tidak punya inflate dengan dictionary. Client menaruh dictionary sebagai
+ *     stored block (BTYPE 00, tidak final) di depan frame lalu DecompressionStream
+ *     ('deflate-raw'); back-reference frame menunjuk ke byte dictionary itu, dan output
+ *     dipotong sepanjang dictionary (StreamDecoder di stream-codec.js).
+ */
+
+const zlib = require('zlib');
+
+// Isi yang jarang muncul di depan; zlib paling murah mereferensikan byte terdekat ke akhir
+const RARE_FIELDS = {
+    anomalies: [{ device_id: 'ESP32_UAV_001', field: 'battery_current', kind: 'spike', value: 12.5, expected: 2.3, score: 7.25, timestamp: '2025-08-01T08:00:00.000Z' }],
+    connection_status: 'disconnected',
+    credit_stalls: 0,
+    pad: 'altitude_rate gps_speed step_up step_down shift_up shift_down jump MAVLink USB-Serial HTTP'
+};
+
+// Urutan key sama dengan latestTelemetry di server.js
+const TYPICAL_FRAME = {
+    battery_voltage: 12.61,
+    battery_current: 2.34,
+    battery_power: 29.51,
+    temperature: 27.4,
+    humidity: 61.2,
+    gps_latitude: -5.397012,
+    gps_longitude: 105.266031,
+    altitude: 152.3,
+    signal_strength: -61,
+    satellites: 9,
+    timestamp: 1760000000000,
+    connection_status: 'connected',
+    device_id: 'ESP32_UAV_001',
+    packet_number: 1,
+    connection_type: 'WebSocket',
+    seq: 1
+};
+
+function buildDictionary() {
+    return JSON.stringify(RARE_FIELDS) + JSON.stringify(TYPICAL_FRAME);
+}
+
+class StreamCompressor {
+    constructor(options = {}) {
+        this.dictionaryText = options.dictionary || buildDictionary();
+        this.dictionary = Buffer.from(this.dictionaryText);
+        this.level = options.level || 9;
+        this.stats = { frames: 0, rawBytes: 0, packedBytes: 0, cpuMs: 0 };
+    }
+
+    /**
+     * JSON frame -> deflate-raw (dengan dictionary) sebagai base64: satu frame teks
+     * Socket.IO. Event biner Socket.IO menambah paket placeholder ~50 byte per frame.
+     */
+    pack(data) {
+        const started = process.hrtime.bigint();
+        const raw = Buffer.from(JSON.stringify(data));
+        const packed = zlib.deflateRawSync(raw, { dictionary: this.dictionary, level: this.level }).toString('base64');
+        this.stats.frames++;
+        this.stats.rawBytes += raw.length;
+        this.stats.packedBytes += packed.length;
+        this.stats.cpuMs += Number(process.hrtime.bigint() - started) / 1e6;
+        return packed;
+    }
+
+    // Dikirim ke client saat memilih mode dictionary
+    describe() {
+        return { mode: 'dictionary', dictionary: this.dictionaryText };
+    }
+
+    getStats() {
+        const { frames, rawBytes, packedBytes, cpuMs } = this.stats;
+        return {
+            frames,
+            rawBytes,
+            packedBytes,
+            ratio: rawBytes ? Math.round(packedBytes / rawBytes * 1000) / 1000 : null,
+            usPerFrame: frames ? Math.round(cpuMs * 1000 / frames * 10) / 10 : 0
+        };
+    }
+}
+
+module.exports = { StreamCompressor, buildDictionary };
@@ -0,0 +1,88 @@
+/**
+ * Telemetry Backfill
+ * Snapshot N menit terakhir dari HistoryStore untuk dashboard yang baru join,
+ * supaya chart langsung penuh tanpa menunggu stream live mengisi.
+ *
+ * Payload socket 'telemetryBackfill':
+ *   { seq, compression, columns: [{ name, type }], devices: [{ device_id, rows, base }], data }
+ * data (opsional deflate) = per device berurutan: offset ms dari base u32[rows],
+ * lalu tiap kolom f32/f64[rows], semua little-endian.
+ * seq = nomor frame live terakhir yang sudah tercakup; client membuang frame live
+ * dengan seq <= itu sehingga tidak ada gap maupun duplikat.
+ */
+
+const zlib = require('zlib');
+const { promisify } = require('util');
+const { COLUMNS, columnBytes } = require('./history-store');
+
+const deflate = promisify(zlib.deflate);
+
+// Kolom yang dipakai chart, peta, dan kartu dashboard
+const BACKFILL_FIELDS = ['battery_voltage', 'battery_current', 'battery_power', 'temperature',
+    'gps_latitude', 'gps_longitude', 'altitude', 'signal_strength'];
+
+class TelemetryBackfill {
+    constructor(historyStore, options = {}) {
+        this.historyStore = historyStore;
+        this.windowMs = options.windowMs || 10 * 60 * 1000;
+        this.columns = BACKFILL_FIELDS.map((name) => {
+            const index = COLUMNS.findIndex((column) => column.name === name);
+            return { name, index, type: COLUMNS[index].array === Float64Array ? 'f64' : 'f32' };
+        });
+        this.stats = { snapshots: 0, rows: 0, rawBytes: 0, sentBytes: 0, lastBuildMs: 0 };
+    }
+
+    /**
+     * Susun snapshot secara sinkron (baris dan seq konsisten dengan stream live),
+     * kompresi berjalan di threadpool zlib.
+     */
+    async snapshot(seq, options = {}) {
+        const started = process.hrtime.bigint();
+        const windowMs = Math.min(options.windowMs || this.windowMs, this.windowMs);
+        const from = Date.now() - windowMs;
+        const devices = [];
+        const parts = [];
+
+        for (const { device_id: deviceId } of this.historyStore.getDevices()) {
+            const slices = this.historyStore.slices(deviceId, from);
+            const rows = slices.reduce((sum, slice) => sum + slice.end - slice.begin, 0);
+            if (rows === 0) continue;
+
+            const base = slices[0].chunk.columns[0][slices[0].begin];
+            const offsets = new Uint32Array(rows);
+            let row = 0;
+            for (const { chunk, begin, end } of slices) {
+                const timestamps = chunk.columns[0];
+                for (let i = begin; i < end; i++) offsets[row++] = timestamps[i] - base;
+            }
+            parts.push(columnBytes(offsets, 0, rows));
+            for (const column of this.columns) {
+                for (const { chunk, begin, end } of slices) parts.push(columnBytes(chunk.columns[column.index], begin, end));
+            }
+            devices.push({ device_id: deviceId, rows, base });
+        }
+
+        const raw = Buffer.concat(parts);
+        const compression = options.compression === 'deflate' ? 'deflate' : 'none';
+        this.stats.lastBuildMs = Number(process.hrtime.bigint() - started) / 1e6;
+        const data = compression === 'deflate' ? await deflate(raw, { level: 6 }) : raw;
+
+        this.stats.snapshots++;
+        this.stats.rows += devices.reduce((sum, device) => sum + device.rows, 0);
+        this.stats.rawBytes += raw.length;
+        this.stats.sentBytes += data.length;
+        return {
+            seq,
+            compression,
+            columns: this.columns.map(({ name, type }) => ({ name, type })),
+            devices,
+            data
+        };
+    }
+
+    getStats() {
+        return { ...this.stats, windowMs: this.windowMs };
+    }
+}
+
+module.exports = { TelemetryBackfill, BACKFILL_FIELDS };
@@ -0,0 +1,458 @@
+/**
+ * Telemetry Export
+ * Streaming CSV dan Parquet dari HistoryStore ke writable (response HTTP, chunked).
+ * Memori terbatas: CSV diproses per batch (paralel di worker_threads untuk flight
+ * besar, urutan output tetap), Parquet ditulis per row group langsung dari view
+ * typed array chunk tanpa copy; hanya metadata footer yang dikumpulkan.
+ *
+ * Parquet: PLAIN encoding, tanpa kompresi, kolom REQUIRED (nilai kosong = NaN),
+ * timestamp INT64 TIMESTAMP_MILLIS, GPS DOUBLE, sisanya FLOAT. Metadata Thrift
+ * compact protocol ditulis sendiri (tanpa dependency).
+ */
+
+const os = require('os');
+const path = require('path');
+const { Worker } = require('worker_threads');
+const { COLUMNS, columnBytes } = require('./history-store');
+const { formatCsvRows } = require('./export-worker');
+
+const CSV_BATCH_ROWS = 16384;
+const PARALLEL_MIN_ROWS = 65536;
+const ROW_GROUP_ROWS = 65536;
+const EXPORT_WORKERS = Math.max(1, Math.min(4, os.cpus().length - 1));
+
+// ====== COLUMN SELECTION ======
+
+// fields=a,b,c -> kolom terpilih (timestamp selalu pertama); kosong = semua kolom
+function resolveColumns(fields) {
+    const all = COLUMNS.map((column, index) => ({ ...column, index }));
+    if (!fields) return all;
+    const wanted = new Set(String(fields).split(',').map((field) => field.trim()).filter(Boolean));
+    const unknown = [...wanted].filter((field) => !COLUMNS.some((column) => column.name === field));
+    if (unknown.length) throw new Error(`Unknown field(s): ${unknown.join(', ')}`);
+    return all.filter((column) => column.index === 0 || wanted.has(column.name));
+}
+
+function countRows(slices) {
+    return slices.reduce((total, slice) => total + slice.end - slice.begin, 0);
+}
+
+// Tulis dengan backpressure; throw jika client sudah menutup koneksi
+async function write(output, data) {
+    if (output.destroyed) throw new Error('Export aborted: client disconnected');
+    if (output.write(data)) return;
+    await new Promise((resolve) => {
+        const done = () => {
+            output.off('drain', done);
+            output.off('close', done);
+            resolve();
+        };
+        output.on('drain', done);
+        output.on('close', done);
+    });
+    if (output.destroyed) throw new Error('Export aborted: client disconnected');
+}
+
+// ====== CSV ======
+
+// Satu task per worker; worker yang crash hanya menggagalkan task miliknya lalu diganti baru
+class CsvWorkerPool {
+    constructor(size) {
+        this.workers = [];
+        this.idle = [];
+        this.queue = [];
+        this.pending = new Map();
+        this.running = new Map();   // worker -> id task yang sedang dikerjakan
+        this.nextId = 0;
+        this.terminated = false;
+        for (let i = 0; i < size; i++) this.spawn();
+    }
+
+    spawn() {
+        const worker = new Worker(path.join(__dirname, 'export-worker.js'));
+        worker.unref();
+        worker.on('message', ({ id, buffer, length }) => {
+            const task = this.pending.get(id);
+            this.pending.delete(id);
+            this.running.delete(worker);
+            if (task) task.resolve(Buffer.from(buffer, 0, length));
+            this.release(worker);
+        });
+        worker.on('error', (error) => this.retire(worker, error));
+        worker.on('exit', (code) => this.retire(worker, new Error(`CSV worker exited with code ${code}`)));
+        this.workers.push(worker);
+        this.idle.push(worker);
+        return worker;
+    }
+
+    retire(worker, error) {
+        const index = this.workers.indexOf(worker);
+        if (index === -1) return;
+        this.workers.splice(index, 1);
+        this.idle = this.idle.filter((candidate) => candidate !== worker);
+        worker.terminate();
+
+        const id = this.running.get(worker);
+        this.running.delete(worker);
+        const task = this.pending.get(id);
+        if (task) {
+            this.pending.delete(id);
+            task.reject(error);
+        }
+        if (this.terminated) return;
+        console.error(`❌ [EXPORT] CSV worker failed, restarting: ${error.message}`);
+        this.spawn();
+        this.dispatch();
+    }
+
+    run(task) {
+        return new Promise((resolve, reject) => {
+            const id = this.nextId++;
+            this.pending.set(id, { resolve, reject });
+            this.queue.push({ id, ...task });
+            this.dispatch();
+        });
+    }
+
+    dispatch() {
+        while (this.idle.length && this.queue.length) {
+            const worker = this.idle.pop();
+            const task = this.queue.shift();
+            this.running.set(worker, task.id);
+            worker.postMessage(task, task.columns.map((array) => array.buffer));
+        }
+    }
+
+    release(worker) {
+        if (!this.workers.includes(worker)) return;
+        this.idle.push(worker);
+        this.dispatch();
+    }
+
+    terminate() {
+        this.terminated = true;
+        for (const worker of this.workers) worker.terminate();
+        this.workers = [];
+        this.idle = [];
+    }
+}
+
+let csvPool = null;
+
+// Batch baris lintas chunk, disalin ke typed array baru (bisa di-transfer ke worker)
+function* csvBatches(slices, columns) {
+    let index = 0;
+    let offset = slices.length ? slices[0].begin : 0;
+    while (index < slices.length) {
+        let rows = 0;
+        const parts = [];
+        while (index < slices.length && rows < CSV_BATCH_ROWS) {
+            const slice = slices[index];
+            const take = Math.min(slice.end - offset, CSV_BATCH_ROWS - rows);
+            parts.push({ chunk: slice.chunk, from: offset, to: offset + take });
+            rows += take;
+            offset += take;
+            if (offset === slice.end) {
+                index++;
+                if (index < slices.length) offset = slices[index].begin;
+            }
+        }
+
+        const batch = columns.map((column) => {
+            const array = new column.array(rows);
+            let at = 0;
+            for (const part of parts) {
+                array.set(part.chunk.columns[column.index].subarray(part.from, part.to), at);
+                at += part.to - part.from;
+            }
+            return array;
+        });
+        yield { columns: batch, rows };
+    }
+}
+
+async function exportCsv(output, slices, columns) {
+    const single = columns.map((column) => column.array === Float32Array);
+    await write(output, columns.map((column) => column.name).join(',') + '\n');
+
+    const rows = countRows(slices);
+    if (rows < PARALLEL_MIN_ROWS) {
+        for (const batch of csvBatches(slices, columns)) {
+            await write(output, formatCsvRows(batch.columns, single, batch.rows));
+            await new Promise(setImmediate);
+        }
+        return rows;
+    }
+
+    // Flight besar: beberapa batch diformat paralel, ditulis sesuai urutan
+    if (!csvPool) csvPool = new CsvWorkerPool(EXPORT_WORKERS);
+    const inFlight = [];
+    for (const batch of csvBatches(slices, columns)) {
+        inFlight.push(csvPool.run({ columns: batch.columns, single, rows: batch.rows }));
+        if (inFlight.length >= EXPORT_WORKERS * 2) await write(output, await inFlight.shift());
+    }
+    while (inFlight.length) await write(output, await inFlight.shift());
+    return rows;
+}
+
+// ====== PARQUET ======
+
+const THRIFT = { TRUE: 1, FALSE: 2, I32: 5, I64: 6, BINARY: 8, LIST: 9, STRUCT: 12 };
+const PARQUET_TYPE = { INT64: 2, FLOAT: 4, DOUBLE: 5 };
+const ENCODING_PLAIN = 0;
+const ENCODING_RLE = 3;
+const REPETITION_REQUIRED = 0;
+const CONVERTED_TIMESTAMP_MILLIS = 9;
+
+// Thrift compact protocol writer (subset yang dipakai metadata Parquet)
+class CompactWriter {
+    constructor() {
+        this.bytes = [];
+        this.lastField = [0];
+    }
+
+    byte(value) {
+        this.bytes.push(value & 0xFF);
+    }
+
+    varint(value) {
+        let v = BigInt(value);
+        while (v >= 0x80n) {
+            this.byte(Number(v & 0x7Fn) | 0x80);
+            v >>= 7n;
+        }
+        this.byte(Number(v));
+    }
+
+    zigzag(value) {
+        const v = BigInt(value);
+        this.varint(v >= 0n ? v << 1n : ((-v) << 1n) - 1n);
+    }
+
+    field(id, type) {
+        const delta = id - this.lastField[this.lastField.length - 1];
+        if (delta > 0 && delta <= 15) {
+            this.byte((delta << 4) | type);
+        } else {
+            this.byte(type);
+            this.zigzag(id);
+        }
+        this.lastField[this.lastField.length - 1] = id;
+    }
+
+    i32(id, value) { this.field(id, THRIFT.I32); this.zigzag(value); }
+    i64(id, value) { this.field(id, THRIFT.I64); this.zigzag(value); }
+    bool(id, value) { this.field(id, value ? THRIFT.TRUE : THRIFT.FALSE); }
+
+    binary(id, buffer) {
+        this.field(id, THRIFT.BINARY);
+        this.varint(buffer.length);
+        for (const b of buffer) this.byte(b);
+    }
+
+    string(id, text) { this.binary(id, Buffer.from(text, 'utf8')); }
+
+    beginStruct(id) {
+        this.field(id, THRIFT.STRUCT);
+        this.lastField.push(0);
+    }
+
+    endStruct() {
+        this.byte(0);
+        this.lastField.pop();
+    }
+
+    list(id, elementType, items, writeItem) {
+        this.field(id, THRIFT.LIST);
+        if (items.length < 15) this.byte((items.length << 4) | elementType);
+        else { this.byte(0xF0 | elementType); this.varint(items.length); }
+        for (const item of items) {
+            if (elementType === THRIFT.STRUCT) {
+                this.lastField.push(0);
+                writeItem(item);
+                this.endStruct();
+            } else {
+                writeItem(item);
+            }
+        }
+    }
+
+    toBuffer() {
+        return Buffer.from(this.bytes);
+    }
+}
+
+function parquetType(column) {
+    if (column.index === 0) return PARQUET_TYPE.INT64;
+    return column.array === Float32Array ? PARQUET_TYPE.FLOAT : PARQUET_TYPE.DOUBLE;
+}
+
+function valueBytes(type, value) {
+    const buffer = Buffer.alloc(type === PARQUET_TYPE.FLOAT ? 4 : 8);
+    if (type === PARQUET_TYPE.INT64) buffer.writeBigInt64LE(BigInt(Math.round(value)));
+    else if (type === PARQUET_TYPE.FLOAT) buffer.writeFloatLE(value);
+    else buffer.writeDoubleLE(value);
+    return buffer;
+}
+
+function writeStatistics(writer, id, type, stats) {
+    writer.beginStruct(id);
+    writer.i64(3, 0);
+    if (stats.min <= stats.max) {
+        writer.binary(5, valueBytes(type, stats.max));
+        writer.binary(6, valueBytes(type, stats.min));
+    }
+    writer.endStruct();
+}
+
+// Data page v1; kolom REQUIRED non-nested tidak punya repetition/definition level
+function encodePageHeader(type, rows, size, stats) {
+    const writer = new CompactWriter();
+    writer.i32(1, 0);
+    writer.i32(2, size);
+    writer.i32(3, size);
+    writer.beginStruct(5);
+    writer.i32(1, rows);
+    writer.i32(2, ENCODING_PLAIN);
+    writer.i32(3, ENCODING_RLE);
+    writer.i32(4, ENCODING_RLE);
+    writeStatistics(writer, 5, type, stats);
+    writer.endStruct();
+    writer.byte(0);
+    return writer.toBuffer();
+}
+
+// Potong slice chunk menjadi row group berisi ~ROW_GROUP_ROWS baris
+function* rowGroups(slices) {
+    let group = [];
+    let rows = 0;
+    for (const slice of slices) {
+        group.push(slice);
+        rows += slice.end - slice.begin;
+        if (rows >= ROW_GROUP_ROWS) {
+            yield { slices: group, rows };
+            group = [];
+            rows = 0;
+        }
+    }
+    if (rows > 0) yield { slices: group, rows };
+}
+
+// Byte PLAIN satu kolom dalam row group + min/max (NaN diabaikan)
+function columnPieces(column, group) {
+    const stats = { min: Infinity, max: -Infinity };
+    const pieces = group.slices.map(({ chunk, begin, end }) => {
+        const values = chunk.columns[column.index];
+        for (let i = begin; i < end; i++) {
+            const value = values[i];
+            if (value < stats.min) stats.min = value;
+            if (value > stats.max) stats.max = value;
+        }
+        if (column.index !== 0) return columnBytes(values, begin, end);
+
+        // Timestamp disimpan Float64 (ms) -> INT64
+        const converted = new BigInt64Array(end - begin);
+        for (let i = begin; i < end; i++) converted[i - begin] = BigInt(Math.round(values[i]));
+        return columnBytes(converted, 0, end - begin);
+    });
+    return { pieces, stats };
+}
+
+function encodeFileMetaData(columns, groups, totalRows, keyValues) {
+    const writer = new CompactWriter();
+    writer.i32(1, 1);
+    writer.list(2, THRIFT.STRUCT, [null, ...columns], (column) => {
+        if (!column) {
+            writer.string(4, 'schema');
+            writer.i32(5, columns.length);
+            return;
+        }
+        writer.i32(1, parquetType(column));
+        writer.i32(3, REPETITION_REQUIRED);
+        writer.string(4, column.name);
+        if (column.index === 0) {
+            writer.i32(6, CONVERTED_TIMESTAMP_MILLIS);
+            writer.beginStruct(10);      // LogicalType.TIMESTAMP
+            writer.beginStruct(8);
+            writer.bool(1, true);        // isAdjustedToUTC
+            writer.beginStruct(2);       // unit: MILLIS
+            writer.beginStruct(1);
+            writer.endStruct();
+            writer.endStruct();
+            writer.endStruct();
+            writer.endStruct();
+        }
+    });
+    writer.i64(3, totalRows);
+    writer.list(4, THRIFT.STRUCT, groups, (group) => {
+        writer.list(1, THRIFT.STRUCT, group.columns, (chunk) => {
+            writer.i64(2, chunk.offset);
+            writer.beginStruct(3);
+            writer.i32(1, chunk.type);
+            writer.list(2, THRIFT.I32, [ENCODING_PLAIN, ENCODING_RLE], (encoding) => writer.zigzag(encoding));
+            writer.list(3, THRIFT.BINARY, [chunk.name], (name) => {
+                const bytes = Buffer.from(name, 'utf8');
+                writer.varint(bytes.length);
+                for (const b of bytes) writer.byte(b);
+            });
+            writer.i32(4, 0);            // UNCOMPRESSED
+            writer.i64(5, group.rows);
+            writer.i64(6, chunk.size);
+            writer.i64(7, chunk.size);
+            writer.i64(9, chunk.offset);
+            writeStatistics(writer, 12, chunk.type, chunk.stats);
+            writer.endStruct();
+        });
+        writer.i64(2, group.bytes);
+        writer.i64(3, group.rows);
+        writer.i64(5, group.offset);
+        writer.i64(6, group.bytes);
+    });
+    writer.list(5, THRIFT.STRUCT, Object.entries(keyValues), ([key, value]) => {
+        writer.string(1, key);
+        writer.string(2, String(value));
+    });
+    writer.string(6, 'uav-dashboard telemetry export');
+    writer.byte(0);
+    return writer.toBuffer();
+}
+
+async function exportParquet(output, slices, columns, keyValues = {}) {
+    const magic = Buffer.from('PAR1', 'ascii');
+    await write(output, magic);
+    let offset = magic.length;
+    let totalRows = 0;
+    const groups = [];
+
+    for (const group of rowGroups(slices)) {
+        const groupOffset = offset;
+        const chunks = [];
+        for (const column of columns) {
+            const type = parquetType(column);
+            const { pieces, stats } = columnPieces(column, group);
+            const size = pieces.reduce((total, piece) => total + piece.length, 0);
+            const header = encodePageHeader(type, group.rows, size, stats);
+
+            chunks.push({ name: column.name, type, offset, size: header.length + size, stats });
+            await write(output, header);
+            for (const piece of pieces) await write(output, piece);
+            offset += header.length + size;
+        }
+        groups.push({ columns: chunks, rows: group.rows, offset: groupOffset, bytes: offset - groupOffset });
+        totalRows += group.rows;
+        await new Promise(setImmediate);
+    }
+
+    const footer = encodeFileMetaData(columns, groups, totalRows, keyValues);
+    const length = Buffer.alloc(4);
+    length.writeUInt32LE(footer.length);
+    await write(output, Buffer.concat([footer, length, magic]));
+    return totalRows;
+}
+
+function shutdownExportWorkers() {
+    if (csvPool) csvPool.terminate();
+    csvPool = null;
+}
+
+module.exports = { exportCsv, exportParquet, resolveColumns, countRows, shutdownExportWorkers };
@@ -0,0 +1,23 @@
+/**
+ * Telemetry Validation
+ * Pemeriksaan dasar payload telemetry sebelum di-ingest (dipakai jalur HTTP,
+ * juga diukur sendiri oleh benchmarks/server-bench.js).
+ */
+
+const NUMERIC_FIELDS = ['battery_voltage', 'battery_current', 'temperature', 'altitude', 'signal_strength'];
+
+// Return pesan error, atau null jika payload valid
+function validateTelemetry(data) {
+    if (!data || typeof data !== 'object') {
+        return 'Invalid telemetry data format';
+    }
+
+    for (const field of NUMERIC_FIELDS) {
+        if (data[field] !== undefined && (isNaN(data[field]) || !isFinite(data[field]))) {
+            return `Invalid ${field}: must be a valid number`;
+        }
+    }
+    return null;
+}
+
+module.exports = { validateTelemetry, NUMERIC_FIELDS };
@@ -0,0 +1,434 @@
+/**
+ * Analytics - kernel statistik window untuk histori telemetry (Node-API addon)
+ * Dipanggil lib/analytics.js per potongan chunk HistoryStore (kolom typed array),
+ * mengakumulasi ke state window: energi (integral daya trapesium), arus puncak,
+ * min/max tegangan + histogram tegangan (persentil sag), histogram ketinggian.
+ *
+ * Kernel dipilih saat load: AVX2 jika CPU mendukung, SSE2 (baseline x86-64),
+ * atau scalar (arsitektur lain). ANALYTICS_KERNEL=scalar|sse2|avx2 memaksa pilihan.
+ *
+ * JS: accumulate(t, power, current, voltage, altitude, begin, end, state, voltageHist, altitudeHist)
+ *     kernel() -> 'avx2' | 'sse2' | 'scalar';  setKernel(name) -> bool
+ * Layout state (Float64Array) sama dengan STATE di lib/analytics.js.
+ */
+
+#define NAPI_VERSION 6
+#include <node_api.h>
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ANALYTICS_X86 1
+#include <immintrin.h>
+#endif
+
+// ====== STATE LAYOUT ======
+enum StateIndex {
+    S_SAMPLES = 0,
+    S_ENERGY_J,
+    S_ENERGY_MS,        // Durasi interval yang ikut diintegrasi
+    S_PREV_T,           // Sampel terakhir (carry antar chunk/window)
+    S_PREV_P,
+    S_PEAK_CURRENT,
+    S_VOLT_MIN,
+    S_VOLT_MAX,
+    S_ALT_MIN,
+    S_ALT_MAX,
+    S_MAX_GAP_MS,       // Config: interval lebih panjang (link putus) tidak diintegrasi
+    S_ALT_ORIGIN_M,     // Config: batas bawah bin ketinggian pertama
+    S_ALT_BIN_M,        // Config: lebar bin ketinggian
+    S_VOLT_BIN_V,       // Config: lebar bin tegangan
+    STATE_SIZE
+};
+
+struct Block {
+    const double* t;
+    const float* power;
+    const float* current;
+    const float* voltage;
+    const float* altitude;
+    size_t n;
+};
+
+struct Histogram {
+    uint32_t* counts;
+    size_t bins;
+};
+
+typedef void (*AccumulateFn)(const Block&, double*, Histogram, Histogram);
+
+// ====== SCALAR ======
+
+static inline bool integrable(double dt, double p0, double p1, double maxGap) {
+    return dt > 0 && dt <= maxGap && !isnan(p0) && !isnan(p1);
+}
+
+// Interval pertama memakai sampel carry dari panggilan sebelumnya
+static void energyCarry(const Block& b, double* s) {
+    double dt = b.t[0] - s[S_PREV_T];
+    if (integrable(dt, s[S_PREV_P], b.power[0], s[S_MAX_GAP_MS])) {
+        s[S_ENERGY_J] += (s[S_PREV_P] + b.power[0]) * 0.5 * dt / 1000.0;
+        s[S_ENERGY_MS] += dt;
+    }
+}
+
+static void energyScalar(const Block& b, size_t from, double* s) {
+    double joules = 0;
+    double ms = 0;
+    const double maxGap = s[S_MAX_GAP_MS];
+    for (size_t i = from; i < b.n; i++) {
+        double dt = b.t[i] - b.t[i - 1];
+        if (integrable(dt, b.power[i - 1], b.power[i], maxGap)) {
+            joules += ((double)b.power[i - 1] + (double)b.power[i]) * 0.5 * dt;
+            ms += dt;
+        }
+    }
+    s[S_ENERGY_J] += joules / 1000.0;
+    s[S_ENERGY_MS] += ms;
+}
+
+// Aritmetika float (bukan double) supaya index bin identik dengan jalur AVX2 dan JS
+static inline void histogramAdd(Histogram h, float value, float origin, float inverseBin) {
+    if (isnan(value)) return;
+    float index = floorf((value - origin) * inverseBin);
+    if (index < 0) index = 0;
+    if (index > (float)(h.bins - 1)) index = (float)(h.bins - 1);
+    h.counts[(size_t)index]++;
+}
+
+static void extremaScalar(const Block& b, size_t from, double* s) {
+    float peak = -INFINITY, vMin = INFINITY, vMax = -INFINITY, aMin = INFINITY, aMax = -INFINITY;
+    for (size_t i = from; i < b.n; i++) {
+        // Perbandingan dengan NaN selalu false, jadi NaN otomatis dilewati
+        if (b.current[i] > peak) peak = b.current[i];
+        if (b.voltage[i] < vMin) vMin = b.voltage[i];
+        if (b.voltage[i] > vMax) vMax = b.voltage[i];
+        if (b.altitude[i] < aMin) aMin = b.altitude[i];
+        if (b.altitude[i] > aMax) aMax = b.altitude[i];
+    }
+    s[S_PEAK_CURRENT] = fmax(s[S_PEAK_CURRENT], peak);
+    s[S_VOLT_MIN] = fmin(s[S_VOLT_MIN], vMin);
+    s[S_VOLT_MAX] = fmax(s[S_VOLT_MAX], vMax);
+    s[S_ALT_MIN] = fmin(s[S_ALT_MIN], aMin);
+    s[S_ALT_MAX] = fmax(s[S_ALT_MAX], aMax);
+}
+
+static void histogramsScalar(const Block& b, size_t from, const double* s, Histogram volts, Histogram alts) {
+    const float voltInverse = (float)(1.0 / s[S_VOLT_BIN_V]);
+    const float altOrigin = (float)s[S_ALT_ORIGIN_M];
+    const float altInverse = (float)(1.0 / s[S_ALT_BIN_M]);
+    for (size_t i = from; i < b.n; i++) {
+        histogramAdd(volts, b.voltage[i], 0.0f, voltInverse);
+        histogramAdd(alts, b.altitude[i], altOrigin, altInverse);
+    }
+}
+
+static void accumulateScalar(const Block& b, double* s, Histogram volts, Histogram alts) {
+    energyScalar(b, 1, s);
+    extremaScalar(b, 0, s);
+    histogramsScalar(b, 0, s, volts, alts);
+}
+
+#ifdef ANALYTICS_X86
+
+// ====== SSE2 ======
+
+static inline float horizontalMax(__m128 v) {
+    v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(v);
+}
+
+static inline float horizontalMin(__m128 v) {
+    v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(v);
+}
+
+static inline __m128d loadTwoFloats(const float* p) {
+    return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i*)p)));
+}
+
+static void accumulateSse2(const Block& b, double* s, Histogram volts, Histogram alts) {
+    // Energi: 2 interval per iterasi (double)
+    const __m128d maxGap = _mm_set1_pd(s[S_MAX_GAP_MS]);
+    const __m128d half = _mm_set1_pd(0.5);
+    __m128d joules = _mm_setzero_pd();
+    __m128d ms = _mm_setzero_pd();
+    size_t i = 1;
+    for (; i + 2 <= b.n; i += 2) {
+        __m128d dt = _mm_sub_pd(_mm_loadu_pd(b.t + i), _mm_loadu_pd(b.t + i - 1));
+        __m128d p0 = loadTwoFloats(b.power + i - 1);
+        __m128d p1 = loadTwoFloats(b.power + i);
+        __m128d valid = _mm_and_pd(_mm_and_pd(_mm_cmpgt_pd(dt, _mm_setzero_pd()), _mm_cmple_pd(dt, maxGap)),
+                                   _mm_cmpord_pd(p0, p1));
+        joules = _mm_add_pd(joules, _mm_and_pd(valid, _mm_mul_pd(_mm_mul_pd(_mm_add_pd(p0, p1), half), dt)));
+        ms = _mm_add_pd(ms, _mm_and_pd(valid, dt));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, joules);
+    s[S_ENERGY_J] += (lanes[0] + lanes[1]) / 1000.0;
+    _mm_storeu_pd(lanes, ms);
+    s[S_ENERGY_MS] += lanes[0] + lanes[1];
+    energyScalar(b, i, s);
+
+    // Min/max: 4 float per iterasi; maxps(x, acc) mengembalikan acc jika x NaN
+    __m128 peak = _mm_set1_ps(-INFINITY), vMin = _mm_set1_ps(INFINITY), vMax = _mm_set1_ps(-INFINITY);
+    __m128 aMin = _mm_set1_ps(INFINITY), aMax = _mm_set1_ps(-INFINITY);
+    size_t j = 0;
+    for (; j + 4 <= b.n; j += 4) {
+        __m128 c = _mm_loadu_ps(b.current + j);
+        __m128 v = _mm_loadu_ps(b.voltage + j);
+        __m128 a = _mm_loadu_ps(b.altitude + j);
+        peak = _mm_max_ps(c, peak);
+        vMin = _mm_min_ps(v, vMin);
+        vMax = _mm_max_ps(v, vMax);
+        aMin = _mm_min_ps(a, aMin);
+        aMax = _mm_max_ps(a, aMax);
+    }
+    s[S_PEAK_CURRENT] = fmax(s[S_PEAK_CURRENT], horizontalMax(peak));
+    s[S_VOLT_MIN] = fmin(s[S_VOLT_MIN], horizontalMin(vMin));
+    s[S_VOLT_MAX] = fmax(s[S_VOLT_MAX], horizontalMax(vMax));
+    s[S_ALT_MIN] = fmin(s[S_ALT_MIN], horizontalMin(aMin));
+    s[S_ALT_MAX] = fmax(s[S_ALT_MAX], horizontalMax(aMax));
+    extremaScalar(b, j, s);
+
+    histogramsScalar(b, 0, s, volts, alts);
+}
+
+// ====== AVX2 ======
+
+__attribute__((target("avx2")))
+static inline float horizontalMax256(__m256 v) {
+    __m128 m = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    m = _mm_max_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = _mm_max_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(m);
+}
+
+__attribute__((target("avx2")))
+static inline float horizontalMin256(__m256 v) {
+    __m128 m = _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(m);
+}
+
+__attribute__((target("avx2")))
+static inline double horizontalSum256(__m256d v) {
+    __m128d m = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(m, _mm_unpackhi_pd(m, m)));
+}
+
+// Index bin 8 sampel sekaligus; lane NaN tidak dihitung (mask movemask)
+__attribute__((target("avx2")))
+static inline void histogramAdd8(Histogram h, __m256 values, __m256 origin, __m256 inverseBin, __m256i last) {
+    int valid = _mm256_movemask_ps(_mm256_cmp_ps(values, values, _CMP_ORD_Q));
+    __m256 scaled = _mm256_floor_ps(_mm256_mul_ps(_mm256_sub_ps(values, origin), inverseBin));
+    scaled = _mm256_max_ps(scaled, _mm256_setzero_ps());
+    __m256i index = _mm256_min_epi32(_mm256_cvttps_epi32(_mm256_min_ps(scaled, _mm256_cvtepi32_ps(last))), last);
+    alignas(32) int32_t lanes[8];
+    _mm256_store_si256((__m256i*)lanes, index);
+    for (int k = 0; k < 8; k++) {
+        if (valid & (1 << k)) h.counts[lanes[k]]++;
+    }
+}
+
+__attribute__((target("avx2")))
+static void accumulateAvx2(const Block& b, double* s, Histogram volts, Histogram alts) {
+    // Energi: 4 interval per iterasi (double, daya float dikonversi)
+    const __m256d maxGap = _mm256_set1_pd(s[S_MAX_GAP_MS]);
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d zero = _mm256_setzero_pd();
+    __m256d joules = zero;
+    __m256d ms = zero;
+    size_t i = 1;
+    for (; i + 4 <= b.n; i += 4) {
+        __m256d dt = _mm256_sub_pd(_mm256_loadu_pd(b.t + i), _mm256_loadu_pd(b.t + i - 1));
+        __m256d p0 = _mm256_cvtps_pd(_mm_loadu_ps(b.power + i - 1));
+        __m256d p1 = _mm256_cvtps_pd(_mm_loadu_ps(b.power + i));
+        __m256d valid = _mm256_and_pd(
+            _mm256_and_pd(_mm256_cmp_pd(dt, zero, _CMP_GT_OQ), _mm256_cmp_pd(dt, maxGap, _CMP_LE_OQ)),
+            _mm256_cmp_pd(p0, p1, _CMP_ORD_Q));
+        joules = _mm256_add_pd(joules, _mm256_and_pd(valid, _mm256_mul_pd(_mm256_mul_pd(_mm256_add_pd(p0, p1), half), dt)));
+        ms = _mm256_add_pd(ms, _mm256_and_pd(valid, dt));
+    }
+    s[S_ENERGY_J] += horizontalSum256(joules) / 1000.0;
+    s[S_ENERGY_MS] += horizontalSum256(ms);
+    energyScalar(b, i, s);
+
+    // Min/max + histogram: 8 float per iterasi
+    const __m256 voltOrigin = _mm256_setzero_ps();
+    const __m256 voltInverse = _mm256_set1_ps((float)(1.0 / s[S_VOLT_BIN_V]));
+    const __m256 altOrigin = _mm256_set1_ps((float)s[S_ALT_ORIGIN_M]);
+    const __m256 altInverse = _mm256_set1_ps((float)(1.0 / s[S_ALT_BIN_M]));
+    const __m256i voltLast = _mm256_set1_epi32((int32_t)(volts.bins - 1));
+    const __m256i altLast = _mm256_set1_epi32((int32_t)(alts.bins - 1));
+    __m256 peak = _mm256_set1_ps(-INFINITY), vMin = _mm256_set1_ps(INFINITY), vMax = _mm256_set1_ps(-INFINITY);
+    __m256 aMin = _mm256_set1_ps(INFINITY), aMax = _mm256_set1_ps(-INFINITY);
+    size_t j = 0;
+    for (; j + 8 <= b.n; j += 8) {
+        __m256 c = _mm256_loadu_ps(b.current + j);
+        __m256 v = _mm256_loadu_ps(b.voltage + j);
+        __m256 a = _mm256_loadu_ps(b.altitude + j);
+        peak = _mm256_max_ps(c, peak);
+        vMin = _mm256_min_ps(v, vMin);
+        vMax = _mm256_max_ps(v, vMax);
+        aMin = _mm256_min_ps(a, aMin);
+        aMax = _mm256_max_ps(a, aMax);
+        histogramAdd8(volts, v, voltOrigin, voltInverse, voltLast);
+        histogramAdd8(alts, a, altOrigin, altInverse, altLast);
+    }
+    s[S_PEAK_CURRENT] = fmax(s[S_PEAK_CURRENT], horizontalMax256(peak));
+    s[S_VOLT_MIN] = fmin(s[S_VOLT_MIN], horizontalMin256(vMin));
+    s[S_VOLT_MAX] = fmax(s[S_VOLT_MAX], horizontalMax256(vMax));
+    s[S_ALT_MIN] = fmin(s[S_ALT_MIN], horizontalMin256(aMin));
+    s[S_ALT_MAX] = fmax(s[S_ALT_MAX], horizontalMax256(aMax));
+    extremaScalar(b, j, s);
+    histogramsScalar(b, j, s, volts, alts);
+}
+
+#endif
+
+// ====== DISPATCH ======
+
+static AccumulateFn activeKernel = accumulateScalar;
+static const char* activeName = "scalar";
+
+static bool selectKernel(const char* name) {
+    if (strcmp(name, "scalar") == 0) {
+        activeKernel = accumulateScalar;
+        activeName = "scalar";
+        return true;
+    }
+#ifdef ANALYTICS_X86
+    if (strcmp(name, "sse2") == 0) {
+        activeKernel = accumulateSse2;
+        activeName = "sse2";
+        return true;
+    }
+    if (strcmp(name, "avx2") == 0 && __builtin_cpu_supports("avx2")) {
+        activeKernel = accumulateAvx2;
+        activeName = "avx2";
+        return true;
+    }
+#endif
+    return false;
+}
+
+static void selectDefaultKernel() {
+    const char* forced = getenv("ANALYTICS_KERNEL");
+    if (forced && selectKernel(forced)) return;
+    if (!selectKernel("avx2") && !selectKernel("sse2")) selectKernel("scalar");
+}
+
+// ====== NODE-API ======
+
+static bool typedArray(napi_env env, napi_value value, napi_typedarray_type expected, void** data, size_t* length) {
+    bool isTypedArray = false;
+    napi_typedarray_type type;
+    if (napi_is_typedarray(env, value, &isTypedArray) != napi_ok || !isTypedArray) return false;
+    if (napi_get_typedarray_info(env, value, &type, length, data, nullptr, nullptr) != napi_ok) return false;
+    return type == expected;
+}
+
+static napi_value Accumulate(napi_env env, napi_callback_info info) {
+    size_t argc = 10;
+    napi_value argv[10];
+    napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+    if (argc < 10) {
+        napi_throw_type_error(env, nullptr, "accumulate expects 10 arguments");
+        return nullptr;
+    }
+
+    void* columns[5];
+    size_t lengths[5];
+    static const napi_typedarray_type types[5] = {
+        napi_float64_array, napi_float32_array, napi_float32_array, napi_float32_array, napi_float32_array
+    };
+    for (int k = 0; k < 5; k++) {
+        if (!typedArray(env, argv[k], types[k], &columns[k], &lengths[k])) {
+            napi_throw_type_error(env, nullptr, "columns must be Float64Array (timestamp) + Float32Array x4");
+            return nullptr;
+        }
+    }
+
+    int64_t begin = 0;
+    int64_t end = 0;
+    napi_get_value_int64(env, argv[5], &begin);
+    napi_get_value_int64(env, argv[6], &end);
+
+    void* state;
+    void* voltCounts;
+    void* altCounts;
+    size_t stateLength, voltBins, altBins;
+    if (!typedArray(env, argv[7], napi_float64_array, &state, &stateLength) || stateLength < STATE_SIZE ||
+        !typedArray(env, argv[8], napi_uint32_array, &voltCounts, &voltBins) || voltBins == 0 ||
+        !typedArray(env, argv[9], napi_uint32_array, &altCounts, &altBins) || altBins == 0) {
+        napi_throw_type_error(env, nullptr, "state must be Float64Array, histograms Uint32Array");
+        return nullptr;
+    }
+
+    size_t rows = lengths[0];
+    for (int k = 1; k < 5; k++) {
+        if (lengths[k] < rows) rows = lengths[k];
+    }
+    if (begin < 0 || end < begin || (size_t)end > rows) {
+        napi_throw_range_error(env, nullptr, "row range out of bounds");
+        return nullptr;
+    }
+    if (end == begin) return nullptr;
+
+    Block block = {
+        (const double*)columns[0] + begin,
+        (const float*)columns[1] + begin,
+        (const float*)columns[2] + begin,
+        (const float*)columns[3] + begin,
+        (const float*)columns[4] + begin,
+        (size_t)(end - begin)
+    };
+    double* s = (double*)state;
+    energyCarry(block, s);
+    activeKernel(block, s, Histogram{ (uint32_t*)voltCounts, voltBins }, Histogram{ (uint32_t*)altCounts, altBins });
+    s[S_SAMPLES] += (double)block.n;
+    s[S_PREV_T] = block.t[block.n - 1];
+    s[S_PREV_P] = block.power[block.n - 1];
+    return nullptr;
+}
+
+static napi_value Kernel(napi_env env, napi_callback_info) {
+    napi_value name;
+    napi_create_string_utf8(env, activeName, NAPI_AUTO_LENGTH, &name);
+    return name;
+}
+
+static napi_value SetKernel(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    char name[16] = { 0 };
+    size_t length = 0;
+    napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+    bool ok = argc == 1 &&
+        napi_get_value_string_utf8(env, argv[0], name, sizeof(name), &length) == napi_ok &&
+        selectKernel(name);
+    napi_value result;
+    napi_get_boolean(env, ok, &result);
+    return result;
+}
+
+static napi_value Init(napi_env env, napi_value exports) {
+    selectDefaultKernel();
+    napi_property_descriptor properties[] = {
+        { "accumulate", nullptr, Accumulate, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "kernel", nullptr, Kernel, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setKernel", nullptr, SetKernel, nullptr, nullptr, nullptr, napi_default, nullptr }
+    };
+    napi_define_properties(env, exports, sizeof(properties) / sizeof(properties[0]), properties);
+    return exports;
+}
+
+NAPI_MODULE(analytics, Init)
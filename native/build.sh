@@ -0,0 +1,35 @@
+#!/bin/sh
+# Compile tool native ground station (Linux, g++ C++17).
+# Usage: native/build.sh [output_dir]
+set -e
+
+NATIVE_DIR="$(cd "$(dirname "$0")" && pwd)"
+OUT_DIR="${1:-$NATIVE_DIR/build}"
+CXX="${CXX:-g++}"
+mkdir -p "$OUT_DIR"
+
+"$CXX" -std=c++17 -O2 -Wall -Wextra -Werror -pthread \
+    -o "$OUT_DIR/serial_bridge" "$NATIVE_DIR/serial_bridge.cpp"
+
+"$CXX" -std=c++17 -O2 -Wall -Wextra -Werror \
+    -o "$OUT_DIR/fec_link" "$NATIVE_DIR/fec_link.cpp"
+
+"$CXX" -std=c++17 -O2 -Wall -Wextra -Werror -pthread \
+    -o "$OUT_DIR/ingest_sidecar" "$NATIVE_DIR/ingest_sidecar.cpp"
+
+# Node-API addon untuk /api/analytics (lib/analytics.js fallback ke JS jika tidak ada)
+NODE_INCLUDE="$(node -p "require('path').resolve(process.execPath, '../../include/node')" 2>/dev/null || true)"
+if [ -f "$NODE_INCLUDE/node_api.h" ]; then
+    "$CXX" -std=c++17 -O2 -Wall -Wextra -Werror -shared -fPIC -I"$NODE_INCLUDE" \
+        -o "$OUT_DIR/analytics.node" "$NATIVE_DIR/analytics.cpp"
+    # Point-in-polygon geofence (opsional, GEOFENCE_NATIVE=1); tanpa FMA agar identik dengan JS
+    "$CXX" -std=c++17 -O2 -ffp-contract=off -Wall -Wextra -Werror -shared -fPIC -I"$NODE_INCLUDE" \
+        -o "$OUT_DIR/geofence.node" "$NATIVE_DIR/geofence.cpp"
+    # Consumer ring ingest_sidecar (INGEST_SIDECAR_SHM)
+    "$CXX" -std=c++17 -O2 -Wall -Wextra -Werror -shared -fPIC -I"$NODE_INCLUDE" \
+        -o "$OUT_DIR/ingest_ring.node" "$NATIVE_DIR/ingest_ring.cpp"
+else
+    echo "⚠️ Node headers not found, skipping analytics.node / geofence.node / ingest_ring.node (JS fallback is used)"
+fi
+
+echo "✅ Native tools built in $OUT_DIR"
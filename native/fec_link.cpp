@@ -0,0 +1,729 @@
+/**
+ * FEC Link - ground station untuk FecUdpTransport
+ * Memulihkan datagram telemetry yang hilang dari parity Reed-Solomon
+ * (ESP32/ESP32_dashboard/fec_codec.h) tanpa retransmisi.
+ *
+ * Mode:
+ *   fec_link receive [--listen 14551] [--forward 127.0.0.1:14550]
+ *       Terima datagram FEC dari device, teruskan MAVLink asli ke server.js
+ *       (data langsung, yang hilang begitu parity cukup), kirim feedback loss
+ *       ke device tiap detik agar redundansi menyesuaikan.
+ *   fec_link proxy --listen 14551 --to 127.0.0.1:14553 --loss 0.1 [--burst 3]
+ *       Loss injection: buang datagram device -> ground station (i.i.d. atau
+ *       burst Gilbert-Elliott), balasan (feedback) diteruskan tanpa loss.
+ *   fec_link bench [--frames 20000] [--interval-ms 3000] [--deadline-ms 500] [--k 4] [--loss 0.05] [--burst 1] [--r auto|n]
+ *       Simulasi link dengan model loss yang sama dan aturan grup firmware
+ *       (DATA_SEND_INTERVAL, FEC_GROUP_DEADLINE; --deadline-ms 0 = selalu grup
+ *       penuh); tanpa --loss/--r menjalankan sweep dan mencetak frame pulih,
+ *       loss sisa, overhead bandwidth dan latency tambahan untuk frame yang dipulihkan.
+ */
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <functional>
+#include <map>
+#include <math.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <queue>
+#include <random>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#include "../ESP32/ESP32_dashboard/fec_codec.h"
+#include "../ESP32/ESP32_dashboard/firmware_config.h"
+
+static const size_t MAX_DATAGRAM = 1500;
+static const int GROUP_WINDOW = 8;           // Grup yang ditahan untuk menunggu parity/reorder
+static const double FEEDBACK_INTERVAL_MS = 1000;
+static const double LOSS_WINDOW_MS = 120000;  // Estimasi loss per datagram, decay eksponensial
+
+static volatile sig_atomic_t running = 1;
+
+static double monotonicMs() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000.0 + now.tv_nsec / 1e6;
+}
+
+static double percentile(std::vector<double> samples, double q) {
+    if (samples.empty()) return 0;
+    std::sort(samples.begin(), samples.end());
+    return samples[(size_t)(q * (samples.size() - 1))];
+}
+
+// ================== RECEIVER CORE ==================
+struct ReceiverStats {
+    unsigned long expected = 0;       // Datagram data yang seharusnya datang (grup final)
+    unsigned long receivedRaw = 0;    // Datang langsung
+    unsigned long recovered = 0;      // Dipulihkan dari parity
+    unsigned long unrecoverable = 0;
+    unsigned long parityReceived = 0;
+    unsigned long dataBytes = 0;
+    unsigned long overheadBytes = 0;  // Header FEC + datagram parity
+    unsigned long lateDatagrams = 0;
+};
+
+/**
+ * Satu instance per device. deliver() dipanggil untuk setiap datagram MAVLink
+ * asli (langsung atau hasil pemulihan), waktu memakai clock caller (ms) sehingga
+ * core yang sama dipakai untuk socket nyata maupun bench simulasi.
+ */
+class FecReceiver {
+public:
+    typedef std::function<void(const uint8_t* data, size_t length, bool recovered, double waitMs)> Deliver;
+
+    explicit FecReceiver(Deliver deliver) : deliver(deliver), groups(GROUP_WINDOW) {}
+
+    void onDatagram(const uint8_t* datagram, size_t length, double nowMs) {
+        FecHeader header;
+        if (!fecReadHeader(datagram, length, header) || header.type == FEC_TYPE_FEEDBACK) return;
+
+        lastNowMs = nowMs;
+        Group* group = groupFor(header, nowMs);
+        const uint8_t* body = datagram + FEC_HEADER_LEN;
+        size_t bodyLength = length - FEC_HEADER_LEN;
+        stats.overheadBytes += FEC_HEADER_LEN;
+
+        if (!group) {
+            // Terlambat di luar window: data tetap berguna, parity tidak
+            stats.lateDatagrams++;
+            if (header.type == FEC_TYPE_DATA) deliver(body, bodyLength, false, 0);
+            return;
+        }
+        if (group->have[header.index]) {
+            // Parity menyalip data terakhir: data sudah dipulihkan, tapi tidak hilang
+            if (header.type == FEC_TYPE_DATA && group->wasRecovered[header.index]) {
+                group->wasRecovered[header.index] = false;
+                group->recovered--;
+                group->rawData++;
+                stats.dataBytes += bodyLength;
+            }
+            return;
+        }
+
+        if (header.type == FEC_TYPE_DATA) {
+            memcpy(group->symbols[header.index], body, bodyLength);
+            group->lengths[header.index] = (uint16_t)bodyLength;
+            group->have[header.index] = true;
+            group->rawData++;
+            stats.dataBytes += bodyLength;
+            deliver(body, bodyLength, false, 0);
+        } else {
+            // Grup ditutup lebih awal oleh deadline: k final dari parity, bukan rencana di data
+            if (header.k < group->k) {
+                for (uint8_t j = header.k; j < group->k; j++) {
+                    if (group->have[j]) return;
+                }
+                group->k = header.k;
+                group->r = header.r;
+            }
+            size_t lengthBytes = 2 * group->k;
+            if (bodyLength < lengthBytes) return;
+            for (uint8_t j = 0; j < group->k; j++) {
+                group->lengths[j] = (uint16_t)(body[2 * j] | (body[2 * j + 1] << 8));
+            }
+            group->symbolLength = bodyLength - lengthBytes;
+            memcpy(group->symbols[header.index], body + lengthBytes, group->symbolLength);
+            group->have[header.index] = true;
+            group->lengthsKnown = true;
+            stats.parityReceived++;
+            stats.overheadBytes += bodyLength;
+        }
+        tryRecover(*group, nowMs);
+    }
+
+    // Loss data mentah (sebelum FEC) per datagram dalam ~LOSS_WINDOW_MS terakhir, permil;
+    // false jika belum ada grup final baru
+    bool takeLoss(uint16_t& lossPermille) {
+        if (!lossUpdated) return false;
+        lossUpdated = false;
+        lossPermille = (uint16_t)(lossLost / lossExpected * 1000 + 0.5);
+        return true;
+    }
+
+    void finish() {
+        for (Group& group : groups) {
+            if (group.used) finalize(group, lastNowMs);
+        }
+    }
+
+    ReceiverStats stats;
+
+private:
+    struct Group {
+        bool used = false;
+        uint16_t id = 0;
+        uint8_t k = 0;
+        uint8_t r = 0;
+        bool have[FEC_MAX_K + FEC_MAX_R] = {};
+        bool wasRecovered[FEC_MAX_K] = {};
+        uint16_t lengths[FEC_MAX_K] = {};
+        bool lengthsKnown = false;
+        size_t symbolLength = 0;
+        uint8_t rawData = 0;
+        uint8_t recovered = 0;
+        double firstSeenMs = 0;
+        uint8_t symbols[FEC_MAX_K + FEC_MAX_R][MAX_DATAGRAM];
+    };
+
+    Deliver deliver;
+    std::vector<Group> groups;
+    bool haveHighest = false;
+    uint16_t highest = 0;
+    uint8_t lastK = 0;
+    double lossExpected = 0;    // Datagram data (decayed) dalam window loss
+    double lossLost = 0;
+    double lossAt = 0;
+    double lastNowMs = 0;
+    bool lossUpdated = false;
+
+    Group* groupFor(const FecHeader& header, double nowMs) {
+        if (haveHighest) {
+            int16_t ahead = (int16_t)(header.group - highest);
+            if (ahead < -(GROUP_WINDOW - 1)) return nullptr;
+            if (ahead > 0) {
+                // Grup yang sama sekali tidak terlihat tetap dihitung hilang
+                if (ahead > 1 && lastK > 0) {
+                    unsigned long skipped = (unsigned long)(ahead - 1) * lastK;
+                    stats.expected += skipped;
+                    stats.unrecoverable += skipped;
+                    updateLoss(skipped, skipped, nowMs);
+                }
+                highest = header.group;
+                // Grup dua langkah di belakang dianggap final (toleransi reorder satu grup)
+                for (Group& group : groups) {
+                    if (group.used && (int16_t)(highest - group.id) >= 2) finalize(group, nowMs);
+                }
+            }
+        } else {
+            haveHighest = true;
+            highest = header.group;
+        }
+
+        Group& group = groups[header.group % GROUP_WINDOW];
+        if (group.used && group.id != header.group) {
+            if ((int16_t)(header.group - group.id) < 0) return nullptr;
+            finalize(group, nowMs);
+        }
+        if (!group.used) {
+            group.used = true;
+            group.id = header.group;
+            group.k = header.k;
+            group.r = header.r;
+            group.lengthsKnown = false;
+            group.symbolLength = 0;
+            group.rawData = 0;
+            group.recovered = 0;
+            group.firstSeenMs = nowMs;
+            memset(group.have, 0, sizeof(group.have));
+            memset(group.wasRecovered, 0, sizeof(group.wasRecovered));
+            memset(group.symbols, 0, sizeof(group.symbols));
+            lastK = header.k;
+        }
+        return &group;
+    }
+
+    void tryRecover(Group& group, double nowMs) {
+        if (!group.lengthsKnown || group.rawData + group.recovered == group.k) return;
+
+        const uint8_t* symbols[FEC_MAX_K + FEC_MAX_R];
+        uint8_t* recovered[FEC_MAX_K];
+        int available = 0;
+        for (int i = 0; i < group.k + group.r; i++) {
+            symbols[i] = group.have[i] ? group.symbols[i] : nullptr;
+            if (group.have[i]) available++;
+        }
+        if (available < group.k) return;
+        for (int j = 0; j < group.k; j++) recovered[j] = group.symbols[j];
+
+        if (fecRecover(group.k, group.r, symbols, group.symbolLength, recovered) <= 0) return;
+        for (uint8_t j = 0; j < group.k; j++) {
+            if (group.have[j]) continue;
+            group.have[j] = true;
+            group.wasRecovered[j] = true;
+            group.recovered++;
+            deliver(group.symbols[j], group.lengths[j], true, nowMs - group.firstSeenMs);
+        }
+    }
+
+    void finalize(Group& group, double nowMs) {
+        stats.expected += group.k;
+        stats.receivedRaw += group.rawData;
+        stats.recovered += group.recovered;
+        stats.unrecoverable += group.k - group.rawData - group.recovered;
+        updateLoss(group.k, group.k - group.rawData, nowMs);
+        group.used = false;
+    }
+
+    // Dihitung per datagram dalam window waktu, bukan per grup: pada 3000 ms grup hanya k=1,
+    // loss per grup 0 atau 1 dan rata-rata per grup jatuh ke nol beberapa grup setelah loss
+    void updateLoss(double expected, double lost, double nowMs) {
+        double decay = exp(-std::max(0.0, nowMs - lossAt) / LOSS_WINDOW_MS);
+        lossExpected = lossExpected * decay + expected;
+        lossLost = lossLost * decay + lost;
+        lossAt = nowMs;
+        lossUpdated = lossExpected > 0;
+    }
+};
+
+// ================== LOSS MODEL ==================
+// Gilbert-Elliott: rata-rata loss `loss`, rata-rata panjang burst `burst` (1 = i.i.d.).
+// Burst i.i.d. rata-rata 1/(1-loss); lebih pendek berarti loss beruntun mustahil
+class LossModel {
+public:
+    LossModel(double loss, double burst, unsigned seed) : loss(loss), rng(seed) {
+        if (loss < 1) burst = std::max(1.0 / (1 - loss), burst);
+        badToGood = 1.0 / burst;
+        goodToBad = loss >= 1 ? 1 : loss * badToGood / (1 - loss);
+    }
+
+    bool drop() {
+        if (loss <= 0) return false;
+        std::uniform_real_distribution<double> uniform(0, 1);
+        bad = bad ? uniform(rng) >= badToGood : uniform(rng) < goodToBad;
+        return bad;
+    }
+
+private:
+    double loss;
+    double goodToBad = 0;
+    double badToGood = 1;
+    bool bad = false;
+    std::mt19937 rng;
+};
+
+// ================== BENCH ==================
+struct BenchConfig {
+    long frames = 20000;
+    double intervalMs = DATA_SEND_INTERVAL;
+    double deadlineMs = FEC_GROUP_DEADLINE;   // 0 = grup selalu penuh
+    int k = FEC_GROUP_SIZE;
+    int r = -1;                  // -1 = adaptif lewat feedback
+    double loss = 0.05;
+    double burst = 1;
+    double delayMs = 5;
+    double jitterMs = 2;
+    size_t datagramBytes = 272;  // Satu siklus MAVLink firmware
+};
+
+struct BenchResult {
+    unsigned long delivered = 0;
+    unsigned long recovered = 0;
+    unsigned long lostRaw = 0;
+    double overhead = 0;
+    double averageParity = 0;
+    double addedP50 = 0;
+    double addedP99 = 0;
+    double addedMax = 0;
+};
+
+static BenchResult runBench(const BenchConfig& config, unsigned seed) {
+    struct Event {
+        double at;
+        long order;
+        std::vector<uint8_t> datagram;
+        bool operator>(const Event& other) const { return at > other.at || (at == other.at && order > other.order); }
+    };
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> jitter(0, config.jitterMs);
+    LossModel lossModel(config.loss, config.burst, seed + 1);
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> inFlight;
+
+    std::vector<double> arrivalAt(config.frames, 0);   // Waktu tiba seandainya tidak hilang
+    std::vector<bool> seen(config.frames, false);
+    std::vector<bool> dropped(config.frames, false);
+    std::vector<double> addedLatency;
+    BenchResult result;
+    double now = 0;
+
+    FecReceiver receiver([&](const uint8_t* data, size_t, bool recovered, double) {
+        uint32_t sequence;
+        memcpy(&sequence, data, sizeof(sequence));
+        if (sequence >= (uint32_t)config.frames || seen[sequence]) return;
+        seen[sequence] = true;
+        result.delivered++;
+        if (recovered && dropped[sequence]) {
+            result.recovered++;
+            addedLatency.push_back(std::max(0.0, now - arrivalAt[sequence]));   // Parity bisa mendahului jitter data
+        }
+    });
+
+    // Sender: encoder dan aturan grup firmware yang sama (FecUdpTransport), redundansi
+    // per grup dari feedback dengan batas firmware. Interval konstan -> ukuran grup rencana selalu tepat
+    FecGroupEncoder<MAX_DATAGRAM> encoder;
+    uint8_t parity = config.r >= 0 ? (uint8_t)config.r : FEC_DEFAULT_PARITY;
+    int groupSize = config.k;
+    if (config.deadlineMs > 0) groupSize = std::min(config.k, 1 + (int)(config.deadlineMs / config.intervalMs));
+    uint16_t group = 0;
+    bool groupOpen = false;
+    double groupStartedAt = 0;
+    unsigned long groupsStarted = 0;
+    unsigned long paritySum = 0;
+    unsigned long dataBytes = 0;
+    unsigned long wireBytes = 0;
+    double nextFeedback = FEEDBACK_INTERVAL_MS;
+    long order = 0;
+    std::vector<uint8_t> payload(config.datagramBytes);
+
+    auto transmit = [&](std::vector<uint8_t> datagram, double arrival) {
+        wireBytes += datagram.size();
+        if (lossModel.drop()) return false;
+        inFlight.push(Event{arrival, order++, std::move(datagram)});
+        return true;
+    };
+    auto deliverUntil = [&](double limit) {
+        while (!inFlight.empty() && inFlight.top().at <= limit) {
+            Event event = inFlight.top();
+            inFlight.pop();
+            now = event.at;
+            receiver.onDatagram(event.datagram.data(), event.datagram.size(), now);
+        }
+    };
+    auto closeGroup = [&](double at) {
+        encoder.truncate();
+        for (uint8_t row = 0; row < parity; row++) {
+            std::vector<uint8_t> parityDatagram(FEC_HEADER_LEN + 2 * config.k + MAX_DATAGRAM);
+            parityDatagram.resize(encoder.buildParity(row, group, parityDatagram.data(), parityDatagram.size()));
+            transmit(std::move(parityDatagram), at + config.delayMs + jitter(rng));
+        }
+        groupOpen = false;
+    };
+
+    for (long i = 0; i < config.frames; i++) {
+        double at = i * config.intervalMs;
+        // Deadline firmware (loop()) lewat sebelum frame berikutnya: grup parsial ditutup
+        if (groupOpen && config.deadlineMs > 0 && groupStartedAt + config.deadlineMs <= at) {
+            deliverUntil(groupStartedAt + config.deadlineMs);
+            closeGroup(groupStartedAt + config.deadlineMs);
+        }
+        deliverUntil(at);
+        now = at;
+
+        if (at >= nextFeedback) {
+            uint16_t loss;
+            if (config.r < 0 && receiver.takeLoss(loss)) {
+                parity = fecParityForLoss(loss, (uint8_t)groupSize, FEC_MIN_PARITY, FEC_MAX_PARITY);
+            }
+            nextFeedback += FEEDBACK_INTERVAL_MS;
+        }
+
+        if (!groupOpen) {
+            group++;
+            encoder.reset((uint8_t)groupSize, parity);
+            groupOpen = true;
+            groupStartedAt = at;
+            groupsStarted++;
+            paritySum += parity;
+        }
+
+        uint32_t sequence = (uint32_t)i;
+        memcpy(payload.data(), &sequence, sizeof(sequence));
+        for (size_t b = sizeof(sequence); b < payload.size(); b++) payload[b] = (uint8_t)(rng() & 0xFF);
+        arrivalAt[i] = at + config.delayMs + jitter(rng);
+        dataBytes += payload.size();
+
+        FecHeader header;
+        header.group = group;
+        header.index = encoder.count();
+        header.k = (uint8_t)groupSize;
+        header.r = parity;
+        std::vector<uint8_t> datagram(FEC_HEADER_LEN);
+        fecWriteHeader(datagram.data(), header);
+        datagram.insert(datagram.end(), payload.begin(), payload.end());
+        encoder.add(payload.data(), payload.size());
+        if (!transmit(std::move(datagram), arrivalAt[i])) {
+            dropped[i] = true;
+            result.lostRaw++;
+        }
+
+        if (encoder.complete()) closeGroup(at);
+    }
+    if (groupOpen) closeGroup(groupStartedAt + config.deadlineMs);
+    deliverUntil(1e18);
+    receiver.finish();
+
+    result.overhead = dataBytes ? (double)(wireBytes - dataBytes) / dataBytes : 0;
+    result.averageParity = groupsStarted ? (double)paritySum / groupsStarted : 0;
+    result.addedP50 = percentile(addedLatency, 0.5);
+    result.addedP99 = percentile(addedLatency, 0.99);
+    result.addedMax = addedLatency.empty() ? 0 : *std::max_element(addedLatency.begin(), addedLatency.end());
+    return result;
+}
+
+static void printBenchRow(const BenchConfig& config, const BenchResult& result) {
+    char mode[16];
+    if (config.r < 0) snprintf(mode, sizeof(mode), "auto(%.2f)", result.averageParity);
+    else snprintf(mode, sizeof(mode), "r=%d", config.r);
+    double lostRaw = result.lostRaw;
+    double residual = config.frames - (double)result.delivered;
+    printf("%6.1f%% %5.1f  %-11s %9.2f%% %9.3f%% %9.1f%% %9.1f %9.1f %9.1f\n",
+           config.loss * 100, config.burst, mode,
+           lostRaw ? 100.0 * result.recovered / lostRaw : 100.0,
+           100.0 * residual / config.frames, 100.0 * result.overhead,
+           result.addedP50, result.addedP99, result.addedMax);
+}
+
+static int runBenchCommand(BenchConfig config, bool sweep) {
+    int groupSize = config.deadlineMs > 0 ? std::min(config.k, 1 + (int)(config.deadlineMs / config.intervalMs)) : config.k;
+    printf("FEC bench: %ld frames @ %.0fms, k=%d (max %d, deadline %.0fms), %zu bytes/frame, delay %.0f±%.0fms\n",
+           config.frames, config.intervalMs, groupSize, config.k, config.deadlineMs, config.datagramBytes,
+           config.delayMs, config.jitterMs / 2);
+    printf("%7s %5s  %-11s %10s %10s %10s %9s %9s %9s\n",
+           "loss", "burst", "parity", "recovered", "residual", "overhead", "add p50", "add p99", "add max");
+
+    if (!sweep) {
+        printBenchRow(config, runBench(config, 1));
+        return 0;
+    }
+
+    const double losses[] = {0.0, 0.01, 0.05, 0.10, 0.20};
+    const int parities[] = {0, 1, 2, -1};
+    for (double loss : losses) {
+        for (int parity : parities) {
+            config.loss = loss;
+            config.r = parity;
+            printBenchRow(config, runBench(config, 1));
+        }
+    }
+    printf("(added latency ms hanya untuk frame yang dipulihkan; frame yang datang langsung +0ms)\n");
+    return 0;
+}
+
+// ================== SOCKETS ==================
+static bool resolve(const char* hostPort, sockaddr_in& address) {
+    const char* colon = strrchr(hostPort, ':');
+    if (!colon) return false;
+    std::string host(hostPort, colon - hostPort);
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons((uint16_t)atoi(colon + 1));
+    return inet_pton(AF_INET, host.c_str(), &address.sin_addr) == 1;
+}
+
+static int bindUdp(int port) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons((uint16_t)port);
+    if (fd < 0 || bind(fd, (sockaddr*)&address, sizeof(address)) != 0) {
+        fprintf(stderr, "❌ [FEC] Cannot bind UDP %d: %s\n", port, strerror(errno));
+        return -1;
+    }
+    return fd;
+}
+
+static std::string addressKey(const sockaddr_in& address) {
+    char text[INET_ADDRSTRLEN];
+    inet_ntop(AF_INET, &address.sin_addr, text, sizeof(text));
+    return std::string(text) + ":" + std::to_string(ntohs(address.sin_port));
+}
+
+// ================== RECEIVE ==================
+static int runReceive(int listenPort, const char* forwardTo, long statsIntervalMs) {
+    sockaddr_in forward;
+    if (!resolve(forwardTo, forward)) {
+        fprintf(stderr, "❌ [FEC] Invalid forward address %s\n", forwardTo);
+        return 2;
+    }
+    int fd = bindUdp(listenPort);
+    if (fd < 0) return 1;
+
+    struct Device {
+        sockaddr_in address;
+        int forwardFd;
+        FecReceiver* receiver;
+        std::vector<double> recoveryWait;
+        double nextFeedback;
+    };
+    std::map<std::string, Device> devices;
+    fprintf(stderr, "🛡️ [FEC] Listening on UDP %d, forwarding MAVLink to %s\n", listenPort, forwardTo);
+
+    uint8_t buffer[MAX_DATAGRAM + FEC_HEADER_LEN];
+    double nextStats = monotonicMs() + statsIntervalMs;
+    while (running) {
+        pollfd waiter = {fd, POLLIN, 0};
+        if (poll(&waiter, 1, 100) > 0) {
+            sockaddr_in source;
+            socklen_t sourceLength = sizeof(source);
+            ssize_t length = recvfrom(fd, buffer, sizeof(buffer), 0, (sockaddr*)&source, &sourceLength);
+            if (length > 0) {
+                std::string key = addressKey(source);
+                auto it = devices.find(key);
+                if (it == devices.end()) {
+                    // Satu socket forward per device: server.js memisahkan parser per remote
+                    Device device{source, socket(AF_INET, SOCK_DGRAM, 0), nullptr, {}, monotonicMs() + FEEDBACK_INTERVAL_MS};
+                    it = devices.emplace(key, std::move(device)).first;
+                    Device* entry = &it->second;
+                    entry->receiver = new FecReceiver([entry, forward](const uint8_t* data, size_t size, bool recovered, double waitMs) {
+                        sendto(entry->forwardFd, data, size, 0, (const sockaddr*)&forward, sizeof(forward));
+                        if (recovered) entry->recoveryWait.push_back(waitMs);
+                    });
+                    fprintf(stderr, "🛰️ [FEC] New device %s\n", key.c_str());
+                }
+                it->second.receiver->onDatagram(buffer, (size_t)length, monotonicMs());
+            }
+        }
+
+        double now = monotonicMs();
+        for (auto& [key, device] : devices) {
+            uint16_t loss;
+            if (now < device.nextFeedback) continue;
+            device.nextFeedback = now + FEEDBACK_INTERVAL_MS;
+            if (!device.receiver->takeLoss(loss)) continue;
+
+            uint8_t feedback[FEC_FEEDBACK_LEN];
+            FecHeader header;
+            header.type = FEC_TYPE_FEEDBACK;
+            fecWriteHeader(feedback, header);
+            uint32_t recovered = (uint32_t)device.receiver->stats.recovered;
+            feedback[FEC_HEADER_LEN] = loss & 0xFF;
+            feedback[FEC_HEADER_LEN + 1] = loss >> 8;
+            memcpy(feedback + FEC_HEADER_LEN + 2, &recovered, sizeof(recovered));
+            sendto(fd, feedback, sizeof(feedback), 0, (const sockaddr*)&device.address, sizeof(device.address));
+        }
+
+        if (now >= nextStats) {
+            nextStats = now + statsIntervalMs;
+            for (auto& [key, device] : devices) {
+                const ReceiverStats& stats = device.receiver->stats;
+                fprintf(stderr, "📊 [FEC] %s: expected %lu, direct %lu, recovered %lu, lost %lu, overhead %.1f%%, recovery wait p50 %.0fms p99 %.0fms\n",
+                        key.c_str(), stats.expected, stats.receivedRaw, stats.recovered, stats.unrecoverable,
+                        stats.dataBytes ? 100.0 * stats.overheadBytes / stats.dataBytes : 0.0,
+                        percentile(device.recoveryWait, 0.5), percentile(device.recoveryWait, 0.99));
+                if (device.recoveryWait.size() > 4096) device.recoveryWait.clear();
+            }
+        }
+    }
+
+    for (auto& [key, device] : devices) {
+        close(device.forwardFd);
+        delete device.receiver;
+    }
+    close(fd);
+    return 0;
+}
+
+// ================== PROXY ==================
+static int runProxy(int listenPort, const char* target, double loss, double burst) {
+    sockaddr_in destination;
+    if (!resolve(target, destination)) {
+        fprintf(stderr, "❌ [PROXY] Invalid target %s\n", target);
+        return 2;
+    }
+    int listenFd = bindUdp(listenPort);
+    int upstreamFd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (listenFd < 0 || upstreamFd < 0) return 1;
+
+    LossModel lossModel(loss, burst, (unsigned)time(nullptr));
+    sockaddr_in client = {};
+    bool haveClient = false;
+    unsigned long forwarded = 0;
+    unsigned long dropped = 0;
+    double nextStats = monotonicMs() + 5000;
+    fprintf(stderr, "🧪 [PROXY] UDP %d -> %s, loss %.1f%%, burst %.1f\n", listenPort, target, loss * 100, burst);
+
+    uint8_t buffer[65536];
+    while (running) {
+        pollfd waiters[2] = {{listenFd, POLLIN, 0}, {upstreamFd, POLLIN, 0}};
+        if (poll(waiters, 2, 200) <= 0) continue;
+
+        if (waiters[0].revents & POLLIN) {
+            socklen_t clientLength = sizeof(client);
+            ssize_t length = recvfrom(listenFd, buffer, sizeof(buffer), 0, (sockaddr*)&client, &clientLength);
+            haveClient = length >= 0;
+            if (length > 0) {
+                if (lossModel.drop()) {
+                    dropped++;
+                } else {
+                    sendto(upstreamFd, buffer, (size_t)length, 0, (const sockaddr*)&destination, sizeof(destination));
+                    forwarded++;
+                }
+            }
+        }
+        // Arah balik (feedback) tanpa loss ke client terakhir
+        if ((waiters[1].revents & POLLIN) && haveClient) {
+            ssize_t length = recv(upstreamFd, buffer, sizeof(buffer), 0);
+            if (length > 0) sendto(listenFd, buffer, (size_t)length, 0, (const sockaddr*)&client, sizeof(client));
+        }
+
+        if (monotonicMs() >= nextStats) {
+            nextStats = monotonicMs() + 5000;
+            fprintf(stderr, "🧪 [PROXY] forwarded %lu, dropped %lu (%.1f%%)\n", forwarded, dropped,
+                    forwarded + dropped ? 100.0 * dropped / (forwarded + dropped) : 0.0);
+        }
+    }
+    return 0;
+}
+
+// ================== MAIN ==================
+static void onSignal(int) { running = 0; }
+
+static void usage() {
+    fprintf(stderr,
+        "Usage:\n"
+        "  fec_link receive [--listen 14551] [--forward 127.0.0.1:14550] [--stats-ms 5000]\n"
+        "  fec_link proxy --to <host:port> [--listen 14551] [--loss 0.05] [--burst 1]\n"
+        "  fec_link bench [--frames n] [--interval-ms n] [--deadline-ms n] [--k n] [--loss p] [--burst n] [--r auto|n]\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage();
+        return 2;
+    }
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    std::string command = argv[1];
+    int listenPort = 14551;
+    const char* forwardTo = "127.0.0.1:14550";
+    const char* target = nullptr;
+    long statsIntervalMs = 5000;
+    BenchConfig bench;
+    bool lossGiven = false;
+    bool parityGiven = false;
+
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            usage();
+            return 2;
+        }
+        i++;
+        if (arg == "--listen") listenPort = atoi(value);
+        else if (arg == "--forward") forwardTo = value;
+        else if (arg == "--to") target = value;
+        else if (arg == "--stats-ms") statsIntervalMs = std::max(200L, atol(value));
+        else if (arg == "--frames") bench.frames = std::max(1L, atol(value));
+        else if (arg == "--interval-ms") bench.intervalMs = std::max(1.0, atof(value));
+        else if (arg == "--deadline-ms") bench.deadlineMs = std::max(0.0, atof(value));
+        else if (arg == "--k") bench.k = std::min(FEC_MAX_K, std::max(1, atoi(value)));
+        else if (arg == "--loss") { bench.loss = atof(value); lossGiven = true; }
+        else if (arg == "--burst") bench.burst = atof(value);
+        else if (arg == "--r") { bench.r = strcmp(value, "auto") == 0 ? -1 : std::min(FEC_MAX_R, atoi(value)); parityGiven = true; }
+        else {
+            usage();
+            return 2;
+        }
+    }
+
+    if (command == "receive") return runReceive(listenPort, forwardTo, statsIntervalMs);
+    if (command == "proxy" && target) return runProxy(listenPort, target, bench.loss, bench.burst);
+    if (command == "bench") return runBenchCommand(bench, !lossGiven && !parityGiven);
+    usage();
+    return 2;
+}
@@ -0,0 +1,208 @@
+/**
+ * Geofence - kernel point-in-polygon untuk grid lib/geofence.js (Node-API addon)
+ * Grid (CSR cell -> entry zona -> edge) tetap dibangun di JS; attach() hanya
+ * menyimpan pointer ke typed array-nya (plus reference agar tidak di-GC) dan
+ * locate() menjalankan uji paritas yang sama dengan GeofenceEngine.locate:
+ * segmen titik referensi cell -> titik GPS disilangkan dengan edge zona di cell itu.
+ * Aritmetika double tanpa FMA (-ffp-contract=off) supaya hasil identik dengan JS.
+ *
+ * Satu panggilan per sampel GPS, jadi biaya panggilan Node-API dominan: lat/lon dan
+ * hasil lewat typed array yang diikat saat attach(), locate() hanya menerima handle.
+ *
+ * JS: attach(cellStart, entryZone, entryInside, entryEdgeStart, entryEdges, edges, grid, io, out) -> handle
+ *       grid = Float64Array [originLat, originLon, metersPerLat, metersPerLon, minX, minY, cellSize, cols, rows]
+ *       io   = Float64Array [lat, lon], out = Int32Array (kapasitas = jumlah zona)
+ *     locate(handle) -> jumlah index zona yang ditulis ke out
+ */
+
+#define NAPI_VERSION 6
+#include <node_api.h>
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ====== GRID ======
+enum GridIndex {
+    G_ORIGIN_LAT = 0,
+    G_ORIGIN_LON,
+    G_METERS_PER_LAT,
+    G_METERS_PER_LON,
+    G_MIN_X,
+    G_MIN_Y,
+    G_CELL_SIZE,
+    G_COLS,
+    G_ROWS,
+    GRID_SIZE
+};
+
+// Harus sama dengan REF_FRACTION_X/Y di lib/geofence.js
+static const double REF_FRACTION_X = 0.4137;
+static const double REF_FRACTION_Y = 0.5821;
+static const int ARRAY_COUNT = 8;   // 6 array grid + io + out
+
+struct GeofenceIndex {
+    const int32_t* cellStart;
+    const int32_t* entryZone;
+    const uint8_t* entryInside;
+    const int32_t* entryEdgeStart;
+    const int32_t* entryEdges;
+    const double* edges;
+    double grid[GRID_SIZE];
+    int64_t cols;
+    int64_t rows;
+    const double* io;
+    int32_t* out;
+    size_t outCapacity;
+    napi_ref arrays[ARRAY_COUNT];
+};
+
+static inline double orient(double ax, double ay, double bx, double by, double px, double py) {
+    return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+}
+
+static size_t locatePoint(const GeofenceIndex& index, double lat, double lon, int32_t* out, size_t capacity) {
+    const double* g = index.grid;
+    double x = (lon - g[G_ORIGIN_LON]) * g[G_METERS_PER_LON];
+    double y = (lat - g[G_ORIGIN_LAT]) * g[G_METERS_PER_LAT];
+    double colValue = floor((x - g[G_MIN_X]) / g[G_CELL_SIZE]);
+    double rowValue = floor((y - g[G_MIN_Y]) / g[G_CELL_SIZE]);
+    // NaN juga gagal di sini
+    if (!(colValue >= 0 && rowValue >= 0 && colValue < (double)index.cols && rowValue < (double)index.rows)) return 0;
+
+    int64_t col = (int64_t)colValue;
+    int64_t row = (int64_t)rowValue;
+    int64_t cell = row * index.cols + col;
+    double refX = g[G_MIN_X] + (col + REF_FRACTION_X) * g[G_CELL_SIZE];
+    double refY = g[G_MIN_Y] + (row + REF_FRACTION_Y) * g[G_CELL_SIZE];
+
+    size_t count = 0;
+    for (int32_t entry = index.cellStart[cell]; entry < index.cellStart[cell + 1]; entry++) {
+        int inside = index.entryInside[entry];
+        for (int32_t k = index.entryEdgeStart[entry]; k < index.entryEdgeStart[entry + 1]; k++) {
+            const double* e = index.edges + (size_t)index.entryEdges[k] * 4;
+            if ((orient(refX, refY, x, y, e[0], e[1]) > 0) != (orient(refX, refY, x, y, e[2], e[3]) > 0) &&
+                (orient(e[0], e[1], e[2], e[3], refX, refY) > 0) != (orient(e[0], e[1], e[2], e[3], x, y) > 0)) {
+                inside ^= 1;
+            }
+        }
+        if (inside && count < capacity) out[count++] = index.entryZone[entry];
+    }
+    return count;
+}
+
+// ====== NODE-API ======
+
+static bool typedArray(napi_env env, napi_value value, napi_typedarray_type expected, void** data, size_t* length) {
+    bool isTypedArray = false;
+    napi_typedarray_type type;
+    if (napi_is_typedarray(env, value, &isTypedArray) != napi_ok || !isTypedArray) return false;
+    if (napi_get_typedarray_info(env, value, &type, length, data, nullptr, nullptr) != napi_ok) return false;
+    return type == expected;
+}
+
+static void releaseIndex(napi_env env, void* data, void*) {
+    GeofenceIndex* index = (GeofenceIndex*)data;
+    for (int k = 0; k < ARRAY_COUNT; k++) napi_delete_reference(env, index->arrays[k]);
+    delete index;
+}
+
+static napi_value Attach(napi_env env, napi_callback_info info) {
+    size_t argc = 9;
+    napi_value argv[9];
+    napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+    if (argc < 9) {
+        napi_throw_type_error(env, nullptr, "attach expects 9 arguments");
+        return nullptr;
+    }
+
+    // argv: 6 array grid, grid (Float64Array), io, out; array disimpan berurutan tanpa grid
+    static const napi_typedarray_type types[9] = {
+        napi_int32_array, napi_int32_array, napi_uint8_array, napi_int32_array, napi_int32_array,
+        napi_float64_array, napi_float64_array, napi_float64_array, napi_int32_array
+    };
+    void* data[9];
+    size_t lengths[9];
+    for (int k = 0; k < 9; k++) {
+        if (!typedArray(env, argv[k], types[k], &data[k], &lengths[k])) {
+            napi_throw_type_error(env, nullptr, "attach expects Int32Array x2, Uint8Array, Int32Array x2, Float64Array x3, Int32Array");
+            return nullptr;
+        }
+    }
+    if (lengths[6] < GRID_SIZE || lengths[7] < 2) {
+        napi_throw_range_error(env, nullptr, "grid needs 9 values, io needs 2");
+        return nullptr;
+    }
+
+    // Validasi CSR sekali di sini supaya locate() tidak perlu bounds check per edge
+    const double* grid = (const double*)data[6];
+    const int32_t* cellStart = (const int32_t*)data[0];
+    const int32_t* entryEdgeStart = (const int32_t*)data[3];
+    const int32_t* entryEdges = (const int32_t*)data[4];
+    double cells = grid[G_COLS] * grid[G_ROWS];
+    size_t entries = lengths[1];
+    bool valid = grid[G_COLS] >= 1 && grid[G_ROWS] >= 1 && grid[G_CELL_SIZE] > 0 &&
+                 lengths[0] == (size_t)cells + 1 && lengths[2] == entries && lengths[3] == entries + 1 &&
+                 (size_t)cellStart[lengths[0] - 1] == entries && (size_t)entryEdgeStart[entries] == lengths[4];
+    for (size_t k = 0; valid && k < lengths[4]; k++) {
+        valid = entryEdges[k] >= 0 && (size_t)entryEdges[k] * 4 + 4 <= lengths[5];
+    }
+    for (size_t k = 0; valid && k + 1 < lengths[0]; k++) valid = cellStart[k] >= 0 && cellStart[k] <= cellStart[k + 1];
+    for (size_t k = 0; valid && k < entries; k++) valid = entryEdgeStart[k] >= 0 && entryEdgeStart[k] <= entryEdgeStart[k + 1];
+    if (!valid) {
+        napi_throw_range_error(env, nullptr, "inconsistent geofence grid");
+        return nullptr;
+    }
+
+    GeofenceIndex* index = new GeofenceIndex();
+    index->cellStart = cellStart;
+    index->entryZone = (const int32_t*)data[1];
+    index->entryInside = (const uint8_t*)data[2];
+    index->entryEdgeStart = entryEdgeStart;
+    index->entryEdges = entryEdges;
+    index->edges = (const double*)data[5];
+    for (int k = 0; k < GRID_SIZE; k++) index->grid[k] = grid[k];
+    index->cols = (int64_t)grid[G_COLS];
+    index->rows = (int64_t)grid[G_ROWS];
+    index->io = (const double*)data[7];
+    index->out = (int32_t*)data[8];
+    index->outCapacity = lengths[8];
+    for (int k = 0, slot = 0; k < 9; k++) {
+        if (k != 6) napi_create_reference(env, argv[k], 1, &index->arrays[slot++]);
+    }
+
+    napi_value handle;
+    if (napi_create_external(env, index, releaseIndex, nullptr, &handle) != napi_ok) {
+        releaseIndex(env, index, nullptr);
+        napi_throw_error(env, nullptr, "cannot wrap geofence index");
+        return nullptr;
+    }
+    return handle;
+}
+
+static napi_value Locate(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    void* data = nullptr;
+    napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+    if (argc < 1 || napi_get_value_external(env, argv[0], &data) != napi_ok || !data) {
+        napi_throw_type_error(env, nullptr, "locate expects a handle from attach()");
+        return nullptr;
+    }
+
+    const GeofenceIndex& index = *(const GeofenceIndex*)data;
+    napi_value result;
+    napi_create_uint32(env, (uint32_t)locatePoint(index, index.io[0], index.io[1], index.out, index.outCapacity), &result);
+    return result;
+}
+
+static napi_value Init(napi_env env, napi_value exports) {
+    napi_property_descriptor properties[] = {
+        { "attach", nullptr, Attach, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "locate", nullptr, Locate, nullptr, nullptr, nullptr, napi_default, nullptr }
+    };
+    napi_define_properties(env, exports, sizeof(properties) / sizeof(properties[0]), properties);
+    return exports;
+}
+
+NAPI_MODULE(geofence, Init)
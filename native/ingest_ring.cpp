@@ -0,0 +1,122 @@
+/**
+ * Ingest Ring - akses shared memory native/ingest_sidecar dari Node (Node-API addon)
+ * File ring di-mmap sekali dan dikembalikan sebagai ArrayBuffer external: lib/ingest-ring.js
+ * membaca header slot dan membuat Buffer view ke payload langsung di atas mapping (tanpa copy).
+ * Hanya index producer/consumer yang butuh native: load-acquire writeIndex memastikan isi
+ * slot sudah terlihat, store-release readIndex memastikan slot selesai dibaca sebelum
+ * sidecar menimpanya. Layout: native/ingest_ring.h.
+ *
+ * JS: open(path) -> ArrayBuffer (munmap saat di-GC)
+ *     loadAcquire(buffer, byteOffset) -> number;  storeRelease(buffer, byteOffset, value)
+ */
+
+#define NAPI_VERSION 6
+#include <node_api.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ingest_ring.h"
+
+// ====== MAPPING ======
+
+static void unmapRing(napi_env, void* data, void* hint) {
+    munmap(data, (size_t)(uintptr_t)hint);
+}
+
+static napi_value Open(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    char path[512] = { 0 };
+    size_t length = 0;
+    napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+    if (argc < 1 || napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &length) != napi_ok) {
+        napi_throw_type_error(env, nullptr, "open expects a path");
+        return nullptr;
+    }
+
+    int fd = open(path, O_RDWR | O_CLOEXEC);
+    struct stat fileInfo;
+    if (fd < 0 || fstat(fd, &fileInfo) != 0) {
+        if (fd >= 0) close(fd);
+        napi_throw_error(env, "ENOENT", strerror(errno));
+        return nullptr;
+    }
+    size_t size = (size_t)fileInfo.st_size;
+    const RingFileHeader* header = nullptr;
+    void* mapping = size >= INGEST_RING_HEADER_BYTES ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (mapping != MAP_FAILED) header = (const RingFileHeader*)mapping;
+
+    // Sidecar menulis magic paling akhir; sebelum itu file dianggap belum siap
+    if (!header || __atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != INGEST_RING_MAGIC ||
+        header->version != INGEST_RING_VERSION ||
+        ingestFileBytes(header->ringCount, header->slotCount, header->slotBytes) > size) {
+        if (mapping != MAP_FAILED) munmap(mapping, size);
+        napi_throw_error(env, "EINVAL", "ingest ring not initialized or version mismatch");
+        return nullptr;
+    }
+
+    napi_value buffer;
+    if (napi_create_external_arraybuffer(env, mapping, size, unmapRing, (void*)(uintptr_t)size, &buffer) != napi_ok) {
+        munmap(mapping, size);
+        napi_throw_error(env, nullptr, "cannot wrap ingest ring mapping");
+        return nullptr;
+    }
+    return buffer;
+}
+
+// ====== INDEX ======
+
+static uint64_t* indexAt(napi_env env, napi_value* argv) {
+    void* data = nullptr;
+    size_t length = 0;
+    int64_t offset = -1;
+    if (napi_get_arraybuffer_info(env, argv[0], &data, &length) != napi_ok ||
+        napi_get_value_int64(env, argv[1], &offset) != napi_ok ||
+        offset < 0 || (offset & 7) != 0 || (size_t)offset + sizeof(uint64_t) > length) {
+        napi_throw_range_error(env, nullptr, "index offset out of bounds");
+        return nullptr;
+    }
+    return (uint64_t*)((uint8_t*)data + offset);
+}
+
+static napi_value LoadAcquire(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+    uint64_t* index = argc == 2 ? indexAt(env, argv) : nullptr;
+    if (!index) return nullptr;
+    napi_value result;
+    // Index < 2^53 (berabad-abad pada juta frame/s) -> aman sebagai number
+    napi_create_double(env, (double)__atomic_load_n(index, __ATOMIC_ACQUIRE), &result);
+    return result;
+}
+
+static napi_value StoreRelease(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+    uint64_t* index = argc == 3 ? indexAt(env, argv) : nullptr;
+    double value = 0;
+    if (!index || napi_get_value_double(env, argv[2], &value) != napi_ok) return nullptr;
+    __atomic_store_n(index, (uint64_t)value, __ATOMIC_RELEASE);
+    return nullptr;
+}
+
+static napi_value Init(napi_env env, napi_value exports) {
+    napi_property_descriptor properties[] = {
+        { "open", nullptr, Open, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "loadAcquire", nullptr, LoadAcquire, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "storeRelease", nullptr, StoreRelease, nullptr, nullptr, nullptr, napi_default, nullptr }
+    };
+    napi_define_properties(env, exports, sizeof(properties) / sizeof(properties[0]), properties);
+    return exports;
+}
+
+NAPI_MODULE(ingest_ring, Init)
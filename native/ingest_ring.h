@@ -0,0 +1,77 @@
+/**
+ * Ingest Ring - layout shared memory antara native/ingest_sidecar (producer) dan
+ * server.js (consumer, lewat addon native/ingest_ring.cpp + lib/ingest-ring.js).
+ *
+ * File di /dev/shm: [RingFileHeader | ring 0 | ring 1 | ...], satu ring SPSC per
+ * worker sidecar. Ring = [RingControl | slot 0 .. slot slotCount-1].
+ * Slot = [RingSlotHeader | payload]; payload selalu berisi frame utuh.
+ *   writeIndex: hanya ditulis producer (release), readIndex: hanya ditulis consumer (release).
+ *   Slot i ada di index (i & (slotCount - 1)); slotCount pangkat dua.
+ * Semua angka little-endian (host), offset harus sama dengan lib/ingest-ring.js.
+ */
+
+#ifndef INGEST_RING_H
+#define INGEST_RING_H
+
+#include <stdint.h>
+
+#define INGEST_RING_MAGIC        0x52564155u   // "UAVR"
+#define INGEST_RING_VERSION      1u
+#define INGEST_RING_HEADER_BYTES 4096u         // Ring mulai di batas page
+#define INGEST_RING_CONTROL_BYTES 256u
+#define INGEST_RING_SLOT_HEADER  32u
+
+// RingSlotHeader.flags
+#define INGEST_KIND_MAVLINK      1u
+#define INGEST_KIND_JSON         2u
+#define INGEST_KIND_MASK         0xFFu
+#define INGEST_FLAG_TCP          0x100u        // Diterima lewat TCP (default UDP)
+#define INGEST_FLAG_SKIP         0x200u        // Slot batal (invalid), consumer melewati
+
+struct RingFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t ringCount;
+    uint32_t slotCount;
+    uint32_t slotBytes;         // Termasuk RingSlotHeader
+    uint32_t pid;               // Proses sidecar (consumer bisa cek masih hidup)
+    uint64_t startedAtMs;       // Berubah saat sidecar restart -> consumer reset readIndex
+    uint64_t sequence;          // Nomor urut global terakhir (atomic, lintas worker)
+};
+
+// Tiap index di cache line sendiri agar producer/consumer tidak saling invalidasi
+struct RingControl {
+    uint64_t writeIndex;
+    uint8_t pad0[56];
+    uint64_t readIndex;
+    uint8_t pad1[56];
+    uint64_t received;          // Datagram/frame TCP diterima
+    uint64_t invalid;           // Gagal validasi (CRC, terpotong, bukan MAVLink/JSON)
+    uint64_t dropped;           // Ring penuh (consumer tertinggal)
+    uint64_t batches;           // Panggilan recvmmsg yang menghasilkan data
+    uint8_t pad2[96];
+};
+
+struct RingSlotHeader {
+    uint32_t length;            // Byte payload valid
+    uint32_t flags;             // INGEST_KIND_* | INGEST_FLAG_*
+    uint64_t sequence;          // Urutan global dari sidecar
+    uint64_t receivedAtUs;      // CLOCK_REALTIME saat diterima
+    uint32_t sourceAddress;     // IPv4, network byte order
+    uint16_t sourcePort;        // Host byte order
+    uint16_t reserved;
+};
+
+static_assert(sizeof(RingFileHeader) <= INGEST_RING_HEADER_BYTES, "header terlalu besar");
+static_assert(sizeof(RingControl) == INGEST_RING_CONTROL_BYTES, "layout RingControl berubah");
+static_assert(sizeof(RingSlotHeader) == INGEST_RING_SLOT_HEADER, "layout RingSlotHeader berubah");
+
+static inline uint64_t ingestRingBytes(uint32_t slotCount, uint32_t slotBytes) {
+    return INGEST_RING_CONTROL_BYTES + (uint64_t)slotCount * slotBytes;
+}
+
+static inline uint64_t ingestFileBytes(uint32_t ringCount, uint32_t slotCount, uint32_t slotBytes) {
+    return INGEST_RING_HEADER_BYTES + (uint64_t)ringCount * ingestRingBytes(slotCount, slotBytes);
+}
+
+#endif
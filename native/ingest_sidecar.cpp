@@ -0,0 +1,772 @@
+/**
+ * Ingest Sidecar - penerima telemetry UDP/TCP native untuk server.js
+ * Untuk swarm/rate tinggi event loop Node jadi bottleneck sebelum jaringan. Sidecar
+ * menerima datagram dengan epoll + recvmmsg langsung ke slot ring shared memory
+ * (tanpa buffer perantara), memvalidasi (MAVLink v2 CRC / JSON utuh), memberi nomor
+ * urut global, lalu mempublikasikan writeIndex. server.js membaca slot yang sama
+ * (lib/ingest-ring.js) tanpa copy. Layout: native/ingest_ring.h.
+ *
+ * N worker = N socket UDP/TCP dengan SO_REUSEPORT pada port yang sama; kernel
+ * membagi flow per 4-tuple, jadi satu device selalu di worker (dan ring) yang sama
+ * dan urutan per device terjaga. Tiap worker punya ring SPSC sendiri.
+ *
+ * Mode:
+ *   ingest_sidecar run [--udp 14550] [--tcp 14571] [--workers N] [--shm /dev/shm/uav-ingest]
+ *                      [--slots 16384] [--slot-bytes 1024] [--stats-ms 1000]
+ *       TCP: frame [u16 big endian length][payload], payload sama dengan datagram UDP.
+ *   ingest_sidecar swarm [--target 127.0.0.1:14550] [--devices 100] [--rate 10] [--seconds 10] [--threads 1]
+ *       Generator swarm: tiap device mengirim satu siklus MAVLink per 1/rate detik
+ *       (rate 0 = secepatnya) dari socket sendiri, batch sendmmsg.
+ *   ingest_sidecar bench [--workers 1,2,4] [--seconds 3] [--devices 256]
+ *       Sidecar + consumer ring + swarm secepatnya dalam satu proses: plafon
+ *       throughput (datagram/s diterima, invalid, drop ring penuh).
+ */
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+#include "../ESP32/ESP32_dashboard/mavlink_telemetry.h"
+#include "ingest_ring.h"
+
+static const int RECV_BATCH = 64;
+static const int SEND_BATCH = 64;
+static const int SOCKET_BUFFER_BYTES = 4 * 1024 * 1024;
+static const size_t TCP_BUFFER_BYTES = 2 + 65535;
+static const int MAVLINK_SIGNATURE_LEN = 13;
+static const uint8_t MAVLINK_INCOMPAT_SIGNED = 0x01;
+
+static std::atomic<bool> running{true};
+
+static uint64_t monotonicMicros() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000ULL + (uint64_t)now.tv_nsec / 1000;
+}
+
+static uint64_t realtimeMicros() {
+    timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    return (uint64_t)now.tv_sec * 1000000ULL + (uint64_t)now.tv_nsec / 1000;
+}
+
+// ================== VALIDATION ==================
+static void crcAccumulate(uint8_t data, uint16_t& crc) {
+    uint8_t tmp = data ^ (uint8_t)(crc & 0xFF);
+    tmp ^= (uint8_t)(tmp << 4);
+    crc = (uint16_t)((crc >> 8) ^ ((uint16_t)tmp << 8) ^ ((uint16_t)tmp << 3) ^ (tmp >> 4));
+}
+
+// CRC_EXTRA message yang dikenal lib/mavlink.js; -1 = tidak dikenal (tidak bisa dicek)
+static int crcExtraFor(uint32_t msgid) {
+    switch (msgid) {
+        case MAVLINK_MSG_ID_HEARTBEAT: return MAVLINK_CRC_EXTRA_HEARTBEAT;
+        case MAVLINK_MSG_ID_SYS_STATUS: return MAVLINK_CRC_EXTRA_SYS_STATUS;
+        case MAVLINK_MSG_ID_GPS_RAW_INT: return MAVLINK_CRC_EXTRA_GPS_RAW_INT;
+        case MAVLINK_MSG_ID_SCALED_PRESSURE: return MAVLINK_CRC_EXTRA_SCALED_PRESSURE;
+        case MAVLINK_MSG_ID_GLOBAL_POSITION_INT: return MAVLINK_CRC_EXTRA_GLOBAL_POSITION_INT;
+        case MAVLINK_MSG_ID_BATTERY_STATUS: return MAVLINK_CRC_EXTRA_BATTERY_STATUS;
+        case MAVLINK_MSG_ID_NAMED_VALUE_FLOAT: return MAVLINK_CRC_EXTRA_NAMED_VALUE_FLOAT;
+        case MAVLINK_MSG_ID_NAMED_VALUE_INT: return MAVLINK_CRC_EXTRA_NAMED_VALUE_INT;
+        default: return -1;
+    }
+}
+
+/**
+ * Panjang prefix berisi frame MAVLink v2 utuh; berhenti di frame pertama yang rusak
+ * atau terpotong. 0 = tidak ada frame valid. Message tidak dikenal diteruskan apa adanya
+ * (lib/mavlink.js melewatinya), yang dikenal wajib lolos CRC.
+ */
+static size_t validMavlinkPrefix(const uint8_t* data, size_t length) {
+    size_t offset = 0;
+    size_t valid = 0;
+    bool anyKnown = false;
+    while (offset + MAVLINK_HEADER_LEN + MAVLINK_CHECKSUM_LEN <= length && data[offset] == MAVLINK_STX_V2) {
+        size_t payloadLength = data[offset + 1];
+        size_t signature = (data[offset + 2] & MAVLINK_INCOMPAT_SIGNED) ? MAVLINK_SIGNATURE_LEN : 0;
+        size_t frameLength = MAVLINK_HEADER_LEN + payloadLength + MAVLINK_CHECKSUM_LEN + signature;
+        if (offset + frameLength > length) break;
+
+        uint32_t msgid = data[offset + 7] | (data[offset + 8] << 8) | ((uint32_t)data[offset + 9] << 16);
+        int crcExtra = crcExtraFor(msgid);
+        if (crcExtra >= 0) {
+            uint16_t crc = 0xFFFF;
+            size_t crcOffset = offset + MAVLINK_HEADER_LEN + payloadLength;
+            for (size_t i = offset + 1; i < crcOffset; i++) crcAccumulate(data[i], crc);
+            crcAccumulate((uint8_t)crcExtra, crc);
+            if ((data[crcOffset] | (data[crcOffset + 1] << 8)) != crc) break;
+            anyKnown = true;
+        }
+        offset += frameLength;
+        valid = offset;
+    }
+    return anyKnown ? valid : 0;
+}
+
+// JSON: cukup pastikan object utuh ({...}); parse + validasi field tetap di server.js
+static size_t validJsonLength(const uint8_t* data, size_t length) {
+    size_t start = 0;
+    while (start < length && (data[start] == ' ' || data[start] == '\n' || data[start] == '\r' || data[start] == '\t')) start++;
+    while (length > start && (data[length - 1] == ' ' || data[length - 1] == '\n' || data[length - 1] == '\r' || data[length - 1] == '\t' || data[length - 1] == 0)) length--;
+    return start == 0 && length > 1 && data[0] == '{' && data[length - 1] == '}' ? length : 0;
+}
+
+// Return flags INGEST_KIND_* dan potong length ke bagian valid; 0 = invalid
+static uint32_t classify(const uint8_t* data, uint32_t& length) {
+    if (length == 0) return 0;
+    if (data[0] == MAVLINK_STX_V2) {
+        length = (uint32_t)validMavlinkPrefix(data, length);
+        return length ? INGEST_KIND_MAVLINK : 0;
+    }
+    length = (uint32_t)validJsonLength(data, length);
+    return length ? INGEST_KIND_JSON : 0;
+}
+
+// ================== SHARED MEMORY RING ==================
+class RingFile {
+public:
+    bool create(const char* path, uint32_t ringCount, uint32_t slotCount, uint32_t slotBytes) {
+        size = ingestFileBytes(ringCount, slotCount, slotBytes);
+        // File baru (inode baru), bukan truncate: mapping lama di server.js tetap valid
+        // sampai ia melihat inode berganti dan membuka ulang
+        unlink(path);
+        int fd = open(path, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+        if (fd < 0 || ftruncate(fd, (off_t)size) != 0) {
+            fprintf(stderr, "❌ [SIDECAR] Cannot create %s: %s\n", path, strerror(errno));
+            if (fd >= 0) close(fd);
+            return false;
+        }
+        void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            fprintf(stderr, "❌ [SIDECAR] mmap %s failed: %s\n", path, strerror(errno));
+            return false;
+        }
+        base = (uint8_t*)mapping;
+        header = (RingFileHeader*)base;
+        header->ringCount = ringCount;
+        header->slotCount = slotCount;
+        header->slotBytes = slotBytes;
+        header->pid = (uint32_t)getpid();
+        header->startedAtMs = realtimeMicros() / 1000;
+        header->sequence = 0;
+        header->version = INGEST_RING_VERSION;
+        // Magic terakhir: consumer yang membuka file di tengah inisialisasi menolak
+        __atomic_store_n(&header->magic, INGEST_RING_MAGIC, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    ~RingFile() {
+        if (base) munmap(base, size);
+    }
+
+    RingControl* control(uint32_t ring) const {
+        return (RingControl*)(base + INGEST_RING_HEADER_BYTES + ring * ingestRingBytes(header->slotCount, header->slotBytes));
+    }
+
+    RingSlotHeader* slot(uint32_t ring, uint64_t index) const {
+        uint8_t* slots = (uint8_t*)control(ring) + INGEST_RING_CONTROL_BYTES;
+        return (RingSlotHeader*)(slots + (index & (header->slotCount - 1)) * header->slotBytes);
+    }
+
+    uint32_t payloadCapacity() const { return header->slotBytes - INGEST_RING_SLOT_HEADER; }
+
+    RingFileHeader* header = nullptr;
+
+private:
+    uint8_t* base = nullptr;
+    uint64_t size = 0;
+};
+
+// ================== OPTIONS ==================
+struct Options {
+    int udpPort = 14550;
+    int tcpPort = 14571;            // 0 = tanpa TCP
+    int workers = 0;                // 0 = jumlah core
+    const char* shmPath = "/dev/shm/uav-ingest";
+    uint32_t slotCount = 16384;
+    uint32_t slotBytes = 1024;
+    long statsIntervalMs = 1000;
+};
+
+// ================== WORKER ==================
+struct TcpConnection {
+    std::vector<uint8_t> buffer;
+    size_t length = 0;
+    uint32_t address = 0;
+    uint16_t port = 0;
+};
+
+static int bindSocket(int type, int port, bool reusePort) {
+    int fd = socket(AF_INET, type | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (reusePort) setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+    if (type == SOCK_DGRAM) {
+        int bufferBytes = SOCKET_BUFFER_BYTES;
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bufferBytes, sizeof(bufferBytes));
+    }
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons((uint16_t)port);
+    if (bind(fd, (sockaddr*)&address, sizeof(address)) != 0 || (type == SOCK_STREAM && listen(fd, 128) != 0)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int boundPort(int fd) {
+    sockaddr_in address{};
+    socklen_t length = sizeof(address);
+    getsockname(fd, (sockaddr*)&address, &length);
+    return ntohs(address.sin_port);
+}
+
+/**
+ * Satu worker = satu thread, satu epoll, socket UDP/TCP SO_REUSEPORT sendiri, satu ring.
+ */
+class IngestWorker {
+public:
+    IngestWorker(uint32_t ringIndex, RingFile& ringFile) : ring(ringIndex), file(ringFile) {}
+
+    ~IngestWorker() {
+        for (auto& entry : connections) close(entry.first);
+        if (udpFd >= 0) close(udpFd);
+        if (tcpFd >= 0) close(tcpFd);
+        if (epollFd >= 0) close(epollFd);
+    }
+
+    bool open(int udpPort, int tcpPort) {
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        udpFd = bindSocket(SOCK_DGRAM, udpPort, true);
+        if (epollFd < 0 || udpFd < 0) return false;
+        watch(udpFd);
+        if (tcpPort > 0) {
+            tcpFd = bindSocket(SOCK_STREAM, tcpPort, true);
+            if (tcpFd < 0) return false;
+            watch(tcpFd);
+        }
+        return true;
+    }
+
+    int udpPort() const { return boundPort(udpFd); }
+    int tcpPort() const { return tcpFd >= 0 ? boundPort(tcpFd) : 0; }
+
+    void run() {
+        epoll_event events[64];
+        while (running) {
+            int count = epoll_wait(epollFd, events, 64, 100);
+            for (int i = 0; i < count; i++) {
+                int fd = events[i].data.fd;
+                if (fd == udpFd) drainUdp();
+                else if (fd == tcpFd) acceptAll();
+                else readTcp(fd);
+            }
+        }
+    }
+
+private:
+    void watch(int fd) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    }
+
+    uint64_t freeSlots() const {
+        RingControl* control = file.control(ring);
+        uint64_t read = __atomic_load_n(&control->readIndex, __ATOMIC_ACQUIRE);
+        return file.header->slotCount - (writeIndex - read);
+    }
+
+    // Slot [writeIndex, writeIndex + count) selesai ditulis: beri nomor urut lalu publikasikan
+    void commit(uint64_t count, uint64_t firstSequence) {
+        for (uint64_t i = 0; i < count; i++) file.slot(ring, writeIndex + i)->sequence = firstSequence + i;
+        writeIndex += count;
+        __atomic_store_n(&file.control(ring)->writeIndex, writeIndex, __ATOMIC_RELEASE);
+    }
+
+    uint64_t reserveSequence(uint64_t count) {
+        return __atomic_fetch_add(&file.header->sequence, count, __ATOMIC_RELAXED) + 1;
+    }
+
+    // recvmmsg langsung ke payload slot ring; ring penuh -> baca ke scratch dan hitung drop
+    void drainUdp() {
+        RingControl* control = file.control(ring);
+        mmsghdr messages[RECV_BATCH];
+        iovec vectors[RECV_BATCH];
+        sockaddr_in sources[RECV_BATCH];
+        const uint32_t capacity = file.payloadCapacity();
+
+        for (;;) {
+            uint64_t available = freeSlots();
+            int batch = (int)std::min<uint64_t>(available, RECV_BATCH);
+            bool discard = batch == 0;
+            if (discard) batch = RECV_BATCH;
+
+            for (int i = 0; i < batch; i++) {
+                vectors[i].iov_base = discard ? scratch + (size_t)i * 64 : (uint8_t*)file.slot(ring, writeIndex + i) + INGEST_RING_SLOT_HEADER;
+                vectors[i].iov_len = discard ? 64 : capacity;
+                memset(&messages[i].msg_hdr, 0, sizeof(msghdr));
+                messages[i].msg_hdr.msg_iov = &vectors[i];
+                messages[i].msg_hdr.msg_iovlen = 1;
+                messages[i].msg_hdr.msg_name = &sources[i];
+                messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            }
+
+            int received = recvmmsg(udpFd, messages, (unsigned)batch, MSG_DONTWAIT, nullptr);
+            if (received <= 0) return;
+            __atomic_fetch_add(&control->received, (uint64_t)received, __ATOMIC_RELAXED);
+            __atomic_fetch_add(&control->batches, 1, __ATOMIC_RELAXED);
+            if (discard) {
+                __atomic_fetch_add(&control->dropped, (uint64_t)received, __ATOMIC_RELAXED);
+                continue;
+            }
+
+            uint64_t now = realtimeMicros();
+            uint64_t invalid = 0;
+            for (int i = 0; i < received; i++) {
+                RingSlotHeader* slot = file.slot(ring, writeIndex + i);
+                uint32_t length = messages[i].msg_len;
+                uint32_t kind = (messages[i].msg_hdr.msg_flags & MSG_TRUNC) ? 0 : classify((uint8_t*)(slot + 1), length);
+                // Slot invalid tetap dipakai (SKIP) agar slot setelahnya tidak perlu digeser
+                slot->length = kind ? length : 0;
+                slot->flags = kind ? kind : INGEST_FLAG_SKIP;
+                slot->receivedAtUs = now;
+                slot->sourceAddress = sources[i].sin_addr.s_addr;
+                slot->sourcePort = ntohs(sources[i].sin_port);
+                if (!kind) invalid++;
+            }
+            if (invalid) __atomic_fetch_add(&control->invalid, invalid, __ATOMIC_RELAXED);
+            commit((uint64_t)received, reserveSequence((uint64_t)received));
+            if (received < batch) return;
+        }
+    }
+
+    void acceptAll() {
+        for (;;) {
+            sockaddr_in source{};
+            socklen_t length = sizeof(source);
+            int fd = accept4(tcpFd, (sockaddr*)&source, &length, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) return;
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            TcpConnection& connection = connections[fd];
+            connection.buffer.resize(TCP_BUFFER_BYTES);
+            connection.address = source.sin_addr.s_addr;
+            connection.port = ntohs(source.sin_port);
+            watch(fd);
+        }
+    }
+
+    // TCP tidak bisa langsung ke slot (batas frame belum diketahui): satu copy per frame
+    void readTcp(int fd) {
+        TcpConnection& connection = connections[fd];
+        RingControl* control = file.control(ring);
+        ssize_t count = read(fd, connection.buffer.data() + connection.length, connection.buffer.size() - connection.length);
+        if (count <= 0) {
+            if (count < 0 && (errno == EAGAIN || errno == EINTR)) return;
+            epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+            close(fd);
+            connections.erase(fd);
+            return;
+        }
+        connection.length += (size_t)count;
+
+        const uint32_t capacity = file.payloadCapacity();
+        uint64_t now = realtimeMicros();
+        uint64_t published = 0;
+        size_t offset = 0;
+        while (connection.length - offset >= 2) {
+            uint32_t frameLength = ((uint32_t)connection.buffer[offset] << 8) | connection.buffer[offset + 1];
+            if (connection.length - offset - 2 < frameLength) break;
+            const uint8_t* frame = connection.buffer.data() + offset + 2;
+            offset += 2 + frameLength;
+            __atomic_fetch_add(&control->received, 1, __ATOMIC_RELAXED);
+
+            uint32_t length = frameLength;
+            uint32_t kind = frameLength <= capacity ? classify(frame, length) : 0;
+            if (!kind) {
+                __atomic_fetch_add(&control->invalid, 1, __ATOMIC_RELAXED);
+                continue;
+            }
+            if (freeSlots() <= published) {
+                __atomic_fetch_add(&control->dropped, 1, __ATOMIC_RELAXED);
+                continue;
+            }
+            RingSlotHeader* slot = file.slot(ring, writeIndex + published);
+            memcpy(slot + 1, frame, length);
+            slot->length = length;
+            slot->flags = kind | INGEST_FLAG_TCP;
+            slot->receivedAtUs = now;
+            slot->sourceAddress = connection.address;
+            slot->sourcePort = connection.port;
+            published++;
+        }
+        if (published) commit(published, reserveSequence(published));
+
+        memmove(connection.buffer.data(), connection.buffer.data() + offset, connection.length - offset);
+        connection.length -= offset;
+    }
+
+    uint32_t ring;
+    RingFile& file;
+    uint64_t writeIndex = 0;
+    int epollFd = -1;
+    int udpFd = -1;
+    int tcpFd = -1;
+    std::unordered_map<int, TcpConnection> connections;
+    uint8_t scratch[RECV_BATCH * 64];
+};
+
+// Worker ke-0 bind dulu (port 0 = acak untuk bench), sisanya ikut port yang sama
+static bool openWorkers(std::vector<IngestWorker*>& workers, RingFile& file, int count, int udpPort, int tcpPort) {
+    for (int i = 0; i < count; i++) {
+        IngestWorker* worker = new IngestWorker((uint32_t)i, file);
+        workers.push_back(worker);
+        if (!worker->open(udpPort, tcpPort)) {
+            fprintf(stderr, "❌ [SIDECAR] Worker %d cannot bind udp %d / tcp %d: %s\n", i, udpPort, tcpPort, strerror(errno));
+            return false;
+        }
+        if (i == 0) {
+            udpPort = worker->udpPort();
+            tcpPort = worker->tcpPort();
+        }
+    }
+    return true;
+}
+
+// ================== RUN ==================
+static int runSidecar(Options options) {
+    if (options.workers <= 0) options.workers = std::max(1u, std::thread::hardware_concurrency());
+    if (options.slotCount & (options.slotCount - 1)) {
+        fprintf(stderr, "❌ --slots must be a power of two\n");
+        return 1;
+    }
+
+    RingFile file;
+    if (!file.create(options.shmPath, (uint32_t)options.workers, options.slotCount, options.slotBytes)) return 1;
+
+    std::vector<IngestWorker*> workers;
+    bool ok = openWorkers(workers, file, options.workers, options.udpPort, options.tcpPort);
+    std::vector<std::thread> threads;
+    if (ok) {
+        for (IngestWorker* worker : workers) threads.emplace_back([worker]() { worker->run(); });
+        printf("🛰️ [SIDECAR] %d workers on udp %d / tcp %d, ring %s (%u slots x %u bytes per worker)\n",
+               options.workers, options.udpPort, options.tcpPort, options.shmPath, options.slotCount, options.slotBytes);
+        fflush(stdout);
+    }
+
+    std::vector<uint64_t> previous(workers.size() * 3, 0);
+    uint64_t lastAt = monotonicMicros();
+    while (ok && running) {
+        usleep((useconds_t)options.statsIntervalMs * 1000);
+        uint64_t now = monotonicMicros();
+        double seconds = (now - lastAt) / 1e6;
+        lastAt = now;
+        uint64_t received = 0, invalid = 0, dropped = 0, backlog = 0;
+        for (size_t i = 0; i < workers.size(); i++) {
+            RingControl* control = file.control((uint32_t)i);
+            uint64_t counters[3] = {
+                __atomic_load_n(&control->received, __ATOMIC_RELAXED),
+                __atomic_load_n(&control->invalid, __ATOMIC_RELAXED),
+                __atomic_load_n(&control->dropped, __ATOMIC_RELAXED)
+            };
+            received += counters[0] - previous[i * 3];
+            invalid += counters[1] - previous[i * 3 + 1];
+            dropped += counters[2] - previous[i * 3 + 2];
+            for (int c = 0; c < 3; c++) previous[i * 3 + c] = counters[c];
+            backlog += __atomic_load_n(&control->writeIndex, __ATOMIC_ACQUIRE) - __atomic_load_n(&control->readIndex, __ATOMIC_ACQUIRE);
+        }
+        if (received || invalid || dropped) {
+            printf("📊 [SIDECAR] %.0f frames/s, invalid %llu, dropped %llu (ring full), backlog %llu\n",
+                   received / seconds, (unsigned long long)invalid, (unsigned long long)dropped, (unsigned long long)backlog);
+            fflush(stdout);
+        }
+    }
+
+    running = false;
+    for (std::thread& thread : threads) thread.join();
+    for (IngestWorker* worker : workers) delete worker;
+    unlink(options.shmPath);
+    return ok ? 0 : 1;
+}
+
+// ================== SWARM GENERATOR ==================
+struct SwarmConfig {
+    sockaddr_in target{};
+    long devices = 100;
+    double rateHz = 10;             // Per device; 0 = secepatnya
+    double seconds = 10;
+    int threads = 1;
+};
+
+// Satu siklus MAVLink seperti MavlinkEncoding firmware; sysid per device (1..255)
+static size_t buildCycle(MavlinkEncoder& mavlink, long device, long cycle, uint8_t* out) {
+    uint32_t now = (uint32_t)(monotonicMicros() / 1000);
+    float voltage = 12.0f + (cycle % 200) / 100.0f;
+    float lat = -5.397f + (device % 100) * 0.0001f;
+    size_t length = 0;
+    length += mavlink.packHeartbeat(out + length);
+    length += mavlink.packSysStatus(out + length, voltage, 2.3f);
+    length += mavlink.packBatteryStatus(out + length, voltage, 2.3f);
+    length += mavlink.packGlobalPositionInt(out + length, now, lat, 105.266f, 150.0f + cycle % 50);
+    length += mavlink.packScaledPressure(out + length, now, 25.8f);
+    return length;
+}
+
+// Device [first, first + count): socket per device (flow berbeda -> tersebar antar worker)
+static void runSwarmThread(const SwarmConfig& config, long first, long count, std::atomic<uint64_t>& sent) {
+    const int variants = 16;       // Siklus pra-encode per device (seq MAVLink berbeda)
+    std::vector<int> sockets((size_t)count);
+    std::vector<std::vector<uint8_t>> cycles((size_t)(count * variants));
+    for (long d = 0; d < count; d++) {
+        sockets[(size_t)d] = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        connect(sockets[(size_t)d], (const sockaddr*)&config.target, sizeof(config.target));
+        MavlinkEncoder mavlink((uint8_t)((first + d) % 255 + 1), 1);
+        for (int v = 0; v < variants; v++) {
+            uint8_t buffer[512];
+            size_t length = buildCycle(mavlink, first + d, v, buffer);
+            cycles[(size_t)(d * variants + v)].assign(buffer, buffer + length);
+        }
+    }
+
+    mmsghdr messages[SEND_BATCH];
+    iovec vectors[SEND_BATCH];
+    uint64_t start = monotonicMicros();
+    uint64_t end = start + (uint64_t)(config.seconds * 1e6);
+    double intervalUs = config.rateHz > 0 ? 1e6 / config.rateHz : 0;
+    long cycle = 0;
+
+    while (running && monotonicMicros() < end) {
+        // Satu putaran: tiap device satu datagram, dikirim per socket dalam batch sendmmsg
+        for (long d = 0; d < count; d++) {
+            int batch = 0;
+            if (intervalUs == 0) {
+                for (; batch < SEND_BATCH; batch++) {
+                    std::vector<uint8_t>& datagram = cycles[(size_t)(d * variants + (cycle + batch) % variants)];
+                    vectors[batch] = { datagram.data(), datagram.size() };
+                    memset(&messages[batch].msg_hdr, 0, sizeof(msghdr));
+                    messages[batch].msg_hdr.msg_iov = &vectors[batch];
+                    messages[batch].msg_hdr.msg_iovlen = 1;
+                }
+            } else {
+                std::vector<uint8_t>& datagram = cycles[(size_t)(d * variants + cycle % variants)];
+                vectors[0] = { datagram.data(), datagram.size() };
+                memset(&messages[0].msg_hdr, 0, sizeof(msghdr));
+                messages[0].msg_hdr.msg_iov = &vectors[0];
+                messages[0].msg_hdr.msg_iovlen = 1;
+                batch = 1;
+            }
+            int result = sendmmsg(sockets[(size_t)d], messages, (unsigned)batch, 0);
+            if (result > 0) sent += (uint64_t)result;
+        }
+        cycle += intervalUs == 0 ? SEND_BATCH : 1;
+        if (intervalUs > 0) {
+            uint64_t nextAt = start + (uint64_t)(cycle * intervalUs);
+            uint64_t current = monotonicMicros();
+            if (nextAt > current) usleep((useconds_t)(nextAt - current));
+        }
+    }
+    for (int fd : sockets) close(fd);
+}
+
+static void runSwarm(const SwarmConfig& config, std::atomic<uint64_t>& sent) {
+    std::vector<std::thread> threads;
+    long perThread = (config.devices + config.threads - 1) / config.threads;
+    for (int t = 0; t < config.threads; t++) {
+        long first = t * perThread;
+        long count = std::min(perThread, config.devices - first);
+        if (count > 0) threads.emplace_back([&config, first, count, &sent]() { runSwarmThread(config, first, count, sent); });
+    }
+    for (std::thread& thread : threads) thread.join();
+}
+
+// ================== BENCH ==================
+// Consumer pengganti server.js: baca slot, cek urutan, lepas (tanpa parse MAVLink)
+static void runConsumer(RingFile& file, std::atomic<uint64_t>& consumed, std::atomic<uint64_t>& orderErrors) {
+    std::vector<uint64_t> readIndex(file.header->ringCount, 0);
+    std::vector<uint64_t> lastSequence(file.header->ringCount, 0);
+    while (running) {
+        bool idle = true;
+        for (uint32_t ring = 0; ring < file.header->ringCount; ring++) {
+            RingControl* control = file.control(ring);
+            uint64_t write = __atomic_load_n(&control->writeIndex, __ATOMIC_ACQUIRE);
+            if (write == readIndex[ring]) continue;
+            idle = false;
+            for (uint64_t i = readIndex[ring]; i < write; i++) {
+                RingSlotHeader* slot = file.slot(ring, i);
+                if (slot->sequence <= lastSequence[ring]) orderErrors++;
+                lastSequence[ring] = slot->sequence;
+                if (!(slot->flags & INGEST_FLAG_SKIP)) consumed++;
+            }
+            readIndex[ring] = write;
+            __atomic_store_n(&control->readIndex, write, __ATOMIC_RELEASE);
+        }
+        if (idle) usleep(50);
+    }
+}
+
+static int runBench(std::vector<int> workerCounts, double seconds, long devices) {
+    printf("Ingest sidecar bench: %ld devices flat out, %.1fs per run, %u cores\n", devices, seconds, std::thread::hardware_concurrency());
+    printf("%8s %14s %14s %10s %10s %12s\n", "workers", "sent/s", "received/s", "invalid", "dropped", "kernel loss");
+
+    for (int workerCount : workerCounts) {
+        std::string path = "/dev/shm/uav-ingest-bench-" + std::to_string(getpid());
+        RingFile file;
+        if (!file.create(path.c_str(), (uint32_t)workerCount, 16384, 1024)) return 1;
+
+        running = true;
+        std::vector<IngestWorker*> workers;
+        if (!openWorkers(workers, file, workerCount, 0, 0)) return 1;
+        int port = workers[0]->udpPort();
+        std::vector<std::thread> threads;
+        for (IngestWorker* worker : workers) threads.emplace_back([worker]() { worker->run(); });
+        std::atomic<uint64_t> consumed{0}, orderErrors{0}, sent{0};
+        std::thread consumer([&]() { runConsumer(file, consumed, orderErrors); });
+
+        SwarmConfig config;
+        config.target.sin_family = AF_INET;
+        config.target.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        config.target.sin_port = htons((uint16_t)port);
+        config.devices = devices;
+        config.rateHz = 0;
+        config.seconds = seconds;
+        config.threads = std::max(1, workerCount);
+        runSwarm(config, sent);
+        usleep(200000);             // Sisa datagram di socket buffer
+
+        running = false;
+        for (std::thread& thread : threads) thread.join();
+        consumer.join();
+        uint64_t received = 0, invalid = 0, dropped = 0;
+        for (int i = 0; i < workerCount; i++) {
+            received += file.control((uint32_t)i)->received;
+            invalid += file.control((uint32_t)i)->invalid;
+            dropped += file.control((uint32_t)i)->dropped;
+        }
+        for (IngestWorker* worker : workers) delete worker;
+        unlink(path.c_str());
+
+        uint64_t offered = sent.load();
+        printf("%8d %14.0f %14.0f %10llu %10llu %11.1f%%%s\n", workerCount, offered / seconds, received / seconds,
+               (unsigned long long)invalid, (unsigned long long)dropped,
+               offered ? 100.0 * (double)(offered - std::min(offered, received)) / offered : 0.0,
+               orderErrors ? "  ORDER ERROR" : "");
+        fflush(stdout);
+    }
+    printf("(satu datagram = satu siklus MAVLink 5 message; kernel loss = dibuang socket buffer saat sidecar tertinggal)\n");
+    return 0;
+}
+
+// ================== MAIN ==================
+static void onSignal(int) { running = false; }
+
+static void usage() {
+    fprintf(stderr,
+        "Usage: ingest_sidecar run [--udp 14550] [--tcp 14571] [--workers n] [--shm path] [--slots n] [--slot-bytes n]\n"
+        "       ingest_sidecar swarm [--target host:port] [--devices 100] [--rate 10] [--seconds 10] [--threads 1]\n"
+        "       ingest_sidecar bench [--workers 1,2,4] [--seconds 3] [--devices 256]\n");
+}
+
+static bool parseTarget(const char* value, sockaddr_in& target) {
+    std::string text = value;
+    size_t colon = text.rfind(':');
+    if (colon == std::string::npos) return false;
+    target.sin_family = AF_INET;
+    target.sin_port = htons((uint16_t)atoi(text.c_str() + colon + 1));
+    return inet_pton(AF_INET, text.substr(0, colon).c_str(), &target.sin_addr) == 1;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage();
+        return 1;
+    }
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+    signal(SIGPIPE, SIG_IGN);
+
+    std::string command = argv[1];
+    Options options;
+    SwarmConfig swarm;
+    parseTarget("127.0.0.1:14550", swarm.target);
+    std::vector<int> benchWorkers;
+    double benchSeconds = 3;
+    long benchDevices = 256;
+
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            usage();
+            return 1;
+        }
+        i++;
+        if (arg == "--udp") options.udpPort = atoi(value);
+        else if (arg == "--tcp") options.tcpPort = atoi(value);
+        else if (arg == "--workers" && command == "bench") {
+            for (const char* cursor = value; *cursor; cursor = strchr(cursor, ',') ? strchr(cursor, ',') + 1 : cursor + strlen(cursor)) {
+                benchWorkers.push_back(std::max(1, atoi(cursor)));
+            }
+        }
+        else if (arg == "--workers") options.workers = atoi(value);
+        else if (arg == "--shm") options.shmPath = value;
+        else if (arg == "--slots") options.slotCount = (uint32_t)atol(value);
+        else if (arg == "--slot-bytes") options.slotBytes = (uint32_t)std::max(256L, atol(value));
+        else if (arg == "--stats-ms") options.statsIntervalMs = std::max(100L, atol(value));
+        else if (arg == "--target" && !parseTarget(value, swarm.target)) {
+            fprintf(stderr, "❌ Invalid --target %s\n", value);
+            return 1;
+        }
+        else if (arg == "--devices") swarm.devices = benchDevices = std::max(1L, atol(value));
+        else if (arg == "--rate") swarm.rateHz = atof(value);
+        else if (arg == "--seconds") swarm.seconds = benchSeconds = atof(value);
+        else if (arg == "--threads") swarm.threads = std::max(1, atoi(value));
+        else if (arg != "--target") {
+            usage();
+            return 1;
+        }
+    }
+
+    if (command == "run") return runSidecar(options);
+    if (command == "bench") {
+        if (benchWorkers.empty()) {
+            for (unsigned n = 1; n <= std::max(1u, std::thread::hardware_concurrency()); n *= 2) benchWorkers.push_back((int)n);
+        }
+        return runBench(benchWorkers, benchSeconds, benchDevices);
+    }
+    if (command == "swarm") {
+        std::atomic<uint64_t> sent{0};
+        uint64_t start = monotonicMicros();
+        runSwarm(swarm, sent);
+        double seconds = (monotonicMicros() - start) / 1e6;
+        printf("🐝 [SWARM] %ld devices, %llu datagrams in %.1fs (%.0f/s)\n", swarm.devices,
+               (unsigned long long)sent.load(), seconds, sent.load() / seconds);
+        return 0;
+    }
+    usage();
+    return 1;
+}
@@ -0,0 +1,526 @@
+/**
+ * USB Serial Telemetry Bridge
+ * Membaca tty dari firmware profile USB serial, men-deframe COBS + CRC-32
+ * (ESP32/ESP32_dashboard/serial_framing.h) dan meneruskan frame yang valid
+ * ke server.js lewat TCP lokal: [u16 big endian length][header + payload].
+ *
+ * Mode:
+ *   serial_bridge /dev/ttyUSB0        bridge dari device nyata
+ *   serial_bridge --pty               buat pasangan PTY, cetak path slave
+ *                                     (untuk firmware host build: HOST_SERIAL_DEVICE=<slave>)
+ *   serial_bridge --loopback 5000     self-test end-to-end lewat PTY: generator
+ *                                     menulis frame MAVLink ke slave, bridge membaca master
+ *
+ * Statistik per interval: frames/s, throughput, CRC/COBS error, sequence gap,
+ * latency p50/p99/max. Di loopback clock generator = clock bridge sehingga
+ * latency absolut; dari device nyata yang dilaporkan adalah delay di atas
+ * offset minimum (variasi delay satu arah).
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#include "../ESP32/ESP32_dashboard/serial_framing.h"
+#include "../ESP32/ESP32_dashboard/mavlink_telemetry.h"
+
+static const size_t MAX_FRAME_BYTES = 2048;   // Frame tanpa delimiter lebih dari ini = sampah, buang
+static const int RECONNECT_INTERVAL_MS = 2000;
+
+static std::atomic<bool> running{true};
+
+static uint64_t monotonicMicros() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000ULL + (uint64_t)now.tv_nsec / 1000;
+}
+
+// ================== OPTIONS ==================
+struct Options {
+    const char* device = nullptr;
+    bool createPty = false;
+    long loopbackFrames = 0;
+    long loopbackRate = 0;          // frame/s, 0 = secepatnya
+    long corruptEvery = 0;          // Loopback: rusak 1 byte tiap N frame
+    long baud = 921600;
+    const char* forwardHost = "127.0.0.1";
+    int forwardPort = 14560;
+    bool forward = true;
+    long statsIntervalMs = 1000;
+};
+
+static void usage() {
+    fprintf(stderr,
+        "Usage: serial_bridge <tty> | --pty | --loopback <frames>\n"
+        "  --baud <n>             baud rate tty (default 921600)\n"
+        "  --forward <host:port>  tujuan server.js (default 127.0.0.1:14560)\n"
+        "  --no-forward           hanya statistik, tidak diteruskan\n"
+        "  --stats-ms <n>         interval laporan (default 1000)\n"
+        "  --rate <n>             loopback: frame per detik (default secepatnya)\n"
+        "  --corrupt-every <n>    loopback: rusak 1 byte tiap n frame\n");
+}
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (strcmp(arg, "--pty") == 0) {
+            options.createPty = true;
+        } else if (strcmp(arg, "--loopback") == 0 && hasValue) {
+            options.loopbackFrames = atol(argv[++i]);
+        } else if (strcmp(arg, "--rate") == 0 && hasValue) {
+            options.loopbackRate = atol(argv[++i]);
+        } else if (strcmp(arg, "--corrupt-every") == 0 && hasValue) {
+            options.corruptEvery = atol(argv[++i]);
+        } else if (strcmp(arg, "--baud") == 0 && hasValue) {
+            options.baud = atol(argv[++i]);
+        } else if (strcmp(arg, "--stats-ms") == 0 && hasValue) {
+            options.statsIntervalMs = std::max(100L, atol(argv[++i]));
+        } else if (strcmp(arg, "--no-forward") == 0) {
+            options.forward = false;
+        } else if (strcmp(arg, "--forward") == 0 && hasValue) {
+            static char host[256];
+            const char* value = argv[++i];
+            const char* colon = strrchr(value, ':');
+            if (!colon) return false;
+            snprintf(host, sizeof(host), "%.*s", (int)(colon - value), value);
+            options.forwardHost = host;
+            options.forwardPort = atoi(colon + 1);
+        } else if (arg[0] != '-' && !options.device) {
+            options.device = arg;
+        } else {
+            return false;
+        }
+    }
+    return options.device || options.createPty || options.loopbackFrames > 0;
+}
+
+// ================== TTY ==================
+static speed_t baudConstant(long baud) {
+    switch (baud) {
+        case 115200: return B115200;
+        case 230400: return B230400;
+        case 460800: return B460800;
+        case 500000: return B500000;
+        case 921600: return B921600;
+        case 1000000: return B1000000;
+        case 2000000: return B2000000;
+        default: return B921600;
+    }
+}
+
+static bool configureRaw(int fd, long baud) {
+    termios tty;
+    if (tcgetattr(fd, &tty) != 0) return false;
+    cfmakeraw(&tty);
+    cfsetispeed(&tty, baudConstant(baud));
+    cfsetospeed(&tty, baudConstant(baud));
+    tty.c_cc[VMIN] = 0;
+    tty.c_cc[VTIME] = 1;     // read() kembali paling lambat 100ms agar statistik tetap jalan
+    return tcsetattr(fd, TCSANOW, &tty) == 0;
+}
+
+// Master dibaca bridge, path slave diberikan ke penulis (firmware host / generator)
+static int openPtyPair(char* slavePath, size_t capacity) {
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) return -1;
+    if (ptsname_r(master, slavePath, capacity) != 0) return -1;
+    return master;
+}
+
+// ================== FORWARDER ==================
+class Forwarder {
+public:
+    Forwarder(const Options& options) : options(options) {}
+    ~Forwarder() { disconnect(); }
+
+    bool send(const uint8_t* frame, size_t length) {
+        if (!options.forward) return true;
+        if (fd < 0 && !connectNow()) return false;
+
+        uint8_t prefix[2] = {(uint8_t)(length >> 8), (uint8_t)(length & 0xFF)};
+        if (!writeAll(prefix, 2) || !writeAll(frame, length)) {
+            fprintf(stderr, "⚠️ [BRIDGE] Server connection lost\n");
+            disconnect();
+            return false;
+        }
+        return true;
+    }
+
+    bool connected() const { return fd >= 0; }
+
+private:
+    const Options& options;
+    int fd = -1;
+    uint64_t lastAttemptUs = 0;
+
+    bool connectNow() {
+        uint64_t now = monotonicMicros();
+        if (lastAttemptUs != 0 && now - lastAttemptUs < (uint64_t)RECONNECT_INTERVAL_MS * 1000) return false;
+        lastAttemptUs = now;
+
+        char port[8];
+        snprintf(port, sizeof(port), "%d", options.forwardPort);
+        addrinfo hints = {};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* result = nullptr;
+        if (getaddrinfo(options.forwardHost, port, &hints, &result) != 0) return false;
+
+        for (addrinfo* entry = result; entry && fd < 0; entry = entry->ai_next) {
+            fd = socket(entry->ai_family, entry->ai_socktype, entry->ai_protocol);
+            if (fd < 0) continue;
+            if (connect(fd, entry->ai_addr, entry->ai_addrlen) != 0) {
+                close(fd);
+                fd = -1;
+            }
+        }
+        freeaddrinfo(result);
+
+        if (fd >= 0) {
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            fprintf(stderr, "✅ [BRIDGE] Forwarding to %s:%d\n", options.forwardHost, options.forwardPort);
+        }
+        return fd >= 0;
+    }
+
+    bool writeAll(const uint8_t* data, size_t length) {
+        while (length > 0) {
+            ssize_t written = ::send(fd, data, length, MSG_NOSIGNAL);
+            if (written <= 0) {
+                if (written < 0 && errno == EINTR) continue;
+                return false;
+            }
+            data += written;
+            length -= (size_t)written;
+        }
+        return true;
+    }
+
+    void disconnect() {
+        if (fd >= 0) close(fd);
+        fd = -1;
+    }
+};
+
+// ================== STATISTICS ==================
+struct BridgeStats {
+    unsigned long frames = 0;
+    unsigned long payloadBytes = 0;
+    unsigned long wireBytes = 0;
+    unsigned long crcErrors = 0;
+    unsigned long cobsErrors = 0;
+    unsigned long shortFrames = 0;
+    unsigned long oversizeFrames = 0;
+    unsigned long sequenceGaps = 0;
+    unsigned long forwardDrops = 0;
+};
+
+class StatsReporter {
+public:
+    StatsReporter(bool absoluteLatency, long intervalMs)
+        : absoluteLatency(absoluteLatency), intervalUs((uint64_t)intervalMs * 1000) {
+        startedUs = lastReportUs = monotonicMicros();
+    }
+
+    void onFrame(uint32_t sentMicros, uint64_t receivedUs) {
+        int64_t offset = (int64_t)(uint32_t)((uint32_t)receivedUs - sentMicros);
+        if (absoluteLatency) {
+            latencies.push_back(offset);
+            allLatencies.push_back(offset);
+            return;
+        }
+        // Clock device beda: ukur delay relatif terhadap offset terkecil yang pernah terlihat
+        if (!haveFloor || offset < floorOffset) {
+            floorOffset = offset;
+            haveFloor = true;
+        }
+        latencies.push_back(offset - floorOffset);
+        allLatencies.push_back(offset - floorOffset);
+    }
+
+    void maybeReport(const BridgeStats& stats, const char* forwardState) {
+        uint64_t now = monotonicMicros();
+        if (now - lastReportUs < intervalUs) return;
+
+        double seconds = (now - lastReportUs) / 1e6;
+        unsigned long frames = stats.frames - previous.frames;
+        unsigned long wireBytes = stats.wireBytes - previous.wireBytes;
+        char latency[96];
+        formatLatency(latencies, latency, sizeof(latency));
+        fprintf(stderr, "📊 [BRIDGE] %.0f frames/s, %.1f KB/s wire | crc %lu, cobs %lu, gaps %lu | %s | %s\n",
+                frames / seconds, wireBytes / seconds / 1024.0,
+                stats.crcErrors, stats.cobsErrors, stats.sequenceGaps, latency, forwardState);
+
+        latencies.clear();
+        previous = stats;
+        lastReportUs = now;
+    }
+
+    void summary(const BridgeStats& stats) {
+        double seconds = (monotonicMicros() - startedUs) / 1e6;
+        char latency[96];
+        formatLatency(allLatencies, latency, sizeof(latency));
+        fprintf(stderr, "🏁 [BRIDGE] %lu frames in %.2fs (%.0f frames/s, %.1f KB/s payload, %.1f KB/s wire)\n",
+                stats.frames, seconds, stats.frames / seconds,
+                stats.payloadBytes / seconds / 1024.0, stats.wireBytes / seconds / 1024.0);
+        fprintf(stderr, "    crc errors %lu, cobs errors %lu, short %lu, oversize %lu, sequence gaps %lu, forward drops %lu\n",
+                stats.crcErrors, stats.cobsErrors, stats.shortFrames, stats.oversizeFrames,
+                stats.sequenceGaps, stats.forwardDrops);
+        fprintf(stderr, "    %s\n", latency);
+    }
+
+private:
+    bool absoluteLatency;
+    uint64_t intervalUs;
+    uint64_t startedUs;
+    uint64_t lastReportUs;
+    bool haveFloor = false;
+    int64_t floorOffset = 0;
+    std::vector<int64_t> latencies;
+    std::vector<int64_t> allLatencies;
+    BridgeStats previous;
+
+    void formatLatency(std::vector<int64_t>& samples, char* out, size_t capacity) const {
+        const char* label = absoluteLatency ? "latency" : "delay above floor";
+        if (samples.empty()) {
+            snprintf(out, capacity, "%s -", label);
+            return;
+        }
+        std::sort(samples.begin(), samples.end());
+        auto at = [&](double q) { return samples[(size_t)(q * (samples.size() - 1))] / 1000.0; };
+        snprintf(out, capacity, "%s p50 %.2fms p99 %.2fms max %.2fms", label, at(0.5), at(0.99), samples.back() / 1000.0);
+    }
+};
+
+// ================== DEFRAMER ==================
+class Deframer {
+public:
+    Deframer(BridgeStats& stats, StatsReporter& reporter, Forwarder& forwarder)
+        : stats(stats), reporter(reporter), forwarder(forwarder) {}
+
+    void push(const uint8_t* data, size_t length) {
+        uint64_t receivedUs = monotonicMicros();
+        for (size_t i = 0; i < length; i++) {
+            uint8_t byte = data[i];
+            stats.wireBytes++;
+            if (byte != SERIAL_FRAME_DELIMITER) {
+                if (encodedLength < sizeof(encoded)) {
+                    encoded[encodedLength] = byte;
+                } else {
+                    overflow = true;
+                }
+                encodedLength++;
+                continue;
+            }
+
+            if (overflow) {
+                stats.oversizeFrames++;
+            } else if (encodedLength > 0) {
+                handleFrame(receivedUs);
+            }
+            encodedLength = 0;
+            overflow = false;
+        }
+    }
+
+private:
+    BridgeStats& stats;
+    StatsReporter& reporter;
+    Forwarder& forwarder;
+    uint8_t encoded[MAX_FRAME_BYTES];
+    uint8_t raw[MAX_FRAME_BYTES];
+    size_t encodedLength = 0;
+    bool overflow = false;
+    bool haveSequence = false;
+    uint32_t expectedSequence = 0;
+
+    void handleFrame(uint64_t receivedUs) {
+        size_t rawLength = cobsDecode(encoded, encodedLength, raw, sizeof(raw));
+        if (rawLength == 0) {
+            stats.cobsErrors++;
+            return;
+        }
+
+        SerialFrameHeader header;
+        size_t payloadLength = 0;
+        switch (serialFrameParse(raw, rawLength, header, payloadLength)) {
+            case SERIAL_FRAME_CRC_ERROR: stats.crcErrors++; return;
+            case SERIAL_FRAME_TOO_SHORT: stats.shortFrames++; return;
+            case SERIAL_FRAME_COBS_ERROR: stats.cobsErrors++; return;
+            case SERIAL_FRAME_OK: break;
+        }
+
+        // Sequence mundur = device reboot, bukan gap
+        if (haveSequence && header.sequence > expectedSequence) {
+            stats.sequenceGaps += header.sequence - expectedSequence;
+        }
+        haveSequence = true;
+        expectedSequence = header.sequence + 1;
+
+        stats.frames++;
+        stats.payloadBytes += payloadLength;
+        reporter.onFrame(header.sentMicros, receivedUs);
+
+        // CRC sudah dicek di sini, server menerima header + payload saja
+        if (!forwarder.send(raw, SERIAL_FRAME_HEADER_LEN + payloadLength)) {
+            stats.forwardDrops++;
+        }
+    }
+};
+
+// ================== LOOPBACK GENERATOR ==================
+// Satu siklus MAVLink seperti MavlinkEncoding firmware, di-frame sama persis dengan SerialTransport
+static void runGenerator(const char* slavePath, const Options& options, std::atomic<long>& sent) {
+    int fd = open(slavePath, O_WRONLY | O_NOCTTY);
+    if (fd < 0 || !configureRaw(fd, options.baud)) {
+        fprintf(stderr, "❌ [LOOPBACK] Cannot open %s: %s\n", slavePath, strerror(errno));
+        running = false;
+        return;
+    }
+
+    MavlinkEncoder mavlink(1, 1);
+    uint8_t payload[512];
+    uint8_t scratch[600];
+    uint8_t frame[SERIAL_COBS_MAX_LEN(sizeof(scratch))];
+    uint64_t intervalUs = options.loopbackRate > 0 ? 1000000ULL / options.loopbackRate : 0;
+    uint64_t nextAt = monotonicMicros();
+
+    for (long i = 0; i < options.loopbackFrames && running; i++) {
+        uint32_t now = (uint32_t)(monotonicMicros() / 1000);
+        float voltage = 12.0f + (i % 200) / 100.0f;
+        size_t length = 0;
+        length += mavlink.packHeartbeat(payload + length);
+        length += mavlink.packSysStatus(payload + length, voltage, 2.3f);
+        length += mavlink.packBatteryStatus(payload + length, voltage, 2.3f);
+        length += mavlink.packGlobalPositionInt(payload + length, now, -5.397f, 105.266f, 150.0f);
+        length += mavlink.packScaledPressure(payload + length, now, 25.8f);
+
+        SerialFrameHeader header;
+        header.sequence = (uint32_t)i;
+        header.sentMicros = (uint32_t)monotonicMicros();
+        size_t frameLength = serialFrameEncode(header, payload, length, scratch, sizeof(scratch), frame, sizeof(frame));
+        if (options.corruptEvery > 0 && i % options.corruptEvery == options.corruptEvery - 1) {
+            frame[frameLength / 2] ^= 0x5A;     // Simulasi noise kabel
+            if (frame[frameLength / 2] == 0) frame[frameLength / 2] = 0x01;
+        }
+
+        const uint8_t* cursor = frame;
+        size_t remaining = frameLength;
+        while (remaining > 0 && running) {
+            ssize_t written = write(fd, cursor, remaining);
+            if (written < 0) {
+                if (errno == EINTR || errno == EAGAIN) continue;
+                running = false;
+                break;
+            }
+            cursor += written;
+            remaining -= (size_t)written;
+        }
+        sent++;
+
+        if (intervalUs > 0) {
+            nextAt += intervalUs;
+            uint64_t current = monotonicMicros();
+            if (nextAt > current) usleep((useconds_t)(nextAt - current));
+        }
+    }
+    close(fd);
+}
+
+// ================== MAIN ==================
+static void onSignal(int) { running = false; }
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        usage();
+        return 2;
+    }
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    bool loopback = options.loopbackFrames > 0;
+    char slavePath[128] = "";
+    int fd = -1;
+    if (options.createPty || loopback) {
+        fd = openPtyPair(slavePath, sizeof(slavePath));
+        if (fd < 0) {
+            fprintf(stderr, "❌ [BRIDGE] Cannot create PTY pair: %s\n", strerror(errno));
+            return 1;
+        }
+        if (options.createPty) {
+            printf("%s\n", slavePath);
+            fflush(stdout);
+        }
+        fprintf(stderr, "🔌 [BRIDGE] PTY slave: %s\n", slavePath);
+    } else {
+        fd = open(options.device, O_RDONLY | O_NOCTTY);
+        if (fd < 0) {
+            fprintf(stderr, "❌ [BRIDGE] Cannot open %s: %s\n", options.device, strerror(errno));
+            return 1;
+        }
+        fprintf(stderr, "🔌 [BRIDGE] Reading %s @ %ld baud\n", options.device, options.baud);
+    }
+    configureRaw(fd, options.baud);
+
+    BridgeStats stats;
+    StatsReporter reporter(loopback, options.statsIntervalMs);
+    Forwarder forwarder(options);
+    Deframer deframer(stats, reporter, forwarder);
+
+    std::atomic<long> sent{0};
+    std::thread generator;
+    if (loopback) {
+        generator = std::thread(runGenerator, slavePath, std::cref(options), std::ref(sent));
+    }
+
+    uint8_t buffer[4096];
+    uint64_t idleSinceUs = monotonicMicros();
+    while (running) {
+        ssize_t count = read(fd, buffer, sizeof(buffer));
+        if (count > 0) {
+            deframer.push(buffer, (size_t)count);
+            idleSinceUs = monotonicMicros();
+        } else if (count < 0 && errno != EAGAIN && errno != EINTR && errno != EIO) {
+            fprintf(stderr, "❌ [BRIDGE] Read error: %s\n", strerror(errno));
+            break;
+        }
+
+        // Loopback selesai: generator sudah berhenti dan tidak ada byte masuk 200ms
+        if (loopback && sent.load() >= options.loopbackFrames && monotonicMicros() - idleSinceUs > 200000) break;
+        // EIO di master PTY = penulis menutup slave, tunggu penulis berikutnya
+        if (count < 0 && errno == EIO) usleep(50000);
+
+        reporter.maybeReport(stats, !options.forward ? "stats only" : forwarder.connected() ? "forwarding" : "server offline");
+    }
+
+    running = false;
+    if (generator.joinable()) generator.join();
+    close(fd);
+    reporter.summary(stats);
+
+    if (loopback) {
+        unsigned long accounted = stats.frames + stats.crcErrors + stats.cobsErrors + stats.shortFrames;
+        fprintf(stderr, "    loopback: sent %ld, received %lu, accounted %lu\n", sent.load(), stats.frames, accounted);
+        return accounted == (unsigned long)sent.load() ? 0 : 1;
+    }
+    return 0;
+}
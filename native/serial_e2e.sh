@@ -0,0 +1,58 @@
+#!/bin/sh
+# Test end-to-end USB serial bridge di Linux tanpa hardware:
+#   1. loopback: generator -> PTY -> serial_bridge -> TCP -> lib/serial-bridge.js
+#   2. firmware: host build profile USB serial -> PTY -> serial_bridge -> TCP -> lib/serial-bridge.js
+# Usage: native/serial_e2e.sh [frames]
+set -e
+
+NATIVE_DIR="$(cd "$(dirname "$0")" && pwd)"
+ROOT_DIR="$(cd "$NATIVE_DIR/.." && pwd)"
+WORK_DIR="${TMPDIR:-/tmp}/serial-e2e"
+FRAMES="${1:-20000}"
+PORT="${SERIAL_BRIDGE_PORT:-14561}"
+mkdir -p "$WORK_DIR"
+
+sh "$NATIVE_DIR/build.sh" "$WORK_DIR" >/dev/null
+g++ -std=c++17 -O2 -Wall -Wextra -Werror -I"$ROOT_DIR/ESP32/host" \
+    -DFIRMWARE_PROFILE=4 -DENABLE_SERIAL_LOG=0 \
+    -o "$WORK_DIR/firmware_usb_serial" "$ROOT_DIR/ESP32/host/host_main.cpp"
+
+# Receiver = modul yang sama dengan server.js, cetak jumlah frame per koneksi
+node -e "
+const { createSerialBridgeServer } = require('$ROOT_DIR/lib/serial-bridge');
+const { MavlinkParser } = require('$ROOT_DIR/lib/mavlink');
+const parsers = new Map();
+const server = createSerialBridgeServer({
+    port: $PORT,
+    onConnect: (key) => parsers.set(key, { parser: new MavlinkParser(), frames: 0, messages: 0 }),
+    onDisconnect: (key) => {
+        const c = parsers.get(key);
+        console.log('receiver: ' + c.frames + ' frames, ' + c.messages + ' MAVLink messages, crc errors ' + c.parser.stats.crcErrors);
+    },
+    onFrame: (frame, key) => {
+        const c = parsers.get(key);
+        c.frames++;
+        c.messages += c.parser.push(frame.payload).length;
+    }
+});
+process.on('SIGTERM', () => server.close(() => process.exit(0)));
+" &
+RECEIVER=$!
+trap 'kill $RECEIVER 2>/dev/null || true' EXIT
+sleep 0.5
+
+echo "🔁 Loopback: $FRAMES frames, 1 byte rusak tiap 500 frame"
+"$WORK_DIR/serial_bridge" --loopback "$FRAMES" --corrupt-every 500 --forward "127.0.0.1:$PORT"
+sleep 0.3
+
+echo "🛩️ Firmware host build (profile USB serial, 60 detik virtual)"
+"$WORK_DIR/serial_bridge" --pty --stats-ms 60000 --forward "127.0.0.1:$PORT" > "$WORK_DIR/pty_path" &
+BRIDGE=$!
+sleep 0.3
+HOST_SERIAL_DEVICE="$(cat "$WORK_DIR/pty_path")" "$WORK_DIR/firmware_usb_serial" 60
+sleep 0.3
+kill -INT $BRIDGE
+wait $BRIDGE
+sleep 0.3
+
+echo "✅ Serial bridge end-to-end test done"
@@ -1,4 +1,128 @@
 // UAV Dashboard JavaScript - Enhanced Interactive Version
+
+// Library peta/chart dimuat saat kartunya pertama kali terlihat, tidak memblokir render awal
+const LAZY_MODULES = {
+    map: {
+        styles: ['https://unpkg.com/leaflet@1.9.4/dist/leaflet.css'],
+        scripts: ['https://unpkg.com/leaflet@1.9.4/dist/leaflet.js']
+    },
+    chart: {
+        styles: [],
+        scripts: ['https://cdn.jsdelivr.net/npm/chart.js@4.4.0/dist/chart.min.js']
+    }
+};
+
+// Pengganti socket io() per tab: semua tab berbagi satu koneksi di socket-worker.js.
+// Interface on()/emit() sama; on() pertama untuk sebuah event = subscribe di worker.
+class SharedSocket {
+    constructor(worker) {
+        this.shared = true;
+        this.port = worker.port;
+        this.handlers = new Map();
+        this.port.onmessage = (message) => {
+            const { event, data } = message.data;
+            (this.handlers.get(event) || []).forEach((handler) => handler(data));
+        };
+        this.port.start();
+
+        // Tanpa ini worker terus mengirim ke tab yang sudah ditutup
+        window.addEventListener('pagehide', () => this.port.postMessage({ type: 'close' }));
+        window.addEventListener('pageshow', (event) => {
+            if (event.persisted) this.handlers.forEach((handlers, name) => this.port.postMessage({ type: 'subscribe', event: name }));
+        });
+    }
+
+    on(event, handler) {
+        if (!this.handlers.has(event)) {
+            this.handlers.set(event, []);
+            this.port.postMessage({ type: 'subscribe', event });
+        }
+        this.handlers.get(event).push(handler);
+        return this;
+    }
+
+    emit(event, data) {
+        this.port.postMessage({ type: 'emit', event, data });
+        return this;
+    }
+}
+
+// Renderer kartu data: string terformat terakhir di-cache per elemen, DOM hanya ditulis
+// saat berubah, dan semua tulisan digabung dalam satu requestAnimationFrame (tab di
+// background: hanya nilai terakhir yang ditulis). Animasi lewat Web Animations API dengan
+// transform/opacity saja -> jalan di compositor, tanpa toggle class + setTimeout.
+const CARD_PULSE = [{ transform: 'scale(1)' }, { transform: 'scale(1.05)' }, { transform: 'scale(1)' }];
+const INDICATOR_PULSE = [{ opacity: 1, transform: 'scale(1)' }, { opacity: 0.6, transform: 'scale(1.1)' }, { opacity: 1, transform: 'scale(1)' }];
+const TREND_ICONS = { up: 'fas fa-arrow-up', down: 'fas fa-arrow-down', stable: 'fas fa-minus' };
+// Peringatan laju turun baru dinilai setelah meter cukup lama/cukup sampel (firmware stok ~0.33 paket/s)
+const RATE_WARN_MIN_AGE_S = 120;
+const RATE_WARN_MIN_PACKETS = 20;
+
+class CardRenderer {
+    constructor() {
+        this.elements = new Map();
+        this.rendered = new Map();     // key -> nilai yang sudah ada di DOM
+        this.pending = new Map();      // key -> { apply, value } untuk frame berikutnya
+        this.frame = null;
+        this.stats = { writes: 0, skipped: 0, frames: 0 };
+    }
+
+    element(id) {
+        if (!this.elements.has(id)) this.elements.set(id, document.getElementById(id));
+        return this.elements.get(id);
+    }
+
+    queue(key, value, apply) {
+        const current = this.pending.has(key) ? this.pending.get(key).value : this.rendered.get(key);
+        if (current === value) {
+            this.stats.skipped++;
+            return;
+        }
+        this.pending.set(key, { value, apply });
+        if (this.frame === null) this.frame = requestAnimationFrame(() => this.flush());
+    }
+
+    setText(id, text, pulse = CARD_PULSE) {
+        this.queue(id, text, (element) => {
+            element.textContent = text;
+            if (pulse && element.animate) element.animate(pulse, { duration: 500, easing: 'ease' });
+        });
+    }
+
+    // Ganti class ikon yang sudah ada, bukan innerHTML (tanpa parse HTML / node baru)
+    setTrend(id, trend) {
+        this.queue(`${id}:trend`, trend, (element) => {
+            element.className = `data-trend trend-${trend}`;
+            const icon = element.firstElementChild;
+            if (icon) icon.className = TREND_ICONS[trend] || TREND_ICONS.stable;
+        });
+    }
+
+    // Pulse tanpa perubahan isi (indikator paket/refresh): maksimal sekali per frame
+    pulse(id, keyframes = INDICATOR_PULSE, duration = 500) {
+        this.pending.set(`${id}:pulse`, {
+            value: null,
+            apply: (element) => {
+                if (element.animate) element.animate(keyframes, { duration, easing: 'ease' });
+            }
+        });
+        if (this.frame === null) this.frame = requestAnimationFrame(() => this.flush());
+    }
+
+    flush() {
+        this.frame = null;
+        this.stats.frames++;
+        for (const [key, { value, apply }] of this.pending) {
+            const element = this.element(key.split(':')[0]);
+            if (!element) continue;
+            apply(element);
+            if (value !== null) this.rendered.set(key, value);
+            this.stats.writes++;
+        }
+        this.pending.clear();
+    }
+}
+
 class UAVDashboard {
     constructor() {
         this.socket = null;
@@ -13,6 +137,8 @@ class UAVDashboard {
         this.flightPath = [];
         this.currentPosition = null;
         this.homePosition = null;
+        this.geofenceZones = [];
+        this.geofenceLayer = null;
         
         // Settings
         this.settings = {
@@ -27,6 +153,23 @@ class UAVDashboard {
         this.trends = {};
         this.isReceivingRealData = false;
         this.demoInterval = null;
+        this.rateDegraded = false;
+
+        // Backfill: frame live ditahan sampai snapshot history diterapkan, lalu disambung via seq
+        this.lastSeq = 0;
+        this.backfillQueue = null;
+        this.backfillTimer = null;
+
+        // Stream mode dictionary (stream-codec.js): frame telemetryPacked di-inflate berurutan
+        this.streamDecoder = new StreamDecoder();
+        this.packedChain = Promise.resolve();
+
+        // Boot bertahap (lihat init)
+        this.assetLoads = new Map();
+        this.firstValueMs = null;
+
+        // Kartu data: tulis DOM hanya saat nilai terformat berubah
+        this.cards = new CardRenderer();
         
         // UI state
         this.isLoading = true;
@@ -36,53 +179,103 @@ class UAVDashboard {
         this.init();
     }
 
-    async init() {
+    /**
+     * Boot bertahap: kartu telemetry dan kontrol dulu, lalu socket, lalu chart/peta saat
+     * terlihat, animasi saat browser idle. Tahap dicatat sebagai performance mark
+     * (DevTools > Performance > Timings): time-to-interactive dan time-to-first-value.
+     */
+    init() {
         console.log('🚁 Initializing Enhanced UAV Dashboard...');
-        
-        // Show loading screen with progress
-        this.showLoadingScreen();
-        
-        // Initialize components with progress tracking
-        await this.initializeWithProgress();
-        
-        // Hide loading screen
+
+        // Tahap 1: kartu + kontrol sudah ada di HTML, tidak butuh library pihak ketiga
+        this.initializeUI();
+        this.setupEventListeners();
         this.hideLoadingScreen();
-        
-        this.addLogEntry('System', 'Enhanced Dashboard initialized successfully');
-    }
-
-    async initializeWithProgress() {
-        const steps = [
-            { name: 'Socket Connection', action: () => this.initializeSocket() },
-            { name: 'Interactive Map', action: () => this.initializeMap() },
-            { name: 'Power Charts', action: () => this.initializePowerChart() },
-            { name: 'Event Listeners', action: () => this.setupEventListeners() },
-            { name: 'UI Components', action: () => this.initializeUI() },
-            { name: 'Animations', action: () => this.startAnimations() }
-        ];
-
-        for (let i = 0; i < steps.length; i++) {
-            const step = steps[i];
-            this.updateLoadingProgress(step.name, (i / steps.length) * 100);
-            
-            try {
-                await new Promise(resolve => {
-                    step.action();
-                    setTimeout(resolve, 200); // Small delay for visual effect
-                });
-            } catch (error) {
-                console.error(`Error in ${step.name}:`, error);
-            }
+        this.recordBootMark('dashboard:cards');
+
+        // Tahap 2: socket (backfill dan frame live langsung mengisi kartu)
+        this.initializeSocket();
+        const interactiveMs = this.recordBootMark('dashboard:interactive', 'time-to-interactive');
+
+        // Tahap 3: modul berat saat kartunya terlihat
+        this.whenVisible(document.getElementById('map-container'), () => this.loadModule('map', () => this.initializeMap()));
+        this.whenVisible(document.getElementById('powerChart'), () => this.loadModule('chart', () => this.initializePowerChart()));
+
+        // Tahap 4: dekorasi dan timer non-esensial
+        this.whenIdle(() => {
+            this.initializeTooltips();
+            this.startDataRefreshIndicator();
+            this.startAnimations();
+        });
+
+        this.addLogEntry('System', `Enhanced Dashboard interactive in ${interactiveMs} ms`);
+    }
+
+    // Mark (+ measure dari navigation start); return ms sejak navigation start
+    recordBootMark(mark, measure = null) {
+        if (typeof performance === 'undefined' || !performance.mark) return null;
+        performance.mark(mark);
+        if (measure) performance.measure(measure, undefined, mark);
+        return Math.round(performance.now());
+    }
+
+    whenVisible(element, callback) {
+        if (!element) return;
+        if (typeof IntersectionObserver !== 'function') {
+            callback();
+            return;
         }
-        
-        this.updateLoadingProgress('Complete', 100);
+        const observer = new IntersectionObserver((entries) => {
+            if (!entries.some((entry) => entry.isIntersecting)) return;
+            observer.disconnect();
+            callback();
+        });
+        observer.observe(element);
     }
 
-    showLoadingScreen() {
-        const loadingScreen = document.getElementById('loading-screen');
-        if (loadingScreen) {
-            loadingScreen.style.display = 'flex';
+    whenIdle(callback) {
+        if (typeof requestIdleCallback === 'function') requestIdleCallback(callback, { timeout: 2000 });
+        else setTimeout(callback, 200);
+    }
+
+    loadAsset(tag, url) {
+        if (!this.assetLoads.has(url)) {
+            this.assetLoads.set(url, new Promise((resolve, reject) => {
+                const element = document.createElement(tag);
+                if (tag === 'link') {
+                    element.rel = 'stylesheet';
+                    element.href = url;
+                } else {
+                    element.src = url;
+                    element.async = true;
+                }
+                element.onload = resolve;
+                element.onerror = () => reject(new Error(`Failed to load ${url}`));
+                document.head.appendChild(element);
+            }));
         }
+        return this.assetLoads.get(url);
+    }
+
+    // Muat library modul, buat komponennya, lalu isi dengan history yang sudah diterima
+    async loadModule(name, initialize) {
+        const module = LAZY_MODULES[name];
+        try {
+            await Promise.all([
+                ...module.styles.map((url) => this.loadAsset('link', url)),
+                ...module.scripts.map((url) => this.loadAsset('script', url))
+            ]);
+        } catch (error) {
+            console.error(`❌ Failed to load ${name} module:`, error);
+            this.addLogEntry('Error', `Failed to load ${name} module`);
+            return;
+        }
+        initialize();
+        if (this.telemetryHistory.length) {
+            if (name === 'chart' && this.powerChart) this.seedPowerChart(this.telemetryHistory);
+            if (name === 'map' && this.flightMap) this.seedFlightPath(this.telemetryHistory);
+        }
+        this.recordBootMark(`dashboard:${name}-ready`);
     }
 
     updateLoadingProgress(text, percentage) {
@@ -101,20 +294,31 @@ class UAVDashboard {
     hideLoadingScreen() {
         const loadingScreen = document.getElementById('loading-screen');
         if (loadingScreen) {
-            setTimeout(() => {
-                loadingScreen.classList.add('fade-out');
-                setTimeout(() => {
-                    loadingScreen.style.display = 'none';
-                }, 500);
-            }, 500);
+            // Fade CSS (transition .loading-screen) langsung, tanpa jeda tetap
+            loadingScreen.addEventListener('transitionend', () => {
+                loadingScreen.style.display = 'none';
+            }, { once: true });
+            loadingScreen.classList.add('fade-out');
         }
         this.isLoading = false;
     }
 
+    // Satu koneksi per browser lewat SharedWorker jika tersedia (Android Chrome belum punya)
+    createSocket() {
+        if (typeof SharedWorker === 'function') {
+            try {
+                return new SharedSocket(new SharedWorker('socket-worker.js', { name: 'uav-dashboard-socket' }));
+            } catch (error) {
+                console.warn('⚠️ SharedWorker unavailable, using a direct connection:', error);
+            }
+        }
+        return io();
+    }
+
     initializeSocket() {
         try {
             console.log('🔌 Connecting to server...');
-            this.socket = io();
+            this.socket = this.createSocket();
 
             this.socket.on('connect', () => {
                 console.log('✅ Connected to server');
@@ -123,6 +327,11 @@ class UAVDashboard {
                 this.updateConnectionStatus(true);
                 this.showNotification('Connected to server successfully', 'success');
                 this.addLogEntry('Connection', 'Connected to server');
+
+                // Alert dievaluasi di server; dashboard hanya menampilkan
+                this.socket.emit('subscribeAlerts');
+                this.requestBackfill();
+                this.enableStreamCompression();
                 
                 // Start demo data for chart testing if no real data within 3 seconds
                 setTimeout(() => {
@@ -143,7 +352,52 @@ class UAVDashboard {
 
             this.socket.on('telemetryData', (data) => {
                 console.log('📡 Received telemetry:', data);
-                this.processTelemetryData(data);
+                this.handleLiveTelemetry(data);
+            });
+
+            this.socket.on('telemetryUpdate', (data) => {
+                this.handleLiveTelemetry(data);
+            });
+
+            this.socket.on('streamCompression', (config) => {
+                this.streamDecoder.configure(config);
+            });
+
+            this.socket.on('telemetryPacked', (packed) => {
+                this.packedChain = this.packedChain
+                    .then(() => this.streamDecoder.unpack(packed))
+                    .then((data) => this.handleLiveTelemetry(data))
+                    .catch((error) => console.error('❌ Failed to unpack telemetry:', error));
+            });
+
+            this.socket.on('telemetryBackfill', (payload) => {
+                this.decodeBackfill(payload)
+                    .then((rows) => this.finishBackfill(rows, payload.seq))
+                    .catch((error) => {
+                        console.error('❌ Failed to decode backfill:', error);
+                        this.finishBackfill([], null);
+                    });
+            });
+
+            this.socket.on('alertSnapshot', (alerts) => {
+                alerts.forEach((alert) => this.handleAlert(alert));
+            });
+
+            this.socket.on('alert', (alert) => {
+                this.handleAlert(alert);
+            });
+
+            this.socket.on('geofenceSnapshot', (snapshot) => {
+                this.geofenceZones = snapshot.zones || [];
+                this.drawGeofenceZones();
+            });
+
+            this.socket.on('geofence', (event) => {
+                this.handleGeofenceEvent(event);
+            });
+
+            this.socket.on('rateStats', (rates) => {
+                this.updateRateStats(rates);
             });
 
             this.socket.on('systemStatus', (status) => {
@@ -201,6 +455,7 @@ class UAVDashboard {
             // Setup map controls
             this.setupMapControls();
             this.updateGPSStatus('No Signal');
+            this.drawGeofenceZones();
 
             this.addLogEntry('Map', 'Interactive flight map initialized');
         } catch (error) {
@@ -209,6 +464,31 @@ class UAVDashboard {
         }
     }
 
+    // Zona dari server: area terbang hijau, no-fly merah
+    drawGeofenceZones() {
+        if (!this.flightMap) return;
+        if (this.geofenceLayer) this.geofenceLayer.remove();
+
+        this.geofenceLayer = L.layerGroup(this.geofenceZones.map((zone) => {
+            const noFly = zone.kind === 'no_fly';
+            return L.polygon(zone.polygon, {
+                color: noFly ? '#ff4757' : '#2ed573',
+                weight: 2,
+                fillOpacity: noFly ? 0.2 : 0.05,
+                dashArray: noFly ? null : '6 4'
+            }).bindTooltip(zone.name);
+        })).addTo(this.flightMap);
+    }
+
+    handleGeofenceEvent(event) {
+        const kind = event.kind === 'no_fly' ? 'no-fly zone' : 'flight area';
+        const action = event.event === 'enter' ? 'entered' : 'left';
+        const text = `${event.device_id} ${action} ${kind} ${event.name} (${event.distance_m} m from boundary)`;
+
+        this.showNotification(event.violation ? `⛔ ${text}` : text, event.violation ? 'error' : 'info', event.violation ? 10000 : 5000);
+        this.addLogEntry('Geofence', text);
+    }
+
     createUAVIcon() {
         return L.divIcon({
             className: 'uav-marker',
@@ -413,16 +693,10 @@ class UAVDashboard {
     }
 
     initializeUI() {
-        // Initialize tooltips
-        this.initializeTooltips();
-        
         // Initialize system time
         this.updateSystemTime();
         setInterval(() => this.updateSystemTime(), 1000);
         
-        // Initialize data refresh indicator
-        this.startDataRefreshIndicator();
-        
         // Initialize settings modal
         this.initializeSettingsModal();
         
@@ -528,6 +802,131 @@ class UAVDashboard {
         this.animateStatusIndicators();
     }
 
+    handleAlert(alert) {
+        const raised = alert.state === 'raised';
+        const type = !raised ? 'success' : alert.severity === 'critical' ? 'error' : 'warning';
+        const text = `${alert.message} (${alert.field} = ${alert.value})`;
+
+        this.showNotification(raised ? `🚨 ${text}` : `Cleared: ${text}`, type, raised ? 10000 : 5000);
+        this.addLogEntry('Alert', `${alert.device_id}: ${raised ? '' : 'cleared '}${text}`);
+    }
+
+    // Minta snapshot history; tanpa balasan dalam 3 detik stream live tetap jalan
+    requestBackfill() {
+        this.backfillQueue = [];
+        clearTimeout(this.backfillTimer);
+        this.backfillTimer = setTimeout(() => this.finishBackfill([], null), 3000);
+        this.socket.emit('requestBackfill', {
+            minutes: 10,
+            compression: typeof DecompressionStream === 'function' ? 'deflate' : 'none'
+        });
+    }
+
+    // Frame telemetry terkompresi dengan preset dictionary (lib/stream-compression.js);
+    // butuh DecompressionStream('deflate-raw'), selain itu tetap telemetryUpdate JSON
+    enableStreamCompression() {
+        if (StreamDecoder.supported()) this.socket.emit('setStreamCompression', { mode: 'dictionary' });
+    }
+
+    handleLiveTelemetry(data) {
+        if (this.backfillQueue) {
+            this.backfillQueue.push(data);
+            return;
+        }
+        if (data.seq !== undefined) {
+            if (data.seq <= this.lastSeq) return;
+            this.lastSeq = data.seq;
+        }
+        this.processTelemetryData(data);
+    }
+
+    // Payload biner dari server (lib/telemetry-backfill.js) -> baris telemetry urut waktu
+    async decodeBackfill(payload) {
+        let bytes = new Uint8Array(payload.data);
+        if (payload.compression === 'deflate') {
+            const stream = new Blob([bytes]).stream().pipeThrough(new DecompressionStream('deflate'));
+            bytes = new Uint8Array(await new Response(stream).arrayBuffer());
+        }
+
+        const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+        const rows = [];
+        let offset = 0;
+        for (const device of payload.devices) {
+            const first = rows.length;
+            for (let i = 0; i < device.rows; i++, offset += 4) {
+                rows.push({ device_id: device.device_id, timestamp: device.base + view.getUint32(offset, true) });
+            }
+            for (const column of payload.columns) {
+                const double = column.type === 'f64';
+                for (let i = 0; i < device.rows; i++, offset += double ? 8 : 4) {
+                    // Float32 dikembalikan ke nilai desimal aslinya
+                    rows[first + i][column.name] = double ? view.getFloat64(offset, true) : +view.getFloat32(offset, true).toPrecision(7);
+                }
+            }
+        }
+        return payload.devices.length > 1 ? rows.sort((a, b) => a.timestamp - b.timestamp) : rows;
+    }
+
+    finishBackfill(rows, seq) {
+        if (!this.backfillQueue) return;
+        clearTimeout(this.backfillTimer);
+
+        if (rows.length) {
+            this.renderBackfill(rows);
+            this.addLogEntry('Data', `Loaded ${rows.length} samples of recent history`);
+        }
+        // seq server direset saat restart, jadi diambil dari snapshot (bukan max)
+        if (seq !== null) this.lastSeq = seq;
+
+        const queue = this.backfillQueue;
+        this.backfillQueue = null;
+        queue.forEach((data) => {
+            // Sudah tercakup snapshot: cukup perbarui kartu, jangan tambah titik chart lagi
+            if (data.seq !== undefined && data.seq <= this.lastSeq) this.updateTelemetryDisplay(data);
+            else this.handleLiveTelemetry(data);
+        });
+    }
+
+    // Snapshot menggantikan history lokal; chart/peta yang belum dimuat diisi saat loadModule
+    renderBackfill(rows) {
+        if (!this.isReceivingRealData) {
+            this.isReceivingRealData = true;
+            this.stopDemoData();
+        }
+
+        this.telemetryHistory = rows.slice(-500);
+        if (this.powerChart) this.seedPowerChart(rows);
+        if (this.flightMap) this.seedFlightPath(rows);
+    }
+
+    seedPowerChart(rows) {
+        const maxDataPoints = this.settings.chartDataPoints || 50;
+        const recent = rows.slice(-maxDataPoints);
+        const value = (number) => (Number.isFinite(number) ? number : null);
+        const [voltage, current, power] = this.powerChart.data.datasets;
+        voltage.data = recent.map((row) => ({ x: row.timestamp, y: value(row.battery_voltage) }));
+        current.data = recent.map((row) => ({ x: row.timestamp, y: value(row.battery_current) }));
+        power.data = recent.map((row) => ({
+            x: row.timestamp,
+            y: value(Number.isFinite(row.battery_power) ? row.battery_power : row.battery_voltage * row.battery_current)
+        }));
+        this.powerChart.update('none');
+    }
+
+    seedFlightPath(rows) {
+        const path = rows
+            .filter((row) => Number.isFinite(row.gps_latitude) && Number.isFinite(row.gps_longitude) &&
+                (row.gps_latitude !== 0 || row.gps_longitude !== 0))
+            .slice(-200)
+            .map((row) => [row.gps_latitude, row.gps_longitude]);
+        if (path.length) {
+            const wasEmpty = this.flightPath.getLatLngs().length === 0;
+            this.flightPath.setLatLngs(path);
+            this.currentPosition.setLatLng(path[path.length - 1]);
+            if (wasEmpty) this.flightMap.setView(path[path.length - 1], 15);
+        }
+    }
+
     processTelemetryData(data) {
         // Check if this is real data from ESP32
         if (data.connection_status !== 'demo') {
@@ -535,9 +934,10 @@ class UAVDashboard {
             this.stopDemoData(); // Stop demo if real data arrives
         }
 
-        // Store historical data
+        // Store historical data (anotasi anomali ditempel per frame di handleAnomaly)
         this.telemetryHistory.push({
             ...data,
+            anomalies: undefined,
             timestamp: Date.now()
         });
 
@@ -554,10 +954,29 @@ class UAVDashboard {
         this.updatePowerChart(data);
         this.updateFlightPath(data);
 
+        if (data.anomalies) {
+            data.anomalies.forEach((anomaly) => this.handleAnomaly(anomaly));
+        }
+
         // Update data refresh indicator
         this.updateDataRefreshIndicator();
     }
 
+    // Anotasi anomali dari server (spike / jump / drift) pada frame telemetry.
+    // Spike baru terkonfirmasi satu frame kemudian; anomaly.seq menunjuk frame spike-nya
+    handleAnomaly(anomaly) {
+        for (let i = this.telemetryHistory.length - 1; i >= 0; i--) {
+            const frame = this.telemetryHistory[i];
+            if (anomaly.seq === undefined || frame.seq === anomaly.seq) {
+                frame.anomalies = [...(frame.anomalies || []), anomaly];
+                break;
+            }
+        }
+        const text = `${anomaly.device_id}: ${anomaly.field} ${anomaly.kind.replace('_', ' ')} ${anomaly.value} (expected ~${anomaly.expected})`;
+        this.showNotification(`⚠️ ${text}`, 'warning', 6000);
+        this.addLogEntry('Anomaly', text);
+    }
+
     calculateTrends(data) {
         Object.keys(data).forEach(key => {
             if (typeof data[key] === 'number' && this.lastValues[key] !== undefined) {
@@ -595,6 +1014,12 @@ class UAVDashboard {
 
             // Update system status
             this.updateDataPacketCount(data.packetCount);
+
+            // Nilai asli pertama di kartu (bukan demo)
+            if (!this.firstValueMs && data.connection_status !== 'demo') {
+                this.firstValueMs = this.recordBootMark('dashboard:first-value', 'time-to-first-value');
+                this.addLogEntry('System', `First telemetry value shown at ${this.firstValueMs} ms`);
+            }
                 
         } catch (error) {
             console.error('❌ Error updating telemetry display:', error);
@@ -602,46 +1027,18 @@ class UAVDashboard {
     }
 
     updateDataCard(id, config, data) {
-        const element = document.getElementById(id);
-        const trendElement = document.getElementById(`${config.trend}-trend`);
-        
-        if (element && config.value !== undefined) {
-            // Format value
-            let displayValue = config.value;
-            if (config.format) {
-                displayValue = parseFloat(config.value).toFixed(config.format);
-            }
-            
-            // Update with animation
-            element.textContent = `${displayValue}${config.unit ? ' ' + config.unit : ''}`;
-            element.classList.add('animate-number');
-            
-            setTimeout(() => {
-                element.classList.remove('animate-number');
-            }, 500);
-            
-            // Update trend indicator
-            if (trendElement && this.trends[config.trend]) {
-                const trend = this.trends[config.trend];
-                trendElement.innerHTML = this.getTrendIcon(trend);
-                trendElement.className = `data-trend trend-${trend}`;
-            }
-        }
-    }
+        if (config.value === undefined) return;
 
-    getTrendIcon(trend) {
-        switch (trend) {
-            case 'up': return '<i class="fas fa-arrow-up"></i>';
-            case 'down': return '<i class="fas fa-arrow-down"></i>';
-            default: return '<i class="fas fa-minus"></i>';
-        }
+        const displayValue = config.format ? parseFloat(config.value).toFixed(config.format) : config.value;
+        this.cards.setText(id, `${displayValue}${config.unit ? ' ' + config.unit : ''}`);
+
+        const trend = this.trends[config.trend];
+        if (trend) this.cards.setTrend(`${config.trend}-trend`, trend);
     }
 
     updatePowerChart(data) {
-        if (!this.powerChart) {
-            console.warn('⚠️ Power chart not initialized yet');
-            return;
-        }
+        // Chart belum terlihat/dimuat: titik ini diambil dari telemetryHistory saat loadModule
+        if (!this.powerChart) return;
 
         try {
             const time = Date.now();
@@ -808,20 +1205,35 @@ class UAVDashboard {
         }
     }
 
-    updateDataPacketCount(count) {
-        const element = document.getElementById('data-packets');
-        if (element && count !== undefined) {
-            element.textContent = count.toString();
-            
-            // Animate packet indicator
-            const packetAnimation = document.getElementById('packet-animation');
-            if (packetAnimation) {
-                packetAnimation.style.animation = 'none';
-                setTimeout(() => {
-                    packetAnimation.style.animation = 'pulse 0.5s ease';
-                }, 10);
-            }
+    // Laju 1/5/15 menit dari server; laju 1 menit jauh di bawah rata-rata 15 menit = link menurun
+    updateRateStats(rates) {
+        const element = document.getElementById('data-rate');
+        if (!element || !rates) return;
+
+        const { packets, bytes, errors } = rates;
+        element.textContent = errors.m1 > 0 ? `${packets.m1}/s · ${errors.m1} err/s` : `${packets.m1}/s`;
+        element.title = [
+            `packets/s 1m ${packets.m1} · 5m ${packets.m5} · 15m ${packets.m15}`,
+            `KB/s 1m ${(bytes.m1 / 1024).toFixed(1)} · 5m ${(bytes.m5 / 1024).toFixed(1)} · 15m ${(bytes.m15 / 1024).toFixed(1)}`,
+            `errors/s 1m ${errors.m1} · 5m ${errors.m5} · 15m ${errors.m15}`,
+            `commands/s 1m ${rates.commands.m1} · 5m ${rates.commands.m5} · 15m ${rates.commands.m15}`
+        ].join('\n');
+
+        const settled = packets.age_s >= RATE_WARN_MIN_AGE_S && packets.total >= RATE_WARN_MIN_PACKETS;
+        const degraded = settled && packets.m1 < packets.m15 * 0.5;
+        element.className = `status-value ${degraded || errors.m1 > 0 ? 'offline' : 'online'}`;
+        if (degraded && !this.rateDegraded) {
+            const text = `Packet rate dropped to ${packets.m1}/s (15 min average ${packets.m15}/s)`;
+            this.showNotification(text, 'warning');
+            this.addLogEntry('Connection', text);
         }
+        this.rateDegraded = degraded;
+    }
+
+    updateDataPacketCount(count) {
+        if (count === undefined) return;
+        this.cards.setText('data-packets', count.toString(), null);
+        this.cards.pulse('packet-animation');
     }
 
     updateSystemTime() {
@@ -833,13 +1245,7 @@ class UAVDashboard {
     }
 
     updateDataRefreshIndicator() {
-        const indicator = document.getElementById('data-refresh');
-        if (indicator) {
-            indicator.style.animation = 'none';
-            setTimeout(() => {
-                indicator.style.animation = 'pulse 1s ease-in-out';
-            }, 10);
-        }
+        this.cards.pulse('data-refresh', INDICATOR_PULSE, 1000);
     }
 
     startDataRefreshIndicator() {
@@ -978,7 +1384,7 @@ Contact: uav@swarakarsa.itera.ac.id`;
 
     toggleFullscreenMap() {
         const mapCard = document.querySelector('.flight-path-card');
-        if (mapCard) {
+        if (mapCard && this.flightMap) {
             if (!mapCard.classList.contains('fullscreen')) {
                 mapCard.classList.add('fullscreen');
                 this.flightMap.invalidateSize();
@@ -1189,6 +1595,9 @@ Contact: uav@swarakarsa.itera.ac.id`;
     }
 
     attemptReconnect() {
+        // Koneksi di SharedWorker reconnect sendiri; 'connect' dikirim ulang ke semua tab
+        if (this.socket && this.socket.shared) return;
+
         if (this.reconnectAttempts >= this.maxReconnectAttempts) {
             this.showNotification('Max reconnection attempts reached', 'error');
             return;
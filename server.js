@@ -10,10 +10,36 @@ const http = require('http');
 const socketIo = require('socket.io');
 const cors = require('cors');
 const path = require('path');
+const dgram = require('dgram');
+const { MavlinkParser, toTelemetry: mavlinkToTelemetry } = require('./lib/mavlink');
+const { createSerialBridgeServer } = require('./lib/serial-bridge');
+const { createIngestServer, handleHttpIngest, INGEST_PATH } = require('./lib/ingest-listener');
+const { FlowController } = require('./lib/flow-control');
+const { validateTelemetry } = require('./lib/telemetry-validation');
+const { AlertEngine, loadRuleFile } = require('./lib/alert-engine');
+const { GeofenceEngine, loadZoneFile } = require('./lib/geofence');
+const { HistoryStore } = require('./lib/history-store');
+const { AnomalyDetector } = require('./lib/anomaly-detector');
+const { TelemetryBackfill } = require('./lib/telemetry-backfill');
+const { SseBroadcaster } = require('./lib/sse-stream');
+const { StreamCompressor } = require('./lib/stream-compression');
+const { FederationUplink, createFederationServer, parsePeers } = require('./lib/federation');
+const { RateTracker } = require('./lib/rate-meter');
+const { IngestRingConsumer, INGEST_KIND, formatSource } = require('./lib/ingest-ring');
+const { exportCsv, exportParquet, resolveColumns, countRows, shutdownExportWorkers } = require('./lib/telemetry-export');
+const { computeAnalytics, nativeKernel } = require('./lib/analytics');
 
 // Initialize Express app
 const app = express();
-const server = http.createServer(app);
+// POST /api/telemetry dengan Content-Length dan GET /stream dilayani sebelum Express (lihat
+// lib/ingest-listener.js, lib/sse-stream.js); body chunked ke route Express, sisanya ke app
+const server = http.createServer((req, res) => {
+    if (req.method === 'POST' && req.headers['content-length'] !== undefined && urlPath(req.url) === INGEST_PATH) {
+        return handleHttpIngest(req, res, ingestHttpBody);
+    }
+    if (req.method === 'GET' && (req.url === '/stream' || req.url.startsWith('/stream?'))) return sseStream.subscribe(req, res);
+    app(req, res);
+});
 const io = socketIo(server, {
     cors: {
         origin: "*",
@@ -22,19 +48,47 @@ const io = socketIo(server, {
     transports: ['websocket', 'polling'],
     allowEIO3: true,
     pingTimeout: 60000,
-    pingInterval: 25000
+    pingInterval: 25000,
+    // WS_DEFLATE=1: permessage-deflate dengan context takeover, window 1 KB dan memLevel 4
+    // (~12 KB state zlib per koneksi, bukan ~256 KB default); threshold rendah untuk frame kecil
+    perMessageDeflate: process.env.WS_DEFLATE === '1'
+        ? { threshold: 64, serverMaxWindowBits: 10, zlibDeflateOptions: { level: 6, memLevel: 4 } }
+        : false
 });
 
 const PORT = process.env.PORT || 3001;
+const MAVLINK_UDP_PORT = parseInt(process.env.MAVLINK_PORT || '14550', 10);
+const SERIAL_BRIDGE_PORT = parseInt(process.env.SERIAL_BRIDGE_PORT || '14560', 10);
+const INGEST_PORT = parseInt(process.env.INGEST_PORT || '3002', 10);
+const ALERT_RULES_FILE = process.env.ALERT_RULES_FILE || null;
+const ALERT_ROOM = 'alerts';
+const PACKED_ROOM = 'stream:dictionary';
+const GEOFENCE_FILE = process.env.GEOFENCE_FILE || null;
+const HISTORY_DIR = process.env.HISTORY_DIR || null;
+const HISTORY_MAX_ROWS = parseInt(process.env.HISTORY_MAX_ROWS || String(1 << 20), 10);
+const HISTORY_MAX_TOTAL_ROWS = parseInt(process.env.HISTORY_MAX_TOTAL_ROWS || String(4 << 20), 10);
+const HISTORY_MAX_DEVICES = parseInt(process.env.HISTORY_MAX_DEVICES || '64', 10);
+const BACKFILL_MINUTES = parseFloat(process.env.BACKFILL_MINUTES || '10');
+const FEDERATION_PORT = parseInt(process.env.FEDERATION_PORT || '0', 10);
+const FEDERATION_PEERS = parsePeers(process.env.FEDERATION_PEERS);
+// Diisi = UDP/TCP diterima native/ingest_sidecar, server.js membaca ring shared memory-nya
+const INGEST_SIDECAR_SHM = process.env.INGEST_SIDECAR_SHM || null;
 
 // Global variables for cleanup
 let connectionMonitorInterval = null;
 let demoDataInterval = null;
+let mavlinkSocket = null;
+let serialBridgeServer = null;
+let ingestServer = null;
+let federationServer = null;
+let ingestSidecar = null;
+let flowControlInterval = null;
 let isShuttingDown = false;
 
 // Middleware
 app.use(cors());
-app.use(express.json({ limit: '1mb' }));
+// rawBodyLength: ukuran body untuk rate bytes di route telemetry chunked (tanpa Content-Length)
+app.use(express.json({ limit: '1mb', verify: (req, res, buffer) => { req.rawBodyLength = buffer.length; } }));
 app.use(express.static(__dirname)); // Serve static files from current directory
 
 // Request logging middleware
@@ -82,6 +136,194 @@ let connectionStats = {
     dataPacketsReceived: 0
 };
 
+const flowController = new FlowController();
+
+// Laju 1/5/15 menit (packets, bytes, errors, commands) global dan per device
+const rateTracker = new RateTracker();
+
+// Rule alert dievaluasi di server untuk setiap sampel, walau tidak ada dashboard terbuka
+function createAlertEngine() {
+    if (!ALERT_RULES_FILE) return new AlertEngine();
+    try {
+        const rules = loadRuleFile(ALERT_RULES_FILE);
+        console.log(`🚨 [ALERT] Loaded ${rules.length} rules from ${ALERT_RULES_FILE}`);
+        return new AlertEngine(rules);
+    } catch (error) {
+        console.error(`❌ [ALERT] Invalid rules file ${ALERT_RULES_FILE}: ${error.message}, using defaults`);
+        return new AlertEngine();
+    }
+}
+
+const alertEngine = createAlertEngine();
+
+// Zona area terbang / no-fly; tanpa GEOFENCE_FILE engine kosong dan evaluate langsung return
+function createGeofence() {
+    if (!GEOFENCE_FILE) return new GeofenceEngine();
+    try {
+        const engine = new GeofenceEngine(loadZoneFile(GEOFENCE_FILE));
+        const stats = engine.getStats();
+        console.log(`🗺️ [GEOFENCE] Loaded ${stats.zones} zones (${stats.edges} edges, ${stats.cells} cells of ${stats.cell_size_m}m) from ${GEOFENCE_FILE}`);
+        return engine;
+    } catch (error) {
+        console.error(`❌ [GEOFENCE] Invalid zone file ${GEOFENCE_FILE}: ${error.message}, geofence disabled`);
+        return new GeofenceEngine();
+    }
+}
+
+const geofence = createGeofence();
+
+// Histori kolumnar per device untuk /api/export (persisten jika HISTORY_DIR di-set)
+const historyStore = new HistoryStore({
+    dir: HISTORY_DIR,
+    maxRows: HISTORY_MAX_ROWS,
+    maxTotalRows: HISTORY_MAX_TOTAL_ROWS,
+    maxDevices: HISTORY_MAX_DEVICES
+});
+
+// Snapshot history untuk dashboard yang baru join (chart langsung terisi)
+const backfill = new TelemetryBackfill(historyStore, { windowMs: BACKFILL_MINUTES * 60 * 1000 });
+
+// Nomor urut frame telemetryUpdate; dashboard memakainya untuk menyambung backfill ke stream live
+let telemetrySeq = 0;
+
+// Deteksi glitch sensor / drift per device per field (O(1) per sampel)
+const anomalyDetector = new AnomalyDetector();
+
+// Spectator stream GET /stream: serialisasi sekali per update untuk semua penonton
+const sseStream = new SseBroadcaster();
+
+// Dashboard mode 'dictionary' menerima telemetryPacked (deflate dengan preset dictionary)
+const streamCompressor = new StreamCompressor();
+
+// Relay ke ground station lain (FEDERATION_PEERS); hanya frame lokal yang diteruskan
+const federationUplink = FEDERATION_PEERS.length ? new FederationUplink(FEDERATION_PEERS, {
+    station: process.env.FEDERATION_STATION,
+    replayFrames: parseInt(process.env.FEDERATION_REPLAY_FRAMES || '0', 10) || undefined
+}) : null;
+
+// ================== TELEMETRY INGEST ==================
+
+// Satu jalur untuk semua transport (HTTP, WebSocket, MAVLink, relay federation).
+// relay = { station, receivedAt } untuk frame dari station lain (waktu terima asli di origin)
+function ingestTelemetry(data, connectionType, deviceId, bytes, sourceSocket = null, relay = null) {
+    const now = relay ? relay.receivedAt : Date.now();
+    latestTelemetry = {
+        ...latestTelemetry,
+        ...data,
+        timestamp: now,
+        connection_status: 'connected',
+        connection_type: connectionType,
+        relay_station: relay ? relay.station : undefined,
+        seq: ++telemetrySeq
+    };
+
+    connectionStats.dataPacketsReceived++;
+    connectionStats.lastConnectionTime = new Date().toISOString();
+    // Laju diukur saat diterima di station ini (frame relay yang di-backfill juga dihitung sekarang)
+    rateTracker.mark('packets', deviceId);
+    rateTracker.mark('bytes', deviceId, bytes);
+
+    const grant = flowController.onFrame(deviceId, data.packet_number, bytes, data.credit_stalls);
+    const anomalies = detectAnomalies(deviceId, data, now, latestTelemetry.seq);
+    // Spike baru terkonfirmasi di sampel berikutnya: flag ditulis ke baris spike itu sendiri
+    for (const { rowsBack, flags } of anomalies.previous) historyStore.markFlags(deviceId, rowsBack, flags);
+    historyStore.append(deviceId, anomalies.flags ? { ...data, anomaly_flags: anomalies.flags } : data, now);
+    // Anotasi dikirim di frame saat anomali terdeteksi; event.seq = frame tempat anomali terjadi
+    latestTelemetry.anomalies = anomalies.events.length ? anomalies.events : undefined;
+    broadcastTelemetry(sourceSocket);
+    evaluateAlerts(deviceId, data, now);
+    evaluateGeofence(deviceId, data, now);
+    if (federationUplink && !relay) federationUplink.forward(deviceId, connectionType, data, now);
+    return grant;
+}
+
+function urlPath(url) {
+    const query = url.indexOf('?');
+    return query === -1 ? url : url.slice(0, query);
+}
+
+// HTTP ingest (port utama dan INGEST_PORT): body mentah -> { status, body } tanpa Express.
+// Tidak ada log per paket di jalur ini; jumlah request ada di /api/stats (ingest).
+function ingestHttpBody(body, remoteAddress) {
+    if (isShuttingDown) return { status: 503, body: '{"success":false,"error":"Server is shutting down"}' };
+
+    let telemetryData;
+    try {
+        telemetryData = JSON.parse(body.toString('utf8'));
+    } catch (error) {
+        rateTracker.mark('errors', null);
+        return { status: 400, body: '{"success":false,"error":"Invalid JSON body"}' };
+    }
+    return ingestHttpTelemetry(telemetryData, remoteAddress, body.length);
+}
+
+function ingestHttpTelemetry(telemetryData, remoteAddress, bytes) {
+    // Basic validation (format object + field numerik)
+    const validationError = validateTelemetry(telemetryData);
+    if (validationError) {
+        rateTracker.mark('errors', (telemetryData && telemetryData.device_id) || remoteAddress);
+        return { status: 400, body: JSON.stringify({ success: false, error: validationError }) };
+    }
+
+    const deviceId = telemetryData.device_id || remoteAddress;
+    const grant = ingestTelemetry(telemetryData, 'HTTP', deviceId, bytes);
+    return {
+        status: 200,
+        body: `{"success":true,"message":"Telemetry data received","packet_number":${connectionStats.dataPacketsReceived},` +
+            `"timestamp":${latestTelemetry.timestamp},"flow":${JSON.stringify(grant)}}`
+    };
+}
+
+// Flag anomali ikut disimpan di history (kolom anomaly_flags) dan dianotasi di broadcast
+function detectAnomalies(deviceId, data, now = Date.now(), seq = undefined) {
+    const result = anomalyDetector.evaluate(deviceId, data, now, seq);
+    for (const event of result.events) {
+        console.log(`⚠️ [ANOMALY] ${event.device_id} ${event.field} ${event.kind} (value ${event.value}, expected ${event.expected}, score ${event.score})`);
+    }
+    return result;
+}
+
+// Transisi alert (raised/cleared) hanya dikirim ke dashboard yang subscribe
+function evaluateAlerts(deviceId, data, now = Date.now()) {
+    const events = alertEngine.evaluate(deviceId, data, now);
+    for (const event of events) {
+        const icon = event.state === 'raised' ? '🚨' : '✅';
+        console.log(`${icon} [ALERT] ${event.device_id} ${event.rule} ${event.state} (${event.field}=${event.value})`);
+        if (io && !isShuttingDown) io.to(ALERT_ROOM).emit('alert', event);
+    }
+}
+
+// Event enter/exit zona ikut room alert; pelanggaran (masuk no-fly / keluar area) di-log sebagai warning
+function evaluateGeofence(deviceId, data, now = Date.now()) {
+    if (data.gps_latitude === undefined || data.gps_longitude === undefined) return;
+    const events = geofence.evaluate(deviceId, Number(data.gps_latitude), Number(data.gps_longitude), now);
+    for (const event of events) {
+        const icon = event.violation ? '⛔' : '🗺️';
+        console.log(`${icon} [GEOFENCE] ${event.device_id} ${event.event} ${event.kind} zone ${event.zone} (${event.distance_m}m from boundary)`);
+        if (io && !isShuttingDown) io.to(ALERT_ROOM).emit('geofence', event);
+    }
+}
+
+// Saat overload, dashboard yang lambat di-skip (volatile) alih-alih antre tanpa batas
+function broadcastTelemetry(sourceSocket) {
+    if (!io || isShuttingDown) return;
+
+    // Penonton SSE selalu dapat frame terbaru; klien lambat dilewati di SseBroadcaster
+    sseStream.publish(latestTelemetry, latestTelemetry.seq);
+
+    const target = sourceSocket ? sourceSocket.broadcast : io;
+    const emitter = flowController.isOverloaded() ? target.volatile : target;
+    const packedRoom = io.sockets.adapter.rooms.get(PACKED_ROOM);
+    if (!packedRoom || packedRoom.size === 0) {
+        emitter.emit('telemetryUpdate', latestTelemetry);
+        return;
+    }
+
+    // Kompresi sekali untuk semua dashboard mode dictionary; sudah terkompresi -> tanpa permessage-deflate
+    emitter.except(PACKED_ROOM).emit('telemetryUpdate', latestTelemetry);
+    emitter.to(PACKED_ROOM).compress(false).emit('telemetryPacked', streamCompressor.pack(latestTelemetry));
+}
+
 // ================== ROUTES ==================
 
 // Root route - serve dashboard
@@ -103,6 +345,12 @@ app.get('/debug', (req, res) => {
     });
 });
 
+// API: Receive telemetry (HTTP fallback): body chunked tanpa Content-Length, sudah di-parse express.json()
+app.post(INGEST_PATH, (req, res) => {
+    const result = ingestHttpTelemetry(req.body, req.ip, req.rawBodyLength || 0);
+    res.status(result.status).type('application/json').send(result.body);
+});
+
 // API: Get latest telemetry data
 app.get('/api/telemetry', (req, res) => {
     res.json({
@@ -113,94 +361,150 @@ app.get('/api/telemetry', (req, res) => {
     });
 });
 
-// API: Receive telemetry data from ESP32 (HTTP fallback)
-app.post('/api/telemetry', (req, res) => {
+// API: Send command to ESP32
+app.post('/api/command', (req, res) => {
+    const { command, value, device_id: deviceId } = req.body;
+    
+    // Broadcast command to ESP32 via Socket.IO (dihitung sama seperti relayCommand)
+    rateTracker.mark('commands', deviceId);
+    io.emit('esp32Command', { command, value, timestamp: Date.now() });
+    
+    console.log('🔌 [COMMAND] Sent to ESP32:', command, value);
+    res.json({ success: true, message: 'Command sent' });
+});
+
+// API: Active alerts + rule engine status
+app.get('/api/alerts', (req, res) => {
+    res.json({
+        success: true,
+        active: alertEngine.getActiveAlerts(),
+        rules: alertEngine.getRules(),
+        stats: alertEngine.getStats()
+    });
+});
+
+// API: Anomali terbaru (opsional ?device=&limit=) + arti bit anomaly_flags
+app.get('/api/anomalies', (req, res) => {
+    const limit = Math.min(parseInt(req.query.limit, 10) || 100, 500);
+    res.json({
+        success: true,
+        events: anomalyDetector.getRecent(req.query.device || null, limit),
+        flag_bits: anomalyDetector.getFlagBits(),
+        stats: anomalyDetector.getStats()
+    });
+});
+
+// API: Geofence zones + zona tempat tiap device berada
+app.get('/api/geofence', (req, res) => {
+    res.json({
+        success: true,
+        zones: geofence.getZones(),
+        devices: geofence.getDevices(),
+        stats: geofence.getStats()
+    });
+});
+
+// API: Device yang punya histori + rentang waktunya
+app.get('/api/export', (req, res) => {
+    res.json({ success: true, devices: historyStore.getDevices() });
+});
+
+// Waktu export: epoch ms atau ISO 8601
+function parseExportTime(value, fallback) {
+    if (value === undefined || value === '') return fallback;
+    const time = /^\d+$/.test(value) ? Number(value) : Date.parse(value);
+    if (!Number.isFinite(time)) throw new Error(`Invalid time '${value}'`);
+    return time;
+}
+
+// API: Stream histori satu device sebagai CSV / Parquet (chunked, memori terbatas)
+app.get('/api/export/:deviceId', async (req, res) => {
+    const format = req.query.format || 'csv';
+    let slices;
+    let columns;
     try {
-        if (isShuttingDown) {
-            return res.status(503).json({ error: 'Server is shutting down' });
-        }
+        if (format !== 'csv' && format !== 'parquet') throw new Error(`Unknown format '${format}'`);
+        columns = resolveColumns(req.query.fields);
+        const from = parseExportTime(req.query.from, -Infinity);
+        const to = parseExportTime(req.query.to, Infinity);
+        slices = historyStore.slices(req.params.deviceId, from, to);
+    } catch (error) {
+        return res.status(400).json({ success: false, error: error.message });
+    }
+    if (slices.length === 0) {
+        return res.status(404).json({ success: false, error: 'No history for device in this range' });
+    }
 
-        const telemetryData = req.body;
-        
-        // Basic validation
-        if (!telemetryData || typeof telemetryData !== 'object') {
-            return res.status(400).json({ 
-                success: false, 
-                error: 'Invalid telemetry data format' 
-            });
-        }
+    const rows = countRows(slices);
+    const started = Date.now();
+    const filename = `${req.params.deviceId.replace(/[^\w.-]/g, '_')}-${new Date(slices[0].chunk.columns[0][slices[0].begin]).toISOString().replace(/[:.]/g, '-')}.${format}`;
+    res.setHeader('Content-Type', format === 'csv' ? 'text/csv; charset=utf-8' : 'application/vnd.apache.parquet');
+    res.setHeader('Content-Disposition', `attachment; filename="${filename}"`);
+    res.setHeader('X-Export-Rows', rows);
 
-        // Validate numeric fields if present
-        const numericFields = ['battery_voltage', 'battery_current', 'temperature', 'altitude', 'signal_strength'];
-        for (const field of numericFields) {
-            if (telemetryData[field] !== undefined && (isNaN(telemetryData[field]) || !isFinite(telemetryData[field]))) {
-                return res.status(400).json({ 
-                    success: false, 
-                    error: `Invalid ${field}: must be a valid number` 
-                });
-            }
+    try {
+        if (format === 'csv') {
+            await exportCsv(res, slices, columns);
+        } else {
+            await exportParquet(res, slices, columns, { device_id: req.params.deviceId });
         }
+        res.end();
+        console.log(`📤 [EXPORT] ${req.params.deviceId} ${rows} rows as ${format} in ${Date.now() - started}ms`);
+    } catch (error) {
+        console.error(`❌ [EXPORT] ${req.params.deviceId} ${format} failed: ${error.message}`);
+        res.destroy();
+    }
+});
 
-        // Update latest data
-        latestTelemetry = {
-            ...latestTelemetry,
-            ...telemetryData,
-            timestamp: Date.now(),
-            connection_status: 'connected',
-            connection_type: 'HTTP'
-        };
-        
-        connectionStats.dataPacketsReceived++;
-        connectionStats.lastConnectionTime = new Date().toISOString();
-        
-        // Broadcast to all connected web clients with error handling
-        if (io && !isShuttingDown) {
-            io.emit('telemetryUpdate', latestTelemetry);
+// API: Statistik per window (energi, arus puncak, voltage sag, histogram ketinggian)
+app.get('/api/analytics/:deviceId', (req, res) => {
+    try {
+        const from = parseExportTime(req.query.from, -Infinity);
+        const to = parseExportTime(req.query.to, Infinity);
+        const windowSeconds = req.query.window === undefined ? 60 : Number(req.query.window);
+        const altitudeBin = req.query.altitude_bin === undefined ? 10 : Number(req.query.altitude_bin);
+        if (!(windowSeconds > 0) || !(altitudeBin > 0)) throw new Error('window and altitude_bin must be positive numbers');
+
+        const slices = historyStore.slices(req.params.deviceId, from, to);
+        if (slices.length === 0) {
+            return res.status(404).json({ success: false, error: 'No history for device in this range' });
         }
-        
-        console.log('📊 [HTTP] Telemetry received:', {
-            battery: `${telemetryData.battery_voltage || 'N/A'}V`,
-            temp: `${telemetryData.temperature || 'N/A'}°C`,
-            signal: `${telemetryData.signal_strength || 'N/A'}dBm`,
-            packet: `#${telemetryData.packet_number || connectionStats.dataPacketsReceived}`
+        const started = process.hrtime.bigint();
+        const analytics = computeAnalytics(slices, { from, windowMs: windowSeconds * 1000, altitudeBinM: altitudeBin });
+        res.json({
+            success: true,
+            device_id: req.params.deviceId,
+            compute_ms: Number(process.hrtime.bigint() - started) / 1e6,
+            ...analytics
         });
-        
-        res.json({ 
-            success: true, 
-            message: 'Telemetry data received',
-            packet_number: connectionStats.dataPacketsReceived,
-            timestamp: latestTelemetry.timestamp
-        });
-        
     } catch (error) {
-        console.error('❌ [HTTP] Error processing telemetry:', error);
-        res.status(500).json({ 
-            success: false, 
-            error: 'Internal server error',
-            message: process.env.NODE_ENV === 'development' ? error.message : 'Failed to process telemetry data'
-        });
+        res.status(400).json({ success: false, error: error.message });
     }
 });
 
-// API: Send command to ESP32
-app.post('/api/command', (req, res) => {
-    const { command, value } = req.body;
-    
-    // Broadcast command to ESP32 via Socket.IO
-    io.emit('esp32Command', { command, value, timestamp: Date.now() });
-    
-    console.log('🔌 [COMMAND] Sent to ESP32:', command, value);
-    res.json({ success: true, message: 'Command sent' });
-});
-
 // API: Connection statistics
 app.get('/api/stats', (req, res) => {
     res.json({
         success: true,
         stats: {
             ...connectionStats,
+            rates: rateTracker.getStats(),
             uptime: process.uptime(),
-            memoryUsage: process.memoryUsage()
+            memoryUsage: process.memoryUsage(),
+            flowControl: flowController.getStats(),
+            alerts: alertEngine.getStats(),
+            geofence: geofence.getStats(),
+            anomalies: anomalyDetector.getStats(),
+            backfill: backfill.getStats(),
+            ingest: ingestServer ? ingestServer.ingestStats : null,
+            sse: sseStream.getStats(),
+            federation: {
+                uplink: federationUplink ? federationUplink.getStats() : null,
+                receiver: federationServer ? federationServer.federationStats() : null
+            },
+            sidecar: ingestSidecar ? ingestSidecar.getStats() : null,
+            streamCompression: { ...streamCompressor.getStats(), dashboards: io.sockets.adapter.rooms.get(PACKED_ROOM)?.size || 0 },
+            history: historyStore.getStats()
         }
     });
 });
@@ -253,23 +557,16 @@ io.on('connection', (socket) => {
             // Basic validation
             if (!data || typeof data !== 'object') {
                 console.error('❌ Invalid telemetry data from ESP32');
+                rateTracker.mark('errors', null);
                 return;
             }
 
-            // Update latest data
-            latestTelemetry = {
-                ...latestTelemetry,
-                ...data,
-                timestamp: Date.now(),
-                connection_status: 'connected',
-                connection_type: 'WebSocket'
-            };
-            
-            connectionStats.dataPacketsReceived++;
-            connectionStats.lastConnectionTime = new Date().toISOString();
-            
-            // Broadcast to all web clients
-            socket.broadcast.emit('telemetryUpdate', latestTelemetry);
+            const deviceId = data.device_id || socket.id;
+            const bytes = Buffer.byteLength(JSON.stringify(data));
+            const grant = ingestTelemetry(data, 'WebSocket', deviceId, bytes, socket);
+
+            // Ack + kredit baru untuk device pengirim
+            socket.emit('flowCredit', grant);
             
             console.log('📊 [WEBSOCKET] Telemetry received:', {
                 battery: `${data.battery_voltage || 'N/A'}V`,
@@ -279,12 +576,52 @@ io.on('connection', (socket) => {
             });
         } catch (error) {
             console.error('❌ Error processing WebSocket telemetry:', error);
+            rateTracker.mark('errors', data && data.device_id);
         }
     });
     
+    // Dashboard subscribe alert: snapshot alert aktif, lalu event 'alert' per transisi
+    socket.on('subscribeAlerts', () => {
+        socket.join(ALERT_ROOM);
+        socket.emit('alertSnapshot', alertEngine.getActiveAlerts());
+        socket.emit('geofenceSnapshot', { zones: geofence.getZones(), devices: geofence.getDevices() });
+    });
+
+    socket.on('unsubscribeAlerts', () => {
+        socket.leave(ALERT_ROOM);
+    });
+
+    // Dashboard memilih format stream: 'dictionary' (telemetryPacked) atau 'none' (telemetryUpdate).
+    // Balasan berisi dictionary dan tiba sebelum frame packed pertama (urutan socket terjaga).
+    socket.on('setStreamCompression', (options = {}) => {
+        if (options.mode === 'dictionary') {
+            socket.join(PACKED_ROOM);
+            socket.emit('streamCompression', streamCompressor.describe());
+        } else {
+            socket.leave(PACKED_ROOM);
+            socket.emit('streamCompression', { mode: 'none' });
+        }
+    });
+
+    // Dashboard minta backfill (bukan otomatis saat connect: ESP32 juga client socket).
+    // Snapshot disusun sinkron dengan seq saat ini; frame live setelahnya punya seq lebih besar.
+    socket.on('requestBackfill', (options = {}) => {
+        const minutes = parseFloat(options.minutes);
+        backfill.snapshot(telemetrySeq, {
+            windowMs: minutes > 0 ? minutes * 60 * 1000 : undefined,
+            compression: options.compression
+        }).then((payload) => {
+            if (socket.connected) socket.emit('telemetryBackfill', payload);
+        }).catch((error) => {
+            console.error('❌ [BACKFILL] Failed to build snapshot:', error.message);
+            socket.emit('telemetryBackfill', { seq: telemetrySeq, compression: 'none', columns: [], devices: [], data: Buffer.alloc(0) });
+        });
+    });
+
     // Handle relay commands from web interface
     socket.on('relayCommand', (data) => {
         console.log('🔌 [RELAY] Command from web:', data);
+        rateTracker.mark('commands', data && data.device_id);
         // Forward to ESP32
         socket.broadcast.emit('esp32Command', data);
     });
@@ -307,6 +644,188 @@ io.on('connection', (socket) => {
     });
 });
 
+// ================== MAVLINK UDP INGEST ==================
+
+// Merge semua message dalam satu datagram/frame lalu broadcast sekali
+function ingestMavlinkMessages(messages, connectionType, bytes, extra = {}) {
+    let update = {};
+    for (const message of messages) {
+        update = { ...update, ...mavlinkToTelemetry(message) };
+    }
+    const deviceId = `MAV_${messages[0].sysid}`;
+    ingestTelemetry({ ...update, device_id: deviceId, ...extra }, connectionType, deviceId, bytes);
+}
+
+// Satu parser per remote endpoint agar frame dari device berbeda tidak tercampur.
+// Endpoint yang diam MAVLINK_PARSER_IDLE_MS dibuang (device ganti port setelah reconnect/NAT),
+// dan jumlahnya dibatasi agar sumber acak tidak menumbuhkan map tanpa batas
+const MAVLINK_PARSER_IDLE_MS = 60000;
+const MAVLINK_MAX_PARSERS = 256;
+const mavlinkParsers = new Map();   // 'address:port' -> { parser, lastSeen }
+
+function mavlinkParserFor(key, now) {
+    let entry = mavlinkParsers.get(key);
+    if (!entry) {
+        if (mavlinkParsers.size >= MAVLINK_MAX_PARSERS) evictMavlinkParsers(now, true);
+        entry = { parser: new MavlinkParser(), lastSeen: now };
+        mavlinkParsers.set(key, entry);
+        console.log('🛰️ [MAVLINK] New device stream from', key);
+    }
+    entry.lastSeen = now;
+    return entry.parser;
+}
+
+// Buang parser idle; force = map penuh, buang juga yang paling lama tidak terlihat
+function evictMavlinkParsers(now, force = false) {
+    let oldestKey = null;
+    let oldestSeen = Infinity;
+    for (const [key, entry] of mavlinkParsers) {
+        if (now - entry.lastSeen > MAVLINK_PARSER_IDLE_MS) {
+            mavlinkParsers.delete(key);
+        } else if (entry.lastSeen < oldestSeen) {
+            oldestKey = key;
+            oldestSeen = entry.lastSeen;
+        }
+    }
+    if (force && mavlinkParsers.size >= MAVLINK_MAX_PARSERS && oldestKey) mavlinkParsers.delete(oldestKey);
+}
+
+// Dengan sidecar, port MAVLink dipegang native/ingest_sidecar (lihat INGEST SIDECAR)
+if (!INGEST_SIDECAR_SHM) mavlinkSocket = dgram.createSocket('udp4');
+
+if (mavlinkSocket) mavlinkSocket.on('message', (msg, rinfo) => {
+    try {
+        if (isShuttingDown) return;
+
+        const parser = mavlinkParserFor(`${rinfo.address}:${rinfo.port}`, Date.now());
+
+        const crcErrors = parser.stats.crcErrors;
+        const messages = parser.push(msg);
+        const newCrcErrors = parser.stats.crcErrors - crcErrors;
+        if (newCrcErrors > 0) rateTracker.mark('errors', messages.length ? `MAV_${messages[0].sysid}` : null, newCrcErrors);
+        if (messages.length === 0) return;
+
+        // UDP tanpa kanal balik: kredit hanya dicatat untuk statistik
+        ingestMavlinkMessages(messages, 'MAVLink', msg.length);
+    } catch (error) {
+        console.error('❌ [MAVLINK] Error processing datagram:', error);
+        rateTracker.mark('errors', null);
+    }
+});
+
+if (mavlinkSocket) {
+    mavlinkSocket.on('error', (error) => {
+        console.error('❌ [MAVLINK] UDP socket error:', error.message);
+        mavlinkSocket.close();
+        mavlinkSocket = null;
+    });
+
+    mavlinkSocket.bind(MAVLINK_UDP_PORT);
+}
+
+// ================== USB SERIAL BRIDGE INGEST ==================
+
+// native/serial_bridge meneruskan frame COBS/CRC yang sudah valid lewat TCP lokal
+const serialBridgeParsers = new Map();
+
+serialBridgeServer = createSerialBridgeServer({
+    port: SERIAL_BRIDGE_PORT,
+    onConnect: (key) => {
+        serialBridgeParsers.set(key, new MavlinkParser());
+        console.log('🔌 [SERIAL] Bridge connected from', key);
+    },
+    onDisconnect: (key, stats) => {
+        serialBridgeParsers.delete(key);
+        console.log(`🔌 [SERIAL] Bridge ${key} disconnected (${stats.framesDecoded} frames)`);
+    },
+    onFrame: (frame, key) => {
+        try {
+            if (isShuttingDown || frame.payload.length === 0) return;
+
+            if (frame.payload[0] === 0x7B) { // '{' -> JSON
+                const data = JSON.parse(frame.payload.toString('utf8'));
+                const deviceId = data.device_id || `USB_${key}`;
+                ingestTelemetry({ packet_number: frame.sequence, ...data }, 'USB-Serial', deviceId, frame.payload.length);
+                return;
+            }
+
+            const messages = serialBridgeParsers.get(key).push(frame.payload);
+            if (messages.length === 0) return;
+            ingestMavlinkMessages(messages, 'USB-Serial', frame.payload.length, { packet_number: frame.sequence });
+        } catch (error) {
+            console.error('❌ [SERIAL] Error processing bridge frame:', error.message);
+            rateTracker.mark('errors', null);
+        }
+    }
+});
+
+serialBridgeServer.on('error', (error) => {
+    console.error('❌ [SERIAL] Bridge listener error:', error.message);
+    serialBridgeServer = null;
+});
+
+// ================== INGEST SIDECAR ==================
+
+// Record sidecar selalu berisi frame MAVLink utuh (sudah lolos CRC), jadi satu parser
+// cukup dan tidak pernah menyimpan view ke slot ring setelah push() selesai
+const sidecarParser = new MavlinkParser();
+
+function ingestSidecarRecord(record) {
+    try {
+        if (isShuttingDown) return;
+
+        if (record.kind === INGEST_KIND.MAVLINK) {
+            const messages = sidecarParser.push(record.payload);
+            if (messages.length) ingestMavlinkMessages(messages, 'MAVLink', record.payload.length);
+            return;
+        }
+
+        // JSON: sidecar hanya memastikan object utuh, validasi field sama dengan HTTP
+        const data = JSON.parse(record.payload.toString('utf8'));
+        const source = formatSource(record.sourceAddress, record.sourcePort);
+        const validationError = validateTelemetry(data);
+        if (validationError) {
+            rateTracker.mark('errors', (data && data.device_id) || source);
+            return;
+        }
+        ingestTelemetry(data, record.tcp ? 'TCP' : 'UDP', data.device_id || source, record.payload.length);
+    } catch (error) {
+        console.error('❌ [SIDECAR] Error processing record:', error.message);
+        rateTracker.mark('errors', null);
+    }
+}
+
+if (INGEST_SIDECAR_SHM) {
+    ingestSidecar = new IngestRingConsumer({ file: INGEST_SIDECAR_SHM, onRecord: ingestSidecarRecord });
+    if (!ingestSidecar.start()) ingestSidecar = null;
+}
+
+// ================== FAST-PATH HTTP INGEST ==================
+
+// Listener khusus POST /api/telemetry (keep-alive + pipelining), tanpa Express
+ingestServer = createIngestServer({ port: INGEST_PORT, onTelemetry: ingestHttpBody });
+
+ingestServer.on('error', (error) => {
+    console.error('❌ [INGEST] Fast-path listener error:', error.message);
+    ingestServer = null;
+});
+
+// Terima relay dari ground station lain; dedupe per station/device ada di lib/federation.js
+if (FEDERATION_PORT) {
+    federationServer = createFederationServer({
+        port: FEDERATION_PORT,
+        onTelemetry: (record) => {
+            if (isShuttingDown) return;
+            ingestTelemetry(record.data, record.connectionType, record.deviceId, 0, null,
+                { station: record.station, receivedAt: record.receivedAt });
+        }
+    });
+    federationServer.on('error', (error) => {
+        console.error('❌ [FEDERATION] Listener error:', error.message);
+        federationServer = null;
+    });
+}
+
 // ================== CONNECTION MONITORING ==================
 
 // Monitor ESP32 connection status
@@ -320,8 +839,30 @@ connectionMonitorInterval = setInterval(() => {
         console.log('⚠️ [MONITOR] ESP32 connection timeout - no data for 15s');
         io.emit('esp32Status', { status: 'timeout' });
     }
+
+    evictMavlinkParsers(now);
+    alertEngine.evictIdle(now);
+    anomalyDetector.evictIdle(now);
+
+    // Laju global untuk panel status dashboard (room alerts = dashboard)
+    io.to(ALERT_ROOM).emit('rateStats', rateTracker.getStats(now).global);
 }, 5000);
 
+// ================== FLOW CONTROL LOAD MONITOR ==================
+
+// Hitung paket yang antre di semua socket dashboard sebagai sinyal backpressure
+flowControlInterval = setInterval(() => {
+    let bufferedPackets = 0;
+    for (const socket of io.of('/').sockets.values()) {
+        bufferedPackets += socket.conn && socket.conn.writeBuffer ? socket.conn.writeBuffer.length : 0;
+    }
+
+    if (flowController.updateLoad(bufferedPackets)) {
+        const { load } = flowController.getStats();
+        console.log(`⚖️ [FLOW] Load level: ${load.level} (lag ${load.eventLoopLagMs}ms, buffered ${bufferedPackets})`);
+    }
+}, 1000);
+
 // ================== SERVER STARTUP ==================
 
 server.listen(PORT, () => {
@@ -333,7 +874,19 @@ server.listen(PORT, () => {
     console.log('   🌐 Web Dashboard: http://localhost:' + PORT);
     console.log('   📡 Socket.IO: Ready for ESP32 connection');
     console.log('   🔌 HTTP API: /api/telemetry (POST)');
+    console.log(`   ⚡ Fast ingest: POST ${INGEST_PATH} on port ${INGEST_PORT} (keep-alive, pipelining)`);
+    if (FEDERATION_PORT) console.log(`   🛰️ Federation: receiving relays on port ${FEDERATION_PORT}`);
+    if (federationUplink) console.log(`   🛰️ Federation: relaying to ${FEDERATION_PEERS.map((peer) => `${peer.host}:${peer.port}`).join(', ')} as ${federationUplink.station}`);
+    console.log('   👀 Spectator stream: /stream (GET, server-sent events)');
     console.log('   📈 Statistics: /api/stats (GET)');
+    console.log(`   🚨 Alerts: /api/alerts (GET), ${alertEngine.getStats().rules} rules`);
+    console.log(`   🗺️ Geofence: /api/geofence (GET), ${geofence.getStats().zones} zones`);
+    console.log(`   ⚠️ Anomalies: /api/anomalies (GET), ${anomalyDetector.getStats().fields} fields`);
+    console.log(`   📐 Analytics: /api/analytics/:deviceId (GET), kernel ${nativeKernel() ? 'native ' + nativeKernel() : 'js (run npm run native:build)'}`);
+    console.log(`   📤 Export: /api/export/:deviceId?format=csv|parquet (GET), history ${HISTORY_DIR || 'in memory'}`);
+    if (INGEST_SIDECAR_SHM) console.log(`   🛰️ MAVLink v2 / UDP / TCP: via native/ingest_sidecar ring ${INGEST_SIDECAR_SHM}`);
+    else console.log('   🛰️ MAVLink v2: UDP port ' + MAVLINK_UDP_PORT);
+    console.log('   🔌 USB serial bridge: 127.0.0.1:' + SERIAL_BRIDGE_PORT);
     console.log('');
     console.log('🔍 Waiting for ESP32 connection...');
     console.log('   📍 IP Address needed in ESP32 code: YOUR_COMPUTER_IP');
@@ -366,6 +919,49 @@ const gracefulShutdown = (signal = 'UNKNOWN') => {
         console.log('🔄 Demo data stopped');
     }
 
+    if (flowControlInterval) {
+        clearInterval(flowControlInterval);
+        flowControlInterval = null;
+        flowController.stop();
+        console.log('🔄 Flow control monitor stopped');
+    }
+
+    if (mavlinkSocket) {
+        mavlinkSocket.close();
+        mavlinkSocket = null;
+        console.log('🔄 MAVLink UDP listener stopped');
+    }
+
+    if (ingestSidecar) {
+        ingestSidecar.close();
+        ingestSidecar = null;
+        console.log('🔄 Ingest sidecar consumer stopped');
+    }
+
+    if (serialBridgeServer) {
+        serialBridgeServer.close();
+        serialBridgeServer = null;
+        console.log('🔄 Serial bridge listener stopped');
+    }
+
+    if (ingestServer) {
+        ingestServer.close();
+        ingestServer = null;
+        console.log('🔄 Fast-path ingest listener stopped');
+    }
+
+    if (federationServer || federationUplink) {
+        if (federationServer) federationServer.close();
+        if (federationUplink) federationUplink.close();
+        federationServer = null;
+        console.log('🔄 Federation relay stopped');
+    }
+
+    sseStream.close();
+    historyStore.flush();
+    shutdownExportWorkers();
+    console.log('🔄 History flushed');
+
     // Notify all connected clients
     try {
         io.emit('serverShuttingDown', { message: 'Server is shutting down', timestamp: Date.now() });
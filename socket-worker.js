@@ -0,0 +1,123 @@
+// UAV Dashboard Socket Worker (SharedWorker)
+// Semua tab/jendela dashboard dari origin yang sama berbagi satu koneksi Socket.IO di sini.
+// Frame telemetryPacked di-inflate sekali lalu dibagikan sebagai telemetryUpdate; tiap tab
+// hanya menerima event yang ia subscribe (SharedSocket di script.js mengirim 'subscribe'
+// saat socket.on() pertama untuk event itu). Balasan request (backfill, snapshot alert)
+// dikirim hanya ke tab yang meminta, dan request yang sama dari beberapa tab digabung.
+
+importScripts('/socket.io/socket.io.js', '/stream-codec.js');
+
+// Request -> event balasan yang hanya untuk peminta
+const REPLIES = {
+    subscribeAlerts: ['alertSnapshot', 'geofenceSnapshot'],
+    requestBackfill: ['telemetryBackfill']
+};
+// Diurus worker sendiri: kompresi stream sekali per koneksi, heartbeat tidak dipakai server
+const WORKER_EVENTS = new Set(['setStreamCompression', 'unsubscribeAlerts', 'heartbeat']);
+
+const subscriptions = new Map();   // port -> Set(event)
+const waiters = new Map();         // event balasan -> [port]
+let connected = false;
+let lastTelemetry = null;
+
+// Stream mode dictionary (stream-codec.js, sama dengan script.js)
+const streamDecoder = new StreamDecoder();
+let packedChain = Promise.resolve();
+
+const socket = io();
+
+function post(event, data) {
+    for (const [port, events] of subscriptions) {
+        if (events.has(event)) port.postMessage({ event, data });
+    }
+}
+
+function reply(event, data) {
+    const ports = waiters.get(event) || [];
+    waiters.delete(event);
+    for (const port of ports) {
+        if (subscriptions.has(port)) port.postMessage({ event, data });
+    }
+}
+
+function request(port, event, data) {
+    const replies = REPLIES[event];
+    const pending = waiters.get(replies[0]);
+    // Tab lain sudah menunggu balasan yang sama: cukup ikut antre
+    if (!pending) socket.emit(event, data);
+    for (const name of replies) {
+        if (!waiters.has(name)) waiters.set(name, []);
+        waiters.get(name).push(port);
+    }
+}
+
+function publishTelemetry(data) {
+    lastTelemetry = data;
+    post('telemetryUpdate', data);
+}
+
+// ====== SOCKET ======
+
+socket.on('connect', () => {
+    connected = true;
+    // Tanpa DecompressionStream di worker tetap telemetryUpdate JSON
+    if (StreamDecoder.supported()) socket.emit('setStreamCompression', { mode: 'dictionary' });
+    post('connect');
+});
+
+socket.on('disconnect', (reason) => {
+    connected = false;
+    // Balasan untuk koneksi lama tidak akan datang; tab mengulang request saat connect
+    waiters.clear();
+    post('disconnect', reason);
+});
+
+socket.on('streamCompression', (config) => streamDecoder.configure(config));
+
+socket.on('telemetryUpdate', publishTelemetry);
+
+socket.on('telemetryPacked', (packed) => {
+    packedChain = packedChain
+        .then(() => streamDecoder.unpack(packed))
+        .then(publishTelemetry)
+        .catch((error) => console.error('❌ Failed to unpack telemetry:', error));
+});
+
+socket.onAny((event, data) => {
+    if (event === 'telemetryUpdate' || event === 'telemetryPacked' || event === 'streamCompression') return;
+    if (waiters.has(event)) reply(event, data);
+    else post(event, data);
+});
+
+// ====== TABS ======
+
+function handleTabMessage(port, message) {
+    switch (message.type) {
+        case 'subscribe': {
+            subscriptions.get(port).add(message.event);
+            // Tab baru langsung dapat status koneksi dan frame terakhir
+            if (message.event === 'connect' && connected) port.postMessage({ event: 'connect' });
+            if (message.event === 'telemetryUpdate' && lastTelemetry) port.postMessage({ event: 'telemetryUpdate', data: lastTelemetry });
+            break;
+        }
+        case 'emit':
+            if (WORKER_EVENTS.has(message.event)) break;
+            if (REPLIES[message.event]) request(port, message.event, message.data);
+            else socket.emit(message.event, message.data);
+            break;
+        case 'close':
+            subscriptions.delete(port);
+            break;
+    }
+}
+
+self.onconnect = (event) => {
+    const port = event.ports[0];
+    subscriptions.set(port, new Set());
+    port.onmessage = (message) => {
+        // Tab dari bfcache kembali setelah 'close': daftar ulang
+        if (!subscriptions.has(port)) subscriptions.set(port, new Set());
+        handleTabMessage(port, message.data);
+    };
+    port.start();
+};
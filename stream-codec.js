@@ -0,0 +1,44 @@
+// UAV Dashboard Stream Codec
+// Decoder frame telemetryPacked mode dictionary (lib/stream-compression.js), dipakai
+// bersama oleh script.js (<script>) dan socket-worker.js (importScripts).
+// Butuh DecompressionStream('deflate-raw'); tanpa itu dashboard tetap telemetryUpdate JSON.
+
+class StreamDecoder {
+    static supported() {
+        try {
+            new DecompressionStream('deflate-raw');
+            return true;
+        } catch (error) {
+            return false;
+        }
+    }
+
+    constructor() {
+        this.prefix = null;
+        this.dictionaryLength = 0;
+    }
+
+    // Dictionary dijadikan stored block deflate (tidak final) yang mendahului setiap frame
+    configure(config) {
+        if (config.mode !== 'dictionary') {
+            this.prefix = null;
+            return;
+        }
+        const dictionary = new TextEncoder().encode(config.dictionary);
+        const length = dictionary.length;
+        this.prefix = new Uint8Array(5 + length);
+        this.prefix.set([0, length & 0xff, length >> 8, ~length & 0xff, (~length >> 8) & 0xff]);
+        this.prefix.set(dictionary, 5);
+        this.dictionaryLength = length;
+    }
+
+    async unpack(packed) {
+        const binary = atob(packed);
+        const bytes = new Uint8Array(binary.length);
+        for (let i = 0; i < binary.length; i++) bytes[i] = binary.charCodeAt(i);
+
+        const stream = new Blob([this.prefix, bytes]).stream().pipeThrough(new DecompressionStream('deflate-raw'));
+        const output = new Uint8Array(await new Response(stream).arrayBuffer());
+        return JSON.parse(new TextDecoder().decode(output.subarray(this.dictionaryLength)));
+    }
+}
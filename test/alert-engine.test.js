@@ -0,0 +1,89 @@
+const test = require('node:test');
+const assert = require('node:assert/strict');
+const { AlertEngine, compileRule, compileRules, DEFAULT_RULES } = require('../lib/alert-engine');
+
+function engine(...definitions) {
+    return new AlertEngine(compileRules(definitions));
+}
+
+// Jalankan deret [now, value] dan kumpulkan state event per sampel
+function run(alerts, field, samples, deviceId = 'uav1') {
+    return samples.map(([now, value]) => alerts.evaluate(deviceId, { [field]: value }, now).map((event) => event.state).join(','));
+}
+
+test('threshold rule holds until the value crosses the clear level', () => {
+    const alerts = engine({ id: 'current', field: 'battery_current', op: '>', value: 20, clear: 18 });
+    const states = run(alerts, 'battery_current', [[1, 19], [2, 21], [3, 19], [4, 20.5], [5, 17.9], [6, 19]]);
+    assert.deepEqual(states, ['', 'raised', '', '', 'cleared', '']);
+    assert.equal(alerts.getActiveAlerts().length, 0);
+});
+
+test('falling rule uses clear above the value', () => {
+    const alerts = engine({ id: 'voltage', field: 'battery_voltage', op: '<', value: 11.1, clear: 11.4 });
+    const states = run(alerts, 'battery_voltage', [[1, 11], [2, 11.3], [3, 11.5]]);
+    assert.deepEqual(states, ['raised', '', 'cleared']);
+});
+
+test('duration rule needs the condition to persist for forMs', () => {
+    const alerts = engine({ id: 'weak', field: 'signal_strength', type: 'duration', op: '<', value: -85, forMs: 3000 });
+    const states = run(alerts, 'signal_strength', [
+        [0, -90], [2000, -90], [2500, -80], [3000, -90], [5999, -90], [6000, -90], [7000, -70]
+    ]);
+    assert.deepEqual(states, ['', '', '', '', '', 'raised', 'cleared']);
+});
+
+test('clearForMs delays clearing', () => {
+    const alerts = engine({ id: 'hot', field: 'temperature', op: '>', value: 60, clear: 55, clearForMs: 2000 });
+    const states = run(alerts, 'temperature', [[0, 61], [1000, 50], [2000, 58], [3000, 50], [4999, 50], [5000, 50]]);
+    assert.deepEqual(states, ['raised', '', '', '', '', 'cleared']);
+});
+
+test('rate rule needs two samples and smooths the derivative', () => {
+    const alerts = engine({ id: 'climb', field: 'altitude', type: 'rate', op: '>', value: 15, clear: 10, smoothing: 1 });
+    const states = run(alerts, 'altitude', [[1000, 100], [2000, 120], [3000, 125], [4000, 129]]);
+    assert.deepEqual(states, ['', 'raised', 'cleared', '']);
+
+    const descent = run(alerts, 'altitude', [[1000, 200], [2000, 180]], 'uav2');
+    assert.deepEqual(descent, ['', 'raised'], 'absolute rate by default');
+});
+
+test('device filter matches exact ids and prefixes', () => {
+    const alerts = engine({ id: 'fleet', field: 'temperature', op: '>', value: 60, devices: ['alpha', 'uav_*'] });
+    assert.equal(alerts.evaluate('alpha', { temperature: 70 }, 1).length, 1);
+    assert.equal(alerts.evaluate('uav_7', { temperature: 70 }, 1).length, 1);
+    assert.equal(alerts.evaluate('beta', { temperature: 70 }, 1).length, 0);
+});
+
+test('ignores missing and non-numeric fields', () => {
+    const alerts = engine({ id: 'hot', field: 'temperature', op: '>', value: 60 });
+    assert.deepEqual(alerts.evaluate('uav1', { temperature: null }, 1), []);
+    assert.deepEqual(alerts.evaluate('uav1', { temperature: 'abc' }, 2), []);
+    assert.equal(alerts.evaluate('uav1', { temperature: '61' }, 3)[0].state, 'raised');
+});
+
+test('rejects clear levels on the wrong side and invalid definitions', () => {
+    assert.throws(() => compileRule({ id: 'x', field: 'f', op: '>', value: 10, clear: 12 }, 0), /clear 12 must be <= value 10/);
+    assert.throws(() => compileRule({ id: 'x', field: 'f', op: '<', value: 10, clear: 8 }, 0), /clear 8 must be >= value 10/);
+    assert.throws(() => compileRule({ id: 'x', field: 'f', type: 'duration', op: '>', value: 1 }, 0), /needs forMs/);
+    assert.throws(() => compileRule({ id: 'x', field: 'f', op: '!=', value: 1 }, 0), /unknown operator/);
+    assert.throws(() => compileRules([{ id: 'a', field: 'f', value: 1 }, { id: 'a', field: 'g', value: 2 }]), /Duplicate rule id/);
+    assert.doesNotThrow(() => compileRules(DEFAULT_RULES));
+});
+
+test('device state is capped and idle devices drop their active alerts', () => {
+    const alerts = new AlertEngine(compileRules([{ id: 'hot', field: 'temperature', op: '>', value: 60 }]), { maxDevices: 2, idleMs: 1000 });
+    alerts.evaluate('a', { temperature: 70 }, 0);
+    alerts.evaluate('b', { temperature: 20 }, 100);
+    alerts.evaluate('a', { temperature: 70 }, 200);
+    alerts.evaluate('c', { temperature: 20 }, 300);
+    assert.deepEqual([...alerts.devices.keys()].sort(), ['a', 'c'], 'least recently seen device evicted');
+    assert.equal(alerts.getActiveAlerts().length, 1);
+
+    alerts.evictIdle(1250);
+    assert.deepEqual([...alerts.devices.keys()], ['c']);
+    assert.equal(alerts.getActiveAlerts().length, 0);
+    assert.equal(alerts.getStats().evictedDevices, 2);
+
+    // Device yang kembali mulai dari state baru: alert naik lagi
+    assert.equal(alerts.evaluate('a', { temperature: 70 }, 1300)[0].state, 'raised');
+});
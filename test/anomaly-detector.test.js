@@ -0,0 +1,90 @@
+const test = require('node:test');
+const assert = require('node:assert/strict');
+const { AnomalyDetector, DEFAULT_FIELDS } = require('../lib/anomaly-detector');
+
+const START = 1e6;
+
+function only(name) {
+    return new AnomalyDetector({ [name]: DEFAULT_FIELDS[name] });
+}
+
+// Noise deterministik kecil di sekitar level
+function noise(i, amplitude) {
+    return Math.sin(i * 12.9898) * amplitude;
+}
+
+test('spike is flagged on its own row through previous', () => {
+    const detector = only('battery_voltage');
+    for (let i = 0; i < 40; i++) {
+        const result = detector.evaluate('uav1', { battery_voltage: 12 + noise(i, 0.02) }, START + i * 100, i);
+        assert.equal(result.flags, 0);
+    }
+    const spike = detector.evaluate('uav1', { battery_voltage: 9 }, START + 4000, 40);
+    assert.equal(spike.flags, 0, 'not known until the next sample');
+    assert.deepEqual(spike.events, []);
+
+    const after = detector.evaluate('uav1', { battery_voltage: 12 }, START + 4100, 41);
+    assert.equal(after.flags, 0);
+    assert.deepEqual(after.previous, [{ rowsBack: 1, flags: detector.getFlagBits().battery_voltage }]);
+    assert.equal(after.events.length, 1);
+    assert.equal(after.events[0].kind, 'spike');
+    assert.equal(after.events[0].seq, 40);
+    assert.equal(after.events[0].value, 9);
+    assert.equal(after.events[0].timestamp, new Date(START + 4000).toISOString());
+});
+
+test('level step is not an anomaly unless reportSteps', () => {
+    const current = only('battery_current');
+    const temperature = only('temperature');
+    let events = [];
+    for (let i = 0; i < 60; i++) {
+        const level = i < 30 ? 5 : 15;
+        const a = current.evaluate('uav1', { battery_current: level + noise(i, 0.1) }, START + i * 100, i);
+        assert.equal(a.flags, 0);
+        assert.deepEqual(a.previous, []);
+        events = events.concat(a.events);
+    }
+    assert.deepEqual(events, []);
+
+    for (let i = 0; i < 60; i++) {
+        const level = i < 30 ? 30 : 45;
+        events = events.concat(temperature.evaluate('uav1', { temperature: level + noise(i, 0.1) }, START + i * 100, i).events);
+    }
+    assert.deepEqual(events.map((event) => event.kind), ['step_up']);
+});
+
+test('GPS teleport is reported as a jump on the same row', () => {
+    const detector = only('gps');
+    for (let i = 0; i < 30; i++) {
+        const result = detector.evaluate('uav1', { gps_latitude: -6 + i * 1e-5, gps_longitude: 106 }, START + i * 1000, i);
+        assert.equal(result.flags, 0);
+    }
+    const jump = detector.evaluate('uav1', { gps_latitude: -5.99, gps_longitude: 106 }, START + 30000, 30);
+    assert.equal(jump.flags, detector.getFlagBits().gps);
+    assert.equal(jump.events[0].kind, 'jump');
+    assert.equal(jump.events[0].field, 'gps_speed');
+});
+
+test('no flags during warmup and devices are independent', () => {
+    const detector = only('battery_voltage');
+    for (let i = 0; i < 15; i++) {
+        const value = i % 2 ? 12 : 5;
+        assert.equal(detector.evaluate('uav1', { battery_voltage: value }, START + i * 100, i).flags, 0);
+    }
+    assert.equal(detector.evaluate('uav2', { battery_voltage: 12 }, START, 0).flags, 0);
+    assert.equal(detector.getStats().devices, 2);
+});
+
+test('device baselines are capped and evicted when idle', () => {
+    const detector = new AnomalyDetector({ battery_voltage: DEFAULT_FIELDS.battery_voltage }, { maxDevices: 2, idleMs: 1000 });
+    detector.evaluate('a', { battery_voltage: 12 }, 0);
+    detector.evaluate('b', { battery_voltage: 12 }, 100);
+    detector.evaluate('a', { battery_voltage: 12 }, 200);
+    detector.evaluate('c', { battery_voltage: 12 }, 300);
+    assert.deepEqual([...detector.devices.keys()].sort(), ['a', 'c']);
+
+    detector.evictIdle(1250);
+    assert.deepEqual([...detector.devices.keys()], ['c']);
+    assert.equal(detector.getStats().evictedDevices, 2);
+    assert.equal(detector.getStats().devices, 1);
+});
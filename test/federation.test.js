@@ -0,0 +1,118 @@
+const test = require('node:test');
+const assert = require('node:assert/strict');
+const net = require('net');
+const zlib = require('zlib');
+const { FederationUplink, createFederationServer, parsePeers } = require('../lib/federation');
+
+// Log koneksi federation tidak perlu ikut di output test runner
+test.mock.method(console, 'log', () => {});
+
+async function listen(onTelemetry) {
+    const server = createFederationServer({ port: 0, host: '127.0.0.1', onTelemetry });
+    await new Promise((resolve) => server.once('listening', resolve));
+    return server;
+}
+
+async function waitFor(condition, timeoutMs = 5000) {
+    const deadline = Date.now() + timeoutMs;
+    while (!condition()) {
+        if (Date.now() > deadline) throw new Error('Timed out');
+        await new Promise((resolve) => setTimeout(resolve, 10));
+    }
+}
+
+async function shutdown(uplink, server) {
+    uplink.close();
+    await new Promise((resolve) => server.close(resolve));
+}
+
+test('parses peer lists', () => {
+    assert.deepEqual(parsePeers(' a:1, 10.0.0.2:7000 ,bad, c: '), [{ host: 'a', port: 1 }, { host: '10.0.0.2', port: 7000 }]);
+});
+
+test('replays the ring after connect and streams live frames in order', async () => {
+    const received = [];
+    const server = await listen((record) => received.push(record));
+    const uplink = new FederationUplink([{ host: '127.0.0.1', port: server.address().port }], { station: 'pit', replayFrames: 4 });
+    // Sebelum resume: hanya ring, 2 frame tertua sudah tertimpa
+    for (let i = 1; i <= 6; i++) uplink.forward('uav1', 'wifi', { n: i }, 1000 + i);
+    uplink.forward('uav2', 'lora', { n: 1 });
+
+    await waitFor(() => received.length === 5);
+    assert.deepEqual(received.filter((record) => record.deviceId === 'uav1').map((record) => record.seq), [3, 4, 5, 6]);
+    assert.deepEqual(received.find((record) => record.deviceId === 'uav2').data, { n: 1 });
+    assert.equal(received[0].station, 'pit');
+    assert.equal(received[0].connectionType, 'wifi');
+
+    uplink.forward('uav1', 'wifi', { n: 7 });
+    await waitFor(() => received.length === 6);
+    assert.equal(received[5].seq, 7);
+    assert.equal(uplink.getStats().peers[0].replayed, 5);
+    await shutdown(uplink, server);
+});
+
+test('resumes after a dropped connection without gaps or duplicates', async () => {
+    const received = [];
+    const server = await listen((record) => received.push(record.seq));
+    const uplink = new FederationUplink([{ host: '127.0.0.1', port: server.address().port }], { station: 'pit' });
+    const peer = uplink.peers[0];
+    await waitFor(() => peer.ready);
+
+    for (let i = 0; i < 3; i++) uplink.forward('uav1', 'wifi', { i });
+    await waitFor(() => received.length === 3);
+
+    peer.socket.destroy();
+    await waitFor(() => !peer.ready);
+    for (let i = 0; i < 3; i++) uplink.forward('uav1', 'wifi', { i });
+    await waitFor(() => received.length === 6);
+
+    assert.deepEqual(received, [1, 2, 3, 4, 5, 6]);
+    assert.equal(server.federationStats().duplicates, 0);
+    assert.equal(peer.stats.connects, 2);
+    await shutdown(uplink, server);
+});
+
+test('streams a full replay ring in bounded batches under backpressure', async () => {
+    const received = [];
+    const server = await listen((record) => received.push(record));
+    const uplink = new FederationUplink([{ host: '127.0.0.1', port: server.address().port }], { station: 'pit' });
+    const peer = uplink.peers[0];
+    // Payload acak supaya deflate tidak bisa memampatkan semuanya ke satu buffer kecil
+    let seed = 7;
+    const noise = () => (seed = (seed * 1103515245 + 12345) % 2147483648).toString(36);
+    for (let i = 0; i < 12000; i++) {
+        uplink.forward(`uav${i % 3}`, 'wifi', { i, noise: noise() + noise() + noise() });
+    }
+
+    await waitFor(() => received.length === 12000, 20000);
+    for (let d = 0; d < 3; d++) {
+        const seqs = received.filter((record) => record.deviceId === `uav${d}`).map((record) => record.seq);
+        assert.deepEqual(seqs, Array.from({ length: 4000 }, (_, i) => i + 1));
+    }
+    assert.equal(peer.stats.replayed, 12000);
+    assert.equal(peer.stats.sent, 12000);
+    assert.equal(peer.stats.dropped, 0);
+    assert.ok(peer.stats.drains > 0, 'writes waited for drain');
+    await shutdown(uplink, server);
+});
+
+test('receiver drops sequence numbers it already has', async () => {
+    const received = [];
+    const server = await listen((record) => received.push(record.seq));
+    const socket = net.connect(server.address().port, '127.0.0.1');
+    const deflate = zlib.createDeflateRaw();
+    deflate.pipe(socket);
+
+    const lines = [{ type: 'hello', station: 'raw', epoch: 'e1', now: Date.now() }]
+        .concat([1, 2, 2, 1, 3].map((q) => ({ d: 'uav1', q, a: Date.now(), c: 'wifi', p: {} })));
+    deflate.write(lines.map((line) => `${JSON.stringify(line)}\n`).join(''));
+    deflate.flush(zlib.constants.Z_SYNC_FLUSH);
+
+    await waitFor(() => server.federationStats().received + server.federationStats().duplicates === 5);
+    assert.deepEqual(received, [1, 2, 3]);
+    assert.equal(server.federationStats().duplicates, 2);
+    assert.deepEqual(server.federationStats().stations, { raw: { uav1: 3 } });
+
+    socket.destroy();
+    await new Promise((resolve) => server.close(resolve));
+});
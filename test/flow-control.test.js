@@ -0,0 +1,29 @@
+const test = require('node:test');
+const assert = require('node:assert/strict');
+const { FlowController } = require('../lib/flow-control');
+
+test('only the overloaded level counts as overloaded', (t) => {
+    const flow = new FlowController({ lagElevatedMs: Infinity, lagOverloadedMs: Infinity });
+    t.after(() => flow.stop());
+
+    assert.equal(flow.updateLoad(0), false);
+    assert.equal(flow.isOverloaded(), false);
+    assert.equal(flow.updateLoad(500), true);
+    assert.equal(flow.getStats().load.level, 'elevated');
+    assert.equal(flow.isOverloaded(), false);
+    flow.updateLoad(5000);
+    assert.equal(flow.getStats().load.level, 'overloaded');
+    assert.equal(flow.isOverloaded(), true);
+});
+
+test('grant window shrinks with load and follows packet numbers', (t) => {
+    const flow = new FlowController({ lagElevatedMs: Infinity, lagOverloadedMs: Infinity });
+    t.after(() => flow.stop());
+
+    assert.equal(flow.onFrame('uav1', 10, 100).credit_limit, 19);
+    flow.updateLoad(5000);
+    const grant = flow.onFrame('uav1', 11, 100);
+    assert.equal(grant.credit_limit, 13);
+    assert.equal(grant.interval_ms, 10000);
+    assert.equal(flow.onFrame('uav1', 0, 100).credit_limit, 2, 'reboot restarts the window');
+});
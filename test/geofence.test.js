@@ -0,0 +1,109 @@
+const test = require('node:test');
+const assert = require('node:assert/strict');
+const { GeofenceEngine, normalizeZones } = require('../lib/geofence');
+
+// Lapangan (allowed) dengan lubang, zona no_fly di dalamnya, dan poligon cekung
+const ZONES = [
+    {
+        id: 'field',
+        kind: 'allowed',
+        polygon: [
+            [[-6.000, 106.000], [-6.000, 106.010], [-6.010, 106.010], [-6.010, 106.000]],
+            [[-6.008, 106.008], [-6.008, 106.009], [-6.009, 106.009], [-6.009, 106.008]]
+        ]
+    },
+    { id: 'tower', kind: 'no_fly', polygon: [[-6.002, 106.002], [-6.002, 106.004], [-6.004, 106.004], [-6.004, 106.002]] },
+    {
+        id: 'comb',
+        kind: 'no_fly',
+        polygon: [[-6.005, 106.011], [-6.005, 106.019], [-6.013, 106.019], [-6.013, 106.017], [-6.007, 106.017],
+            [-6.007, 106.015], [-6.013, 106.015], [-6.013, 106.013], [-6.007, 106.013], [-6.007, 106.011]]
+    }
+];
+
+// Even-odd brute force langsung di lat/lon (proyeksi engine linear, paritas sama)
+function containsBrute(rings, lat, lon) {
+    let inside = false;
+    for (const ring of rings) {
+        for (let i = 0, j = ring.length - 1; i < ring.length; j = i++) {
+            const [ai, bi] = ring[i];
+            const [aj, bj] = ring[j];
+            if ((bi > lon) !== (bj > lon) && lat < (aj - ai) * (lon - bi) / (bj - bi) + ai) inside = !inside;
+        }
+    }
+    return inside;
+}
+
+test('locate matches brute-force parity including holes and concave zones', () => {
+    const zones = normalizeZones(ZONES);
+    const engine = new GeofenceEngine(zones);
+    let seed = 12345;
+    const random = () => (seed = (seed * 1103515245 + 12345) % 2147483648) / 2147483648;
+    for (let i = 0; i < 5000; i++) {
+        const lat = -6.015 + random() * 0.017;
+        const lon = 105.998 + random() * 0.023;
+        const expected = zones.map((zone, index) => (containsBrute(zone.rings, lat, lon) ? index : -1)).filter((index) => index >= 0);
+        assert.deepEqual(engine.locate(lat, lon).sort(), expected, `${lat},${lon}`);
+    }
+});
+
+test('emits enter/exit with violation flags per zone kind', () => {
+    const engine = new GeofenceEngine(normalizeZones(ZONES));
+    const path = [
+        [-6.001, 106.001],   // di field
+        [-6.003, 106.003],   // masuk tower
+        [-6.001, 106.001],   // keluar tower
+        [-6.0085, 106.0085], // lubang field = keluar area
+        [-6.020, 106.020]    // tetap di luar
+    ];
+    const events = path.map(([lat, lon], i) => engine.evaluate('uav1', lat, lon, i * 1000)
+        .map((event) => `${event.zone}:${event.event}:${event.violation}`));
+
+    assert.deepEqual(events, [
+        [],
+        ['tower:enter:true'],
+        ['tower:exit:false'],
+        ['field:exit:true'],
+        []
+    ]);
+    assert.deepEqual(engine.getStats().violations, 2);
+});
+
+test('first fix outside every flight area is an exit violation', () => {
+    const engine = new GeofenceEngine(normalizeZones(ZONES));
+    const [event, extra] = engine.evaluate('uav1', -6.020, 106.020, 0);
+    assert.equal(extra, undefined);
+    assert.equal(event.zone, 'field');
+    assert.equal(event.event, 'exit');
+    assert.equal(event.violation, true);
+    assert.deepEqual(engine.evaluate('uav1', -6.021, 106.020, 1000), []);
+
+    const tower = engine.evaluate('uav2', -6.003, 106.003, 0);
+    assert.deepEqual(tower.map((e) => `${e.zone}:${e.event}:${e.violation}`), ['tower:enter:true']);
+    assert.deepEqual(engine.evaluate('uav3', -6.001, 106.001, 0), []);
+    assert.deepEqual(engine.getDevices().map((device) => device.zones), [[], ['field', 'tower'], ['field']]);
+});
+
+test('ignores missing GPS fixes', () => {
+    const engine = new GeofenceEngine(normalizeZones(ZONES));
+    engine.evaluate('uav1', -6.003, 106.003, 0);
+    assert.deepEqual(engine.evaluate('uav1', 0, 0, 1000), []);
+    assert.deepEqual(engine.evaluate('uav1', NaN, 106, 2000), []);
+    assert.deepEqual(engine.getDevices()[0].zones.sort(), ['field', 'tower']);
+});
+
+test('rejects invalid zone definitions', () => {
+    assert.throws(() => normalizeZones([{ id: 'a', polygon: [[0, 0], [0, 1]] }]), /at least 3 points/);
+    assert.throws(() => normalizeZones([{ id: 'a', kind: 'nope', polygon: ZONES[1].polygon }]), /unknown kind/);
+    assert.throws(() => normalizeZones([ZONES[1], ZONES[1]]), /Duplicate zone id/);
+    assert.throws(() => normalizeZones([{ id: 'a', polygon: [[0, 0], [0, 1], [91, 0]] }]), /invalid point/);
+});
+
+test('reads GeoJSON in lon/lat order', () => {
+    const [zone] = normalizeZones({
+        type: 'FeatureCollection',
+        features: [{ properties: { id: 'g', kind: 'no_fly' }, geometry: { type: 'Polygon', coordinates: [[[106, -6], [107, -6], [107, -7]]] } }]
+    });
+    assert.deepEqual(zone.rings[0][1], [-6, 107]);
+    assert.equal(zone.kind, 'no_fly');
+});
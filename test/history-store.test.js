@@ -0,0 +1,79 @@
+const test = require('node:test');
+const assert = require('node:assert/strict');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { HistoryStore, COLUMNS, CHUNK_ROWS } = require('../lib/history-store');
+
+const VOLTAGE = COLUMNS.findIndex((column) => column.name === 'battery_voltage');
+const FLAGS = COLUMNS.findIndex((column) => column.name === 'anomaly_flags');
+
+function rows(store, deviceId) {
+    const result = [];
+    for (const { chunk, begin, end } of store.slices(deviceId)) {
+        for (let i = begin; i < end; i++) result.push({ t: chunk.columns[0][i], voltage: chunk.columns[VOLTAGE][i], flags: chunk.columns[FLAGS][i] });
+    }
+    return result;
+}
+
+test('keeps rows across chunk growth and time-range slices', () => {
+    const store = new HistoryStore();
+    for (let i = 0; i < 200; i++) store.append('uav1', { battery_voltage: i }, 1000 + i);
+    const all = rows(store, 'uav1');
+    assert.equal(all.length, 200);
+    assert.ok(all.every((row, i) => row.voltage === i && row.t === 1000 + i));
+
+    const window = store.slices('uav1', 1050, 1059);
+    assert.equal(window.reduce((sum, slice) => sum + slice.end - slice.begin, 0), 10);
+});
+
+test('markFlags ORs bits into rows counted from the end', () => {
+    const store = new HistoryStore();
+    for (let i = 0; i < 5; i++) store.append('uav1', {}, 1000 + i);
+    assert.equal(store.markFlags('uav1', 1, 2), true);
+    assert.equal(store.markFlags('uav1', 3, 1), true);
+    assert.equal(store.markFlags('uav1', 3, 4), true);
+    assert.equal(store.markFlags('uav1', 6, 1), false);
+    assert.equal(store.markFlags('uav1', 0, 1), false);
+    assert.equal(store.markFlags('nope', 1, 1), false);
+    assert.deepEqual(rows(store, 'uav1').map((row) => row.flags), [0, 0, 5, 0, 2]);
+});
+
+test('per-device maxRows drops whole old chunks', () => {
+    const store = new HistoryStore({ maxRows: CHUNK_ROWS });
+    for (let i = 0; i < CHUNK_ROWS * 2 + 1; i++) store.append('uav1', { battery_voltage: i }, i);
+    const kept = rows(store, 'uav1');
+    assert.equal(kept.length, CHUNK_ROWS + 1);
+    assert.equal(kept[0].voltage, CHUNK_ROWS);
+    assert.equal(store.getStats().evictedChunks, 1);
+});
+
+test('maxDevices evicts the device idle the longest', () => {
+    const store = new HistoryStore({ maxDevices: 2 });
+    store.append('a', {}, 1);
+    store.append('b', {}, 2);
+    store.append('a', {}, 3);
+    store.append('c', {}, 4);
+    assert.deepEqual(store.getDevices().map((device) => device.device_id).sort(), ['a', 'c']);
+    assert.equal(store.getStats().evictedDevices, 1);
+    assert.equal(store.getStats().totalRows, 3);
+});
+
+test('persists flushed chunks and reloads them', () => {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'history-test-'));
+    try {
+        const store = new HistoryStore({ dir });
+        for (let i = 0; i < 10; i++) store.append('uav/1', { battery_voltage: i / 2 }, 5000 + i);
+        store.markFlags('uav/1', 1, 8);
+        store.flush();
+
+        const reloaded = new HistoryStore({ dir });
+        const restored = rows(reloaded, 'uav/1');
+        assert.equal(restored.length, 10);
+        assert.equal(restored[9].voltage, 4.5);
+        assert.equal(restored[9].flags, 8);
+        assert.equal(restored[0].t, 5000);
+    } finally {
+        fs.rmSync(dir, { recursive: true, force: true });
+    }
+});
@@ -0,0 +1,143 @@
+const test = require('node:test');
+const assert = require('node:assert/strict');
+const net = require('net');
+const { IngestRequestParser, createIngestServer, INGEST_PATH } = require('../lib/ingest-listener');
+
+function post(body, headers = '', path = INGEST_PATH) {
+    return `POST ${path} HTTP/1.1\r\nHost: x\r\nContent-Length: ${Buffer.byteLength(body)}\r\n${headers}\r\n${body}`;
+}
+
+// Request object dipakai ulang parser, jadi field disalin sebelum next() berikutnya
+function drain(parser) {
+    const requests = [];
+    for (let request = parser.next(); request; request = parser.next()) {
+        requests.push({ ...request, body: request.body === null ? null : String(request.body) });
+        if (!request.ok && !request.keepAlive) break;
+    }
+    return requests;
+}
+
+test('parses a single POST with body and keep-alive default', () => {
+    const parser = new IngestRequestParser();
+    parser.push(Buffer.from(post('{"a":1}')));
+    const [request, extra] = drain(parser);
+    assert.equal(extra, undefined);
+    assert.equal(request.ok, true);
+    assert.equal(request.keepAlive, true);
+    assert.equal(request.body, '{"a":1}');
+});
+
+test('splits pipelined requests from one chunk in order', () => {
+    const parser = new IngestRequestParser();
+    parser.push(Buffer.from(post('{"n":1}') + post('{"n":2}') + post('{"n":3}')));
+    assert.deepEqual(drain(parser).map((request) => request.body), ['{"n":1}', '{"n":2}', '{"n":3}']);
+});
+
+test('waits for headers and body split across pushes', () => {
+    const parser = new IngestRequestParser();
+    const raw = Buffer.from(post('{"split":true}'));
+    for (let i = 0; i < raw.length - 1; i++) {
+        parser.push(raw.subarray(i, i + 1));
+        assert.equal(parser.next(), null, `byte ${i}`);
+    }
+    parser.push(raw.subarray(raw.length - 1));
+    assert.equal(String(parser.next().body), '{"split":true}');
+    assert.equal(parser.next(), null);
+});
+
+test('accepts a query string on the ingest path', () => {
+    const parser = new IngestRequestParser();
+    parser.push(Buffer.from(post('{}', '', `${INGEST_PATH}?device=x`)));
+    assert.equal(parser.next().ok, true);
+});
+
+test('answers 404 for other routes but keeps the connection', () => {
+    const parser = new IngestRequestParser();
+    parser.push(Buffer.from(`GET ${INGEST_PATH} HTTP/1.1\r\nHost: x\r\n\r\n` + post('{}', '', '/api/other') + post('{}')));
+    const requests = drain(parser);
+    assert.deepEqual(requests.map((request) => request.status), [404, 404, 0]);
+    assert.ok(requests.every((request) => request.keepAlive));
+    assert.equal(requests[2].ok, true);
+});
+
+test('rejects POST without Content-Length and chunked bodies, then closes', () => {
+    const missing = new IngestRequestParser();
+    missing.push(Buffer.from(`POST ${INGEST_PATH} HTTP/1.1\r\nHost: x\r\n\r\n{}`));
+    const [lengthRequired] = drain(missing);
+    assert.equal(lengthRequired.status, 411);
+    assert.equal(lengthRequired.keepAlive, false);
+    assert.equal(missing.next(), null);
+
+    const chunked = new IngestRequestParser();
+    chunked.push(Buffer.from(`POST ${INGEST_PATH} HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n2\r\n{}\r\n0\r\n\r\n`));
+    assert.equal(chunked.next().status, 501);
+});
+
+test('rejects bad request line, bad Content-Length, oversized body and headers', () => {
+    const malformed = new IngestRequestParser();
+    malformed.push(Buffer.from('POST\r\n\r\n'));
+    assert.equal(malformed.next().status, 400);
+
+    const badLength = new IngestRequestParser();
+    badLength.push(Buffer.from(`POST ${INGEST_PATH} HTTP/1.1\r\nContent-Length: 1x\r\n\r\n`));
+    assert.equal(badLength.next().status, 400);
+
+    const tooLarge = new IngestRequestParser(16);
+    tooLarge.push(Buffer.from(post('{"payload":"0123456789"}')));
+    assert.equal(tooLarge.next().status, 413);
+
+    const headers = new IngestRequestParser();
+    headers.push(Buffer.from(`POST ${INGEST_PATH} HTTP/1.1\r\nX-Filler: ${'a'.repeat(9000)}`));
+    assert.equal(headers.next().status, 431);
+});
+
+test('signals Expect: 100-continue once before the body arrives', () => {
+    const parser = new IngestRequestParser();
+    parser.push(Buffer.from(`POST ${INGEST_PATH} HTTP/1.1\r\nContent-Length: 2\r\nExpect: 100-continue\r\n\r\n`));
+    assert.equal(parser.next().needsContinue, true);
+    assert.equal(parser.next(), null);
+    parser.push(Buffer.from('{}'));
+    const request = parser.next();
+    assert.equal(request.needsContinue, false);
+    assert.equal(String(request.body), '{}');
+});
+
+test('HTTP/1.0 and Connection: close disable keep-alive', () => {
+    const http10 = new IngestRequestParser();
+    http10.push(Buffer.from(`POST ${INGEST_PATH} HTTP/1.0\r\nContent-Length: 2\r\n\r\n{}`));
+    assert.equal(http10.next().keepAlive, false);
+
+    const http10KeepAlive = new IngestRequestParser();
+    http10KeepAlive.push(Buffer.from(`POST ${INGEST_PATH} HTTP/1.0\r\nConnection: keep-alive\r\nContent-Length: 2\r\n\r\n{}`));
+    assert.equal(http10KeepAlive.next().keepAlive, true);
+
+    const close = new IngestRequestParser();
+    close.push(Buffer.from(post('{}', 'Connection: close\r\n')));
+    assert.equal(close.next().keepAlive, false);
+});
+
+test('ingest server answers pipelined requests in one response batch', async () => {
+    const bodies = [];
+    const server = createIngestServer({
+        port: 0,
+        host: '127.0.0.1',
+        onTelemetry: (body) => {
+            bodies.push(String(body));
+            return { status: 200, body: '{"success":true}' };
+        }
+    });
+    await new Promise((resolve) => server.once('listening', resolve));
+
+    const socket = net.connect(server.address().port, '127.0.0.1');
+    let response = '';
+    socket.setEncoding('utf8');
+    socket.on('data', (chunk) => { response += chunk; });
+    socket.write(post('{"n":1}') + post('{"n":2}', 'Connection: close\r\n'));
+    await new Promise((resolve) => socket.on('close', resolve));
+    await new Promise((resolve) => server.close(resolve));
+
+    assert.deepEqual(bodies, ['{"n":1}', '{"n":2}']);
+    assert.equal(response.match(/HTTP\/1\.1 200 OK/g).length, 2);
+    assert.match(response, /Connection: close\r\n\r\n\{"success":true\}$/);
+    assert.equal(server.ingestStats.pipelinedBatches, 1);
+});
@@ -0,0 +1,92 @@
+const test = require('node:test');
+const assert = require('node:assert/strict');
+const { MavlinkParser, toTelemetry, crcCalculate, MESSAGES } = require('../lib/mavlink');
+
+// Frame MAVLink v2 tanpa signature; payload boleh lebih pendek (trailing zero truncation)
+function frame(msgid, payload, sequence = 0) {
+    const buffer = Buffer.alloc(10 + payload.length + 2);
+    buffer[0] = 0xFD;
+    buffer[1] = payload.length;
+    buffer[4] = sequence;
+    buffer[5] = 1;
+    buffer[6] = 1;
+    buffer[7] = msgid & 0xFF;
+    buffer[8] = (msgid >> 8) & 0xFF;
+    buffer[9] = msgid >> 16;
+    payload.copy(buffer, 10);
+    buffer.writeUInt16LE(crcCalculate(buffer, 1, 10 + payload.length, MESSAGES[msgid] ? MESSAGES[msgid].crcExtra : 0), 10 + payload.length);
+    return buffer;
+}
+
+function sysStatus(millivolts, centiamps) {
+    const payload = Buffer.alloc(MESSAGES[1].length);
+    payload.writeUInt16LE(millivolts, 14);
+    payload.writeInt16LE(centiamps, 16);
+    return payload;
+}
+
+test('decodes SYS_STATUS fed one byte at a time', () => {
+    const parser = new MavlinkParser();
+    const raw = frame(1, sysStatus(12600, 1550), 42);
+    const messages = [];
+    for (const byte of raw) messages.push(...parser.push(Buffer.from([byte])));
+
+    assert.equal(messages.length, 1);
+    assert.equal(messages[0].name, 'SYS_STATUS');
+    assert.equal(messages[0].sequence, 42);
+    const data = toTelemetry(messages[0]);
+    assert.equal(data.battery_voltage, 12.6);
+    assert.equal(data.battery_current, 15.5);
+    assert.ok(Math.abs(data.battery_power - 12.6 * 15.5) < 1e-9);
+});
+
+test('skips garbage before STX and counts dropped bytes', () => {
+    const parser = new MavlinkParser();
+    const messages = parser.push(Buffer.concat([Buffer.from([1, 2, 3]), frame(1, sysStatus(11000, 100))]));
+    assert.equal(messages.length, 1);
+    assert.equal(parser.stats.bytesDropped, 3);
+});
+
+test('resyncs after a corrupted frame', () => {
+    const parser = new MavlinkParser();
+    const bad = frame(1, sysStatus(11000, 100));
+    bad[20] ^= 0xFF;
+    const messages = parser.push(Buffer.concat([bad, frame(1, sysStatus(12000, 200), 7)]));
+    assert.equal(messages.length, 1);
+    assert.equal(messages[0].sequence, 7);
+    assert.equal(parser.stats.crcErrors, 1);
+});
+
+test('zero-extends truncated payloads', () => {
+    const parser = new MavlinkParser();
+    const [message] = parser.push(frame(1, sysStatus(12000, 300).subarray(0, 18)));
+    assert.equal(message.payload.length, MESSAGES[1].length);
+    assert.equal(toTelemetry(message).battery_current, 3);
+});
+
+test('skips unknown messages and keeps decoding', () => {
+    const parser = new MavlinkParser();
+    const messages = parser.push(Buffer.concat([frame(9999, Buffer.alloc(4)), frame(1, sysStatus(12000, 0))]));
+    assert.equal(messages.length, 1);
+    assert.equal(parser.stats.unknownMessages, 1);
+});
+
+test('skips the signature of signed frames', () => {
+    const parser = new MavlinkParser();
+    const payload = sysStatus(12000, 0);
+    const signed = frame(1, payload);
+    signed[2] = 0x01;
+    signed.writeUInt16LE(crcCalculate(signed, 1, 10 + payload.length, MESSAGES[1].crcExtra), 10 + payload.length);
+    const messages = parser.push(Buffer.concat([signed, Buffer.alloc(13, 0xAA), frame(1, payload, 2)]));
+    assert.deepEqual(messages.map((message) => message.sequence), [0, 2]);
+    assert.equal(parser.stats.bytesDropped, 0);
+});
+
+test('maps GLOBAL_POSITION_INT to GPS fields', () => {
+    const payload = Buffer.alloc(MESSAGES[33].length);
+    payload.writeInt32LE(-62000000, 4);
+    payload.writeInt32LE(1068000000, 8);
+    payload.writeInt32LE(123450, 16);
+    const [message] = new MavlinkParser().push(frame(33, payload));
+    assert.deepEqual(toTelemetry(message), { gps_latitude: -6.2, gps_longitude: 106.8, altitude: 123.45 });
+});
@@ -0,0 +1,22 @@
+const test = require('node:test');
+const assert = require('node:assert/strict');
+const { RateTracker } = require('../lib/rate-meter');
+
+test('device cap evicts the least recently marked device', () => {
+    const rates = new RateTracker({ maxDevices: 2 });
+    rates.mark('packets', 'a', 1, 1000);
+    rates.mark('packets', 'b', 1, 2000);
+    rates.mark('packets', 'a', 1, 3000);
+    rates.mark('packets', 'c', 1, 4000);
+    assert.deepEqual(Object.keys(rates.getStats(5000).devices).sort(), ['a', 'c']);
+    assert.equal(rates.getStats(5000).devices.a.packets.total, 2);
+});
+
+test('global meter counts marks without a device', () => {
+    const rates = new RateTracker();
+    rates.mark('errors', null, 3, 1000);
+    const stats = rates.getStats(61000);
+    assert.equal(stats.global.errors.total, 3);
+    assert.deepEqual(stats.devices, {});
+    assert.ok(stats.global.errors.m1 > 0);
+});
@@ -0,0 +1,40 @@
+const test = require('node:test');
+const assert = require('node:assert/strict');
+const { BridgeFrameReader, FRAME_HEADER_LEN } = require('../lib/serial-bridge');
+
+function bridgeFrame(sequence, sentMicros, payload, flags = 0) {
+    const buffer = Buffer.alloc(2 + FRAME_HEADER_LEN + payload.length);
+    buffer.writeUInt16BE(FRAME_HEADER_LEN + payload.length, 0);
+    buffer[2] = 1;
+    buffer[3] = flags;
+    buffer.writeUInt32LE(sequence, 4);
+    buffer.writeUInt32LE(sentMicros, 8);
+    payload.copy(buffer, 12);
+    return buffer;
+}
+
+test('reassembles frames split at every byte boundary', () => {
+    const raw = Buffer.concat([bridgeFrame(1, 1000, Buffer.from('{"a":1}')), bridgeFrame(2, 2000, Buffer.from([0xFD, 0, 1]), 3)]);
+    for (let split = 1; split < raw.length; split++) {
+        const reader = new BridgeFrameReader();
+        const frames = [...reader.push(raw.subarray(0, split)), ...reader.push(raw.subarray(split))];
+        assert.equal(frames.length, 2, `split ${split}`);
+        assert.deepEqual(frames.map((frame) => frame.sequence), [1, 2]);
+        assert.equal(frames[0].sentMicros, 1000);
+        assert.equal(String(frames[0].payload), '{"a":1}');
+        assert.equal(frames[1].flags, 3);
+        assert.equal(frames[1].payload[0], 0xFD);
+    }
+});
+
+test('drops the buffer on an impossible length and recovers on the next frame', () => {
+    const reader = new BridgeFrameReader();
+    assert.deepEqual(reader.push(Buffer.from([0x00, 0x03, 1, 2, 3])), []);
+    assert.equal(reader.stats.invalidFrames, 1);
+    assert.deepEqual(reader.push(Buffer.from([0xFF, 0xFF])), []);
+    assert.equal(reader.stats.invalidFrames, 2);
+
+    const [frame] = reader.push(bridgeFrame(9, 0, Buffer.from('{}')));
+    assert.equal(frame.sequence, 9);
+    assert.equal(reader.stats.framesDecoded, 1);
+});